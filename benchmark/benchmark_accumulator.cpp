@@ -19,8 +19,8 @@ using namespace xt;
 using namespace hg;
 
 
-std::size_t min_tree_size = 10;
-std::size_t max_tree_size = 20;
+static std::size_t min_tree_size = 10;
+static std::size_t max_tree_size = 20;
 
 
 static void BM_tree_accumulator(benchmark::State &state) {
@@ -0,0 +1,57 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "utils.h"
+
+#include "higra/image/graph_image.hpp"
+#include "higra/algo/watershed.hpp"
+#include "higra/algo/rag.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace xt;
+using namespace hg;
+
+// end-to-end benchmarks on synthetic images of size state.range(0) x state.range(0)
+
+static void image_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(2)->Range(128, 2048)->Unit(benchmark::kMillisecond);
+}
+
+static void BM_labelisation_seeded_watershed(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    // one seed every 1000 pixels on average
+    xt::random::seed(42);
+    array_1d<index_t> seeds = xt::random::randint<index_t>({num_vertices(graph)}, 0, 1000);
+    seeds = xt::where(seeds > 0, 0, xt::arange<index_t>(1, num_vertices(graph) + 1));
+    for (auto _ : state) {
+        auto labels = labelisation_seeded_watershed(graph, edge_weights, seeds);
+        benchmark::DoNotOptimize(labels.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_labelisation_seeded_watershed)->Apply(image_sizes);
+
+static void BM_make_region_adjacency_graph_from_labelisation(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    auto labels = labelisation_watershed(graph, edge_weights);
+    for (auto _ : state) {
+        auto rag = make_region_adjacency_graph_from_labelisation(graph, labels);
+        benchmark::DoNotOptimize(rag.vertex_map.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_make_region_adjacency_graph_from_labelisation)->Apply(image_sizes);
@@ -17,9 +17,9 @@
 using namespace xt;
 using namespace hg;
 
-std::size_t min_array_size = 10;
-std::size_t max_array_size = 16;
-std::size_t max_array2d_size = 12;
+static std::size_t min_array_size = 10;
+static std::size_t max_array_size = 16;
+static std::size_t max_array2d_size = 12;
 
 
 template<typename T>
@@ -0,0 +1,193 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include <benchmark/benchmark.h>
+#include "utils.h"
+
+#include "higra/image/graph_image.hpp"
+#include "higra/image/tree_of_shapes.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/hierarchy/binary_partition_tree.hpp"
+#include "higra/hierarchy/watershed_hierarchy.hpp"
+#include "xtensor/xrandom.hpp"
+#include "xtensor/xview.hpp"
+
+using namespace xt;
+using namespace hg;
+
+// end-to-end benchmarks on synthetic images of size state.range(0) x state.range(0)
+
+static void image_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(2)->Range(128, 1024)->Unit(benchmark::kMillisecond);
+}
+
+static void small_image_sizes(benchmark::internal::Benchmark *b) {
+    b->RangeMultiplier(2)->Range(64, 256)->Unit(benchmark::kMillisecond);
+}
+
+static void BM_bpt_canonical(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    for (auto _ : state) {
+        auto res = bpt_canonical(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_bpt_canonical)->Apply(image_sizes);
+
+static void BM_binary_partition_tree_complete_linkage(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    for (auto _ : state) {
+        auto res = binary_partition_tree_complete_linkage(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_binary_partition_tree_complete_linkage)->Apply(small_image_sizes);
+
+static void BM_binary_partition_tree_average_linkage(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    array_1d<double> edge_weight_weights = xt::ones<double>({num_edges(graph)});
+    for (auto _ : state) {
+        auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_binary_partition_tree_average_linkage)->Apply(small_image_sizes);
+
+static void BM_binary_partition_tree_average_linkage_rnn(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    array_1d<double> edge_weight_weights = xt::ones<double>({num_edges(graph)});
+    for (auto _ : state) {
+        auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, bpt_engine::rnn);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_binary_partition_tree_average_linkage_rnn)->Apply(small_image_sizes);
+
+static void BM_binary_partition_tree_exponential_linkage(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    array_1d<double> edge_weight_weights = xt::ones<double>({num_edges(graph)});
+    for (auto _ : state) {
+        auto res = binary_partition_tree_exponential_linkage(graph, edge_weights, 0.1, edge_weight_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_binary_partition_tree_exponential_linkage)->Apply(small_image_sizes);
+
+static void BM_binary_partition_tree_ward_linkage(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto image = get_synthetic_image_2d(size, size);
+    array_2d<double> vertex_centroids = xt::reshape_view(image, {size * size, (std::size_t) 1});
+    array_1d<double> vertex_sizes = xt::ones<double>({num_vertices(graph)});
+    for (auto _ : state) {
+        auto res = binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_binary_partition_tree_ward_linkage)->Apply(small_image_sizes);
+
+static void BM_watershed_hierarchy_by_area(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    for (auto _ : state) {
+        auto res = watershed_hierarchy_by_area(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_watershed_hierarchy_by_area)->Apply(image_sizes);
+
+static void BM_watershed_hierarchy_by_volume(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    for (auto _ : state) {
+        auto res = watershed_hierarchy_by_volume(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_watershed_hierarchy_by_volume)->Apply(image_sizes);
+
+static void BM_watershed_hierarchy_by_dynamics(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    auto edge_weights = get_edge_weights_2d(graph, get_synthetic_image_2d(size, size));
+    for (auto _ : state) {
+        auto res = watershed_hierarchy_by_dynamics(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK(BM_watershed_hierarchy_by_dynamics)->Apply(image_sizes);
+
+static void BM_component_tree_tree_of_shapes_image2d(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto image = get_synthetic_image_2d(size, size);
+    for (auto _ : state) {
+        auto res = component_tree_tree_of_shapes_image2d(image);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+
+BENCHMARK(BM_component_tree_tree_of_shapes_image2d)->Apply(image_sizes);
+
+// comparison of the priority queues of binary_partition_tree on 4-adjacency grid graphs of 10^5, 10^6, and 10^7
+// vertices with random integer weights
+
+static void rag_sizes(benchmark::internal::Benchmark *b) {
+    b->Arg(316)->Arg(1000)->Arg(3162)->Unit(benchmark::kMillisecond);
+}
+
+template<typename heap_policy>
+static void BM_binary_partition_tree_heap(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto graph = get_4_adjacency_graph({(index_t) size, (index_t) size});
+    xt::random::seed(42);
+    array_1d<int> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 1 << 20);
+    for (auto _ : state) {
+        auto res = binary_partition_tree_complete_linkage<heap_policy>(graph, edge_weights);
+        benchmark::DoNotOptimize(res.altitudes.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(graph));
+}
+
+BENCHMARK_TEMPLATE(BM_binary_partition_tree_heap, fibonacci_heap_policy)->Apply(rag_sizes);
+BENCHMARK_TEMPLATE(BM_binary_partition_tree_heap, dary_heap_policy<2>)->Apply(rag_sizes);
+BENCHMARK_TEMPLATE(BM_binary_partition_tree_heap, dary_heap_policy<4>)->Apply(rag_sizes);
+BENCHMARK_TEMPLATE(BM_binary_partition_tree_heap, dary_heap_policy<8>)->Apply(rag_sizes);
+BENCHMARK_TEMPLATE(BM_binary_partition_tree_heap, radix_heap_policy)->Apply(rag_sizes);
@@ -21,7 +21,7 @@
 using namespace xt;
 using namespace hg;
 
-index_t repetition = 1;
+static index_t repetition = 1;
 
 static void BM_lca_sparse_table_block(benchmark::State &state) {
     for (auto _ : state) {
@@ -79,4 +79,40 @@ static void BM_lca_sparse_table(benchmark::State &state) {
     }
 }
 
-BENCHMARK(BM_lca_sparse_table)->DenseRange(256, 2048, 256);
\ No newline at end of file
+BENCHMARK(BM_lca_sparse_table)->DenseRange(256, 2048, 256);
+
+// number of threads available to parallel queries
+static double num_cores() {
+#ifdef HG_USE_TBB
+    return tbb::this_task_arena::max_concurrency();
+#else
+    return 1;
+#endif
+}
+
+// throughput of the batched lca queries on the edges of a size x size 4 adjacency graph (construction excluded)
+template<typename lca_t>
+static void BM_lca_queries(benchmark::State &state) {
+    index_t size = state.range(0);
+    auto g = get_4_adjacency_graph({size, size});
+    array_1d<double> weights = xt::random::rand<double>({num_edges(g)});
+    auto res = watershed_hierarchy_by_area(g, weights);
+    lca_t l(res.tree);
+
+    for (auto _ : state) {
+        auto ll = l.lca(edge_iterator(g));
+        benchmark::DoNotOptimize(ll.data());
+    }
+    state.SetItemsProcessed(state.iterations() * num_edges(g));
+    state.counters["queries_per_second_per_core"] = benchmark::Counter(
+            state.iterations() * num_edges(g) / num_cores(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(BM_lca_queries, lca_sparse_table)->RangeMultiplier(2)->Range(256, 2048)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_lca_queries, lca_sparse_table_block)->RangeMultiplier(2)->Range(256, 2048)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_lca_queries, lca_schieber_vishkin)->RangeMultiplier(2)->Range(256, 2048)->Unit(
+        benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_lca_queries, lca_schieber_vishkin_32)->RangeMultiplier(2)->Range(256, 2048)->Unit(
+        benchmark::kMillisecond);
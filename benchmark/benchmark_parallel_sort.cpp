@@ -11,17 +11,21 @@
 #include <benchmark/benchmark.h>
 
 #include "higra/graph.hpp"
+#include "higra/sorting.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xrandom.hpp"
 #include <algorithm>
+
+#ifdef HG_USE_TBB
 #include "tbb/parallel_sort.h"
 #include "tbb-ssort/parallel_stable_sort.h"
+#endif
 
 using namespace xt;
 using namespace hg;
 
-std::size_t min_array_size = 10;
-std::size_t max_array_size = 24;
+static std::size_t min_array_size = 10;
+static std::size_t max_array_size = 24;
 
 
 
@@ -56,6 +60,8 @@ static void BM_stl_stable_sort(benchmark::State &state) {
 
 BENCHMARK(BM_stl_stable_sort)->Range(1 << min_array_size, 1 << max_array_size);
 
+#ifdef HG_USE_TBB
+
 static void BM_tbb_parallel_sort(benchmark::State &state) {
     for (auto _ : state) {
         state.PauseTiming();
@@ -84,4 +90,51 @@ static void BM_tbb_parallel_stable_sort(benchmark::State &state) {
     }
 }
 
-BENCHMARK(BM_tbb_parallel_stable_sort)->Range(1 << min_array_size, 1 << max_array_size);
\ No newline at end of file
+BENCHMARK(BM_tbb_parallel_stable_sort)->Range(1 << min_array_size, 1 << max_array_size);
+
+#endif
+
+template<typename value_t>
+array_1d<value_t> random_sort_input(size_t size) {
+    return xt::random::randint<int>({size}, 0, (std::min)((int)std::numeric_limits<value_t>::max(), 1 << 20));
+}
+
+template<>
+array_1d<float> random_sort_input<float>(size_t size) {
+    return xt::random::rand<float>({size});
+}
+
+template<typename value_t>
+static void BM_comparison_stable_arg_sort(benchmark::State &state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        size_t size = state.range(0);
+        array_1d<value_t> a = random_sort_input<value_t>(size);
+        state.ResumeTiming();
+        auto indices = hg::sorting_internal::comparison_stable_arg_sort(a, std::less<value_t>());
+        bool flag;
+        benchmark::DoNotOptimize(flag = (indices.size() == size));
+    }
+}
+
+template<typename value_t>
+static void BM_radix_stable_arg_sort(benchmark::State &state) {
+    for (auto _ : state) {
+        state.PauseTiming();
+        size_t size = state.range(0);
+        array_1d<value_t> a = random_sort_input<value_t>(size);
+        state.ResumeTiming();
+        auto indices = hg::sorting_internal::radix_stable_arg_sort(a);
+        bool flag;
+        benchmark::DoNotOptimize(flag = (indices.size() == size));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, uint8_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, uint8_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, uint16_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, uint16_t)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, int)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, int)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_comparison_stable_arg_sort, float)->Range(1 << min_array_size, 1 << max_array_size);
+BENCHMARK_TEMPLATE(BM_radix_stable_arg_sort, float)->Range(1 << min_array_size, 1 << max_array_size);
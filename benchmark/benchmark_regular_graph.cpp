@@ -19,8 +19,8 @@ using namespace xt;
 using namespace hg;
 
 
-std::size_t min_size = 6;
-std::size_t max_size = 12;
+static std::size_t min_size = 6;
+static std::size_t max_size = 12;
 
 
 static void BM_graph_implicit_adjacency_iterator(benchmark::State &state) {
@@ -20,12 +20,13 @@
 #include "xtensor/xstrided_view.hpp"
 #include "xtensor/xeval.hpp"
 #include "higra/attribute/tree_attribute.hpp"
+#include "utils.h"
 
 using namespace xt;
 using namespace hg;
 
-std::size_t min_tree_size = 10;
-std::size_t max_tree_size = 16;
+static std::size_t min_tree_size = 10;
+static std::size_t max_tree_size = 16;
 
 static void BM_tree_volume_cstyle(benchmark::State &state) {
     for (auto _ : state) {
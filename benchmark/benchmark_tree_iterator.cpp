@@ -24,8 +24,8 @@
 using namespace xt;
 using namespace hg;
 
-std::size_t min_tree_size = 10;
-std::size_t max_tree_size = 16;
+static std::size_t min_tree_size = 10;
+static std::size_t max_tree_size = 16;
 
 
 
@@ -42,7 +42,7 @@ static void BM_tree_accumulate_parallel_scalar_cstyle(benchmark::State &state) {
         auto sout = output.data();
         auto sin = input.data();
         std::fill(sout, sout + t.num_vertices(), 0);
-        for (auto i: t.iterate_from_leaves_to_root(leaves_it::exclude)) {
+        for (auto i: t.leaves_to_root_iterator(leaves_it::exclude)) {
             for (auto c: t.children(i)) {
                 sout[i] += sin[c];
             }
@@ -54,6 +54,49 @@ static void BM_tree_accumulate_parallel_scalar_cstyle(benchmark::State &state) {
 
 BENCHMARK(BM_tree_accumulate_parallel_scalar_cstyle)->Range(1 << min_tree_size, 1 << max_tree_size);
 
+static void BM_tree_compute_children(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto t = get_complete_binary_tree(size);
+    for (auto _ : state) {
+        t.clear_children();
+        t.compute_children();
+        benchmark::DoNotOptimize(t.num_children(t.root()));
+    }
+}
+
+BENCHMARK(BM_tree_compute_children)->Range(1 << min_tree_size, 1 << max_tree_size);
+
+static void BM_tree_out_edge_iterator(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto t = get_complete_binary_tree(size);
+    t.compute_children();
+    for (auto _ : state) {
+        index_t sum = 0;
+        for (auto v: vertex_iterator(t)) {
+            for (auto e: out_edge_iterator(v, t)) {
+                sum += target(e, t);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_tree_out_edge_iterator)->Range(1 << min_tree_size, 1 << max_tree_size);
+
+static void BM_tree_edge_iterator(benchmark::State &state) {
+    std::size_t size = state.range(0);
+    auto t = get_complete_binary_tree(size);
+    for (auto _ : state) {
+        index_t sum = 0;
+        for (auto e: edge_iterator(t)) {
+            sum += source(e, t);
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+BENCHMARK(BM_tree_edge_iterator)->Range(1 << min_tree_size, 1 << max_tree_size);
+
 /*
 static void BM_tree_accumulate_parallel_scalar_view(benchmark::State& state) {
     for (auto _ : state)
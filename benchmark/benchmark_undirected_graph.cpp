@@ -22,8 +22,8 @@ using namespace xt;
 using namespace hg;
 
 
-std::size_t min_size = 6;
-std::size_t max_size = 12;
+static std::size_t min_size = 6;
+static std::size_t max_size = 12;
 
 static void BM_from_edge_list_no_preallocation(benchmark::State &state) {
     for (auto _ : state) {
@@ -96,3 +96,71 @@ static void BM_graph_implicit_to_explicit(benchmark::State &state) {
 
 BENCHMARK(BM_graph_implicit_to_explicit)->Range(1 << min_size, 1 << max_size);
 
+
+template<typename graph_t>
+static void traverse_out_edges(benchmark::State &state, const graph_t &g) {
+    for (auto _ : state) {
+        index_t sum = 0;
+        for (auto v: vertex_iterator(g)) {
+            for (auto e: out_edge_iterator(v, g)) {
+                sum += target(e, g);
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+template<typename graph_t>
+static void traverse_adjacent_vertices(benchmark::State &state, const graph_t &g) {
+    for (auto _ : state) {
+        index_t sum = 0;
+        for (auto v: vertex_iterator(g)) {
+            for (auto n: adjacent_vertex_iterator(v, g)) {
+                sum += n;
+            }
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+}
+
+static void BM_ugraph_out_edge_iterator(benchmark::State &state) {
+    hg::index_t size = state.range(0);
+    auto g = hg::get_4_adjacency_graph({size, size});
+    traverse_out_edges(state, g);
+}
+
+BENCHMARK(BM_ugraph_out_edge_iterator)->Range(1 << min_size, 1 << max_size);
+
+static void BM_ugraph_adjacency_iterator(benchmark::State &state) {
+    hg::index_t size = state.range(0);
+    auto g = hg::get_4_adjacency_graph({size, size});
+    traverse_adjacent_vertices(state, g);
+}
+
+BENCHMARK(BM_ugraph_adjacency_iterator)->Range(1 << min_size, 1 << max_size);
+
+static void BM_csr_graph_out_edge_iterator(benchmark::State &state) {
+    hg::index_t size = state.range(0);
+    auto ug = hg::get_4_adjacency_graph({size, size});
+    hg::csr_graph g(sources(ug), targets(ug), num_vertices(ug));
+    traverse_out_edges(state, g);
+}
+
+BENCHMARK(BM_csr_graph_out_edge_iterator)->Range(1 << min_size, 1 << max_size);
+
+static void BM_csr_graph_adjacency_iterator(benchmark::State &state) {
+    hg::index_t size = state.range(0);
+    auto ug = hg::get_4_adjacency_graph({size, size});
+    hg::csr_graph g(sources(ug), targets(ug), num_vertices(ug));
+    traverse_adjacent_vertices(state, g);
+}
+
+BENCHMARK(BM_csr_graph_adjacency_iterator)->Range(1 << min_size, 1 << max_size);
+
+static void BM_implicit_graph_out_edge_iterator(benchmark::State &state) {
+    hg::index_t size = state.range(0);
+    auto g = hg::get_4_adjacency_implicit_graph(hg::embedding_grid_2d({size, size}));
+    traverse_out_edges(state, g);
+}
+
+BENCHMARK(BM_implicit_graph_out_edge_iterator)->Range(1 << min_size, 1 << max_size);
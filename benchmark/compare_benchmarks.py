@@ -0,0 +1,114 @@
+############################################################################
+# Copyright ESIEE Paris (2018)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+"""
+Compare two result files of the benchmark suite produced with Google Benchmark JSON output, for example with the
+target benchmark_json or with:
+
+    benchmark_higra --benchmark_out=results.json --benchmark_out_format=json
+
+Usage:
+
+    python compare_benchmarks.py baseline.json contender.json [--threshold 0.1] [--filter regex]
+
+For each benchmark present in both files, the ratio contender time / baseline time is printed. The script exits with
+a non zero status if at least one benchmark is slower than the baseline by more than the given relative threshold
+(default 10%), so it can be used to detect performance regressions between two releases.
+"""
+
+import argparse
+import json
+import re
+import sys
+
+
+def load_benchmarks(filename, time_key):
+    """
+    Read a Google Benchmark JSON file and return a dictionary benchmark name => time.
+
+    When benchmarks were run with repetitions, the median aggregate is used if present, otherwise the mean of the
+    repetitions.
+    """
+    with open(filename) as f:
+        data = json.load(f)
+
+    times = {}
+    medians = {}
+    for b in data["benchmarks"]:
+        if b.get("error_occurred", False):
+            continue
+        name = b.get("run_name", b["name"])
+        if b.get("run_type") == "aggregate":
+            if b.get("aggregate_name") == "median":
+                medians[name] = b[time_key]
+        else:
+            times.setdefault(name, []).append(b[time_key])
+
+    result = {k: sum(v) / len(v) for k, v in times.items()}
+    result.update(medians)
+    return result
+
+
+def compare(baseline, contender, threshold, name_filter):
+    """
+    Return a list of tuples (name, baseline time, contender time, ratio) for benchmarks present in both
+    dictionaries and a list of regressed benchmark names.
+    """
+    rows = []
+    regressions = []
+    for name in baseline:
+        if name not in contender or (name_filter is not None and not re.search(name_filter, name)):
+            continue
+        t0 = baseline[name]
+        t1 = contender[name]
+        ratio = t1 / t0 if t0 > 0 else float("inf")
+        rows.append((name, t0, t1, ratio))
+        if ratio > 1 + threshold:
+            regressions.append(name)
+    return rows, regressions
+
+
+def main(argv=None):
+    parser = argparse.ArgumentParser(description="Compare two Google Benchmark JSON result files.")
+    parser.add_argument("baseline", help="JSON result file of the reference version")
+    parser.add_argument("contender", help="JSON result file of the tested version")
+    parser.add_argument("--threshold", type=float, default=0.1,
+                        help="relative slowdown above which a benchmark is reported as a regression (default 0.1)")
+    parser.add_argument("--filter", default=None, help="only compare benchmarks whose name matches this regex")
+    parser.add_argument("--time", choices=("real_time", "cpu_time"), default="real_time",
+                        help="time measure to compare (default real_time)")
+    args = parser.parse_args(argv)
+
+    baseline = load_benchmarks(args.baseline, args.time)
+    contender = load_benchmarks(args.contender, args.time)
+    rows, regressions = compare(baseline, contender, args.threshold, args.filter)
+
+    if len(rows) == 0:
+        print("No common benchmark found.")
+        return 0
+
+    width = max(len(r[0]) for r in rows)
+    print("{:<{w}}  {:>14}  {:>14}  {:>8}".format("Benchmark", "Baseline", "Contender", "Ratio", w=width))
+    for name, t0, t1, ratio in rows:
+        flag = "  <-- regression" if name in regressions else ""
+        print("{:<{w}}  {:>14.6g}  {:>14.6g}  {:>8.3f}{}".format(name, t0, t1, ratio, flag, w=width))
+
+    missing = sorted(set(baseline) ^ set(contender))
+    if len(missing) > 0:
+        print("\n{} benchmark(s) present in only one file were ignored.".format(len(missing)))
+
+    if len(regressions) > 0:
+        print("\n{} regression(s) above {:.1f}%.".format(len(regressions), args.threshold * 100))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
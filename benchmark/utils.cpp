@@ -9,6 +9,9 @@
 ****************************************************************************/
 
 #include "utils.h"
+#include "higra/algo/graph_weights.hpp"
+#include "xtensor/xrandom.hpp"
+#include <cmath>
 
 using namespace hg;
 
@@ -25,4 +28,20 @@ hg::tree get_complete_binary_tree(std::size_t num_leaves) {
     }
     parent(parent.size() - 1) = parent.size() - 1;
     return tree(std::move(parent));
-}
\ No newline at end of file
+}
+
+hg::array_2d<double> get_synthetic_image_2d(std::size_t height, std::size_t width) {
+    xt::random::seed(42);
+    array_2d<double> image = xt::random::rand<double>({height, width}) * 32;
+    for (std::size_t i = 0; i < height; i++) {
+        for (std::size_t j = 0; j < width; j++) {
+            image(i, j) += 128 + 64 * std::sin(i / 13.) * std::cos(j / 17.) + 32 * std::sin((i + j) / 29.);
+        }
+    }
+    return image;
+}
+
+hg::array_1d<double> get_edge_weights_2d(const hg::ugraph &graph, const hg::array_2d<double> &image) {
+    array_1d<double> vertex_weights = xt::flatten(image);
+    return weight_graph(graph, vertex_weights, weight_functions::L1);
+}
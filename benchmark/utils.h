@@ -10,5 +10,16 @@
 
 #pragma once
 #include "higra/graph.hpp"
+#include "higra/structure/array.hpp"
 
 hg::tree get_complete_binary_tree(std::size_t num_leaves);
+
+/**
+ * Synthetic gray level image of the given size: smooth blobs plus uniform noise (deterministic).
+ */
+hg::array_2d<double> get_synthetic_image_2d(std::size_t height, std::size_t width);
+
+/**
+ * Edge weights of the 4 adjacency graph of the given image (absolute difference of adjacent pixel values).
+ */
+hg::array_1d<double> get_edge_weights_2d(const hg::ugraph &graph, const hg::array_2d<double> &image);
@@ -11,6 +11,7 @@
 # pre-declaration of globals
 globals()["__higra_global_cache"] = None
 globals()["__auto_caching"] = True
+globals()["__auto_cache_disk_tier"] = None
 
 # extension module
 from .higram import *
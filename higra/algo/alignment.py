@@ -47,7 +47,6 @@ def align_hierarchies(graph, vertex_labels, other_hierarchies):
         on a region adjacency graph (Concept :class:`~higra.CptRegionAdjacencyGraph`).
     :return: a hierarchy or a list of hierarchies as saliency maps
     """
-    result = []
     list_input = True
     if not hg.is_iterable(other_hierarchies):
         raise TypeError("bas format for other hierarchies.")
@@ -59,27 +58,46 @@ def align_hierarchies(graph, vertex_labels, other_hierarchies):
 
     aligner = hg.HierarchyAligner.from_labelisation(graph, vertex_labels)
 
-    for hierarchy in other_hierarchies:
+    # hierarchies of a same kind (and of a same value type) are aligned in parallel with a single call
+    groups = {}
+
+    def add_to_group(key, i, *args):
+        indices, arguments = groups.setdefault(key, ([], tuple([] for _ in args)))
+        indices.append(i)
+        for l, arg in zip(arguments, args):
+            l.append(arg)
+
+    for i, hierarchy in enumerate(other_hierarchies):
         obj, values = hierarchy
+        values = np.asarray(values)
         if type(obj) is hg.Tree:
             leaf_graph = hg.CptHierarchy.get_leaf_graph(obj)
             if leaf_graph is not None and hg.CptRegionAdjacencyGraph.validate(leaf_graph):
-                vertex_map = hg.CptRegionAdjacencyGraph.get_vertex_map(leaf_graph)
-                r = aligner.align_hierarchy(vertex_map, obj, values)
+                vertex_map = hg.cast_to_dtype(hg.CptRegionAdjacencyGraph.get_vertex_map(leaf_graph), np.int64)
+                add_to_group(("supervertices", values.dtype), i, vertex_map, obj, values)
             else:
-                r = aligner.align_hierarchy(obj, values)
+                add_to_group(("tree", values.dtype), i, obj, values)
 
         elif type(obj) is hg.UndirectedGraph:
             if hg.CptRegionAdjacencyGraph.validate(obj):
-                vertex_map = hg.CptRegionAdjacencyGraph.get_vertex_map(obj)
+                vertex_map = hg.cast_to_dtype(hg.CptRegionAdjacencyGraph.get_vertex_map(obj), np.int64)
                 bpt, altitudes = hg.bpt_canonical(obj, values)
-                r = aligner.align_hierarchy(vertex_map, bpt, altitudes)
+                add_to_group(("supervertices", altitudes.dtype), i, vertex_map, bpt, altitudes)
             else:
-                r = aligner.align_hierarchy(obj, values)
+                add_to_group(("saliency_map", id(obj), values.dtype), i, values)
 
         else:
             raise Exception("Hierarchy format not recognized: " + str(hierarchy))
-        result.append(r)
+
+    result = [None] * len(other_hierarchies)
+    for key, (indices, arguments) in groups.items():
+        if key[0] == "saliency_map":
+            aligned = aligner.align_hierarchies(other_hierarchies[indices[0]][0], *arguments)
+        else:
+            aligned = aligner.align_hierarchies(*arguments)
+        for i, r in zip(indices, aligned):
+            result[i] = r
+
     if not list_input:
         return result[0]
     return result
@@ -21,6 +21,14 @@ namespace py_alignement {
 
     namespace py = pybind11;
 
+    std::vector<std::reference_wrapper<const hg::tree>> get_trees(const py::list &py_trees) {
+        std::vector<std::reference_wrapper<const hg::tree>> trees;
+        for (const auto &t: py_trees) {
+            trees.push_back(t.cast<const hg::tree &>());
+        }
+        return trees;
+    }
+
     struct def_project_fine_to_coarse_labelisation {
         template<typename value_t, typename C>
         static
@@ -124,6 +132,42 @@ namespace py_alignement {
         }
     };
 
+    struct def_align_hierarchies {
+        template<typename value_t, typename C>
+        static
+        void def(C &c, const char *doc) {
+            c.def("align_hierarchies", [](
+                          const hg::hierarchy_aligner &a,
+                          const py::list &trees,
+                          const std::vector<pyarray<value_t>> &altitudes) {
+                      return a.align_hierarchies(get_trees(trees), altitudes);
+                  },
+                  doc,
+                  py::arg("trees"),
+                  py::arg("altitudes"));
+            c.def("align_hierarchies", [](
+                          const hg::hierarchy_aligner &a,
+                          const hg::ugraph &graph,
+                          const std::vector<pyarray<value_t>> &saliency_maps) {
+                      return a.align_hierarchies(graph, saliency_maps);
+                  },
+                  doc,
+                  py::arg("graph"),
+                  py::arg("saliency_maps"));
+            c.def("align_hierarchies", [](
+                          const hg::hierarchy_aligner &a,
+                          const std::vector<pyarray<hg::index_t>> &super_vertices,
+                          const py::list &trees,
+                          const std::vector<pyarray<value_t>> &altitudes) {
+                      return a.align_hierarchies(super_vertices, get_trees(trees), altitudes);
+                  },
+                  doc,
+                  py::arg("super_vertices"),
+                  py::arg("trees"),
+                  py::arg("altitudes"));
+        }
+    };
+
     void py_init_alignement(pybind11::module &m) {
         //xt::import_numpy();
 
@@ -145,5 +189,8 @@ namespace py_alignement {
         add_type_overloads<def_align_hierarchy, HG_TEMPLATE_NUMERIC_TYPES>
                 (c, "Align the given hierarchy given either as a tree or as a saliency map.");
 
+        add_type_overloads<def_align_hierarchies, HG_TEMPLATE_NUMERIC_TYPES>
+                (c, "Align, in parallel, the given hierarchies given either as trees or as saliency maps.");
+
     }
 }
\ No newline at end of file
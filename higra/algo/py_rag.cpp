@@ -12,6 +12,7 @@
 #include "higra/algo/rag.hpp"
 #include "higra/algo/alignment.hpp"
 #include "../py_common.hpp"
+#include "../structure/py_csr_graph.hpp"
 #include "xtensor-python/pyarray.hpp"
 #include "xtensor-python/pytensor.hpp"
 
@@ -40,6 +41,22 @@ namespace py_rag {
         }
     };
 
+    template<typename graph_t>
+    struct def_make_rag_parallel {
+        template<typename value_t, typename C>
+        static
+        void def(C &c, const char *doc) {
+            c.def("_make_region_adjacency_graph_from_labelisation_parallel",
+                  [](const graph_t &graph, const pyarray<value_t> &input) {
+                      auto res = hg::make_region_adjacency_graph_from_labelisation_parallel(graph, input);
+                      return py::make_tuple(std::move(res.rag), std::move(res.vertex_map), std::move(res.edge_map));
+                  },
+                  doc,
+                  py::arg("graph"),
+                  py::arg("vertex_labels"));
+        }
+    };
+
     template<typename graph_t>
     struct def_make_rag_cut {
         template<typename value_t, typename C>
@@ -78,10 +95,28 @@ namespace py_rag {
                 (m,
                  "Create a region adjacency graph of the input graph with regions identified by the provided vertex labels.");
 
+        add_type_overloads<def_make_rag_parallel<hg::ugraph>, HG_TEMPLATE_INTEGRAL_TYPES>
+                (m,
+                 "Create a region adjacency graph of the input graph with regions identified by the provided vertex labels "
+                 "(parallel algorithm, edges of the result are sorted by increasing source and target).");
+
         add_type_overloads<def_make_rag_cut<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>
                 (m,
                  "Create a region adjacency graph of the input graph with regions identified by the provided graph cut.");
 
+        add_type_overloads<def_make_rag<py_csr_graph::csr_graph_t>, HG_TEMPLATE_INTEGRAL_TYPES>
+                (m,
+                 "Create a region adjacency graph of the input graph with regions identified by the provided vertex labels.");
+
+        add_type_overloads<def_make_rag_parallel<py_csr_graph::csr_graph_t>, HG_TEMPLATE_INTEGRAL_TYPES>
+                (m,
+                 "Create a region adjacency graph of the input graph with regions identified by the provided vertex labels "
+                 "(parallel algorithm, edges of the result are sorted by increasing source and target).");
+
+        add_type_overloads<def_make_rag_cut<py_csr_graph::csr_graph_t>, HG_TEMPLATE_NUMERIC_TYPES>
+                (m,
+                 "Create a region adjacency graph of the input graph with regions identified by the provided graph cut.");
+
         add_type_overloads<def_rag_back_project_weights, HG_TEMPLATE_NUMERIC_TYPES>
                 (m,
                  "Projects vertex or edge weights defined on a region adjacency graph back to the original graph space.");
@@ -11,6 +11,7 @@
 #include "py_watershed.hpp"
 #include "higra/algo/watershed.hpp"
 #include "../py_common.hpp"
+#include "../structure/py_csr_graph.hpp"
 #include "xtensor-python/pyarray.hpp"
 #include "xtensor-python/pytensor.hpp"
 
@@ -56,12 +57,55 @@ namespace py_watershed {
         }
     };
 
+    template<typename graph_t>
+    struct def_make_seeded_watershed_msf {
+        template<typename value_t, typename C>
+        static
+        void def(C &c, const char *doc) {
+            c.def("_make_seeded_watershed_msf",
+                  [](const graph_t &graph, const pyarray<value_t> &edge_weights) {
+                      return hg::make_seeded_watershed_msf(graph, edge_weights);
+                  },
+                  doc,
+                  py::arg("graph"),
+                  py::arg("edge_weights"));
+        }
+    };
 
     void py_init_watershed(pybind11::module &m) {
         //xt::import_numpy();
 
         add_type_overloads<def_labelisation_watershed<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
         add_type_overloads<def_labelisation_seeded_watershed<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+        add_type_overloads<def_labelisation_watershed<py_csr_graph::csr_graph_t>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+        add_type_overloads<def_labelisation_seeded_watershed<py_csr_graph::csr_graph_t>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+        add_type_overloads<def_labelisation_watershed<hg::regular_grid_graph_2d>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+        add_type_overloads<def_labelisation_watershed<hg::regular_grid_graph_3d>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+
+        py::class_<hg::seeded_watershed_msf>(m, "SeededWatershedMSF",
+                                             "Sorted minimum spanning forest of an edge weighted graph used to compute "
+                                             "several seeded watersheds on the same graph.")
+                .def_readonly("num_vertices", &hg::seeded_watershed_msf::num_vertices, "Number of vertices of the graph")
+                .def_property_readonly("sources",
+                                       [](const hg::seeded_watershed_msf &msf) { return msf.sources; },
+                                       "Sources of the edges of the minimum spanning forest")
+                .def_property_readonly("targets",
+                                       [](const hg::seeded_watershed_msf &msf) { return msf.targets; },
+                                       "Targets of the edges of the minimum spanning forest");
+
+        add_type_overloads<def_make_seeded_watershed_msf<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+        add_type_overloads<def_make_seeded_watershed_msf<py_csr_graph::csr_graph_t>, HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+
+        m.def("_labelisation_seeded_watershed",
+              [](const hg::seeded_watershed_msf &msf,
+                 const pyarray<hg::index_t> &vertex_seeds,
+                 const hg::index_t background_label) {
+                  return hg::labelisation_seeded_watershed(msf, vertex_seeds, background_label);
+              },
+              "",
+              py::arg("seeded_watershed_msf"),
+              py::arg("vertex_seeds"),
+              py::arg("background_label"));
     }
 }
 
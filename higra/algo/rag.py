@@ -11,7 +11,7 @@
 import higra as hg
 
 
-def make_region_adjacency_graph_from_labelisation(graph, vertex_labels):
+def make_region_adjacency_graph_from_labelisation(graph, vertex_labels, parallel=False):
     """
     Create a region adjacency graph (rag) of a vertex labelled graph.
     Each maximal connected set of vertices having the same label is a region.
@@ -19,13 +19,22 @@ def make_region_adjacency_graph_from_labelisation(graph, vertex_labels):
     There is an edge between two regions of labels :math:`l_1` and :math:`l_2` in the rag iff there exists an edge
     linking two vertices of labels :math:`l_1` and :math:`l_2` int he original graph.
 
+    If :attr:`parallel` is ``True``, the rag is constructed with a parallel algorithm (multi-threaded if Higra was
+    compiled with TBB and the graph is large): the vertices of the rag are the same but its edges are sorted
+    by increasing source and target vertices.
+
     :param graph: input graph
     :param vertex_labels: vertex labels on the input graph
+    :param parallel: use the parallel algorithm (default ``False``)
     :return: a region adjacency graph (Concept :class:`~higra.CptRegionAdjacencyGraph`)
     """
     vertex_labels = hg.linearize_vertex_weights(vertex_labels, graph)
 
-    rag, vertex_map, edge_map = hg.cpp._make_region_adjacency_graph_from_labelisation(graph, vertex_labels)
+    if parallel:
+        rag, vertex_map, edge_map = hg.cpp._make_region_adjacency_graph_from_labelisation_parallel(graph,
+                                                                                                   vertex_labels)
+    else:
+        rag, vertex_map, edge_map = hg.cpp._make_region_adjacency_graph_from_labelisation(graph, vertex_labels)
 
     hg.CptRegionAdjacencyGraph.link(rag, graph, vertex_map, edge_map)
 
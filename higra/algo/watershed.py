@@ -28,6 +28,10 @@ def labelisation_watershed(graph, edge_weights):
 
     This algorithm has a linear runtime complexity :math:`\mathcal{O}(n)` with :math:`n` the number of edges in the graph.
 
+    The graph can also be an implicit 2d or 3d grid graph (see :func:`~higra.get_4_adjacency_implicit_graph`,
+    :func:`~higra.get_8_adjacency_implicit_graph`, and :func:`~higra.get_6_adjacency_implicit_graph`). In this case,
+    the edges are ordered as in the corresponding explicit graph (see :func:`~higra.get_4_adjacency_graph`,
+    :func:`~higra.get_8_adjacency_graph`, and :func:`~higra.get_6_adjacency_graph`).
 
     :param graph: input graph
     :param edge_weights: Weights on the edges of the graph
@@ -40,6 +44,25 @@ def labelisation_watershed(graph, edge_weights):
     return vertex_labels
 
 
+def make_seeded_watershed_msf(graph, edge_weights):
+    """
+    Precompute the sorted minimum spanning forest of an edge weighted graph.
+
+    The result can be given in place of the edge weights to :func:`~higra.labelisation_seeded_watershed` in order to
+    compute several seeded watersheds with different seeds on the same edge weighted graph: each such seeded watershed
+    is then computed in linear time.
+
+    :Complexity:
+
+    This algorithm has a runtime complexity in :math:`\mathcal{O}(n \log n)` with :math:`n` the number of edges in the graph.
+
+    :param graph: Input graph
+    :param edge_weights: Weights on the edges of the graph
+    :return: an object of type :class:`~higra.SeededWatershedMSF`
+    """
+    return hg.cpp._make_seeded_watershed_msf(graph, edge_weights)
+
+
 def labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_label=0):
     """
     Seeded watershed cut on an edge weighted graph.
@@ -55,9 +78,12 @@ def labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_
     :Complexity:
 
     This algorithm has a runtime complexity in :math:`\mathcal{O}(n \log n)` with :math:`n` the number of edges in the graph.
+    If :attr:`edge_weights` is a minimum spanning forest computed with :func:`~higra.make_seeded_watershed_msf`, the
+    runtime complexity is linear.
 
     :param graph: Input graph
-    :param edge_weights: Weights on the edges of the graph
+    :param edge_weights: Weights on the edges of the graph, or the result of :func:`~higra.make_seeded_watershed_msf`
+        on the same graph
     :param vertex_seeds: Seeds with integer label values on the vertices of the graph
     :param background_label: Vertices whose values are equal to :attr:`background_label` (default 0) in :attr:`vertex_seeds` are not considered as seeds
     :return: A labelisation of the graph vertices
@@ -69,7 +95,10 @@ def labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_
 
     vertex_seeds = hg.cast_to_dtype(vertex_seeds, np.int64)
 
-    labels = hg.cpp._labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_label)
+    if isinstance(edge_weights, hg.SeededWatershedMSF):
+        labels = hg.cpp._labelisation_seeded_watershed(edge_weights, vertex_seeds, background_label)
+    else:
+        labels = hg.cpp._labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_label)
 
     labels = hg.delinearize_vertex_weights(labels, graph)
     return labels
@@ -8,6 +8,7 @@
 # The full license is in the file LICENSE, distributed with this software. #
 ############################################################################
 
+from .batch_assessment import *
 from .hierarchical_cost import *
 from .fragmentation_curve import *
 
@@ -10,5 +10,7 @@
 
 #pragma once
 
+#include "py_batch_assessment.hpp"
 #include "py_fragmentation_curve.hpp"
+#include "py_hierarchical_cost.hpp"
 #include "py_partition.hpp"
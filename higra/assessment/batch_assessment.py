@@ -0,0 +1,146 @@
+############################################################################
+# Copyright ESIEE Paris (2018)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+
+import higra as hg
+import numpy as np
+
+
+def __ground_truth_stacks(ground_truths):
+    # a 1d array is a single ground truth and a 2d array is a stack of ground truths
+    stacks = []
+    for ground_truth in ground_truths:
+        ground_truth = hg.cast_to_dtype(np.asarray(ground_truth), np.int64)
+        if ground_truth.ndim == 1:
+            ground_truth = ground_truth[np.newaxis, :]
+        if ground_truth.ndim != 2:
+            raise ValueError("Each ground truth must be a 1d array or a 2d array (stack of ground truths).")
+        stacks.append(ground_truth)
+    return stacks
+
+
+def __vertex_maps(trees, vertex_maps):
+    # deduce the vertex maps from the leaf graphs of the trees (see CptRegionAdjacencyGraph)
+    if vertex_maps is None:
+        vertex_maps = []
+        for tree in trees:
+            leaf_graph = hg.CptHierarchy.get_leaf_graph(tree)
+            vertex_map = None if leaf_graph is None else hg.CptRegionAdjacencyGraph.get_vertex_map(leaf_graph)
+            vertex_maps.append(vertex_map)
+        if all(vertex_map is None for vertex_map in vertex_maps):
+            return []
+    elif len(vertex_maps) != len(trees):
+        raise ValueError("The number of vertex maps must be equal to the number of trees.")
+
+    # an empty vertex map means that the tree is not built on a region adjacency graph
+    return [np.zeros((0,), dtype=np.int64) if vertex_map is None else hg.cast_to_dtype(vertex_map, np.int64)
+            for vertex_map in vertex_maps]
+
+
+def assess_partition_batch(candidates, ground_truths, measure):
+    """
+    Assess many candidate partitions, each against its own stack of ground-truth partitions, with the given
+    measure (see :class:`~higra.PartitionMeasure`).
+
+    Unlike :func:`~higra.assess_partition`, which averages the scores over a stack of ground-truths, the candidate
+    is scored against each ground-truth of its stack. The (candidate, ground-truth) pairs are evaluated in parallel.
+
+    :param candidates: list of candidate labelisations
+    :param ground_truths: list of ground-truths: :attr:`ground_truths[i]` is a 1d array (a single ground-truth) or
+        a 2d array (a stack of ground-truths, one per row) of labelisations with the same number of elements as
+        :attr:`candidates[i]`
+    :param measure: evaluation measure to use (see enumeration :class:`~higra.PartitionMeasure`)
+    :return: a list of 1d arrays: element :attr:`j` of the :attr:`i`-th array is the score of :attr:`candidates[i]`
+        w.r.t. the :attr:`j`-th ground-truth of its stack
+    """
+    if len(candidates) != len(ground_truths):
+        raise ValueError("The number of ground-truths must be equal to the number of candidates.")
+    candidates = [hg.cast_to_dtype(np.asarray(candidate), np.int64) for candidate in candidates]
+    return hg.cpp._assess_partition_batch(candidates, __ground_truth_stacks(ground_truths), measure)
+
+
+def dendrogram_purity_batch(trees, leaf_labels):
+    """
+    Dendrogram purity (see :func:`~higra.dendrogram_purity`) of many trees, each against its own stack of leaf
+    labelisations.
+
+    The preprocessing of each tree is shared by all the labelisations of its stack and the (tree, labelisation)
+    pairs are evaluated in parallel.
+
+    :param trees: list of trees
+    :param leaf_labels: list of leaf labelisations: :attr:`leaf_labels[i]` is a 1d array (a single labelisation) or
+        a 2d array (a stack of labelisations, one per row) of integral labels of the leaves of :attr:`trees[i]`
+    :return: a list of 1d arrays: element :attr:`j` of the :attr:`i`-th array is the purity of :attr:`trees[i]`
+        w.r.t. the :attr:`j`-th labelisation of its stack
+    """
+    if len(trees) != len(leaf_labels):
+        raise ValueError("The number of leaf labelisations must be equal to the number of trees.")
+    for labels in leaf_labels:
+        if np.asarray(labels).dtype.kind != 'i':
+            raise ValueError("leaf_labels must be integral arrays.")
+    return hg.cpp._dendrogram_purity_batch(list(trees), __ground_truth_stacks(leaf_labels))
+
+
+def assess_fragmentation_optimal_cut_batch(trees, ground_truths, measure, max_regions=200, vertex_maps=None):
+    """
+    Fragmentation curves of the optimal cuts (see :func:`~higra.assess_fragmentation_optimal_cut`) of many
+    hierarchies, each against its own stack of ground-truths.
+
+    The preprocessing of each hierarchy is shared by all the ground-truths of its stack and the
+    (hierarchy, ground-truth) pairs are evaluated in parallel.
+
+    :param trees: list of binary hierarchies
+    :param ground_truths: list of ground-truths: :attr:`ground_truths[i]` is a 1d array (a single ground-truth) or a
+        2d array (a stack of ground-truths, one per row) of labelisations of the base graph vertices of :attr:`trees[i]`
+    :param measure: evaluation measure to use (see enumeration :class:`~higra.OptimalCutMeasure`)
+    :param max_regions: maximum number of regions in the cuts
+    :param vertex_maps: optional, list of vertex mappings if the hierarchies are built on region adjacency graphs
+        (deduced from :class:`~higra.CptRegionAdjacencyGraph` on the leaf graphs of the trees)
+    :return: a list of lists of :class:`~higra.FragmentationCurve`: element :attr:`j` of the :attr:`i`-th list is the
+        fragmentation curve of :attr:`trees[i]` w.r.t. the :attr:`j`-th ground-truth of its stack
+    """
+    if len(trees) != len(ground_truths):
+        raise ValueError("The number of ground-truths must be equal to the number of trees.")
+    return hg.cpp._assess_fragmentation_optimal_cut_batch(list(trees),
+                                                          __ground_truth_stacks(ground_truths),
+                                                          measure,
+                                                          vertex_maps=__vertex_maps(trees, vertex_maps),
+                                                          max_regions=int(max_regions))
+
+
+def assess_fragmentation_horizontal_cut_batch(trees, altitudes, ground_truths, measure, max_regions=200,
+                                              vertex_maps=None):
+    """
+    Fragmentation curves of the horizontal cuts (see :func:`~higra.assess_fragmentation_horizontal_cut`) of many
+    hierarchies, each against its own stack of ground-truths.
+
+    The preprocessing of each hierarchy (in particular the sorting of its altitudes) is shared by all the
+    ground-truths of its stack and the (hierarchy, ground-truth) pairs are evaluated in parallel.
+
+    :param trees: list of hierarchies
+    :param altitudes: list of node altitudes: :attr:`altitudes[i]` are the altitudes of the nodes of :attr:`trees[i]`
+    :param ground_truths: list of ground-truths: :attr:`ground_truths[i]` is a 1d array (a single ground-truth) or a
+        2d array (a stack of ground-truths, one per row) of labelisations of the base graph vertices of :attr:`trees[i]`
+    :param measure: evaluation measure to use (see enumeration :class:`~higra.PartitionMeasure`)
+    :param max_regions: maximum number of regions in the cuts
+    :param vertex_maps: optional, list of vertex mappings if the hierarchies are built on region adjacency graphs
+        (deduced from :class:`~higra.CptRegionAdjacencyGraph` on the leaf graphs of the trees)
+    :return: a list of lists of :class:`~higra.FragmentationCurve`: element :attr:`j` of the :attr:`i`-th list is the
+        fragmentation curve of :attr:`trees[i]` w.r.t. the :attr:`j`-th ground-truth of its stack
+    """
+    if len(trees) != len(ground_truths) or len(trees) != len(altitudes):
+        raise ValueError("The number of altitudes and of ground-truths must be equal to the number of trees.")
+    altitudes = [hg.cast_to_dtype(np.asarray(a), np.float64) for a in altitudes]
+    return hg.cpp._assess_fragmentation_horizontal_cut_batch(list(trees),
+                                                             altitudes,
+                                                             __ground_truth_stacks(ground_truths),
+                                                             measure,
+                                                             vertex_maps=__vertex_maps(trees, vertex_maps),
+                                                             max_regions=int(max_regions))
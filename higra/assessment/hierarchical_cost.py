@@ -42,8 +42,8 @@ def dendrogram_purity(tree, leaf_labels):
     
     :Complexity:
     
-    The dendrogram purity is computed in :math:`\mathcal{O}(N\\times K \\times C^2)` with :math:`N` the number of nodes
-    in the tree, :math:`K` the number of classes, and :math:`C` the maximal number of children of a node in the tree.
+    The dendrogram purity is computed in :math:`\mathcal{O}(N\log(N))` with :math:`N` the number of nodes in the tree:
+    the sparse label histograms of the children of a node are merged into the largest one.
 
     :param tree: input tree
     :param leaf_labels: a 1d integral array of length `tree.num_leaves()`
@@ -52,21 +52,7 @@ def dendrogram_purity(tree, leaf_labels):
     if leaf_labels.ndim != 1 or leaf_labels.size != tree.num_leaves() or leaf_labels.dtype.kind != 'i':
         raise ValueError("leaf_labels must be a 1d integral array of length `tree.num_leaves()`")
 
-    num_l = tree.num_leaves()
-    area = hg.attribute_area(tree)
-
-    max_label = np.max(leaf_labels)
-    num_labels = max_label + 1
-    label_histo_leaves = np.zeros((num_l, num_labels), dtype=np.float64)
-    label_histo_leaves[np.arange(num_l), leaf_labels] = 1
-
-    label_histo = hg.accumulate_sequential(tree, label_histo_leaves, hg.Accumulators.sum)
-    class_purity = label_histo / area[:, np.newaxis]
-
-    weights = hg.attribute_children_pair_sum_product(tree, label_histo)
-    total = np.sum(class_purity[num_l:, :] * weights[num_l:, :])
-
-    return total / np.sum(weights[num_l:])
+    return hg.cpp._dendrogram_purity(tree, leaf_labels)
 
 
 @hg.argument_helper(hg.CptHierarchy)
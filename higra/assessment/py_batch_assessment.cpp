@@ -0,0 +1,125 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+
+#include "py_batch_assessment.hpp"
+#include "../py_common.hpp"
+#include "higra/assessment/batch_assessment.hpp"
+#include "xtensor-python/pyarray.hpp"
+
+namespace py_batch_assessment {
+    using namespace hg;
+    namespace py = pybind11;
+
+    using trees_t = std::vector<std::reference_wrapper<const hg::tree>>;
+    using labels_t = std::vector<xt::pyarray<index_t>>;
+
+    trees_t get_trees(const py::list &py_trees) {
+        trees_t trees;
+        for (const auto &t: py_trees) {
+            trees.push_back(t.cast<const hg::tree &>());
+        }
+        return trees;
+    }
+
+    template<typename T>
+    py::list to_py_list(std::vector<T> &&table) {
+        py::list result;
+        for (auto &row: table) {
+            result.append(py::cast(std::move(row)));
+        }
+        return result;
+    }
+
+    void py_init_batch_assessment(pybind11::module &m) {
+        m.def("_assess_partition_batch",
+              [](const std::vector<xt::pyarray<index_t>> &candidates,
+                 const labels_t &ground_truths,
+                 partition_measure measure) {
+                  switch (measure) {
+                      case partition_measure::DHamming:
+                          return to_py_list(assess_partition_batch(candidates, ground_truths,
+                                                                   scorer_partition_DHamming()));
+                      case partition_measure::DCovering:
+                          return to_py_list(assess_partition_batch(candidates, ground_truths,
+                                                                   scorer_partition_DCovering()));
+                      case partition_measure::BCE:
+                          return to_py_list(assess_partition_batch(candidates, ground_truths,
+                                                                   scorer_partition_BCE()));
+                      default:
+                          throw std::runtime_error(
+                                  "Partition measure is not known, see enumeration PartitionMeasure for legal values.");
+                  }
+              },
+              "Assess many candidate partitions, each against a stack of ground truth partitions.",
+              py::arg("candidates"),
+              py::arg("ground_truths"),
+              py::arg("partition_measure"));
+
+        m.def("_dendrogram_purity_batch",
+              [](const py::list &trees,
+                 const labels_t &leaf_labels) {
+                  return to_py_list(dendrogram_purity_batch(get_trees(trees), leaf_labels));
+              },
+              "Dendrogram purity of many trees, each against a stack of leaf labelisations.",
+              py::arg("trees"),
+              py::arg("leaf_labels"));
+
+        m.def("_assess_fragmentation_optimal_cut_batch",
+              [](const py::list &trees,
+                 const labels_t &ground_truths,
+                 optimal_cut_measure measure,
+                 const std::vector<array_1d<index_t>> &vertex_maps,
+                 hg::size_t max_regions) {
+                  return to_py_list(assess_fragmentation_optimal_cut_batch(get_trees(trees), ground_truths, measure,
+                                                                           vertex_maps, max_regions));
+              },
+              "Fragmentation curves of the optimal cuts of many hierarchies, each against a stack of ground truths.",
+              py::arg("trees"),
+              py::arg("ground_truths"),
+              py::arg("optimal_cut_measure"),
+              py::arg("vertex_maps") = std::vector<array_1d<index_t>>{},
+              py::arg("max_regions") = 200);
+
+        m.def("_assess_fragmentation_horizontal_cut_batch",
+              [](const py::list &trees,
+                 const std::vector<xt::pyarray<double>> &altitudes,
+                 const labels_t &ground_truths,
+                 partition_measure measure,
+                 const std::vector<array_1d<index_t>> &vertex_maps,
+                 hg::size_t max_regions) {
+                  auto trees_v = get_trees(trees);
+                  switch (measure) {
+                      case partition_measure::DHamming:
+                          return to_py_list(assess_fragmentation_horizontal_cut_batch(
+                                  trees_v, altitudes, ground_truths, scorer_partition_DHamming(), vertex_maps,
+                                  max_regions));
+                      case partition_measure::DCovering:
+                          return to_py_list(assess_fragmentation_horizontal_cut_batch(
+                                  trees_v, altitudes, ground_truths, scorer_partition_DCovering(), vertex_maps,
+                                  max_regions));
+                      case partition_measure::BCE:
+                          return to_py_list(assess_fragmentation_horizontal_cut_batch(
+                                  trees_v, altitudes, ground_truths, scorer_partition_BCE(), vertex_maps,
+                                  max_regions));
+                      default:
+                          throw std::runtime_error(
+                                  "Partition measure is not known, see enumeration PartitionMeasure for legal values.");
+                  }
+              },
+              "Fragmentation curves of the horizontal cuts of many hierarchies, each against a stack of ground truths.",
+              py::arg("trees"),
+              py::arg("altitudes"),
+              py::arg("ground_truths"),
+              py::arg("partition_measure"),
+              py::arg("vertex_maps") = std::vector<array_1d<index_t>>{},
+              py::arg("max_regions") = 200);
+    }
+}
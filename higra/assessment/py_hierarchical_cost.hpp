@@ -0,0 +1,19 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+
+#pragma once
+
+#include "pybind11/pybind11.h"
+
+namespace py_hierarchical_cost {
+    void py_init_hierarchical_cost(pybind11::module &m);
+}
+
@@ -125,6 +125,72 @@ namespace py_attributes {
         }
     };
 
+    template<typename R>
+    py::dict fused_attributes_to_dict(R &res, const std::vector<hg::tree_attribute> &attributes) {
+        py::dict d;
+        for (auto a: attributes) {
+            switch (a) {
+                case hg::tree_attribute::area:
+                    d["area"] = res.area;
+                    break;
+                case hg::tree_attribute::volume:
+                    d["volume"] = res.volume;
+                    break;
+                case hg::tree_attribute::depth:
+                    d["depth"] = res.depth;
+                    break;
+                case hg::tree_attribute::height:
+                    d["height"] = res.height;
+                    break;
+                case hg::tree_attribute::extrema:
+                    d["extrema"] = res.extrema;
+                    break;
+                case hg::tree_attribute::dynamics:
+                    d["dynamics"] = res.dynamics;
+                    break;
+                case hg::tree_attribute::topological_height:
+                    d["topological_height"] = res.topological_height;
+                    break;
+            }
+        }
+        return d;
+    }
+
+    struct def_compute_tree_attributes {
+        template<typename T, typename T_area>
+        static
+        void def_area(pybind11::module &m, const char *doc) {
+            m.def("_compute_tree_attributes",
+                  [](const hg::tree &tree,
+                     const std::vector<hg::tree_attribute> &attributes,
+                     const pyarray<T_area> &leaf_area,
+                     const pyarray<T> &altitudes,
+                     bool increasing_altitudes) {
+                      auto res = hg::compute_tree_attributes(
+                              tree,
+                              attributes,
+                              leaf_area,
+                              altitudes,
+                              increasing_altitudes
+                      );
+                      return fused_attributes_to_dict(res, attributes);
+                  },
+                  doc,
+                  py::arg("tree"),
+                  py::arg("attributes"),
+                  py::arg("leaf_area"),
+                  py::arg("altitudes"),
+                  py::arg("increasing_altitudes"));
+        }
+
+        template<typename T>
+        static
+        void def(pybind11::module &m, const char *doc) {
+            def_area<T, hg::index_t>(m, doc);
+            def_area<T, double>(m, doc);
+        }
+    };
+
     void py_init_attributes(pybind11::module &m) {
         //xt::import_numpy();
         m.def("_attribute_sibling",
@@ -161,6 +227,19 @@ namespace py_attributes {
         add_type_overloads<def_attribute_height,
                 HG_TEMPLATE_NUMERIC_TYPES>(m, "");
 
+        py::enum_<hg::tree_attribute>(m, "TreeAttribute",
+                                      "Tree attributes that can be computed together with compute_tree_attributes.")
+                .value("area", hg::tree_attribute::area)
+                .value("volume", hg::tree_attribute::volume)
+                .value("depth", hg::tree_attribute::depth)
+                .value("height", hg::tree_attribute::height)
+                .value("extrema", hg::tree_attribute::extrema)
+                .value("dynamics", hg::tree_attribute::dynamics)
+                .value("topological_height", hg::tree_attribute::topological_height);
+
+        add_type_overloads<def_compute_tree_attributes,
+                HG_TEMPLATE_NUMERIC_TYPES>(m, "");
+
         add_type_overloads<def_attribute_children_pair_sum_product,
                 int32_t, uint32_t, int64_t, uint64_t, float, double>(m, "");
     }
@@ -747,3 +747,64 @@ def attribute_moment_of_inertia(tree, leaf_graph):
     I_1 = (miu_20 + miu_02) / (M_00 ** 2)
 
     return I_1
+
+
+@hg.argument_helper(hg.CptHierarchy)
+def compute_tree_attributes(tree, attributes, altitudes=None, vertex_area=None, increasing_altitudes="auto",
+                            leaf_graph=None):
+    """
+    Compute several attributes of the given tree at once.
+
+    The available attributes (see :class:`~higra.TreeAttribute`) are:
+
+        - ``'area'``: see :func:`~higra.attribute_area`;
+        - ``'volume'``: see :func:`~higra.attribute_volume`;
+        - ``'depth'``: see :func:`~higra.attribute_depth`;
+        - ``'height'``: see :func:`~higra.attribute_height`;
+        - ``'extrema'``: see :func:`~higra.attribute_extrema`;
+        - ``'dynamics'``: see :func:`~higra.attribute_dynamics`; and
+        - ``'topological_height'``: see :func:`~higra.attribute_topological_height`.
+
+    The requested attributes and their dependencies (area for volume, height and extrema for dynamics) are computed
+    together in a single leaves to root traversal of the tree followed, if depth or dynamics is requested, by
+    a single root to leaves traversal. This is faster than calling the corresponding functions one by one when
+    several attributes are needed.
+
+    >>> res = hg.compute_tree_attributes(tree, ["area", "volume", "dynamics"], altitudes)
+    >>> area, volume, dynamics = res["area"], res["volume"], res["dynamics"]
+
+    :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
+    :param attributes: list of attribute names or of :class:`~higra.TreeAttribute`
+    :param altitudes: tree node altitudes (only required for ``'volume'``, ``'height'``, ``'extrema'``, and ``'dynamics'``)
+    :param vertex_area: area of the vertices of the leaf graph of the tree (provided by :func:`~higra.attribute_vertex_area` on `leaf_graph` )
+    :param increasing_altitudes: possible values 'auto', True, False, 'increasing', and 'decreasing' (see :func:`~higra.attribute_height`)
+    :param leaf_graph: (deduced from :class:`~higra.CptHierarchy`)
+    :return: a dictionary associating each requested attribute name to a 1d array
+    """
+    attributes = [a if isinstance(a, hg.TreeAttribute) else hg.TreeAttribute.__members__.get(a, None)
+                  for a in attributes]
+    if None in attributes:
+        raise ValueError("Unknown tree attribute, valid attributes are: " +
+                         ", ".join(hg.TreeAttribute.__members__.keys()) + ".")
+
+    if vertex_area is None:
+        if leaf_graph is not None:
+            vertex_area = hg.attribute_vertex_area(leaf_graph)
+        else:
+            vertex_area = np.ones((tree.num_leaves(),), dtype=np.float64)
+
+    if leaf_graph is not None:
+        vertex_area = hg.linearize_vertex_weights(vertex_area, leaf_graph)
+
+    if not np.issubdtype(vertex_area.dtype, np.integer):
+        vertex_area = vertex_area.astype(np.float64, copy=False)
+    else:
+        vertex_area = vertex_area.astype(np.int64, copy=False)
+
+    if altitudes is None:
+        altitudes = np.zeros((0,), dtype=np.float64)
+        inc = True
+    else:
+        inc = __process_param_increasing_altitudes(tree, altitudes, increasing_altitudes)
+
+    return hg.cpp._compute_tree_attributes(tree, attributes, vertex_area, altitudes, inc)
@@ -12,6 +12,11 @@ import weakref
 import functools
 import sys
 import inspect
+import hashlib
+import os
+import tempfile
+import time
+import numpy as np
 import higra as hg
 
 
@@ -100,6 +105,14 @@ class WeakKeyDictionary:
 def _data_cache__init():
     hg.__higra_global_cache = DataCache()
 
+    directory = os.environ.get("HIGRA_AUTO_CACHE_DIR", None)
+    if directory:
+        max_size = os.environ.get("HIGRA_AUTO_CACHE_MAX_SIZE", None)
+        if max_size:
+            set_auto_cache_disk_tier(directory, int(max_size))
+        else:
+            set_auto_cache_disk_tier(directory)
+
 
 class DataCache:
 
@@ -501,6 +514,13 @@ def auto_cache(fun):
         - :func:`~set_auto_cache_state`
         - :func:`~get_auto_cache_state`
 
+    :Disk tier:
+
+    Results can also be shared between processes and sessions with a persistent disk tier, see:
+
+        - :func:`~set_auto_cache_disk_tier`
+        - :func:`~get_auto_cache_disk_tier`
+
     :return:
     """
 
@@ -547,7 +567,7 @@ def auto_cache(fun):
             h = __make_hash(*args, **kwargs)
 
             if force_recompute or h not in cache:
-                cache[h] = fun(*args, **kwargs)
+                cache[h] = __call_with_disk_tier(fun, data_name, force_recompute, args, kwargs)
 
             return cache[h]
         except TypeError as e:
@@ -561,6 +581,319 @@ def auto_cache(fun):
 
     return wrapper
 
+###########################################################
+#                                                         #
+#                 AUTO CACHE DISK TIER                    #
+#                                                         #
+###########################################################
+
+class _NotContentHashable(Exception):
+    pass
+
+
+# Higra attributes which are computed from the structure of their object (they do not describe its content)
+_content_hash_derived_attributes = {"lca_fast"}
+
+
+def _update_content_hash(h, o, visited):
+    """
+    Feed a description of the content of the object :attr:`o` to the hash object :attr:`h`.
+
+    Trees and graphs are described by their structure, by their Higra attributes (see
+    :func:`~higra.list_attributes`) which may influence the result of a function (concepts), and by their tags.
+    Classes, such as the concepts used as tags, are described by their qualified name. Attributes derived from the
+    structure of the object (e.g. ``lca_fast``) are ignored.
+
+    :param h: hash object (see hashlib)
+    :param o: object
+    :param visited: ids of the trees and graphs already described (avoid cycles between linked objects)
+    :return: nothing
+    :raise _NotContentHashable: if the content of the object cannot be described
+    """
+    if o is None or isinstance(o, (bool, int, float, complex, str, bytes)):
+        h.update(repr((type(o).__name__, o)).encode())
+    elif isinstance(o, (np.ndarray, np.generic)):
+        if o.dtype.hasobject:
+            raise _NotContentHashable()
+        h.update(repr(("ndarray", o.dtype.str, o.shape)).encode())
+        h.update(np.ascontiguousarray(o).reshape(-1).view(np.uint8).data)
+    elif isinstance(o, (tuple, list)):
+        h.update(repr((type(o).__name__, len(o))).encode())
+        for e in o:
+            _update_content_hash(h, e, visited)
+    elif isinstance(o, (set, frozenset)):
+        h.update(repr(("set", len(o))).encode())
+        for e in sorted(o, key=repr):
+            _update_content_hash(h, e, visited)
+    elif isinstance(o, dict):
+        h.update(repr(("dict", len(o))).encode())
+        for k in sorted(o.keys(), key=repr):
+            _update_content_hash(h, k, visited)
+            _update_content_hash(h, o[k], visited)
+    elif isinstance(o, type):
+        h.update(repr(("class", o.__module__ + "." + o.__qualname__)).encode())
+    elif hasattr(type(o), "__members__") and hasattr(o, "__int__"):
+        # enumerations exported by the extension module
+        h.update(repr((type(o).__name__, int(o))).encode())
+    else:
+        if id(o) in visited:
+            h.update(repr(("visited", visited.index(id(o)))).encode())
+            return
+        if isinstance(o, hg.Tree):
+            h.update(repr(("Tree", int(o.category()))).encode())
+            structure = (o.parents(),)
+        elif hg.has_method(o, "neighbour_list") and hg.has_method(o, "shape"):
+            h.update(type(o).__name__.encode())
+            structure = (o.shape(), o.neighbour_list())
+        elif hg.has_method(o, "edge_list") and hg.has_method(o, "num_vertices"):
+            h.update(type(o).__name__.encode())
+            structure = (o.num_vertices(), o.edge_list())
+        else:
+            raise _NotContentHashable()
+        visited.append(id(o))
+        _update_content_hash(h, structure, visited)
+        attributes = getattr(o, "__higra_attributes__", {})
+        _update_content_hash(h, {k: v for k, v in attributes.items() if k not in _content_hash_derived_attributes},
+                             visited)
+        _update_content_hash(h, getattr(o, "__higra_tags__", set()), visited)
+
+
+class DiskCache:
+    """
+    Persistent store of the results of :func:`~higra.auto_cache` decorated functions (see
+    :func:`~higra.set_auto_cache_disk_tier`).
+
+    Entries are identified by a hash of the content of the function arguments. Arrays are stored in the numpy ``.npy``
+    format and trees in the binary tree format (see :func:`~higra.save_tree`): entries are memory mapped (copy on
+    write) when they are loaded.
+
+    The store can be shared by several processes: an entry is written in a temporary file which is then atomically
+    renamed, and an entry removed by another process is simply considered missing. When the total size of the stored
+    entries exceeds :attr:`max_size`, least recently used entries are removed.
+    """
+
+    _temporary_prefix = ".tmp-"
+    _array_suffix = ".npy"
+    _tree_suffix = ".tree"
+    # temporary files older than this delay (in seconds) were left by a process that died while writing them
+    _stale_temporary_delay = 3600
+
+    def __init__(self, directory, max_size=2 ** 30):
+        """
+        :param directory: directory of the store (created if it does not exist)
+        :param max_size: maximal total size of the stored entries in bytes
+        """
+        self.directory = os.path.abspath(directory)
+        self.max_size = max_size
+        os.makedirs(self.directory, exist_ok=True)
+
+    def key(self, function, data_name, args, kwargs):
+        """
+        Key of the result of the call :attr:`function(*args, **kwargs)`.
+
+        :return: a string or ``None`` if the content of an argument cannot be hashed
+        """
+        h = hashlib.blake2b(digest_size=20)
+        h.update(repr((hg.cpp.__version__, function.__module__, function.__qualname__, data_name)).encode())
+        try:
+            _update_content_hash(h, (args, kwargs), [])
+        except _NotContentHashable:
+            return None
+        return h.hexdigest()
+
+    def load(self, key):
+        """
+        Load the entry associated to the given key.
+
+        :return: a pair (found, result)
+        """
+        path = os.path.join(self.directory, key + self._array_suffix)
+        if os.path.exists(path):
+            try:
+                try:
+                    result = np.load(path, mmap_mode="c", allow_pickle=False)
+                except ValueError:
+                    # empty arrays cannot be mapped
+                    result = np.load(path, allow_pickle=False)
+            except (OSError, ValueError):
+                return False, None
+            self.__touch(path)
+            return True, result
+
+        path = os.path.join(self.directory, key + self._tree_suffix)
+        if os.path.exists(path):
+            try:
+                result, _ = hg.cpp._read_tree_binary(path, True)
+            except (OSError, RuntimeError):
+                return False, None
+            self.__touch(path)
+            return True, result
+
+        return False, None
+
+    def store(self, key, result):
+        """
+        Store the given result under the given key: only numpy arrays (without Python objects) and trees are stored.
+
+        :return: ``True`` if the result was stored
+        """
+        if isinstance(result, np.ndarray) and not result.dtype.hasobject:
+            suffix = self._array_suffix
+        elif isinstance(result, hg.Tree):
+            suffix = self._tree_suffix
+        else:
+            return False
+
+        fd, temporary_path = tempfile.mkstemp(prefix=self._temporary_prefix, suffix=suffix, dir=self.directory)
+        try:
+            with os.fdopen(fd, "wb") as file:
+                if suffix == self._array_suffix:
+                    np.save(file, result, allow_pickle=False)
+            if suffix == self._tree_suffix:
+                hg.cpp._save_tree_binary(temporary_path, result, {})
+            os.replace(temporary_path, os.path.join(self.directory, key + suffix))
+        except (OSError, RuntimeError):
+            self.__remove(temporary_path)
+            return False
+
+        self.evict()
+        return True
+
+    def size(self):
+        """
+        Total size of the stored entries in bytes.
+        """
+        return sum(size for _, size, _ in self.__entries())
+
+    def evict(self):
+        """
+        Remove the least recently used entries until the total size of the stored entries is at most
+        :attr:`max_size`.
+        """
+        entries = self.__entries()
+        total_size = sum(size for _, size, _ in entries)
+        if total_size <= self.max_size:
+            return
+        entries.sort()
+        for _, size, path in entries:
+            if total_size <= self.max_size:
+                break
+            self.__remove(path)
+            total_size -= size
+
+    def clear(self):
+        """
+        Remove all the stored entries.
+        """
+        for _, _, path in self.__entries():
+            self.__remove(path)
+
+    def __entries(self):
+        """
+        List of the stored entries as triplets (last access time, size, path). Stale temporary files are removed.
+        """
+        entries = []
+        now = time.time()
+        with os.scandir(self.directory) as it:
+            for e in it:
+                try:
+                    stat = e.stat()
+                except OSError:
+                    continue
+                if e.name.startswith(self._temporary_prefix):
+                    if now - stat.st_mtime > self._stale_temporary_delay:
+                        self.__remove(e.path)
+                elif e.name.endswith(self._array_suffix) or e.name.endswith(self._tree_suffix):
+                    entries.append((stat.st_mtime, stat.st_size, e.path))
+        return entries
+
+    @staticmethod
+    def __touch(path):
+        # the modification time is used as last access time (access times are often not maintained)
+        try:
+            os.utime(path)
+        except OSError:
+            pass
+
+    @staticmethod
+    def __remove(path):
+        # the entry may have been removed by another process, or may not be removable while it is mapped (Windows)
+        try:
+            os.remove(path)
+        except OSError:
+            pass
+
+
+def set_auto_cache_disk_tier(directory, max_size=2 ** 30):
+    """
+    Activates or deactivates the persistent disk tier of :func:`~higra.auto_cache` decorated functions.
+
+    When the disk tier is active, a result that is not found in the object cache of the reference object is searched
+    in a store located in the given directory before being computed, and newly computed results are saved in this
+    store. Contrarily to the object cache, the store is identified by the content of the function arguments
+    (values of arrays and scalars, structure, Higra attributes and tags of trees and graphs): it can thus be shared by
+    several processes working on the same data (for example workers of a batch job) and it persists between
+    sessions. Function calls whose arguments cannot be hashed (arbitrary Python objects) and results which are not
+    numpy arrays or trees are not stored on disk.
+
+    Stored arrays and trees are memory mapped when they are loaded: they are then only read when they are used.
+
+    The total size of the store is bounded by :attr:`max_size` (in bytes): least recently used entries are removed
+    when this size is exceeded.
+
+    The disk tier can also be activated when Higra is imported by setting the environment variable
+    ``HIGRA_AUTO_CACHE_DIR`` to the directory of the store (and optionally ``HIGRA_AUTO_CACHE_MAX_SIZE`` to its
+    maximal size in bytes).
+
+    :See:
+
+    :func:`~higra.get_auto_cache_disk_tier`: get the current disk tier.
+
+    :param directory: directory of the store (created if it does not exist), ``None`` to deactivate the disk tier
+    :param max_size: maximal size of the store in bytes (default: 1 GiB)
+    :return: the new disk tier (an object of type :class:`~higra.DiskCache`) or ``None``
+    """
+    if directory is None:
+        hg.__auto_cache_disk_tier = None
+    else:
+        hg.__auto_cache_disk_tier = DiskCache(directory, max_size)
+    return hg.__auto_cache_disk_tier
+
+
+def get_auto_cache_disk_tier():
+    """
+    Returns the current persistent disk tier of :func:`~higra.auto_cache` decorated functions.
+
+    :See:
+
+    :func:`~higra.set_auto_cache_disk_tier`: activate or deactivate the disk tier.
+
+    :return: an object of type :class:`~higra.DiskCache` or ``None`` if the disk tier is not active
+    """
+    return hg.__auto_cache_disk_tier
+
+
+def __call_with_disk_tier(fun, data_name, force_recompute, args, kwargs):
+    """
+    Call :attr:`fun(*args, **kwargs)` through the disk tier if it is active.
+    """
+    disk_tier = hg.__auto_cache_disk_tier
+    if disk_tier is None:
+        return fun(*args, **kwargs)
+
+    key = disk_tier.key(fun, data_name, args, kwargs)
+    if key is None:
+        return fun(*args, **kwargs)
+
+    if not force_recompute:
+        found, result = disk_tier.load(key)
+        if found:
+            return result
+
+    result = fun(*args, **kwargs)
+    disk_tier.store(key, result)
+    return result
+
 ###########################################################
 #                                                         #
 #              ARGUMENT HELPER DECORATOR                  #
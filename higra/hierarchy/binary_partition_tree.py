@@ -12,7 +12,7 @@ import higra as hg
 import numpy as np
 
 
-def binary_partition_tree_complete_linkage(graph, edge_weights):
+def binary_partition_tree_complete_linkage(graph, edge_weights, engine="heap"):
     """
     Binary partition tree with complete linkage distance.
 
@@ -27,17 +27,21 @@ def binary_partition_tree_complete_linkage(graph, edge_weights):
 
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
+    :param engine: algorithm used to compute the tree: ``"heap"`` (default) searches the closest pair of clusters in a
+        global priority queue, ``"rnn"`` merges reciprocal nearest neighbours by rounds which is usually much faster
+        (the result is identical up to the order of merges between equal weight edges) but requires a graph without
+        parallel edges
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
-    tree, altitudes = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights)
+    tree, altitudes = hg.cpp._binary_partition_tree_complete_linkage(graph, edge_weights, engine)
 
     hg.CptHierarchy.link(tree, graph)
 
     return tree, altitudes
 
 
-def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None):
+def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights=None, engine="heap"):
     """
     Binary partition tree with average linkage distance.
 
@@ -53,6 +57,10 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
     :param graph: input graph
     :param edge_weights: edge weights of the input graph
     :param edge_weight_weights: weighting of edge weights of the input graph (default to an array of ones)
+    :param engine: algorithm used to compute the tree: ``"heap"`` (default) searches the closest pair of clusters in a
+        global priority queue, ``"rnn"`` merges reciprocal nearest neighbours by rounds which is usually much faster
+        (the result is identical up to the order of merges between equal weight edges) but requires a graph without
+        parallel edges
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -61,14 +69,14 @@ def binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weigh
     else:
         edge_weights, edge_weight_weights = hg.cast_to_common_type(edge_weights, edge_weight_weights)
 
-    tree, altitudes = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights)
+    tree, altitudes = hg.cpp._binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, engine)
 
     hg.CptHierarchy.link(tree, graph)
 
     return tree, altitudes
 
 
-def binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_weight_weights=None):
+def binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_weight_weights=None, engine="heap"):
     """
     Binary partition tree with exponential linkage distance.
 
@@ -91,6 +99,10 @@ def binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_w
     :param edge_weights: edge weights of the input graph
     :param alpha: exponential parameter
     :param edge_weight_weights: weighting of edge weights of the input graph (default to an array of ones)
+    :param engine: algorithm used to compute the tree: ``"heap"`` (default) searches the closest pair of clusters in a
+        global priority queue, ``"rnn"`` merges reciprocal nearest neighbours by rounds which is usually much faster
+        (the result is identical up to the order of merges between equal weight edges) but requires a graph without
+        parallel edges
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -103,13 +115,14 @@ def binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_w
 
     # special cases: improve efficiency and avoid numerical issues
     if alpha == 0:
-        tree, altitudes = hg.binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights)
+        tree, altitudes = hg.binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, engine)
     elif alpha == float('-inf'):
         tree, altitudes = hg.binary_partition_tree_single_linkage(graph, edge_weights)
     elif alpha == float('inf'):
-        tree, altitudes = hg.binary_partition_tree_complete_linkage(graph, edge_weights)
+        tree, altitudes = hg.binary_partition_tree_complete_linkage(graph, edge_weights, engine)
     else:
-        tree, altitudes = hg.cpp._binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_weight_weights)
+        tree, altitudes = hg.cpp._binary_partition_tree_exponential_linkage(graph, edge_weights, alpha, edge_weight_weights,
+                                                                             engine)
 
     hg.CptHierarchy.link(tree, graph)
 
@@ -137,7 +150,8 @@ def binary_partition_tree_single_linkage(graph, edge_weights):
     return hg.bpt_canonical(graph, edge_weights)
 
 
-def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=None, altitude_correction="max"):
+def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=None, altitude_correction="max",
+                                       engine="heap"):
     """
     Binary partition tree with the Ward linkage rule.
 
@@ -164,6 +178,9 @@ def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=Non
     :param vertex_centroids: Centroids of the graph vertices (must be a 2d array)
     :param vertex_sizes: Size (number of elements) of the graph vertices (default to an array of ones)
     :param altitude_correction: can be ``"none"`` or ``"max"`` (default)
+    :param engine: algorithm used to compute the tree: ``"heap"`` (default) or ``"rnn"`` (reciprocal nearest
+        neighbours, see :func:`~higra.binary_partition_tree_average_linkage`); as the Ward distance is not reducible
+        on non complete graphs, the two engines may produce different hierarchies in this case
     :return: a tree (Concept :class:`~higra.CptHierarchy`) and its node altitudes
     """
 
@@ -172,7 +189,8 @@ def binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes=Non
     else:
         vertex_centroids, vertex_sizes = hg.cast_to_common_type(vertex_centroids, vertex_sizes)
 
-    tree, altitudes = hg.cpp._binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction)
+    tree, altitudes = hg.cpp._binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes, altitude_correction,
+                                                                  engine)
 
     hg.CptHierarchy.link(tree, graph)
 
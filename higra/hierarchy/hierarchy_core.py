@@ -121,6 +121,16 @@ def bpt_canonical(graph, edge_weights=None, sorted_edge_indices=None, return_alt
     Otherwise, the computation time is dominated by the sorting of the edge weights which is performed in linearithmic
     :math:`\mathcal{O}(n \log(n))` time.
 
+    If :attr:`sorted_edge_indices` is not provided and :attr:`edge_weights` is a 1d array of integers on at most 16
+    bits, edges are sorted with a linear time radix sort. For other 1d arrays, the Filter-Kruskal
+    algorithm is used: edges are recursively partitioned around pivots and the heaviest edges whose extremities
+    are already connected are discarded without being sorted. This does not change the result.
+
+        Peter Sanders, Johannes Singler and Vitaly Osipov.
+        `The Filter-Kruskal Minimum Spanning Tree Algorithm
+        <https://doi.org/10.1137/1.9781611972894.5>`_.
+        ALENEX 2009: 52-61.
+
     :param graph: input graph or triplet of two arrays and an integer (sources, targets, num_vertices)
            defining all the edges of the graph and its number of vertices.
     :param edge_weights: edge weights of the input graph (may be omitted if :attr:`sorted_edge_indices` is given).
@@ -138,7 +148,7 @@ def bpt_canonical(graph, edge_weights=None, sorted_edge_indices=None, return_alt
     if edge_weights is None and sorted_edge_indices is None:
         raise ValueError("edge_weights and sorted_edge_indices cannot be both equal to None.")
 
-    if sorted_edge_indices is None:
+    if sorted_edge_indices is None and edge_weights.ndim > 1:
         if edge_weights.ndim > 2:
             tmp_edge_weights = edge_weights.reshape((edge_weights.shape[0], -1))
         else:
@@ -157,7 +167,10 @@ def bpt_canonical(graph, edge_weights=None, sorted_edge_indices=None, return_alt
         except Exception as e:
             raise ValueError("Invalid graph input.") from e
 
-    parents, mst_edge_map = hg.cpp._bpt_canonical(sources, targets, sorted_edge_indices, num_vertices)
+    if sorted_edge_indices is None:
+        parents, mst_edge_map = hg.cpp._bpt_canonical_from_edge_weights(sources, targets, edge_weights, num_vertices)
+    else:
+        parents, mst_edge_map = hg.cpp._bpt_canonical(sources, targets, sorted_edge_indices, num_vertices)
     tree = hg.Tree(parents)
 
     if return_altitudes:
@@ -253,7 +266,7 @@ def saliency(tree, altitudes, leaf_graph, handle_rag=True):
 
     Formally, this is computed using the following property: :math:`sm(i,j) = altitudes(lowest\_common\_ancestor_{tree}(i,j))`.
 
-    Complexity: :math:`\mathcal{O}(n\log(n) + m)` with :math:`n` the number of vertices in the tree and :math:`m` the number of edges in the graph.
+    Complexity: :math:`\mathcal{O}(n + m)` with :math:`n` the number of vertices in the tree and :math:`m` the number of edges in the graph.
 
     :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
     :param altitudes: altitudes of the vertices of the tree
@@ -261,9 +274,14 @@ def saliency(tree, altitudes, leaf_graph, handle_rag=True):
     :param handle_rag: if tree has been constructed on a rag, then saliency values will be propagated to the original graph, hence leading to a saliency on the original graph and not on the rag
     :return: 1d array of edge weights
     """
-    lca_map = hg.attribute_lca_map(tree, leaf_graph=leaf_graph)
+    # reuse the lowest common ancestor structure of the tree if it has already been computed
+    lca_fast = hg.get_attribute(tree, "lca_fast")
+    if lca_fast is None and type(leaf_graph) is hg.UndirectedGraph and altitudes.ndim == 1:
+        sm = hg.cpp._saliency_map(leaf_graph, tree, altitudes)
+    else:
+        lca_map = hg.attribute_lca_map(tree, leaf_graph=leaf_graph)
+        sm = altitudes[lca_map]
 
-    sm = altitudes[lca_map]
     if hg.CptRegionAdjacencyGraph.validate(leaf_graph) and handle_rag:
         sm = hg.rag_back_project_edge_weights(leaf_graph, sm)
 
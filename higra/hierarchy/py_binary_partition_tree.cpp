@@ -22,6 +22,16 @@ namespace py_binary_partition_tree {
     using namespace hg;
     namespace py = pybind11;
 
+    hg::bpt_engine to_bpt_engine(const std::string &engine) {
+        if (engine == "heap") {
+            return hg::bpt_engine::heap;
+        } else if (engine == "rnn") {
+            return hg::bpt_engine::rnn;
+        } else {
+            throw std::runtime_error("binary_partition_tree: Unknown engine option.");
+        }
+    }
+
     template<typename T>
     void def_new_neighbour(pybind11::module &m) {
         using class_t = typename hg::binary_partition_tree_internal::new_neighbour<T>;
@@ -48,14 +58,17 @@ namespace py_binary_partition_tree {
         static
         void def(pybind11::module &m, const char *doc) {
             m.def("_binary_partition_tree_average_linkage",
-                  [](const hg::ugraph &graph, pyarray<T> &edge_weights, pyarray<T> &edge_weight_weights) {
-                      auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+                  [](const hg::ugraph &graph, pyarray<T> &edge_weights, pyarray<T> &edge_weight_weights,
+                     const std::string &engine) {
+                      auto res = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights,
+                                                                       to_bpt_engine(engine));
                       return py::make_tuple(std::move(res.tree), std::move(res.altitudes));
                   },
                   doc,
                   py::arg("graph"),
                   py::arg("edge_weights"),
-                  py::arg("edge_weight_weights"));
+                  py::arg("edge_weight_weights"),
+                  py::arg("engine") = std::string("heap"));
         }
     };
 
@@ -64,16 +77,19 @@ namespace py_binary_partition_tree {
         static
         void def(pybind11::module &m, const char *doc) {
             m.def("_binary_partition_tree_exponential_linkage",
-                  [](const hg::ugraph &graph, pyarray<T> &edge_weights, T alpha, pyarray<T> &edge_weight_weights) {
+                  [](const hg::ugraph &graph, pyarray<T> &edge_weights, T alpha, pyarray<T> &edge_weight_weights,
+                     const std::string &engine) {
                       auto res = binary_partition_tree_exponential_linkage(graph, edge_weights, alpha,
-                                                                           edge_weight_weights);
+                                                                           edge_weight_weights,
+                                                                           to_bpt_engine(engine));
                       return py::make_tuple(std::move(res.tree), std::move(res.altitudes));
                   },
                   doc,
                   py::arg("graph"),
                   py::arg("edge_weights"),
                   py::arg("alpha"),
-                  py::arg("edge_weight_weights"));
+                  py::arg("edge_weight_weights"),
+                  py::arg("engine") = std::string("heap"));
         }
     };
 
@@ -85,16 +101,18 @@ namespace py_binary_partition_tree {
                   [](const hg::ugraph &graph,
                      const pyarray<T> &vertex_centroids,
                      const pyarray<T> &vertex_sizes,
-                     const std::string &altitude_correction) {
+                     const std::string &altitude_correction,
+                     const std::string &engine) {
                       auto res = binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes,
-                                                                    altitude_correction);
+                                                                    altitude_correction, to_bpt_engine(engine));
                       return py::make_tuple(std::move(res.tree), std::move(res.altitudes));
                   },
                   doc,
                   py::arg("graph"),
                   py::arg("vertex_centroids"),
                   py::arg("vertex_sizes"),
-                  py::arg("altitude_correction") = std::string("max"));
+                  py::arg("altitude_correction") = std::string("max"),
+                  py::arg("engine") = std::string("heap"));
         }
     };
 
@@ -134,13 +152,15 @@ namespace py_binary_partition_tree {
         static
         void def(pybind11::module &m, const char *doc) {
             m.def("_binary_partition_tree_complete_linkage",
-                  [](const hg::ugraph &graph, pyarray<T> &edge_weights) {
-                      auto res = hg::binary_partition_tree_complete_linkage(graph, edge_weights);
+                  [](const hg::ugraph &graph, pyarray<T> &edge_weights, const std::string &engine) {
+                      auto res = hg::binary_partition_tree_complete_linkage(graph, edge_weights,
+                                                                            to_bpt_engine(engine));
                       return py::make_tuple(std::move(res.tree), std::move(res.altitudes));
                   },
                   doc,
                   py::arg("graph"),
-                  py::arg("edge_weights"));
+                  py::arg("edge_weights"),
+                  py::arg("engine") = std::string("heap"));
         }
     };
 
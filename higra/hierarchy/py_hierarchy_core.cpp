@@ -36,6 +36,53 @@ namespace py_hierarchy_core {
         }
     };
 
+    template<typename graph_t>
+    struct def_saliency_map {
+        template<typename value_t, typename C>
+        static
+        void def(C &m, const char *doc) {
+            m.def("_saliency_map", [](const graph_t &graph,
+                                      const hg::tree &tree,
+                                      const pyarray<value_t> &altitudes) {
+                      return hg::saliency_map(graph, tree, altitudes);
+                  },
+                  doc,
+                  py::arg("graph"),
+                  py::arg("tree"),
+                  py::arg("altitudes")
+            );
+        }
+    };
+
+    struct def_bpt_canonical_from_edge_weights {
+        template<typename value_t, typename C>
+        static
+        void def(C &m, const char *doc) {
+            m.def("_bpt_canonical_from_edge_weights", [](const xt::pytensor<hg::index_t, 1> &sources,
+                                                         const xt::pytensor<hg::index_t, 1> &targets,
+                                                         const xt::pytensor<value_t, 1> &edge_weights,
+                                                         const hg::index_t num_vertices) {
+                      hg_assert(num_vertices >= 0, "Number of vertices must be a positive number.");
+                      hg_assert((xt::amin)(sources)() >= 0, "Source vertex index cannot be negative.");
+                      hg_assert((xt::amin)(targets)() >= 0, "Target vertex index cannot be negative.");
+                      hg_assert((xt::amax)(sources)() < num_vertices,
+                                "Source vertex index must be less than the number of vertices.");
+                      hg_assert((xt::amax)(targets)() < num_vertices,
+                                "Target vertex index must be less than the number of vertices.");
+                      auto res = hg::hierarchy_core_internal::bpt_canonical_from_edge_weights(sources, targets,
+                                                                                              edge_weights,
+                                                                                              num_vertices);
+                      return py::make_tuple(std::move(res.first), std::move(res.second));
+                  },
+                  doc,
+                  py::arg("sources"),
+                  py::arg("targets"),
+                  py::arg("edge_weights"),
+                  py::arg("num_vertices")
+            );
+        }
+    };
+
     template<typename M>
     void add_simplified_tree(M &m) {
         using class_t = hg::remapped_tree<hg::tree, hg::array_1d<hg::index_t>>;
@@ -75,6 +122,12 @@ namespace py_hierarchy_core {
             return py::make_tuple(std::move(res.first), std::move(res.second));
         });
 
+        add_type_overloads<def_bpt_canonical_from_edge_weights, HG_TEMPLATE_NUMERIC_TYPES>
+                (m,
+                 "Compute the canonical binary partition tree of the given weighted graph from its edge weights "
+                 "(radix sort for small integral weights, Filter-Kruskal algorithm otherwise)."
+                );
+
         add_simplified_tree(m);
         m.def("_simplify_tree",
               [](const hg::tree &t, pyarray<bool> &criterion, bool process_leaves) {
@@ -90,6 +143,11 @@ namespace py_hierarchy_core {
                  "Compute the quasi flat zones hierarchy of the given weighted graph."
                 );
 
+        add_type_overloads<def_saliency_map<hg::ugraph>, HG_TEMPLATE_NUMERIC_TYPES>
+                (m,
+                 "Compute the saliency map of the given hierarchy for the given graph."
+                );
+
         m.def("_tree_2_binary_tree",
               [](const hg::tree &t) {
                   return hg::tree_2_binary_tree(t);
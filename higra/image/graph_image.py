@@ -27,6 +27,28 @@ def graph_4_adjacency_2_khalimsky(graph, edge_weights, shape, add_extra_border=F
     return hg.cpp._graph_4_adjacency_2_khalimsky(graph, shape, edge_weights, add_extra_border)
 
 
+@hg.argument_helper(hg.CptHierarchy, ("leaf_graph", hg.CptGridGraph))
+def saliency_khalimsky(tree, altitudes, leaf_graph, shape, add_extra_border=False):
+    """
+    Create a contour image in the Khalimsky grid from the saliency map of the hierarchy :math:`(tree, altitudes)` on
+    the 4 adjacency graph of the given shape.
+
+    The result is equal to ``graph_4_adjacency_2_khalimsky(graph, saliency(tree, altitudes, graph), shape,
+    add_extra_border)`` but the saliency map is not computed.
+
+    :param tree: input tree (Concept :class:`~higra.CptHierarchy`)
+    :param altitudes: altitudes of the vertices of the tree
+    :param leaf_graph: graph whose vertex set is equal to the leaves of the input tree, must be the 4 adjacency graph
+           of the given shape (deduced from :class:`~higra.CptHierarchy`)
+    :param shape: shape of the leaf graph of the tree (deduced from :class:`~higra.CptHierarchy` and
+           :class:`~higra.CptGridGraph`)
+    :param add_extra_border: if False result size is 2 * shape - 1 and 2 * shape + 1 otherwise
+    :return: a 2d array
+    """
+    shape = hg.normalize_shape(shape)
+    return hg.cpp._saliency_map_khalimsky(leaf_graph, tree, shape, altitudes, add_extra_border)
+
+
 def khalimsky_2_graph_4_adjacency(khalimsky, extra_border=False, graph=None):
     """
     Create a 4 adjacency edge-weighted graph from a contour image in the Khalimsky grid.
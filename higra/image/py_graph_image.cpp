@@ -61,6 +61,27 @@ namespace py_graph_image {
         }
     };
 
+    struct def_saliency_map_khalimsky {
+        template<typename value_t>
+        static
+        void def(pybind11::module &m, const char *doc) {
+            m.def("_saliency_map_khalimsky", [](const hg::ugraph &graph,
+                                                const hg::tree &tree,
+                                                const std::vector<size_t> &shape,
+                                                const pyarray<value_t> &altitudes,
+                                                bool add_extra_border) {
+                      hg::embedding_grid_2d embedding(shape);
+                      return hg::saliency_map_khalimsky(graph, tree, embedding, altitudes, add_extra_border);
+                  },
+                  doc,
+                  py::arg("graph"),
+                  py::arg("tree"),
+                  py::arg("shape"),
+                  py::arg("altitudes"),
+                  py::arg("add_extra_border") = false);
+        }
+    };
+
     struct def_get_bipartite_matching_graph_contour_image_2d {
         template<typename value_t>
         static
@@ -101,6 +122,12 @@ namespace py_graph_image {
                  "Returns a tuple of three elements (graph, embedding, edge_weights)."
                 );
 
+        add_type_overloads<def_saliency_map_khalimsky, HG_TEMPLATE_NUMERIC_TYPES>
+                (m,
+                 "Create a contour image in the Khalimsky grid from the saliency map of a hierarchy on a 4 "
+                 "adjacency graph."
+                );
+
         add_type_overloads<def_get_bipartite_matching_graph_contour_image_2d, bool>
                 (m,
                  "Create a bipartite matching graph from two images. "
@@ -29,7 +29,7 @@ namespace py_tree_io {
               "Read tree from mixed ascii/binary format. Return a pair with the tree and a map of attributes (tree, dict[string => 1d array[double] ])",
               pybind11::arg("filename"));
 
-        m.def("save_tree", [](const std::string &filename, const hg::tree &tree,
+        m.def("_save_tree", [](const std::string &filename, const hg::tree &tree,
                               const std::map<std::string, pyarray<double>> &attributes) {
                   std::ofstream file(filename);
                   auto s = hg::save_tree(file, tree);
@@ -43,6 +43,55 @@ namespace py_tree_io {
               pybind11::arg("filename"),
               pybind11::arg("tree"),
               pybind11::arg("attributes") = std::map<std::string, pyarray<double>>());
+
+        m.def("_save_tree_binary", [](const std::string &filename, const hg::tree &tree,
+                                      const std::map<std::string, pybind11::array> &attributes) {
+                  std::ofstream file(filename, std::ios::binary);
+                  auto s = hg::save_tree_binary(file, tree);
+                  for (const auto &e: attributes) {
+                      auto a = pybind11::array::ensure(e.second, pybind11::array::c_style);
+                      hg_assert(a, "Attribute '" + e.first + "' cannot be converted to a contiguous array.");
+                      std::vector<std::size_t> shape(a.shape(), a.shape() + a.ndim());
+                      s.add_raw_attribute(e.first, a.dtype().kind(), (std::size_t) a.itemsize(), shape, a.data());
+                  }
+                  s.finalize();
+              },
+              "Save a tree and attributes of any shape and numeric type to the binary tree format.",
+              pybind11::arg("filename"),
+              pybind11::arg("tree"),
+              pybind11::arg("attributes") = std::map<std::string, pybind11::array>());
+
+        m.def("_is_binary_tree", [](const std::string &filename) {
+                  std::ifstream file(filename, std::ios::binary);
+                  return hg::is_binary_tree(file);
+              },
+              "Test if the given file contains a tree in the binary tree format.",
+              pybind11::arg("filename"));
+
+        m.def("_read_tree_binary", [](const std::string &filename, bool mmap) {
+                  auto archive = [&filename, mmap]() {
+                      if (mmap) {
+                          return hg::map_tree_binary(filename);
+                      }
+                      std::ifstream file(filename, std::ios::binary);
+                      return hg::read_tree_binary(file);
+                  }();
+                  // numpy arrays are views on the archive storage: the capsule keeps the storage alive
+                  pybind11::capsule base(new std::shared_ptr<const char>(archive.storage()), [](void *p) {
+                      delete reinterpret_cast<std::shared_ptr<const char> *>(p);
+                  });
+                  pybind11::dict attributes;
+                  for (const auto &a: archive.attributes()) {
+                      pybind11::dtype dtype(std::string(1, a.kind) + std::to_string(a.item_size));
+                      attributes[pybind11::str(a.name)] = pybind11::array(dtype, a.shape, a.data, base);
+                  }
+                  return pybind11::make_tuple(archive.get_tree(), attributes);
+              },
+              "Read a tree stored in the binary tree format. Return a pair with the tree and a map of attributes "
+              "(tree, dict[string => array]). If mmap is true, the file is memory mapped and the attributes are "
+              "views on the mapped memory.",
+              pybind11::arg("filename"),
+              pybind11::arg("mmap") = true);
     }
 }
 
@@ -12,16 +12,26 @@ import higra as hg
 import numpy as np
 
 
-def read_tree(filename):
+def read_tree(filename, mmap=True):
     """
-    Read a tree stored in mixed ascii/binary format.
+    Read a tree stored in mixed ascii/binary format or in binary format (see :func:`~higra.save_tree`).
+
+    The format of the file is detected automatically.
 
     Attributes are also registered as tree object attributes.
 
+    With the binary format, attributes keep their shape and type, and if :attr:`mmap` is ``True`` the file is memory
+    mapped: the returned attributes are then views on the mapped memory that are loaded lazily (copy on write, the
+    file is never modified).
+
     :param filename: path to the tree file
+    :param mmap: if ``True`` (default), memory map files in binary format instead of reading them in memory
     :return: a pair (tree, attribute_map)
     """
-    tree, attribute_map = hg.cpp._read_tree(filename)
+    if hg.cpp._is_binary_tree(filename):
+        tree, attribute_map = hg.cpp._read_tree_binary(filename, mmap)
+    else:
+        tree, attribute_map = hg.cpp._read_tree(filename)
 
     for k in attribute_map:
         hg.set_attribute(tree, k, attribute_map[k])
@@ -29,6 +39,35 @@ def read_tree(filename):
     return tree, attribute_map
 
 
+def save_tree(filename, tree, attributes=None, binary=False):
+    """
+    Save a tree and its attributes to a file.
+
+    Attributes must be numpy arrays stored in a dictionary with string keys (attribute names).
+
+    With the mixed ascii/binary format (default), attributes must be 1d arrays with one value per node of the tree and
+    they are stored as 64 bits floating point values.
+
+    With the binary format, attributes can have any shape and numeric type (for example node altitudes, vectorial
+    node attributes, or the mst edge map of a binary partition tree) which are preserved. Arrays are stored
+    contiguously and aligned in the file such that it can be memory mapped without copy or conversion
+    by :func:`~higra.read_tree`.
+
+    :param filename: path to the tree file
+    :param tree: input tree
+    :param attributes: dictionary of attributes (default: no attribute)
+    :param binary: if ``True``, use the binary format
+    :return: nothing
+    """
+    if attributes is None:
+        attributes = {}
+
+    if binary:
+        hg.cpp._save_tree_binary(filename, tree, {k: np.ascontiguousarray(v) for k, v in attributes.items()})
+    else:
+        hg.cpp._save_tree(filename, tree, attributes)
+
+
 def print_partition_tree(tree, *,
                altitudes=None,
                attribute=None,
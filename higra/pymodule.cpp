@@ -41,16 +41,19 @@ PYBIND11_MODULE(higram, m) {
     py_partition::py_init_assessment_partition(m);
     py_at_accumulator::py_init_at_accumulator(m);
     py_attributes::py_init_attributes(m);
+    py_batch_assessment::py_init_batch_assessment(m);
     py_binary_partition_tree::py_init_binary_partition_tree(m);
     py_bipartite_graph::py_init_bipartite_graph(m);
     py_common_hierarchy::py_init_common_hierarchy(m);
     py_component_tree::py_init_component_tree(m);
     py_contour_2d::py_init_contour_2d(m);
+    py_csr_graph::py_init_csr_graph(m);
     py_embedding::py_init_embedding(m);
     py_graph_accumulator::py_init_graph_accumulator(m);
     py_graph_image::py_init_graph_image(m);
     py_graph_weights::py_init_graph_weights(m);
     py_fragmentation_curve::py_init_fragmentation_curve(m);
+    py_hierarchical_cost::py_init_hierarchical_cost(m);
     py_hierarchy_core::py_init_hierarchy_core(m);
     py_hierarchy_mean_pb::py_init_hierarchy_mean_pb(m);
     py_horizontal_cuts::py_init_horizontal_cuts(m);
@@ -8,6 +8,7 @@
 # The full license is in the file LICENSE, distributed with this software. #
 ############################################################################
 
+from .csr_graph import *
 from .embedding import *
 from .lca_fast import *
 from .regular_graph import *
@@ -10,6 +10,7 @@
 
 #pragma once
 
+#include "py_csr_graph.hpp"
 #include "py_embedding.hpp"
 #include "py_lca_fast.hpp"
 #include "py_regular_graph.hpp"
@@ -0,0 +1,91 @@
+############################################################################
+# Copyright ESIEE Paris (2018)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+import higra as hg
+
+
+def __reduce_ctr(num_vertices, sources, targets):
+    return hg.CSRGraph(sources, targets, num_vertices)
+
+
+@hg.extend_class(hg.CSRGraph, method_name="__reduce__")
+def ____reduce__(self):
+    return __reduce_ctr, (self.num_vertices(), *self.edge_list()), self.__dict__
+
+
+@hg.extend_class(hg.CSRGraph, method_name="sources")
+def __sources(self):
+    """
+    Source vertex of every edge of the graph.
+
+    The returned array is the one given at construction if it was a contiguous array of type int64.
+
+    :Example:
+
+    >>> g = CSRGraph(np.asarray((0, 1, 0)), np.asarray((1, 2, 2)), 3)
+    >>> g.sources()
+    array([0, 1, 0])
+
+    :return: a 1d array of size ``self.num_edges()``
+    """
+    return self._sources()
+
+
+@hg.extend_class(hg.CSRGraph, method_name="targets")
+def __targets(self):
+    """
+    Target vertex of every edge of the graph.
+
+    The returned array is the one given at construction if it was a contiguous array of type int64.
+
+    :Example:
+
+    >>> g = CSRGraph(np.asarray((0, 1, 0)), np.asarray((1, 2, 2)), 3)
+    >>> g.targets()
+    array([1, 2, 2])
+
+    :return: a 1d array of size ``self.num_edges()``
+    """
+    return self._targets()
+
+
+@hg.extend_class(hg.CSRGraph, method_name="edge_list")
+def __edge_list(self):
+    """
+    Returns a tuple of two arrays (sources, targets) defining all the edges of the graph.
+
+    :Example:
+
+    >>> g = CSRGraph(np.asarray((0, 1, 0)), np.asarray((1, 2, 2)), 3)
+    >>> g.edge_list()
+    (array([0, 1, 0]), array([1, 2, 2]))
+
+    :return: pair of two 1d arrays
+    """
+    return self.sources(), self.targets()
+
+
+@hg.extend_class(hg.UndirectedGraph, method_name="to_csr_graph")
+def __to_csr_graph(self):
+    """
+    Creates an immutable copy of the current graph stored in compressed sparse row format
+    (see :class:`~higra.CSRGraph`).
+
+    :Example:
+
+    >>> g = UndirectedGraph(3)
+    >>> g.add_edges((0, 1, 0), (1, 2, 2))
+    >>> g2 = g.to_csr_graph()
+    >>> g2.edge_list()
+    (array([0, 1, 0]), array([1, 2, 2]))
+
+    :return: a :class:`~higra.CSRGraph`
+    """
+    return hg.CSRGraph(self.sources(), self.targets(), self.num_vertices())
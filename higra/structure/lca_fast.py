@@ -29,6 +29,14 @@ def __reduce_ctr_lca_stb(*args):
     return hg.LCA_rmq_sparse_table_block._make_from_state(args)
 
 
+def __reduce_ctr_lca_sv(*args):
+    return hg.LCA_schieber_vishkin._make_from_state(args)
+
+
+def __reduce_ctr_lca_sv32(*args):
+    return hg.LCA_schieber_vishkin_32._make_from_state(args)
+
+
 @hg.extend_class(hg.LCA_rmq_sparse_table, method_name="__reduce__")
 def ____reduce__(self):
     return __reduce_ctr_lca_st, self._get_state(), self.__dict__
@@ -39,4 +47,14 @@ def ____reduce__(self):
     return __reduce_ctr_lca_stb, self._get_state(), self.__dict__
 
 
+@hg.extend_class(hg.LCA_schieber_vishkin, method_name="__reduce__")
+def ____reduce__(self):
+    return __reduce_ctr_lca_sv, self._get_state(), self.__dict__
+
+
+@hg.extend_class(hg.LCA_schieber_vishkin_32, method_name="__reduce__")
+def ____reduce__(self):
+    return __reduce_ctr_lca_sv32, self._get_state(), self.__dict__
+
+
 LCAFast = hg.LCA_rmq_sparse_table_block
@@ -0,0 +1,66 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "py_csr_graph.hpp"
+#include "py_common_graph.hpp"
+
+namespace py_csr_graph {
+    using namespace py_common_graph;
+    namespace py = pybind11;
+
+    void py_init_csr_graph(py::module &m) {
+        using graph_t = csr_graph_t;
+
+        auto c = py::class_<graph_t>(m,
+                                     "CSRGraph",
+                                     "An immutable undirected graph stored in compressed sparse row format.",
+                                     py::dynamic_attr());
+
+        c.def(py::init([](xt::pytensor<hg::index_t, 1> sources,
+                          xt::pytensor<hg::index_t, 1> targets,
+                          const hg::size_t num_vertices) {
+                  hg_assert_same_shape(sources, targets);
+                  // moving the pytensors into the graph keeps a reference on the numpy arrays without copy
+                  return graph_t(std::move(sources), std::move(targets), num_vertices);
+              }), R"doc(
+    Create a new graph with the given number of vertices and the edges given by the two arrays
+    sources and targets.
+
+    If sources and targets are contiguous arrays of type int64, the graph shares their memory (no copy is made):
+    they must not be modified afterward.
+
+    :param sources: a 1d array of vertex indices
+    :param targets: a 1d array of vertex indices of the same size as sources
+    :param num_vertices: number of vertices in the graph
+    )doc",
+              py::arg("sources"),
+              py::arg("targets"),
+              py::arg("num_vertices"));
+
+        add_edge_accessor_graph_concept<graph_t, decltype(c)>(c);
+        add_incidence_graph_concept<graph_t, decltype(c)>(c);
+        add_bidirectionnal_graph_concept<graph_t, decltype(c)>(c);
+        add_adjacency_graph_concept<graph_t, decltype(c)>(c);
+        add_vertex_list_graph_concept<graph_t, decltype(c)>(c);
+        add_edge_list_graph_concept<graph_t, decltype(c)>(c);
+        add_edge_index_graph_concept<graph_t, decltype(c)>(c);
+
+        // returns the numpy arrays given at construction
+        c.def("_sources", [](const graph_t &g) { return py::object(g.sources()); });
+        c.def("_targets", [](const graph_t &g) { return py::object(g.targets()); });
+        c.def("_csr_arrays", [](const graph_t &g) {
+                  return py::make_tuple(g.offsets(), g.adjacent_vertices(), g.edge_indices());
+              },
+              "Returns the three arrays (offsets, adjacent_vertices, edge_indices) of the compressed sparse row "
+              "representation: the incidence list of vertex i is stored at positions "
+              "offsets[i] to offsets[i + 1] (excluded) of the arrays adjacent_vertices and edge_indices.");
+    }
+
+}
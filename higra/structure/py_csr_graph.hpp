@@ -0,0 +1,24 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "pybind11/pybind11.h"
+#include "higra/structure/csr_graph.hpp"
+#include "xtensor-python/pytensor.hpp"
+
+namespace py_csr_graph {
+    /**
+     * CSR graph type exposed to Python: sources and targets share the memory of the numpy arrays
+     */
+    using csr_graph_t = hg::csr_graph_internal::csr_graph<xt::pytensor<hg::index_t, 1>>;
+
+    void py_init_csr_graph(pybind11::module &m);
+}
@@ -120,6 +120,44 @@ namespace py_lca_fast {
         );
     }
 
+    template<typename value_t>
+    auto get_lca_schieber_vishkin_state_to_python(
+            const typename lca_internal::lca_schieber_vishkin<tree, value_t>::template internal_state<array_1d> &state) {
+        py::list list;
+        list.append(std::move(state.inlabel));
+        list.append(std::move(state.ascendant));
+        list.append(std::move(state.head_parent));
+        return list;
+    }
+
+    auto get_lca_state_to_python(const lca_schieber_vishkin::internal_state<array_1d> &state) {
+        return get_lca_schieber_vishkin_state_to_python<index_t>(state);
+    }
+
+    auto get_lca_state_to_python(const lca_schieber_vishkin_32::internal_state<array_1d> &state) {
+        return get_lca_schieber_vishkin_state_to_python<uint32_t>(state);
+    }
+
+    template<typename value_t>
+    auto get_lca_schieber_vishkin_state_from_python(const py::list &list) {
+        using state_type = typename lca_internal::lca_schieber_vishkin<tree, value_t>::template internal_state<pyarray_1d>;
+        return state_type(
+                list[0].template cast<pyarray_1d<value_t>>(),
+                list[1].template cast<pyarray_1d<value_t>>(),
+                list[2].template cast<pyarray_1d<value_t>>()
+        );
+    }
+
+    template<>
+    auto get_lca_state_from_python<lca_schieber_vishkin>(const py::list &list) {
+        return get_lca_schieber_vishkin_state_from_python<index_t>(list);
+    }
+
+    template<>
+    auto get_lca_state_from_python<lca_schieber_vishkin_32>(const py::list &list) {
+        return get_lca_schieber_vishkin_state_from_python<uint32_t>(list);
+    }
+
     template<typename lca_t, typename T>
     auto def_lca_t(T &m, const char *name, const char *doc) {
         auto c = py::class_<lca_t>(m, name, doc, py::dynamic_attr());
@@ -190,6 +228,17 @@ namespace py_lca_fast {
                       py::arg("tree"),
                       py::arg("block_size"));
 
+        def_lca_t<lca_schieber_vishkin>(
+                m, "LCA_schieber_vishkin",
+                "Provides fast :math:`\\mathcal{O}(1)` lowest common ancestor computation in a tree thanks "
+                "to a linear preprocessing of the tree with the algorithm of Schieber and Vishkin: it uses "
+                "3 arrays of integers of the size of the tree.");
+
+        def_lca_t<lca_schieber_vishkin_32>(
+                m, "LCA_schieber_vishkin_32",
+                "Same as :class:`~higra.LCA_schieber_vishkin` with internal arrays of 32 bits unsigned integers "
+                "(the tree must have less than :math:`2^{32}-1` vertices).");
+
         // @TODO export symbol LCAFast python
 
     }
@@ -96,7 +96,7 @@ def __lowest_common_ancestor_preprocess(self, algorithm="sparse_table_block", bl
     :func:`~higra.Tree.lowest_common_ancestor` will use this preprocessing. Calling twice this function does nothing
     except if :attr:`force_recompute` is ``True``.
 
-    Two algorithms are available:
+    Three algorithms are available:
 
     - ``sparse_table`` has a preprocessing time and space complexity in :math:`\\mathcal{O}(n\log(n))` with :math:`n`
       the number of vertices in the tree and performs every query in constant time :math:`\\mathcal{O}(1)`.
@@ -104,12 +104,18 @@ def __lowest_common_ancestor_preprocess(self, algorithm="sparse_table_block", bl
       and performs queries in average-case constant time :math:`\\mathcal{O}(1)`. With this algorithm the user can specify
       the block size to be used, the general rule of thumb being that larger block size will decrease the pre-processing
       time but increase the query time.
+    - ``schieber_vishkin`` has a linear preprocessing time and space complexity in :math:`\\mathcal{O}(n)` and performs
+      every query in constant time :math:`\\mathcal{O}(1)`. It only stores 3 integers per vertex of the tree (32 bits
+      integers if the tree has less than :math:`2^{32}-1` vertices), which makes it the most memory efficient
+      algorithm for very large trees.
 
-    :param algorithm: specify the algorithm to be used, can be either ``sparse_table`` or ``sparse_table_block``.
+    :param algorithm: specify the algorithm to be used, can be ``sparse_table``, ``sparse_table_block``, or
+           ``schieber_vishkin``.
     :param block_size: if :attr:`algorithm` is ``sparse_table_block``, specify the block size to be used (default 1024)
     :param force_recompute: if ``False`` (default) calling this function twice won't re-preprocess the tree, even if the
            specified algorithm or algorithm parameter have changed.
-    :return: An object of type :class:`~higra.hg.LCA_rmq_sparse_table_block` or :class:`~higra.hg.LCA_rmq_sparse_table`
+    :return: An object of type :class:`~higra.hg.LCA_rmq_sparse_table_block`, :class:`~higra.hg.LCA_rmq_sparse_table`,
+             :class:`~higra.hg.LCA_schieber_vishkin`, or :class:`~higra.hg.LCA_schieber_vishkin_32`
     """
     lca_fast = hg.get_attribute(self, "lca_fast")
     if lca_fast is None or force_recompute:
@@ -121,6 +127,11 @@ def __lowest_common_ancestor_preprocess(self, algorithm="sparse_table_block", bl
                 raise ValueError("Invalid block size: " + str(block_size))
 
             lca_fast = hg.LCA_rmq_sparse_table_block(self, block_size)
+        elif algorithm == "schieber_vishkin":
+            if self.num_vertices() < 2 ** 32 - 1:
+                lca_fast = hg.LCA_schieber_vishkin_32(self)
+            else:
+                lca_fast = hg.LCA_schieber_vishkin(self)
         else:
             raise ValueError("Unknown LCA algorithm: " + str(algorithm))
         hg.set_attribute(self, "lca_fast", lca_fast)
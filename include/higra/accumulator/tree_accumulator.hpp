@@ -13,6 +13,7 @@
 #include "../graph.hpp"
 #include "accumulator.hpp"
 #include "../structure/details/light_axis_view.hpp"
+#include "../structure/details/tree_schedule.hpp"
 
 namespace hg {
 
@@ -37,32 +38,39 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+            if (tree.children_computed() || tree_internal::use_tree_schedule(tree)) {
+                tree.compute_children();
+                tree_internal::schedule_leaves_to_root(tree, [&tree, &input, &output, &accumulator](auto first,
+                                                                                                    auto last) {
+                    auto input_view = make_light_axis_view<vectorial>(input);
+                    auto output_view = make_light_axis_view<vectorial>(output);
+                    auto acc = accumulator.template make_accumulator<vectorial>(output_view);
 
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
-                acc.finalize();
-            }
+                    for (; first != last; ++first) {
+                        auto i = *first;
+                        output_view.set_position(i);
+                        acc.set_storage(output_view);
+                        acc.initialize();
+                        for (auto c : children_iterator(i, tree)) {
+                            input_view.set_position(c);
+                            acc.accumulate(input_view.begin());
+                        }
+                        acc.finalize();
+                    }
+                });
+            } else {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
 
-            if (tree.children_computed()) {
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
 
-                for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                for (auto i: leaves_iterator(tree)) {
                     output_view.set_position(i);
                     acc.set_storage(output_view);
                     acc.initialize();
-                    for (auto c : children_iterator(i, tree)) {
-                        input_view.set_position(c);
-                        acc.accumulate(input_view.begin());
-                    }
                     acc.finalize();
                 }
 
-            } else {
                 index_t numl = num_leaves(tree);
                 std::vector<decltype(accumulator.template make_accumulator<vectorial>(output_view))> accs;
                 accs.reserve(num_vertices(tree) - numl);
@@ -106,30 +114,43 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
-            auto input_view = make_light_axis_view<vectorial>(output);
-            auto output_view = make_light_axis_view<vectorial>(output);
-
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                vertex_data_view.set_position(i);
-                output_view = vertex_data_view;
-            }
-
-            if (tree.children_computed()) {
-                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+            if (tree.children_computed() || tree_internal::use_tree_schedule(tree)) {
+                tree.compute_children();
+                tree_internal::schedule_leaves_to_root(tree, [&tree, &vertex_data, &output, &accumulator](auto first,
+                                                                                                          auto last) {
+                    auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
+                    auto input_view = make_light_axis_view<vectorial>(output);
+                    auto output_view = make_light_axis_view<vectorial>(output);
+                    auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+
+                    for (; first != last; ++first) {
+                        auto i = *first;
+                        output_view.set_position(i);
+                        if (is_leaf(i, tree)) {
+                            vertex_data_view.set_position(i);
+                            output_view = vertex_data_view;
+                        } else {
+                            acc.set_storage(output_view);
+                            acc.initialize();
+                            for (auto c : children_iterator(i, tree)) {
+                                input_view.set_position(c);
+                                acc.accumulate(input_view.begin());
+                            }
+                            acc.finalize();
+                        }
+                    }
+                });
+            } else {
+                auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
+                auto input_view = make_light_axis_view<vectorial>(output);
+                auto output_view = make_light_axis_view<vectorial>(output);
 
-                for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                for (auto i: leaves_iterator(tree)) {
                     output_view.set_position(i);
-                    acc.set_storage(output_view);
-                    acc.initialize();
-                    for (auto c : children_iterator(i, tree)) {
-                        input_view.set_position(c);
-                        acc.accumulate(input_view.begin());
-                    }
-                    acc.finalize();
+                    vertex_data_view.set_position(i);
+                    output_view = vertex_data_view;
                 }
-            } else {
+
                 index_t numl = num_leaves(tree);
                 std::vector<decltype(accumulator.template make_accumulator<vectorial>(output_view))> accs;
                 accs.reserve(num_vertices(tree) - numl);
@@ -188,34 +209,48 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto inout_view = make_light_axis_view<vectorial>(output);
-            auto output_view = make_light_axis_view<vectorial>(output);
-
-            auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
-
-            for (auto i: leaves_iterator(tree)) {
-                output_view.set_position(i);
-                vertex_data_view.set_position(i);
-                output_view = vertex_data_view;
-            }
+            if (tree.children_computed() || tree_internal::use_tree_schedule(tree)) {
+                tree.compute_children();
+                tree_internal::schedule_leaves_to_root(tree, [&tree, &input, &vertex_data, &output, &accumulator,
+                        &combine](auto first, auto last) {
+                    auto input_view = make_light_axis_view<vectorial>(input);
+                    auto inout_view = make_light_axis_view<vectorial>(output);
+                    auto output_view = make_light_axis_view<vectorial>(output);
+                    auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
+                    auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+
+                    for (; first != last; ++first) {
+                        auto i = *first;
+                        output_view.set_position(i);
+                        if (is_leaf(i, tree)) {
+                            vertex_data_view.set_position(i);
+                            output_view = vertex_data_view;
+                        } else {
+                            acc.set_storage(output_view);
+                            acc.initialize();
+                            for (auto c : children_iterator(i, tree)) {
+                                inout_view.set_position(c);
+                                acc.accumulate(inout_view.begin());
+                            }
+                            acc.finalize();
+                            input_view.set_position(i);
+                            output_view.combine(input_view, combine);
+                        }
+                    }
+                });
+            } else {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto inout_view = make_light_axis_view<vectorial>(output);
+                auto output_view = make_light_axis_view<vectorial>(output);
 
-            if (tree.children_computed()) {
-                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
+                auto vertex_data_view = make_light_axis_view<vectorial>(vertex_data);
 
-                for (auto i : leaves_to_root_iterator(tree, leaves_it::exclude)) {
+                for (auto i: leaves_iterator(tree)) {
                     output_view.set_position(i);
-                    acc.set_storage(output_view);
-                    acc.initialize();
-                    for (auto c : children_iterator(i, tree)) {
-                        inout_view.set_position(c);
-                        acc.accumulate(inout_view.begin());
-                    }
-                    acc.finalize();
-                    input_view.set_position(i);
-                    output_view.combine(input_view, combine);
+                    vertex_data_view.set_position(i);
+                    output_view = vertex_data_view;
                 }
-            } else {
+
                 index_t numl = num_leaves(tree);
                 std::vector<decltype(accumulator.template make_accumulator<vectorial>(output_view))> accs;
                 accs.reserve(num_vertices(tree) - numl);
@@ -323,28 +358,28 @@ namespace hg {
 
             array_nd <output_t> output = array_nd<output_t>::from_shape(input.shape());
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto inout_view = make_light_axis_view<vectorial>(output);
-
-            auto aparents = parents(tree).linear_begin();
+            tree_internal::schedule_root_to_leaves(tree, [&tree, &input, &condition, &output](auto first,
+                                                                                            auto last) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto inout_view = make_light_axis_view<vectorial>(output);
 
-            // root cannot be deleted
-            output_view.set_position(root(tree));
-            input_view.set_position(root(tree));
-            output_view = input_view;
+                auto aparents = parents(tree).linear_begin();
+                const auto root_v = root(tree);
 
-            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                output_view.set_position(i);
-                if (condition(i)) {
-                    inout_view.set_position(aparents[i]);
-                    output_view = inout_view;
-                } else {
-                    input_view.set_position(i);
-                    output_view = input_view;
+                for (; first != last; ++first) {
+                    auto i = *first;
+                    output_view.set_position(i);
+                    // root cannot be deleted
+                    if (i != root_v && condition(i)) {
+                        inout_view.set_position(aparents[i]);
+                        output_view = inout_view;
+                    } else {
+                        input_view.set_position(i);
+                        output_view = input_view;
+                    }
                 }
-
-            }
+            });
             return output;
         };
 
@@ -370,33 +405,34 @@ namespace hg {
             output_shape.insert(output_shape.begin(), num_vertices(tree));
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto parent_view = make_light_axis_view<vectorial>(output);
+            tree_internal::schedule_root_to_leaves(tree, [&tree, &input, &output, &accumulator](auto first,
+                                                                                              auto last) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto parent_view = make_light_axis_view<vectorial>(output);
 
-            auto aparents = parents(tree).linear_begin();
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-            // root cannot be deleted
-            output_view.set_position(root(tree));
-            input_view.set_position(root(tree));
-            acc.set_storage(output_view);
-            acc.initialize();
-            acc.accumulate(input_view.begin());
-            acc.finalize();
-
-            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                output_view.set_position(i);
-                acc.set_storage(output_view);
-                acc.initialize();
+                auto aparents = parents(tree).linear_begin();
+                const auto root_v = root(tree);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
 
-                parent_view.set_position(aparents[i]);
-                acc.accumulate(parent_view.begin());
+                for (; first != last; ++first) {
+                    auto i = *first;
+                    output_view.set_position(i);
+                    acc.set_storage(output_view);
+                    acc.initialize();
 
-                input_view.set_position(i);
-                acc.accumulate(input_view.begin());
+                    // root has no parent
+                    if (i != root_v) {
+                        parent_view.set_position(aparents[i]);
+                        acc.accumulate(parent_view.begin());
+                    }
 
-                acc.finalize();
-            }
+                    input_view.set_position(i);
+                    acc.accumulate(input_view.begin());
+
+                    acc.finalize();
+                }
+            });
 
             return output;
         };
@@ -428,44 +464,38 @@ namespace hg {
             output_shape.insert(output_shape.begin(), num_vertices(tree));
             array_nd <output_t> output = array_nd<output_t>::from_shape(output_shape);
 
-            auto input_view = make_light_axis_view<vectorial>(input);
-            auto output_view = make_light_axis_view<vectorial>(output);
-            auto parent_view = make_light_axis_view<vectorial>(output);
+            tree_internal::schedule_root_to_leaves(tree, [&tree, &input, &condition, &output, &accumulator](
+                    auto first, auto last) {
+                auto input_view = make_light_axis_view<vectorial>(input);
+                auto output_view = make_light_axis_view<vectorial>(output);
+                auto parent_view = make_light_axis_view<vectorial>(output);
 
-            auto aparents = parents(tree).linear_begin();
-            auto acc = accumulator.template make_accumulator<vectorial>(output_view);
-            // root cannot be deleted
-            output_view.set_position(root(tree));
-            input_view.set_position(root(tree));
-
-            if (condition(root(tree))){
-                acc.set_storage(output_view);
-                acc.initialize();
-                acc.accumulate(input_view.begin());
-                acc.finalize();
-            } else {
-                output_view = input_view;
-            }
+                auto aparents = parents(tree).linear_begin();
+                const auto root_v = root(tree);
+                auto acc = accumulator.template make_accumulator<vectorial>(output_view);
 
-            for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-                output_view.set_position(i);
-                if (condition(i)){
-                    acc.set_storage(output_view);
-                    acc.initialize();
+                for (; first != last; ++first) {
+                    auto i = *first;
+                    output_view.set_position(i);
+                    input_view.set_position(i);
+                    if (condition(i)) {
+                        acc.set_storage(output_view);
+                        acc.initialize();
 
-                    parent_view.set_position(aparents[i]);
-                    acc.accumulate(parent_view.begin());
+                        // root has no parent
+                        if (i != root_v) {
+                            parent_view.set_position(aparents[i]);
+                            acc.accumulate(parent_view.begin());
+                        }
 
-                    input_view.set_position(i);
-                    acc.accumulate(input_view.begin());
+                        acc.accumulate(input_view.begin());
 
-                    acc.finalize();
-                } else{
-                    input_view.set_position(i);
-                    output_view = input_view;
+                        acc.finalize();
+                    } else {
+                        output_view = input_view;
+                    }
                 }
-
-            }
+            });
 
             return output;
         };
@@ -13,7 +13,9 @@
 #include "rag.hpp"
 #include "tree.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
+#include "../structure/lca_fast.hpp"
 #include "xtensor/xsort.hpp"
+#include <algorithm>
 
 namespace hg {
 
@@ -91,36 +93,6 @@ namespace hg {
                                                    num_vertices(coarse_rag.rag));
     }
 
-    namespace alignment_internal {
-
-        template<typename rag_t, typename T, typename tree_t, typename T2>
-        auto project_hierarchy(const rag_t &rag_fine, const T &coarse_supervertices, const tree_t &tree_coarse,
-                               const T2 &tree_coarse_node_altitudes) {
-            HG_TRACE();
-            hg_assert_node_weights(tree_coarse, tree_coarse_node_altitudes);
-            hg_assert_1d_array(tree_coarse_node_altitudes);
-            hg_assert_1d_array(coarse_supervertices);
-            hg_assert(rag_fine.vertex_map.size() == coarse_supervertices.size(),
-                      "Dimensions of the two labelisations do not match.");
-
-            auto &fine_supervertices = rag_fine.vertex_map;
-            auto &rag = rag_fine.rag;
-
-            auto fine_to_coarse_map = project_fine_to_coarse_labelisation(fine_supervertices, coarse_supervertices);
-            array_1d<typename T2::value_type> coarse_sm_on_fine_rag = xt::empty<typename T2::value_type>(
-                    {num_edges(rag_fine.rag)});
-
-            lca_fast lca(tree_coarse);
-
-            for (auto e: edge_iterator(rag)) {
-                auto projected_lca = lca.lca(fine_to_coarse_map[source(e, rag)], fine_to_coarse_map[target(e, rag)]);
-                coarse_sm_on_fine_rag(index(e, rag)) = tree_coarse_node_altitudes(projected_lca);
-            }
-
-            return coarse_sm_on_fine_rag;
-        }
-    }
-
     /**
      * This class allows to project hierarchies build from coarse supervertices
      * onto fine supervertices.
@@ -141,6 +113,11 @@ namespace hg {
      * The projection of t onto l1 is a hierarchy given by the saliency map sm on g defined by:
      *     for all {x,y} in edges(g), sm({x,y}) = a(lca_t(s(l1(x), l2), s(l1(y), l2)))
      *
+     * The structures that only depend on the fine supervertices (the edges of the fine region adjacency graph and
+     * the vertices of each fine supervertex) are computed once, when the aligner is created, and shared by all the
+     * alignments. Aligning a hierarchy does not modify the aligner: the functions align_hierarchies align several
+     * hierarchies in parallel.
+     *
      * See the following helper functions for instanciation
      *  - make_hierarchy_aligner_from_graph_cut
      *  - make_hierarchy_aligner_from_labelisation
@@ -150,7 +127,32 @@ namespace hg {
     public:
 
         hierarchy_aligner(region_adjacency_graph &&rag) : m_fine_rag(std::forward<region_adjacency_graph>(rag)) {
+            HG_TRACE();
+            auto &fine_rag = m_fine_rag.rag;
+            auto &vertex_map = m_fine_rag.vertex_map;
+            index_t num_fine_regions = num_vertices(fine_rag);
+
+            // extremities of the edges of the fine rag
+            m_fine_sources = array_1d<index_t>::from_shape({num_edges(fine_rag)});
+            m_fine_targets = array_1d<index_t>::from_shape({num_edges(fine_rag)});
+            for (auto e: edge_iterator(fine_rag)) {
+                m_fine_sources(index(e, fine_rag)) = source(e, fine_rag);
+                m_fine_targets(index(e, fine_rag)) = target(e, fine_rag);
+            }
 
+            // vertices of each fine region (counting sort of the vertices by region)
+            m_region_vertices_starts = xt::zeros<index_t>({(size_t) num_fine_regions + 1});
+            for (auto r: vertex_map) {
+                m_region_vertices_starts(r + 1)++;
+            }
+            for (index_t r = 0; r < num_fine_regions; r++) {
+                m_region_vertices_starts(r + 1) += m_region_vertices_starts(r);
+            }
+            m_region_vertices = array_1d<index_t>::from_shape({vertex_map.size()});
+            std::vector<index_t> positions(m_region_vertices_starts.begin(), m_region_vertices_starts.end() - 1);
+            for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
+                m_region_vertices(positions[vertex_map(i)]++) = i;
+            }
         }
 
         template<typename T>
@@ -162,13 +164,10 @@ namespace hg {
             hg_assert(num_leaves(tree) == m_fine_rag.vertex_map.size(),
                       "Cannot align given hierarchy: incompatible sizes!");
             auto sv_hierarchy = supervertices_hierarchy(tree, altitudes);
-            auto altitudes_sv_hierarchy = xt::index_view(altitudes, sv_hierarchy.node_map);
-            auto coarse_sm_on_fine_rag =
-                    alignment_internal::project_hierarchy(m_fine_rag,
-                                                           sv_hierarchy.supervertex_labelisation,
-                                                           sv_hierarchy.tree,
-                                                           altitudes_sv_hierarchy);
-            return rag_back_project_weights(m_fine_rag.edge_map, coarse_sm_on_fine_rag);
+            array_1d<typename T::value_type> altitudes_sv_hierarchy = xt::index_view(altitudes, sv_hierarchy.node_map);
+            return project_hierarchy(sv_hierarchy.supervertex_labelisation,
+                                     sv_hierarchy.tree,
+                                     altitudes_sv_hierarchy);
         }
 
         template<typename graph_t, typename T>
@@ -183,13 +182,9 @@ namespace hg {
             auto coarse_rag_edge_weights = rag_accumulate(coarse_rag.edge_map, saliency_map, accumulator_first());
             auto bpt_coarse_rag = bpt_canonical(coarse_rag.rag, coarse_rag_edge_weights);
 
-            auto coarse_sm_on_fine_rag =
-                    alignment_internal::project_hierarchy(m_fine_rag,
-                                                           coarse_rag.vertex_map,
-                                                           bpt_coarse_rag.tree,
-                                                           bpt_coarse_rag.altitudes);
-
-            return rag_back_project_weights(m_fine_rag.edge_map, coarse_sm_on_fine_rag);
+            return project_hierarchy(coarse_rag.vertex_map,
+                                     bpt_coarse_rag.tree,
+                                     bpt_coarse_rag.altitudes);
         }
 
         template<typename T1, typename T2>
@@ -206,17 +201,154 @@ namespace hg {
             hg_assert(coarse_supervertices.size() == m_fine_rag.vertex_map.size(),
                       "Cannot align given hierarchy: incompatible sizes!");
 
-            auto coarse_sm_on_fine_rag =
-                    alignment_internal::project_hierarchy(m_fine_rag,
-                                                           coarse_supervertices,
-                                                           tree,
-                                                           altitudes);
+            return project_hierarchy(coarse_supervertices, tree, altitudes);
+        }
 
-            return rag_back_project_weights(m_fine_rag.edge_map, coarse_sm_on_fine_rag);
+        /**
+         * Align several hierarchies given as valued trees, in parallel.
+         *
+         * @tparam tree_t hg::tree or std::reference_wrapper<const hg::tree>
+         * @tparam T type of the altitudes
+         * @param trees trees on the vertices of the graph
+         * @param altitudes altitudes[i] are the altitudes of the nodes of trees[i]
+         * @return a vector of saliency maps on the graph
+         */
+        template<typename tree_t, typename T>
+        auto align_hierarchies(const std::vector<tree_t> &trees, const std::vector<T> &altitudes) const {
+            HG_TRACE();
+            hg_assert(trees.size() == altitudes.size(), "The number of trees and of altitudes do not match.");
+            // the children are computed (lazily) by supervertices_hierarchy: a same tree may appear several times
+            for (const tree &t: trees) {
+                t.compute_children();
+            }
+            std::vector<decltype(align_hierarchy(std::declval<const hg::tree &>(), altitudes[0]))> result(
+                    trees.size());
+            parfor(0, trees.size(), [&](index_t i) {
+                const tree &t = trees[i];
+                result[i] = align_hierarchy(t, altitudes[i]);
+            });
+            return result;
+        }
+
+        /**
+         * Align several hierarchies given as saliency maps on a same graph, in parallel.
+         *
+         * @tparam graph_t graph type
+         * @tparam T type of the saliency maps
+         * @param graph the graph
+         * @param saliency_maps saliency maps on the graph
+         * @return a vector of saliency maps on the graph
+         */
+        template<typename graph_t, typename T>
+        auto align_hierarchies(const graph_t &graph, const std::vector<T> &saliency_maps) const {
+            HG_TRACE();
+            std::vector<decltype(align_hierarchy(graph, saliency_maps[0]))> result(saliency_maps.size());
+            parfor(0, saliency_maps.size(), [&](index_t i) {
+                result[i] = align_hierarchy(graph, saliency_maps[i]);
+            });
+            return result;
+        }
+
+        /**
+         * Align several hierarchies given as valued trees on coarse supervertices, in parallel.
+         *
+         * @tparam T1 type of the coarse supervertices
+         * @tparam tree_t hg::tree or std::reference_wrapper<const hg::tree>
+         * @tparam T2 type of the altitudes
+         * @param coarse_supervertices coarse_supervertices[i] is the labelisation of the graph vertices corresponding
+         * to the leaves of trees[i]
+         * @param trees trees on the coarse supervertices
+         * @param altitudes altitudes[i] are the altitudes of the nodes of trees[i]
+         * @return a vector of saliency maps on the graph
+         */
+        template<typename T1, typename tree_t, typename T2>
+        auto align_hierarchies(const std::vector<T1> &coarse_supervertices,
+                               const std::vector<tree_t> &trees,
+                               const std::vector<T2> &altitudes) const {
+            HG_TRACE();
+            hg_assert(trees.size() == altitudes.size() && trees.size() == coarse_supervertices.size(),
+                      "The number of supervertices, of trees, and of altitudes do not match.");
+            std::vector<decltype(align_hierarchy(coarse_supervertices[0],
+                                                 std::declval<const hg::tree &>(),
+                                                 altitudes[0]))> result(trees.size());
+            parfor(0, trees.size(), [&](index_t i) {
+                const tree &t = trees[i];
+                result[i] = align_hierarchy(coarse_supervertices[i], t, altitudes[i]);
+            });
+            return result;
         }
 
     private:
+
+        /**
+         * For each fine region, the coarse region that has the largest intersection with it (in case of ties, the
+         * coarse region of smallest index).
+         */
+        template<typename T>
+        auto project_fine_to_coarse(const T &coarse_supervertices) const {
+            index_t num_fine_regions = num_vertices(m_fine_rag.rag);
+            auto fine_to_coarse = array_1d<index_t>::from_shape({(size_t) num_fine_regions});
+            const index_t block_size = 1024;
+            parfor(0, (num_fine_regions + block_size - 1) / block_size, [&](index_t b) {
+                std::vector<index_t> labels;
+                for (index_t r = b * block_size; r < (std::min)((b + 1) * block_size, num_fine_regions); r++) {
+                    labels.clear();
+                    for (index_t i = m_region_vertices_starts(r); i < m_region_vertices_starts(r + 1); i++) {
+                        labels.push_back(coarse_supervertices(m_region_vertices(i)));
+                    }
+                    if (labels.empty()) {
+                        fine_to_coarse(r) = 0;
+                        continue;
+                    }
+                    std::sort(labels.begin(), labels.end());
+                    index_t best_label = labels[0];
+                    index_t best_count = 0;
+                    for (index_t i = 0; i < (index_t) labels.size();) {
+                        index_t j = i + 1;
+                        while (j < (index_t) labels.size() && labels[j] == labels[i]) {
+                            j++;
+                        }
+                        if (j - i > best_count) {
+                            best_count = j - i;
+                            best_label = labels[i];
+                        }
+                        i = j;
+                    }
+                    fine_to_coarse(r) = best_label;
+                }
+            });
+            return fine_to_coarse;
+        }
+
+        template<typename T1, typename T2>
+        auto project_hierarchy(const T1 &coarse_supervertices, const hg::tree &tree_coarse,
+                               const T2 &tree_coarse_node_altitudes) const {
+            HG_TRACE();
+            hg_assert_node_weights(tree_coarse, tree_coarse_node_altitudes);
+            hg_assert_1d_array(tree_coarse_node_altitudes);
+            hg_assert_1d_array(coarse_supervertices);
+            hg_assert(m_fine_rag.vertex_map.size() == coarse_supervertices.size(),
+                      "Dimensions of the two labelisations do not match.");
+
+            auto fine_to_coarse = project_fine_to_coarse(coarse_supervertices);
+            array_1d<index_t> coarse_sources = xt::index_view(fine_to_coarse, m_fine_sources);
+            array_1d<index_t> coarse_targets = xt::index_view(fine_to_coarse, m_fine_targets);
+
+            lca_schieber_vishkin lca(tree_coarse);
+            auto projected_lcas = lca.lca(coarse_sources, coarse_targets);
+
+            array_1d<typename T2::value_type> coarse_sm_on_fine_rag = xt::index_view(tree_coarse_node_altitudes,
+                                                                                     projected_lcas);
+            return rag_back_project_weights(m_fine_rag.edge_map, coarse_sm_on_fine_rag);
+        }
+
         region_adjacency_graph m_fine_rag;
+        // extremities of the edges of the fine rag
+        array_1d<index_t> m_fine_sources;
+        array_1d<index_t> m_fine_targets;
+        // vertices of the fine region r are m_region_vertices[m_region_vertices_starts[r]:m_region_vertices_starts[r + 1]]
+        array_1d<index_t> m_region_vertices_starts;
+        array_1d<index_t> m_region_vertices;
     };
 
     template<typename graph_t, typename T>
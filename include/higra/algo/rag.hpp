@@ -13,7 +13,9 @@
 #include "xtensor/xsort.hpp"
 
 #include "../graph.hpp"
+#include "../sorting.hpp"
 #include "../accumulator/at_accumulator.hpp"
+#include <vector>
 
 
 namespace hg {
@@ -39,6 +41,28 @@ namespace hg {
         array_1d<index_t> edge_map;
     };
 
+    /**
+     * Result of the parallel region adjacency graph (rag) construction algorithm when the rag is stored as a
+     * compressed sparse row graph
+     */
+    struct region_adjacency_csr_graph {
+        /**
+         * The region adjacency graph
+         */
+        csr_graph rag;
+
+        /**
+         * An array indicating for each vertex of the original graph, the corresponding vertex of the rag
+         */
+        array_1d<index_t> vertex_map;
+
+        /**
+         * An array indicating for each edge of the original graph, the corresponding edge of the rag.
+         * An edge with no corresponding edge in the rag (edge within a region) is indicated with the value invalid_index.
+         */
+        array_1d<index_t> edge_map;
+    };
+
     /**
      * Construct a region adjacency graph from a vertex labeled graph in linear time.
      * @tparam graph_t
@@ -118,6 +142,323 @@ namespace hg {
         return region_adjacency_graph{std::move(rag), std::move(vertex_map), std::move(edge_map)};
     }
 
+    namespace rag_internal {
+
+        /**
+         * Minimal number of vertices for which the region adjacency graph is computed in parallel
+         */
+        const index_t parallel_rag_min_size = 1 << 20;
+
+        /**
+         * Number of vertices of a slab in the parallel region adjacency graph construction
+         */
+        const index_t parallel_rag_slab_size = 1 << 18;
+
+        /**
+         * Root of the element x in a union-find forest where each element points to an element of smaller or
+         * equal index (no path compression).
+         */
+        inline index_t find_root(const array_1d<index_t> &parents, index_t x) {
+            while (parents(x) != x) {
+                x = parents(x);
+            }
+            return x;
+        }
+
+        /**
+         * Union-find with path halving: the root of a set is its element of smallest index.
+         */
+        inline void union_min_root(array_1d<index_t> &parents, index_t x, index_t y) {
+            while (parents(x) != x) {
+                parents(x) = parents(parents(x));
+                x = parents(x);
+            }
+            while (parents(y) != y) {
+                parents(y) = parents(parents(y));
+                y = parents(y);
+            }
+            if (x < y) {
+                parents(y) = x;
+            } else {
+                parents(x) = y;
+            }
+        }
+
+        /**
+         * Boundary edge of the parallel region adjacency graph construction
+         */
+        struct rag_boundary_edge {
+            index_t region1;
+            index_t region2;
+            index_t edge_index;
+        };
+
+        /**
+         * Number of slabs used by the parallel region adjacency graph construction on the given graph
+         */
+        template<typename graph_t>
+        index_t parallel_rag_num_slabs(const graph_t &graph) {
+            index_t num_slabs = 1;
+#ifdef HG_USE_TBB
+            const index_t num_v = (index_t) num_vertices(graph);
+            if (num_v >= parallel_rag_min_size) {
+                num_slabs = num_v / parallel_rag_slab_size;
+            }
+#endif
+            return num_slabs;
+        }
+
+        /**
+         * Builds the graph of a region adjacency graph from its edges sorted by increasing source and target.
+         */
+        template<typename rag_t>
+        struct rag_builder;
+
+        template<>
+        struct rag_builder<ugraph> {
+            static ugraph make(index_t num_regions, const array_1d<index_t> &sources,
+                               const array_1d<index_t> &targets) {
+                ugraph rag(num_regions, sources.size());
+                for (index_t i = 0; i < (index_t) sources.size(); i++) {
+                    add_edge(sources(i), targets(i), rag);
+                }
+                return rag;
+            }
+        };
+
+        template<>
+        struct rag_builder<csr_graph> {
+            static csr_graph make(index_t num_regions, array_1d<index_t> &sources, array_1d<index_t> &targets) {
+                return csr_graph(std::move(sources), std::move(targets), num_regions);
+            }
+        };
+
+        /**
+         * Parallel version of make_region_adjacency_graph_from_labelisation.
+         *
+         * The vertex set is split into num_slabs ranges of consecutive indices. The regions of each slab are
+         * computed independently with a union-find whose roots are the vertices of smallest index, and they are
+         * merged along the edges linking the slabs. Regions are then numbered by increasing smallest vertex index,
+         * so the vertex map is identical to the one of make_region_adjacency_graph_from_labelisation.
+         *
+         * The edges linking two different regions are extracted independently in each slab as triplets
+         * (smaller region, larger region, edge index) which are sorted and deduplicated: the edges of the
+         * resulting rag are ordered by increasing source and target, as in a compressed sparse row graph, and
+         * their indices may thus differ from the ones of make_region_adjacency_graph_from_labelisation.
+         *
+         * @tparam result_t region_adjacency_graph or region_adjacency_csr_graph
+         * @tparam graph_t
+         * @tparam T
+         * @param graph input graph
+         * @param vertex_labels labels of the graph vertices
+         * @param num_slabs number of independent slabs
+         * @return see struct region_adjacency_graph
+         */
+        template<typename result_t = region_adjacency_graph, typename graph_t, typename T>
+        auto parallel_region_adjacency_graph_from_labelisation(const graph_t &graph,
+                                                               const T &vertex_labels,
+                                                               index_t num_slabs) {
+            HG_TRACE();
+            const index_t num_v = (index_t) num_vertices(graph);
+            num_slabs = (std::max)((index_t) 1, (std::min)(num_slabs, num_v));
+            auto slab_start = [num_v, num_slabs](index_t s) {
+                return (index_t) (((double) num_v * s) / num_slabs);
+            };
+
+            // regions inside each slab
+            array_1d<index_t> parents = xt::arange<index_t>(num_v);
+            std::vector<std::vector<std::pair<index_t, index_t>>> cross_edges(num_slabs);
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                for (index_t v = start; v < end; v++) {
+                    for (auto n: adjacent_vertex_iterator(v, graph)) {
+                        if (n <= v || vertex_labels(n) != vertex_labels(v)) {
+                            continue;
+                        }
+                        if (n >= end) {
+                            cross_edges[s].emplace_back(v, n);
+                        } else {
+                            union_min_root(parents, v, n);
+                        }
+                    }
+                }
+            });
+
+            // merge regions across slabs
+            for (auto &slab_cross_edges: cross_edges) {
+                for (auto &e: slab_cross_edges) {
+                    union_min_root(parents, e.first, e.second);
+                }
+            }
+
+            // number the regions by increasing root index
+            array_1d<index_t> vertex_map = array_1d<index_t>::from_shape({(size_t) num_v});
+            std::vector<index_t> num_slab_regions(num_slabs + 1, 0);
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                index_t num_roots = 0;
+                for (index_t v = start; v < end; v++) {
+                    if (parents(v) == v) {
+                        num_roots++;
+                    }
+                }
+                num_slab_regions[s + 1] = num_roots;
+            });
+            for (index_t s = 0; s < num_slabs; s++) {
+                num_slab_regions[s + 1] += num_slab_regions[s];
+            }
+            const index_t num_regions = num_slab_regions[num_slabs];
+
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                index_t region = num_slab_regions[s];
+                for (index_t v = start; v < end; v++) {
+                    if (parents(v) == v) {
+                        vertex_map(v) = region++;
+                    }
+                }
+            });
+
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                for (index_t v = start; v < end; v++) {
+                    if (parents(v) != v) {
+                        vertex_map(v) = vertex_map(find_root(parents, v));
+                    }
+                }
+            });
+
+            // extract boundary edges
+            std::vector<std::vector<rag_boundary_edge>> slab_boundary_edges(num_slabs);
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                auto &boundary_edges = slab_boundary_edges[s];
+                for (index_t v = start; v < end; v++) {
+                    const index_t region_v = vertex_map(v);
+                    for (auto e: out_edge_iterator(v, graph)) {
+                        const index_t n = target(e, graph);
+                        if (n <= v) {
+                            continue;
+                        }
+                        const index_t region_n = vertex_map(n);
+                        if (region_n != region_v) {
+                            boundary_edges.push_back({(std::min)(region_v, region_n),
+                                                      (std::max)(region_v, region_n),
+                                                      (index_t) index(e, graph)});
+                        }
+                    }
+                }
+            });
+
+            std::vector<index_t> boundary_offsets(num_slabs + 1, 0);
+            for (index_t s = 0; s < num_slabs; s++) {
+                boundary_offsets[s + 1] = boundary_offsets[s] + slab_boundary_edges[s].size();
+            }
+            std::vector<rag_boundary_edge> boundary_edges(boundary_offsets[num_slabs]);
+            parfor(0, num_slabs, [&](index_t s) {
+                std::copy(slab_boundary_edges[s].begin(), slab_boundary_edges[s].end(),
+                          boundary_edges.begin() + boundary_offsets[s]);
+                std::vector<rag_boundary_edge>().swap(slab_boundary_edges[s]);
+            });
+
+            hg::sort(boundary_edges.begin(), boundary_edges.end(),
+                     [](const rag_boundary_edge &a, const rag_boundary_edge &b) {
+                         return a.region1 < b.region1 || (a.region1 == b.region1 && a.region2 < b.region2);
+                     });
+
+            // deduplicate region pairs
+            auto is_new_pair = [&boundary_edges](index_t i) {
+                return i == 0 || boundary_edges[i].region1 != boundary_edges[i - 1].region1 ||
+                       boundary_edges[i].region2 != boundary_edges[i - 1].region2;
+            };
+            index_t num_rag_edges = 0;
+            for (index_t i = 0; i < (index_t) boundary_edges.size(); i++) {
+                if (is_new_pair(i)) {
+                    num_rag_edges++;
+                }
+            }
+
+            array_1d<index_t> edge_map({num_edges(graph)}, invalid_index);
+            array_1d<index_t> sources = array_1d<index_t>::from_shape({(size_t) num_rag_edges});
+            array_1d<index_t> targets = array_1d<index_t>::from_shape({(size_t) num_rag_edges});
+            index_t num_added = 0;
+            for (index_t i = 0; i < (index_t) boundary_edges.size(); i++) {
+                auto &be = boundary_edges[i];
+                if (is_new_pair(i)) {
+                    sources(num_added) = be.region1;
+                    targets(num_added) = be.region2;
+                    num_added++;
+                }
+                edge_map(be.edge_index) = num_added - 1;
+            }
+
+            return result_t{rag_builder<decltype(result_t::rag)>::make(num_regions, sources, targets),
+                            std::move(vertex_map),
+                            std::move(edge_map)};
+        }
+    }
+
+    /**
+     * Construct a region adjacency graph from a vertex labeled graph in parallel.
+     *
+     * The result is identical to make_region_adjacency_graph_from_labelisation except for the ordering of the
+     * rag edges: edges are sorted by increasing source and target (source being the smaller vertex of the edge).
+     *
+     * The construction is parallel when TBB is enabled and the graph is large.
+     *
+     * @tparam graph_t
+     * @tparam T
+     * @param graph
+     * @param xvertex_labels
+     * @return see struct region_adjacency_graph
+     */
+    template<typename graph_t, typename T>
+    auto make_region_adjacency_graph_from_labelisation_parallel(const graph_t &graph,
+                                                                const xt::xexpression<T> &xvertex_labels) {
+        HG_TRACE();
+        auto &vertex_labels = xvertex_labels.derived_cast();
+        hg_assert_vertex_weights(graph, vertex_labels);
+        hg_assert_1d_array(vertex_labels);
+        hg_assert_integral_value_type(vertex_labels);
+
+        return rag_internal::parallel_region_adjacency_graph_from_labelisation(
+                graph, vertex_labels, rag_internal::parallel_rag_num_slabs(graph));
+    }
+
+    /**
+     * Construct a region adjacency graph from a vertex labeled graph in parallel and store it as a compressed
+     * sparse row graph.
+     *
+     * The rag, the vertex map and the edge map are identical to the ones of
+     * make_region_adjacency_graph_from_labelisation_parallel: the sorted and deduplicated rag edges are directly
+     * used as the edge arrays of the csr graph instead of being inserted one by one in an undirected graph.
+     *
+     * The construction is parallel when TBB is enabled and the graph is large.
+     *
+     * @tparam graph_t
+     * @tparam T
+     * @param graph
+     * @param xvertex_labels
+     * @return see struct region_adjacency_csr_graph
+     */
+    template<typename graph_t, typename T>
+    auto make_region_adjacency_csr_graph_from_labelisation(const graph_t &graph,
+                                                           const xt::xexpression<T> &xvertex_labels) {
+        HG_TRACE();
+        auto &vertex_labels = xvertex_labels.derived_cast();
+        hg_assert_vertex_weights(graph, vertex_labels);
+        hg_assert_1d_array(vertex_labels);
+        hg_assert_integral_value_type(vertex_labels);
+
+        return rag_internal::parallel_region_adjacency_graph_from_labelisation<region_adjacency_csr_graph>(
+                graph, vertex_labels, rag_internal::parallel_rag_num_slabs(graph));
+    }
+
     /**
      * Construct a region adjacency graph from a graph cut in linear time.
      * Any edge with weight different from 0 belongs to the cut.
@@ -17,15 +17,309 @@
 #include "higra/sorting.hpp"
 #include <vector>
 #include <stack>
+#include <algorithm>
+#include <cstdint>
 
 namespace hg {
 
+    namespace watershed_internal {
+
+        /**
+         * Number of bits set to 1 in x
+         */
+        inline index_t popcount(std::uint32_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+            return __builtin_popcount(x);
+#else
+            index_t count = 0;
+            while (x != 0) {
+                x &= x - 1;
+                count++;
+            }
+            return count;
+#endif
+        }
+
+        /**
+         * Minimum descent arrows of the vertices of an edge weighted graph: y has an arrow toward each vertex x such
+         * that the edge {x, y} has the weight fminus(y), with fminus(y) the minimum weight of the edges incident
+         * to y. Arrows are visited in the order of the out edges of y.
+         */
+        template<typename graph_t, typename T, typename fminus_t>
+        struct graph_descent_arrows {
+            const graph_t &graph;
+            const T &edge_weights;
+            const fminus_t &fminus;
+
+            template<typename fun_t>
+            void visit(index_t y, fun_t &fun) const {
+                for (auto e: out_edge_iterator(y, graph)) {
+                    if (edge_weights(index(e, graph)) == fminus(y) && fun(target(e, graph))) {
+                        return;
+                    }
+                }
+            }
+        };
+
+        /**
+         * Minimum descent arrows of the vertices of a regular graph: the i-th bit of masks[y] is set if there is an
+         * arrow from y to its neighbour y + relative_neighbours[i].
+         */
+        struct regular_descent_arrows {
+            std::vector<std::uint32_t> masks;
+            std::vector<index_t> relative_neighbours;
+
+            template<typename fun_t>
+            void visit(index_t y, fun_t &fun) const {
+                auto mask = masks[y];
+                for (index_t i = 0; mask != 0; i++, mask >>= 1) {
+                    if ((mask & 1) && fun(y + relative_neighbours[i])) {
+                        return;
+                    }
+                }
+            }
+        };
+
+        /**
+         * Computes fminus(y), the minimum weight of the edges incident to y, for every vertex y of the graph.
+         *
+         * Vertices are processed in parallel.
+         */
+        template<typename graph_t, typename T, typename fminus_t>
+        void graph_fminus(const graph_t &graph, const T &edge_weights, fminus_t &fminus) {
+            using value_type = typename T::value_type;
+            parfor(0, (index_t) num_vertices(graph), [&graph, &edge_weights, &fminus](index_t v) {
+                auto min_value = (std::numeric_limits<value_type>::max)();
+                for (auto e: out_edge_iterator(v, graph)) {
+                    min_value = (std::min)(min_value, edge_weights(index(e, graph)));
+                }
+                fminus(v) = min_value;
+            });
+        }
+
+        /**
+         * Minimum descent arrows of an edge weighted implicit regular graph (see graph_descent_arrows) and
+         * fminus values of its vertices.
+         *
+         * Edge weights are given in the edge order of the explicit graph copy_graph(graph) (e.g. the graphs
+         * returned by get_4_adjacency_graph and get_8_adjacency_graph): the edges are ordered by increasing
+         * smallest extremity and then by the order of the neighbour list of the regular graph.
+         *
+         * Neighbours are accessed with raw linear offsets. The arrows of a vertex are ordered as the out edges
+         * of the explicit graph: neighbours of smaller index first, by increasing index, followed by the
+         * neighbours of larger index in the order of the neighbour list.
+         */
+        template<typename embedding_t, typename T, typename fminus_t>
+        auto regular_graph_descent_arrows(const regular_graph<embedding_t> &graph,
+                                          const T &edge_weights,
+                                          fminus_t &fminus) {
+            using value_type = typename T::value_type;
+            using point_type = typename embedding_t::point_type;
+            const auto &embedding = graph.embedding();
+            const auto &neighbours = graph.neighbours();
+            const index_t num_v = (index_t) num_vertices(graph);
+            const index_t num_n = (index_t) neighbours.size();
+            hg_assert(num_n <= 32, "Regular graphs with more than 32 neighbours are not supported.");
+
+            // neighbours sorted in the order of the out edges of the explicit graph
+            point_type origin;
+            origin.fill(0);
+            std::vector<index_t> order(num_n);
+            std::vector<index_t> offsets(num_n);
+            for (index_t i = 0; i < num_n; i++) {
+                order[i] = i;
+                offsets[i] = embedding.grid2lin(xt::eval(origin + neighbours[i]));
+            }
+            std::stable_sort(order.begin(), order.end(), [&offsets](index_t i, index_t j) {
+                return offsets[i] < 0 && (offsets[j] > 0 || offsets[i] < offsets[j]);
+            });
+
+            regular_descent_arrows arrows;
+            arrows.relative_neighbours.resize(num_n);
+            std::vector<index_t> opposite(num_n, invalid_index);
+            std::uint32_t forward_mask = 0;
+            for (index_t i = 0; i < num_n; i++) {
+                arrows.relative_neighbours[i] = offsets[order[i]];
+                hg_assert(offsets[order[i]] != 0, "Regular graph must not contain self loops.");
+                if (offsets[order[i]] > 0) {
+                    forward_mask |= (std::uint32_t) 1 << i;
+                }
+                for (index_t j = 0; j < num_n; j++) {
+                    if (xt::all(xt::equal(neighbours[order[i]], -neighbours[order[j]]))) {
+                        opposite[i] = j;
+                    }
+                }
+                hg_assert(opposite[i] != invalid_index, "Regular graph neighbour list must be symmetric.");
+            }
+
+            // masks of the neighbours inside the embedding, computed line by line along the last axis
+            const index_t dim = embedding_t::_dim;
+            const auto &shape = embedding.shape();
+            const index_t line_size = shape(dim - 1);
+            const index_t num_lines = (line_size == 0) ? 0 : num_v / line_size;
+            std::vector<std::uint32_t> last_axis_mask(line_size, 0);
+            for (index_t x = 0; x < line_size; x++) {
+                for (index_t i = 0; i < num_n; i++) {
+                    auto c = x + neighbours[order[i]](dim - 1);
+                    if (c >= 0 && c < line_size) {
+                        last_axis_mask[x] |= (std::uint32_t) 1 << i;
+                    }
+                }
+            }
+
+            std::vector<std::uint32_t> valid(num_v);
+            parfor(0, num_lines, [&](index_t l) {
+                auto coordinates = embedding.lin2grid(l * line_size);
+                std::uint32_t line_mask = 0;
+                for (index_t i = 0; i < num_n; i++) {
+                    bool inside = true;
+                    for (index_t d = 0; d < dim - 1; d++) {
+                        auto c = coordinates(d) + neighbours[order[i]](d);
+                        inside = inside && c >= 0 && c < shape(d);
+                    }
+                    if (inside) {
+                        line_mask |= (std::uint32_t) 1 << i;
+                    }
+                }
+                for (index_t x = 0; x < line_size; x++) {
+                    valid[l * line_size + x] = line_mask & last_axis_mask[x];
+                }
+            });
+
+            // index of the first edge whose smallest extremity is v
+            std::vector<index_t> first_edge(num_v + 1);
+            first_edge[0] = 0;
+            for (index_t v = 0; v < num_v; v++) {
+                first_edge[v + 1] = first_edge[v] + popcount(valid[v] & forward_mask);
+            }
+            hg_assert(first_edge[num_v] == (index_t) edge_weights.size(),
+                      "Edge weights size does not match the number of edges in the graph.");
+
+            // the edge to the i-th forward neighbour of v is preceded by the edges to the forward neighbours of v
+            // located before it in the neighbour list
+            std::vector<std::uint32_t> preceding_mask(num_n, 0);
+            for (index_t i = 0; i < num_n; i++) {
+                for (index_t j = 0; j < num_n; j++) {
+                    if (((forward_mask >> j) & 1) && order[j] < order[i]) {
+                        preceding_mask[i] |= (std::uint32_t) 1 << j;
+                    }
+                }
+            }
+
+            auto edge_index = [&valid, &first_edge, &preceding_mask, &opposite, &arrows](index_t v, index_t i) {
+                if (arrows.relative_neighbours[i] > 0) {
+                    return first_edge[v] + popcount(valid[v] & preceding_mask[i]);
+                }
+                auto n = v + arrows.relative_neighbours[i];
+                return first_edge[n] + popcount(valid[n] & preceding_mask[opposite[i]]);
+            };
+
+            arrows.masks.resize(num_v);
+            parfor(0, num_v, [&edge_weights, &fminus, &valid, &arrows, &edge_index, num_n](index_t v) {
+                value_type weights[32];
+                auto min_value = (std::numeric_limits<value_type>::max)();
+                for (index_t i = 0; i < num_n; i++) {
+                    if ((valid[v] >> i) & 1) {
+                        weights[i] = edge_weights(edge_index(v, i));
+                        min_value = (std::min)(min_value, weights[i]);
+                    }
+                }
+                fminus(v) = min_value;
+                std::uint32_t mask = 0;
+                for (index_t i = 0; i < num_n; i++) {
+                    if (((valid[v] >> i) & 1) && weights[i] == min_value) {
+                        mask |= (std::uint32_t) 1 << i;
+                    }
+                }
+                arrows.masks[v] = mask;
+            });
+            return arrows;
+        }
+
+        /**
+         * Stream based watershed cut labelisation of Cousty et al. from the minimum descent arrows of the graph
+         * vertices (see labelisation_watershed).
+         *
+         * Labels depend on the order in which streams are explored: this part of the algorithm is sequential.
+         */
+        template<typename fminus_t, typename arrows_t>
+        auto labelisation_watershed_from_arrows(const fminus_t &fminus, const arrows_t &arrows) {
+            const index_t num_v = (index_t) fminus.size();
+            const auto no_label = (std::numeric_limits<index_t>::max)();
+            array_1d<index_t> labels({(size_t) num_v}, no_label);
+            array_1d<bool> notInL({(size_t) num_v}, true);
+
+            std::vector<index_t> L;
+            std::vector<index_t> LL;
+
+            auto stream = [&L, &LL, &arrows, &fminus, &notInL, &labels, no_label](index_t x) {
+                L.clear();
+                LL.clear();
+                L.push_back(x);
+                LL.push_back(x);
+                notInL[x] = false;
+
+                index_t result = no_label;
+                index_t y;
+                auto explore = [&](index_t adjacent_vertex) {
+                    if (!notInL[adjacent_vertex]) {
+                        return false;
+                    }
+                    if (labels[adjacent_vertex] != no_label) {
+                        result = labels[adjacent_vertex];
+                        return true;
+                    }
+                    L.push_back(adjacent_vertex);
+                    notInL[adjacent_vertex] = false;
+                    if (fminus[adjacent_vertex] < fminus[y]) {
+                        LL.clear();
+                        LL.push_back(adjacent_vertex);
+                        return true; // stop breadth_first
+                    }
+                    LL.push_back(adjacent_vertex);
+                    return false;
+                };
+
+                while (!LL.empty()) {
+                    y = LL.back();
+                    LL.pop_back();
+                    arrows.visit(y, explore);
+                    if (result != no_label) {
+                        return result;
+                    }
+                }
+                return no_label;
+            };
+
+            index_t num_labs = 0;
+
+            for (index_t v = 0; v < num_v; v++) {
+                if (labels[v] == no_label) {
+                    auto res = stream(v);
+                    if (res == no_label) {
+                        num_labs++;
+                        res = num_labs;
+                    }
+                    for (auto x: L) {
+                        labels[x] = res;
+                        notInL[x] = true;
+                    }
+                }
+            }
+            return labels;
+        }
+    }
+
     /**
      * Linear time watershed cut algorithm.
      *
      * Jean Cousty, Gilles Bertrand, Laurent Najman, Michel Couprie. Watershed Cuts: Minimum Spanning
      * Forests and the Drop of Water Principle. IEEE Transactions on Pattern Analysis and Machine
      * Intelligence, Institute of Electrical and Electronics Engineers, 2009, 31 (8), pp.1362-1374.
+     *
+     * The minimum weights of the edges incident to each vertex are computed in parallel (if TBB is enabled), the
+     * streams are then explored sequentially.
+     *
      * @tparam graph_t
      * @tparam T
      * @param graph
@@ -40,118 +334,256 @@ namespace hg {
         hg_assert_edge_weights(graph, edge_weights);
         hg_assert_1d_array(edge_weights);
 
-        using value_type = typename T::value_type;
-        using vertex_t = typename graph_traits<graph_t>::vertex_descriptor;
-
-        auto fminus = array_1d<value_type>::from_shape({graph.num_vertices()});
-
-        for (auto v: vertex_iterator(graph)) {
-            auto minValue = (std::numeric_limits<value_type>::max)();
-            for (auto e: out_edge_iterator(v, graph)) {
-                minValue = (std::min)(minValue, edge_weights(e));
-            }
-            fminus[v] = minValue;
-        }
+        using fminus_t = array_1d<typename T::value_type>;
+        auto fminus = fminus_t::from_shape({num_vertices(graph)});
+        watershed_internal::graph_fminus(graph, edge_weights, fminus);
+        watershed_internal::graph_descent_arrows<graph_t, T, fminus_t> arrows{graph, edge_weights, fminus};
+        return watershed_internal::labelisation_watershed_from_arrows(fminus, arrows);
+    };
 
+    /**
+     * Linear time watershed cut algorithm on an implicit regular graph (for example a 4, 8 or 6 adjacency graph
+     * given by get_4_adjacency_implicit_graph, get_8_adjacency_implicit_graph, or get_6_adjacency_implicit_graph).
+     *
+     * Edge weights are given in the edge order of the explicit graph copy_graph(graph) (e.g. the graphs
+     * returned by get_4_adjacency_graph and get_8_adjacency_graph): the result is identical to
+     * labelisation_watershed(copy_graph(graph), edge_weights) but the neighbours of a vertex are accessed with
+     * raw linear offsets.
+     *
+     * The neighbour list of the graph must be symmetric and contain at most 32 neighbours.
+     *
+     * @tparam embedding_t
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @return array of labels on graph vertices, numbered from 1 to n with n the number of minima
+     */
+    template<typename embedding_t, typename T>
+    auto
+    labelisation_watershed(const regular_graph<embedding_t> &graph, const xt::xexpression<T> &xedge_weights) {
+        HG_TRACE();
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_1d_array(edge_weights);
 
-        auto no_label = (std::numeric_limits<index_t>::max)();
-        auto labels = array_1d<index_t>::from_shape({graph.num_vertices()});
-        std::fill(labels.begin(), labels.end(), no_label);
+        auto fminus = array_1d<typename T::value_type>::from_shape({num_vertices(graph)});
+        auto arrows = watershed_internal::regular_graph_descent_arrows(graph, edge_weights, fminus);
+        return watershed_internal::labelisation_watershed_from_arrows(fminus, arrows);
+    };
 
-        auto notInL = array_1d<bool>::from_shape({graph.num_vertices()});
-        std::fill(notInL.begin(), notInL.end(), true);
 
-        std::vector<vertex_t> L;
-        std::vector<vertex_t> LL;
+    namespace watershed_internal {
 
-        auto stream = [&L, &LL, &graph, &edge_weights, &fminus, &notInL, &labels, no_label](vertex_t x) {
-            L.clear();
-            LL.clear();
-            L.push_back(x);
-            LL.push_back(x);
-            notInL[x] = false;
+        /**
+         * Minimum size (number of vertices) of a graph such that the minimum spanning forest used by the seeded
+         * watershed is computed in parallel (only if TBB is enabled).
+         */
+        const index_t parallel_msf_min_size = 1 << 20;
 
-            while (!LL.empty()) {
-                auto y = LL[LL.size() - 1];
-                LL.pop_back();
+        /**
+         * Number of vertices of each slab in the parallel computation of the minimum spanning forest.
+         */
+        const index_t parallel_msf_slab_size = 1 << 18;
 
-                for (auto e: out_edge_iterator(y, graph)) {
-                    auto adjacent_vertex = target(e, graph);
-                    if (notInL[adjacent_vertex] && edge_weights(e) == fminus[y]) {
-                        if (labels[adjacent_vertex] != no_label) {
-                            return labels[adjacent_vertex];
-                        } else if (fminus[adjacent_vertex] < fminus[y]) {
-                            L.push_back(adjacent_vertex);
-                            notInL[adjacent_vertex] = false;
-                            LL.clear();
-                            LL.push_back(adjacent_vertex);
-                            break; // stop breadth_first
-                        } else {
-                            L.push_back(adjacent_vertex);
-                            notInL[adjacent_vertex] = false;
-                            LL.push_back(adjacent_vertex);
-                        }
-                    }
+        /**
+         * Kruskal algorithm on the given candidate edges (sorted by increasing weights): returns the candidate edges
+         * that belong to the minimum spanning forest, in the order of the candidates.
+         *
+         * Vertices are numbered relatively to vertex_offset and must be in [vertex_offset, vertex_offset + num_vertices).
+         */
+        template<typename graph_t>
+        auto kruskal_filter(const graph_t &graph,
+                            const std::vector<index_t> &sorted_candidates,
+                            index_t vertex_offset,
+                            index_t num_vertices) {
+            union_find uf(num_vertices);
+            std::vector<index_t> msf;
+            msf.reserve((std::min)((index_t) sorted_candidates.size(), (std::max)(num_vertices - 1, (index_t) 0)));
+            for (auto ei: sorted_candidates) {
+                auto e = edge_from_index(ei, graph);
+                auto c1 = uf.find(source(e, graph) - vertex_offset);
+                auto c2 = uf.find(target(e, graph) - vertex_offset);
+                if (c1 != c2) {
+                    uf.link(c1, c2);
+                    msf.push_back(ei);
                 }
             }
-            return no_label;
-        };
+            return msf;
+        }
 
-        index_t num_labs = 0;
+        /**
+         * Sort the given edge indices by increasing weights, ties are broken by edge index: the order is thus the
+         * same as the one given by a stable sort of all the edges of the graph.
+         */
+        template<typename T>
+        void sort_edges(std::vector<index_t> &edges, const T &edge_weights) {
+            std::sort(edges.begin(), edges.end(), [&edge_weights](index_t i, index_t j) {
+                return edge_weights(i) < edge_weights(j) || (!(edge_weights(j) < edge_weights(i)) && i < j);
+            });
+        }
 
-        for (auto v: vertex_iterator(graph)) {
-            if (labels[v] == no_label) {
-                auto res = stream(v);
-                if (res == no_label) {
-                    num_labs++;
-                    for (auto x: L) {
-                        labels[x] = num_labs;
-                        notInL[x] = true;
-                    }
-                } else {
-                    for (auto x: L) {
-                        labels[x] = res;
-                        notInL[x] = true;
+        /**
+         * Edges of a minimum spanning forest of the graph sorted by increasing weights (ties are broken by edge
+         * index).
+         *
+         * The vertex set is split into num_slabs ranges of consecutive indices (slabs of planes for a 3d grid graph in
+         * row major order). The minimum spanning forest of the subgraph induced by each slab is computed
+         * independently: an edge which does not belong to the minimum spanning forest of a subgraph cannot belong
+         * to the minimum spanning forest of the graph. The final minimum spanning forest is then computed on the
+         * union of the minimum spanning forests of the slabs and of the edges linking different slabs.
+         */
+        template<typename graph_t, typename T>
+        auto sorted_minimum_spanning_forest(const graph_t &graph, const T &edge_weights, index_t num_slabs) {
+            HG_TRACE();
+            const index_t num_v = (index_t) num_vertices(graph);
+            num_slabs = (std::max)((index_t) 1, (std::min)(num_slabs, num_v));
+
+            std::vector<index_t> candidates;
+            if (num_slabs == 1) {
+                array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
+                candidates.assign(sorted_edges_indices.begin(), sorted_edges_indices.end());
+            } else {
+                auto slab_start = [num_v, num_slabs](index_t s) {
+                    return (index_t) (((double) num_v * s) / num_slabs);
+                };
+                std::vector<std::vector<index_t>> slab_msf(num_slabs);
+                std::vector<std::vector<index_t>> slab_cross_edges(num_slabs);
+
+                parfor(0, num_slabs, [&](index_t s) {
+                    const index_t start = slab_start(s);
+                    const index_t end = slab_start(s + 1);
+                    std::vector<index_t> internal_edges;
+                    auto &cross_edges = slab_cross_edges[s];
+                    for (index_t v = start; v < end; v++) {
+                        for (auto e: out_edge_iterator(v, graph)) {
+                            // each edge is seen from its 2 extremities: it is processed by the smallest one
+                            auto n = target(e, graph);
+                            if (v < n) {
+                                if (n < end) {
+                                    internal_edges.push_back(index(e, graph));
+                                } else {
+                                    cross_edges.push_back(index(e, graph));
+                                }
+                            }
+                        }
                     }
+                    sort_edges(internal_edges, edge_weights);
+                    slab_msf[s] = kruskal_filter(graph, internal_edges, start, end - start);
+                });
+
+                std::size_t num_candidates = 0;
+                for (index_t s = 0; s < num_slabs; s++) {
+                    num_candidates += slab_msf[s].size() + slab_cross_edges[s].size();
+                }
+                candidates.reserve(num_candidates);
+                for (index_t s = 0; s < num_slabs; s++) {
+                    extend(candidates, slab_msf[s]);
+                    std::vector<index_t>().swap(slab_msf[s]);
+                    extend(candidates, slab_cross_edges[s]);
+                    std::vector<index_t>().swap(slab_cross_edges[s]);
                 }
+                sort_edges(candidates, edge_weights);
             }
+            return kruskal_filter(graph, candidates, 0, num_v);
         }
-        return labels;
+    }
+
+    /**
+     * Minimum spanning forest of an edge weighted graph, with edges sorted by increasing weights, that can be
+     * reused to compute several seeded watersheds on the same edge weighted graph with different seeds
+     * (see labelisation_seeded_watershed).
+     */
+    struct seeded_watershed_msf {
+        /**
+         * Number of vertices of the graph
+         */
+        index_t num_vertices;
+
+        /**
+         * Sources of the edges of the minimum spanning forest (sorted by increasing weights)
+         */
+        array_1d<index_t> sources;
+
+        /**
+         * Targets of the edges of the minimum spanning forest (sorted by increasing weights)
+         */
+        array_1d<index_t> targets;
     };
 
+    /**
+     * Precompute the sorted minimum spanning forest of an edge weighted graph in order to compute seeded watersheds
+     * in linear time (see labelisation_seeded_watershed).
+     *
+     * When TBB is enabled, the minimum spanning forest of large graphs is computed in parallel.
+     *
+     * @tparam graph_t
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @return a seeded_watershed_msf
+     */
+    template<typename graph_t, typename T>
+    auto make_seeded_watershed_msf(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
+        HG_TRACE();
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
+        hg_assert_1d_array(edge_weights);
 
-    template<typename graph_t, typename T1, typename T2>
+        index_t num_v = num_vertices(graph);
+        index_t num_slabs = 1;
+#ifdef HG_USE_TBB
+        if (num_v >= watershed_internal::parallel_msf_min_size) {
+            num_slabs = num_v / watershed_internal::parallel_msf_slab_size;
+        }
+#endif
+        auto msf = watershed_internal::sorted_minimum_spanning_forest(graph, edge_weights, num_slabs);
+
+        array_1d<index_t> sources = array_1d<index_t>::from_shape({msf.size()});
+        array_1d<index_t> targets = array_1d<index_t>::from_shape({msf.size()});
+        for (index_t i = 0; i < (index_t) msf.size(); i++) {
+            auto e = edge_from_index(msf[i], graph);
+            sources(i) = source(e, graph);
+            targets(i) = target(e, graph);
+        }
+        return seeded_watershed_msf{num_v, std::move(sources), std::move(targets)};
+    }
+
+    /**
+     * Seeded watershed cut computed from a precomputed sorted minimum spanning forest (see make_seeded_watershed_msf).
+     *
+     * The result is identical to labelisation_seeded_watershed(graph, edge_weights, vertex_seeds, background_label)
+     * but the complexity is linear in the number of vertices.
+     *
+     * @tparam T2
+     * @param msf
+     * @param xvertex_seeds
+     * @param background_label
+     * @return
+     */
+    template<typename T2>
     auto labelisation_seeded_watershed(
-            const graph_t &graph,
-            const xt::xexpression<T1> &xedge_weights,
+            const seeded_watershed_msf &msf,
             const xt::xexpression<T2> &xvertex_seeds,
             const typename T2::value_type background_label = 0) {
         HG_TRACE();
-        auto &edge_weights = xedge_weights.derived_cast();
         auto &vertex_seeds = xvertex_seeds.derived_cast();
-        hg_assert_edge_weights(graph, edge_weights);
-        hg_assert_node_weights(graph, vertex_seeds);
-        hg_assert_1d_array(edge_weights);
         hg_assert_1d_array(vertex_seeds);
+        hg_assert((index_t) vertex_seeds.size() == msf.num_vertices,
+                  "vertex_seeds size does not match the number of vertices of the graph.");
 
         using label_type = typename T2::value_type;
 
-        array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
-
-        index_t num_nodes = num_vertices(graph);
-        index_t num_edges = sorted_edges_indices.size();
+        index_t num_nodes = msf.num_vertices;
+        index_t num_edges = msf.sources.size();
 
         union_find uf(num_nodes);
 
         array_1d<label_type> labels = vertex_seeds;
 
         for (index_t i = 0; i < num_edges; i++) {
-            auto ei = sorted_edges_indices[i];
-            auto e = edge_from_index(ei, graph);
-            auto c1 = uf.find(source(e, graph));
-            auto c2 = uf.find(target(e, graph));
+            auto c1 = uf.find(msf.sources(i));
+            auto c2 = uf.find(msf.targets(i));
 
-            if (c1 != c2 && (labels(c1) == background_label || labels(c2) == background_label)) {
+            if (labels(c1) == background_label || labels(c2) == background_label) {
                 if (labels(c1) == background_label) {
                     labels(c1) = labels(c2);
                 } else {
@@ -159,7 +591,6 @@ namespace hg {
                 }
                 uf.link(c1, c2);
             }
-
         }
 
         for (index_t i = 0; i < num_nodes; i++) {
@@ -171,4 +602,36 @@ namespace hg {
         return labels;
     };
 
+    /**
+     * Seeded watershed cut on an edge weighted graph.
+     *
+     * The seeded watershed is the minimum spanning forest rooted in the seeds: only the edges of a minimum spanning
+     * forest of the graph need to be processed. If several seeded watersheds must be computed on the same edge
+     * weighted graph, the minimum spanning forest can be precomputed with make_seeded_watershed_msf.
+     *
+     * When TBB is enabled, the minimum spanning forest of large graphs is computed in parallel.
+     *
+     * @tparam graph_t
+     * @tparam T1
+     * @tparam T2
+     * @param graph
+     * @param xedge_weights
+     * @param xvertex_seeds seeds with integer label values on the vertices of the graph
+     * @param background_label vertices whose seed value is equal to background_label are not seeds
+     * @return array of labels on graph vertices
+     */
+    template<typename graph_t, typename T1, typename T2>
+    auto labelisation_seeded_watershed(
+            const graph_t &graph,
+            const xt::xexpression<T1> &xedge_weights,
+            const xt::xexpression<T2> &xvertex_seeds,
+            const typename T2::value_type background_label = 0) {
+        HG_TRACE();
+        auto &vertex_seeds = xvertex_seeds.derived_cast();
+        hg_assert_node_weights(graph, vertex_seeds);
+
+        auto msf = make_seeded_watershed_msf(graph, xedge_weights);
+        return labelisation_seeded_watershed(msf, vertex_seeds, background_label);
+    };
+
 }
@@ -0,0 +1,280 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "dendrogram_purity.hpp"
+#include "fragmentation_curve.hpp"
+#include "partition.hpp"
+#include <memory>
+
+namespace hg {
+
+    /*
+     * Batch assessment: evaluation of many hierarchies (or partitions), each against its own stack of ground truths.
+     *
+     * The i-th element of the list of ground truths is a 2d array whose rows are the ground truth labelisations
+     * associated to the i-th hierarchy (or partition). The result is a table: element (i, j) of the result is the
+     * assessment of the i-th hierarchy against the j-th ground truth of its stack.
+     *
+     * The hierarchies can be given as a std::vector of hg::tree or of std::reference_wrapper<const hg::tree>. The
+     * preprocessing of each hierarchy (children, area, sorted altitudes) is done once, in parallel, and shared by all
+     * the ground truths of its stack; then the (hierarchy, ground truth) pairs are evaluated in parallel.
+     */
+
+    namespace batch_assessment_internal {
+
+        template<typename T>
+        void assert_ground_truths(const std::vector<T> &ground_truths, size_t num_items) {
+            hg_assert(ground_truths.size() == num_items,
+                      "The number of ground truth stacks must be equal to the number of assessed items.");
+            for (const auto &g: ground_truths) {
+                hg_assert(g.dimension() == 2, "Each ground truth stack must be a 2d array.");
+                hg_assert_integral_value_type(g);
+            }
+        }
+
+        template<typename T>
+        void assert_vertex_maps(const std::vector<T> &vertex_maps, size_t num_items) {
+            hg_assert(vertex_maps.empty() || vertex_maps.size() == num_items,
+                      "The number of vertex maps must be equal to the number of hierarchies.");
+        }
+
+        /**
+         * List of the pairs (i, j) such that j is the index of a ground truth in the i-th stack of ground truths.
+         */
+        template<typename T>
+        auto make_tasks(const std::vector<T> &ground_truths) {
+            std::vector<std::pair<index_t, index_t>> tasks;
+            for (index_t i = 0; i < (index_t) ground_truths.size(); i++) {
+                for (index_t j = 0; j < (index_t) ground_truths[i].shape()[0]; j++) {
+                    tasks.push_back({i, j});
+                }
+            }
+            return tasks;
+        }
+
+        template<typename T>
+        auto make_table(const std::vector<T> &ground_truths) {
+            std::vector<array_1d<double>> table;
+            for (const auto &g: ground_truths) {
+                table.push_back(array_1d<double>::from_shape({(size_t) g.shape()[0]}));
+            }
+            return table;
+        }
+
+        /**
+         * Rearrange the fragmentation curves computed for each task (see make_tasks) into a table.
+         */
+        inline
+        auto make_curve_table(const std::vector<std::pair<index_t, index_t>> &tasks,
+                              std::vector<std::unique_ptr<fragmentation_curve<>>> &curves,
+                              size_t num_items) {
+            std::vector<std::vector<fragmentation_curve<>>> table(num_items);
+            for (index_t t = 0; t < (index_t) tasks.size(); t++) {
+                table[tasks[t].first].push_back(std::move(*curves[t]));
+            }
+            return table;
+        }
+
+        /**
+         * Compute the children of all the trees sequentially: the same tree may appear several times in the list.
+         */
+        template<typename trees_t>
+        void compute_children(const trees_t &trees) {
+            for (index_t i = 0; i < (index_t) trees.size(); i++) {
+                const tree &t = trees[i];
+                t.compute_children();
+            }
+        }
+
+        template<typename T>
+        const array_1d<index_t> &vertex_map(const std::vector<T> &vertex_maps, index_t i) {
+            static const array_1d<index_t> no_vertex_map{};
+            return vertex_maps.empty() ? no_vertex_map : vertex_maps[i];
+        }
+    }
+
+    /**
+     * Assessment of many partitions, each against a stack of ground truth partitions.
+     *
+     * Each partition is compared to the ground truths of its stack one by one (unlike assess_partition,
+     * which aggregates the scores over all the ground truths of a stack).
+     *
+     * @tparam T1 type of the candidate labelisations
+     * @tparam T2 type of the ground truth stacks
+     * @tparam scorer_t partition scorer (see partition.hpp)
+     * @param candidates list of candidate labelisations
+     * @param ground_truths list of ground truth stacks: ground_truths[i] is a 2d array whose rows are the ground truths
+     * of candidates[i]
+     * @param scorer partition scorer
+     * @return a vector of 1d arrays: element j of the i-th array is the score of candidates[i] w.r.t. the j-th
+     * ground truth of its stack
+     */
+    template<typename T1, typename T2, typename scorer_t>
+    auto assess_partition_batch(const std::vector<T1> &candidates,
+                                const std::vector<T2> &ground_truths,
+                                const scorer_t &scorer) {
+        batch_assessment_internal::assert_ground_truths(ground_truths, candidates.size());
+        auto tasks = batch_assessment_internal::make_tasks(ground_truths);
+        auto scores = batch_assessment_internal::make_table(ground_truths);
+
+        parfor(0, tasks.size(), [&](index_t t) {
+            index_t i, j;
+            std::tie(i, j) = tasks[t];
+            auto ground_truth = xt::view(ground_truths[i], j, xt::all());
+            hg_assert(candidates[i].size() == ground_truth.size(),
+                      "Candidate and ground truth partitions must have the same number of elements.");
+            scores[i](j) = assess_partition(xt::flatten(candidates[i]), ground_truth, scorer);
+        });
+        return scores;
+    };
+
+    /**
+     * Dendrogram purity (see dendrogram_purity.hpp) of many hierarchies, each against a stack of ground truth
+     * labelisations of its leaves.
+     *
+     * @tparam trees_t std::vector of hg::tree or of std::reference_wrapper<const hg::tree>
+     * @tparam T type of the leaf label stacks
+     * @param trees list of hierarchies
+     * @param leaf_labels list of leaf label stacks: leaf_labels[i] is a 2d array whose rows are labelisations of the
+     * leaves of trees[i]
+     * @return a vector of 1d arrays: element j of the i-th array is the purity of trees[i] w.r.t. the j-th
+     * labelisation of its stack
+     */
+    template<typename trees_t, typename T>
+    auto dendrogram_purity_batch(const trees_t &trees, const std::vector<T> &leaf_labels) {
+        batch_assessment_internal::assert_ground_truths(leaf_labels, trees.size());
+        // checked before the parallel loop, see dendrogram_purity_internal::dendrogram_purity
+        for (const auto &l: leaf_labels) {
+            hg_assert(l.size() == 0 || xt::amin(l)() >= 0, "Leaf labels must be non negative.");
+        }
+
+        batch_assessment_internal::compute_children(trees);
+        std::vector<array_1d<index_t>> areas(trees.size());
+        parfor(0, trees.size(), [&](index_t i) {
+            const tree &t = trees[i];
+            areas[i] = attribute_area(t);
+        });
+
+        auto tasks = batch_assessment_internal::make_tasks(leaf_labels);
+        auto scores = batch_assessment_internal::make_table(leaf_labels);
+
+        parfor(0, tasks.size(), [&](index_t t) {
+            index_t i, j;
+            std::tie(i, j) = tasks[t];
+            const tree &tree_i = trees[i];
+            auto labels = xt::view(leaf_labels[i], j, xt::all());
+            hg_assert_leaf_weights(tree_i, labels);
+            scores[i](j) = dendrogram_purity_internal::dendrogram_purity(tree_i, labels, areas[i]);
+        });
+        return scores;
+    };
+
+    /**
+     * Fragmentation curves of the optimal cuts (see assesser_fragmentation_optimal_cut) of many hierarchies,
+     * each against a stack of ground truths.
+     *
+     * @tparam trees_t std::vector of hg::tree or of std::reference_wrapper<const hg::tree>
+     * @tparam T type of the ground truth stacks
+     * @param trees list of binary hierarchies
+     * @param ground_truths list of ground truth stacks: ground_truths[i] is a 2d array whose rows are the ground truths
+     * of trees[i]
+     * @param measure evaluation measure
+     * @param vertex_maps super-vertices maps (if the trees are built on rags, leave empty otherwise)
+     * @param max_regions maximum number of regions in the considered cuts
+     * @return a vector of vectors of fragmentation curves: element j of the i-th vector is the fragmentation curve of
+     * trees[i] w.r.t. the j-th ground truth of its stack
+     */
+    template<typename trees_t, typename T>
+    auto assess_fragmentation_optimal_cut_batch(const trees_t &trees,
+                                                const std::vector<T> &ground_truths,
+                                                optimal_cut_measure measure,
+                                                const std::vector<array_1d<index_t>> &vertex_maps = {},
+                                                size_t max_regions = 200) {
+        batch_assessment_internal::assert_ground_truths(ground_truths, trees.size());
+        batch_assessment_internal::assert_vertex_maps(vertex_maps, trees.size());
+
+        batch_assessment_internal::compute_children(trees);
+
+        auto tasks = batch_assessment_internal::make_tasks(ground_truths);
+        std::vector<std::unique_ptr<fragmentation_curve<>>> curves(tasks.size());
+
+        parfor(0, tasks.size(), [&](index_t t) {
+            index_t i, j;
+            std::tie(i, j) = tasks[t];
+            const tree &tree_i = trees[i];
+            assesser_fragmentation_optimal_cut assesser(tree_i,
+                                                        xt::view(ground_truths[i], j, xt::all()),
+                                                        measure,
+                                                        batch_assessment_internal::vertex_map(vertex_maps, i),
+                                                        max_regions);
+            curves[t].reset(new fragmentation_curve<>(assesser.fragmentation_curve()));
+        });
+        return batch_assessment_internal::make_curve_table(tasks, curves, trees.size());
+    };
+
+    /**
+     * Fragmentation curves of the horizontal cuts (see assess_fragmentation_horizontal_cut) of many hierarchies,
+     * each against a stack of ground truths.
+     *
+     * @tparam trees_t std::vector of hg::tree or of std::reference_wrapper<const hg::tree>
+     * @tparam T1 type of the altitudes
+     * @tparam T2 type of the ground truth stacks
+     * @tparam scorer_t partition scorer (see partition.hpp)
+     * @param trees list of hierarchies
+     * @param altitudes list of node altitudes: altitudes[i] are the altitudes of the nodes of trees[i]
+     * @param ground_truths list of ground truth stacks: ground_truths[i] is a 2d array whose rows are the ground truths
+     * of trees[i]
+     * @param scorer partition scorer
+     * @param vertex_maps super-vertices maps (if the trees are built on rags, leave empty otherwise)
+     * @param max_regions maximum number of regions in the considered cuts
+     * @return a vector of vectors of fragmentation curves: element j of the i-th vector is the fragmentation curve of
+     * trees[i] w.r.t. the j-th ground truth of its stack
+     */
+    template<typename trees_t, typename T1, typename T2, typename scorer_t>
+    auto assess_fragmentation_horizontal_cut_batch(const trees_t &trees,
+                                                   const std::vector<T1> &altitudes,
+                                                   const std::vector<T2> &ground_truths,
+                                                   const scorer_t &scorer,
+                                                   const std::vector<array_1d<index_t>> &vertex_maps = {},
+                                                   size_t max_regions = 200) {
+        using value_type = typename T1::value_type;
+        using explorer_t = horizontal_cut_explorer<hg::tree, value_type>;
+        hg_assert(altitudes.size() == trees.size(), "The number of altitudes must be equal to the number of trees.");
+        batch_assessment_internal::assert_ground_truths(ground_truths, trees.size());
+        batch_assessment_internal::assert_vertex_maps(vertex_maps, trees.size());
+
+        batch_assessment_internal::compute_children(trees);
+        std::vector<std::unique_ptr<explorer_t>> explorers(trees.size());
+        parfor(0, trees.size(), [&](index_t i) {
+            const tree &t = trees[i];
+            explorers[i].reset(new explorer_t(t, altitudes[i]));
+        });
+
+        auto tasks = batch_assessment_internal::make_tasks(ground_truths);
+        std::vector<std::unique_ptr<fragmentation_curve<>>> curves(tasks.size());
+
+        parfor(0, tasks.size(), [&](index_t t) {
+            index_t i, j;
+            std::tie(i, j) = tasks[t];
+            const tree &tree_i = trees[i];
+            curves[t].reset(new fragmentation_curve<>(
+                    fragmentation_curve_internal::horizontal_cut_fragmentation_curve(
+                            tree_i,
+                            *explorers[i],
+                            xt::view(ground_truths[i], j, xt::all()),
+                            scorer,
+                            batch_assessment_internal::vertex_map(vertex_maps, i),
+                            max_regions)));
+        });
+        return batch_assessment_internal::make_curve_table(tasks, curves, trees.size());
+    };
+}
@@ -13,12 +13,110 @@
 #include "../graph.hpp"
 #include "../attribute/tree_attribute.hpp"
 #include "../accumulator/tree_accumulator.hpp"
+#include "../structure/details/tree_schedule.hpp"
+#include <memory>
+#include <unordered_map>
 
 namespace hg {
 
     using namespace xt;
     using namespace xt::placeholders;
 
+    namespace dendrogram_purity_internal {
+
+        /**
+         * Dendrogram purity of a tree whose children have already been computed, given the area of its nodes.
+         */
+        template<typename tree_t, typename T1, typename T2>
+        auto dendrogram_purity(const tree_t &tree, const T1 &leaf_labels, const T2 &area) {
+            using histogram_t = std::unordered_map<index_t, index_t>;
+            const index_t num_l = num_leaves(tree);
+            const index_t num_v = num_vertices(tree);
+
+            hg_assert(xt::amin(leaf_labels)() >= 0, "Leaf labels must be non negative.");
+
+            // number of pairs of distinct leaves belonging to the same class
+            std::vector<index_t> class_sizes(xt::amax(leaf_labels)() + 1, 0);
+            for (index_t i = 0; i < num_l; i++) {
+                class_sizes[leaf_labels(i)]++;
+            }
+            double Z = 0;
+            for (auto s: class_sizes) {
+                Z += (double) s * (double) (s - 1) / 2;
+            }
+
+            // label histogram of the non leaf nodes whose parent has not been processed yet (the histogram of a leaf is
+            // implicitly made of its label)
+            std::vector<std::unique_ptr<histogram_t>> histograms(num_v);
+            // sum of the purities of the pairs of leaves of a same class whose lowest common ancestor is the node
+            array_1d<double> node_purity = xt::zeros<double>({(size_t) num_v});
+
+            auto histogram_size = [&histograms, num_l](index_t n) {
+                return (n < num_l) ? (size_t) 1 : histograms[n]->size();
+            };
+
+            tree_internal::schedule_leaves_to_root(tree, [&](auto first, auto last) {
+                // label and number of pairs of leaves counted for this label during the merge
+                std::vector<std::pair<index_t, index_t>> pairs;
+                for (; first != last; ++first) {
+                    index_t n = *first;
+                    if (n < num_l) {
+                        continue;
+                    }
+
+                    index_t largest = child(0, n, tree);
+                    for (auto c: tree.children(n)) {
+                        if (histogram_size(c) > histogram_size(largest)) {
+                            largest = c;
+                        }
+                    }
+
+                    std::unique_ptr<histogram_t> histogram;
+                    if (largest < num_l) {
+                        histogram.reset(new histogram_t());
+                        histogram->emplace(leaf_labels(largest), 1);
+                    } else {
+                        histogram = std::move(histograms[largest]);
+                    }
+
+                    pairs.clear();
+                    auto merge = [&histogram, &pairs](index_t label, index_t count) {
+                        auto it = histogram->find(label);
+                        if (it == histogram->end()) {
+                            histogram->emplace(label, count);
+                        } else {
+                            pairs.push_back({label, it->second * count});
+                            it->second += count;
+                        }
+                    };
+
+                    for (auto c: tree.children(n)) {
+                        if (c == largest) {
+                            continue;
+                        }
+                        if (c < num_l) {
+                            merge(leaf_labels(c), 1);
+                        } else {
+                            for (const auto &e: *histograms[c]) {
+                                merge(e.first, e.second);
+                            }
+                            histograms[c].reset();
+                        }
+                    }
+
+                    double purity = 0;
+                    for (const auto &p: pairs) {
+                        purity += (double) p.second * (double) histogram->find(p.first)->second;
+                    }
+                    node_purity(n) = purity / (double) area(n);
+                    histograms[n] = std::move(histogram);
+                }
+            });
+
+            return xt::sum(node_purity)() / Z;
+        }
+    }
+
     /**
      * Weighted average of the purity of each node of the tree with respect to a ground truth
      * labelization of the tree leaves.
@@ -48,8 +146,12 @@ namespace hg {
      *
      * :Complexity:
      *
-     * The dendrogram purity is computed in :math:`\mathcal{O}(N\\times K \\times C^2)` with :math:`N` the number of nodes
-     * in the tree, :math:`K` the number of classes, and :math:`C` the maximal number of children of a node in the tree.
+     * The dendrogram purity is computed in :math:`\mathcal{O}(N\log(N))` time with :math:`N` the number of nodes in the
+     * tree. The label histogram of each node is stored sparsely (only the labels present in the node) and it is
+     * obtained by merging the histograms of its children into the largest one: the histogram of a node is dropped once
+     * it has been merged into the histogram of its parent. The number of pairs of leaves of a class whose lowest common
+     * ancestor is a given node is counted during the merge. With TBB, independent subtrees of large trees are processed
+     * in parallel.
      *
      * @tparam tree_t
      * @tparam T
@@ -64,24 +166,7 @@ namespace hg {
         hg_assert_leaf_weights(tree, leaf_labels);
         hg_assert_integral_value_type(leaf_labels);
 
-        auto num_l = num_leaves(tree);
-        auto area = attribute_area(tree);
-
-        auto max_label = xt::amax(leaf_labels)();
-        size_t num_labels = max_label + 1;
-        array_2d<double> label_histo_leaves = zeros<double>({num_l, num_labels});
-        for (index_t i = 0; i < (index_t) num_l; i++) {
-            label_histo_leaves(i, leaf_labels(i)) = 1;
-        }
-
-        auto label_histo = accumulate_sequential(tree, label_histo_leaves, accumulator_sum());
-        auto class_purity = label_histo / view(area, all(), newaxis());
-
-        auto weights = attribute_children_pair_sum_product(tree, label_histo);
-        double Z = sum(weights)();
-        double total = sum(view(class_purity, range(num_l, _), all()) *
-                           view(weights, range(num_l, _), all()))();
-
-        return total / Z;
+        tree.compute_children();
+        return dendrogram_purity_internal::dendrogram_purity(tree, leaf_labels, attribute_area(tree));
     }
 };
@@ -15,6 +15,7 @@
 #include "../algo/tree.hpp"
 #include "../algo/rag.hpp"
 #include "../algo/horizontal_cuts.hpp"
+#include "partition.hpp"
 #include <xtensor/xsort.hpp>
 
 namespace hg {
@@ -88,32 +89,81 @@ namespace hg {
             size_t back_track_k_right; // number of regions coming from right/second  child
         };
 
-        template<typename value_t=index_t, typename tree_t, typename T>
-        auto compute_card_intersection_tree_ground_truth(
+        /**
+         * Cardinal of each ground truth region.
+         */
+        template<typename T>
+        auto ground_truth_region_cards(const T &ground_truth) {
+            size_t num_regions_ground_truth = xt::amax(ground_truth)() + 1;
+            array_1d<double> region_cards({num_regions_ground_truth}, 0);
+            for (auto v: ground_truth) {
+                region_cards(v)++;
+            }
+            return region_cards;
+        }
+
+        /**
+         * Computes the rows of the sparse contingency table between the nodes of the tree and the ground truth
+         * regions (see sparse_card_intersection_row). The rows are computed in leaves to root order and, for each
+         * node n, visitor(n, row, row_card) is called with the row of n and the cardinal of n.
+         *
+         * The row of a node is obtained by merging the rows of its children and is dropped once it has been merged
+         * into the row of its parent: memory usage is proportional to the number of non empty intersections
+         * between the ground truth regions and the nodes whose parent has not been visited yet.
+         *
+         * @param tree input tree
+         * @param ground_truth ground truth labelisation of the tree leaves (or of the rag vertices)
+         * @param num_regions_ground_truth number of ground truth regions
+         * @param vertex_map super-vertices map (if tree is built on a rag, leave empty otherwise)
+         * @param visitor function called on each node of the tree
+         */
+        template<typename tree_t, typename T, typename visitor_t>
+        void visit_card_intersection_tree_ground_truth(
                 const tree_t &tree,
-                const xt::xexpression<T> &xground_truth,
-                const array_1d<index_t> &vertex_map = {}) {
-            auto &ground_truth = xground_truth.derived_cast();
-            hg_assert_1d_array(ground_truth);
+                const T &ground_truth,
+                size_t num_regions_ground_truth,
+                const array_1d<index_t> &vertex_map,
+                visitor_t &&visitor) {
+            using entry_t = std::pair<index_t, index_t>;
+            // rows merged into each node, waiting for the node to be visited
+            std::vector<std::vector<entry_t>> pending(num_vertices(tree));
 
-            auto num_regions_ground_truth = xt::amax(ground_truth)() + 1;
-            array_2d<index_t> card_intersection_leaves({num_leaves(tree), (size_t) num_regions_ground_truth}, 0);
             if (vertex_map.size() <= 1) { // no rag
                 hg_assert_leaf_weights(tree, ground_truth);
                 for (auto i: leaves_iterator(tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
+                    pending[i].push_back({ground_truth(i), 1});
                 }
             } else { // tree on rag
                 hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
                 for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
+                    pending[vertex_map(i)].push_back({ground_truth(i), 1});
                 }
             }
 
-            array_2d<value_t> card_intersection = accumulate_sequential(tree, card_intersection_leaves,
-                                                                        accumulator_sum());
-            return card_intersection;
-        };
+            partition_internal::card_intersection_accumulator<index_t> accumulator(num_regions_ground_truth);
+            std::vector<index_t> labels;
+            std::vector<index_t> cards;
+            for (auto n: leaves_to_root_iterator(tree)) {
+                for (const auto &e: pending[n]) {
+                    accumulator.add(e.first, e.second);
+                }
+                std::vector<entry_t>().swap(pending[n]);
+
+                labels.clear();
+                cards.clear();
+                auto row_card = accumulator.finalize(labels, cards);
+                visitor(n, sparse_card_intersection_row<index_t>{labels.data(), cards.data(), labels.size()},
+                        row_card);
+
+                auto p = parent(n, tree);
+                if (p != n) {
+                    auto &pending_parent = pending[p];
+                    for (index_t k = 0; k < (index_t) labels.size(); k++) {
+                        pending_parent.push_back({labels[k], cards[k]});
+                    }
+                }
+            }
+        }
 
     }
 
@@ -156,60 +206,30 @@ namespace hg {
 
             max_regions = (std::min)(max_regions, num_leaves(m_tree));
 
-            size_t num_regions_ground_truth = xt::amax(ground_truth)() + 1;
-
-            array_1d<index_t> region_gt_areas({num_regions_ground_truth}, 0);
-            for (auto v:ground_truth) {
-                region_gt_areas[v]++;
-            }
+            auto region_gt_areas = fragmentation_curve_internal::ground_truth_region_cards(ground_truth);
 
             m_num_regions_ground_truth = xt::count_nonzero(region_gt_areas)();
 
-// TODO remove when xtensor MSVC witht he bug with xt::view(region_tree_area, xt::all(), xt::newaxis()) on 1d tensor
-#ifndef _MSC_VER
-            array_1d<index_t> region_tree_area;
-#else
-            array_nd<index_t> region_tree_area;
-#endif
-
-            // for a tree node i, a gt region j: card_intersection(i, j) is the number of pixels in R_i cap R_j
-            array_2d<index_t> card_intersection_leaves{{num_leaves(m_tree), region_gt_areas.size()}, 0};
-            if (vertex_map.size() <= 1) { // no rag
-                hg_assert_leaf_weights(m_tree, ground_truth);
-                for (auto i: leaves_iterator(m_tree)) {
-                    card_intersection_leaves(i, ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(m_tree);
-            } else { // tree on rag
-                hg_assert(vertex_map.size() == ground_truth.size(), "Vertex map and ground truth sizes do not match.");
-                for (index_t i = 0; i < (index_t) vertex_map.size(); i++) {
-                    card_intersection_leaves(vertex_map(i), ground_truth(i))++;
-                }
-                region_tree_area = attribute_area(m_tree,
-                                                  rag_accumulate(vertex_map, xt::ones<index_t>(vertex_map.shape()),
-                                                                 accumulator_counter()));
-            }
-
-            array_2d<double> card_intersection = accumulate_sequential(m_tree, card_intersection_leaves,
-                                                                       accumulator_sum());
-
-            array_1d<double> scores;
+            // score of each tree node seen as a region of a cut, computed from the non empty intersections
+            // (card_intersection(i, j) is the number of pixels in R_i cap R_j) between the node and the gt regions
+            array_1d<double> scores = array_1d<double>::from_shape({num_vertices(m_tree)});
+            auto compute_scores = [&](const auto &scorer) {
+                fragmentation_curve_internal::visit_card_intersection_tree_ground_truth(
+                        m_tree, ground_truth, region_gt_areas.size(), vertex_map,
+                        [&scores, &region_gt_areas, &scorer](index_t n, const auto &row, index_t row_card) {
+                            scores(n) = scorer.score_row(row, (double) row_card, region_gt_areas);
+                        });
+            };
 
             switch (measure) {
                 case optimal_cut_measure::BCE:
-                    scores = xt::eval(xt::sum(
-                            card_intersection *
-                            xt::minimum(card_intersection / region_gt_areas,
-                                        card_intersection / xt::view(region_tree_area, xt::all(), xt::newaxis())),
-                            {1}));
+                    compute_scores(scorer_partition_BCE());
                     break;
                 case optimal_cut_measure::DHamming:
-                    scores = xt::eval(xt::amax(card_intersection, {1}));
+                    compute_scores(scorer_partition_DHamming());
                     break;
                 case optimal_cut_measure::DCovering:
-                    auto card_union = xt::eval(-card_intersection + region_gt_areas +
-                                               xt::view(region_tree_area, xt::all(), xt::newaxis()));
-                    scores = xt::eval(xt::amax(card_intersection / card_union, {1}) * region_tree_area);
+                    compute_scores(scorer_partition_DCovering());
                     break;
             }
 
@@ -388,6 +408,106 @@ namespace hg {
         size_t m_num_regions_ground_truth;
     };
 
+    namespace fragmentation_curve_internal {
+
+        /**
+         * Function computing the score of a cut of the tree from the list of its nodes, for a scorer with a
+         * score_row function: the score of each node is computed once from its row of the sparse contingency table
+         * and the score of a cut is the normalized sum of the scores of its nodes.
+         */
+        template<typename tree_t, typename T, typename scorer_t>
+        auto make_cut_scorer(const tree_t &tree,
+                             const T &ground_truth,
+                             const array_1d<double> &region_gt_areas,
+                             const scorer_t &partition_scorer,
+                             const array_1d<index_t> &vertex_map,
+                             std::true_type) {
+            array_1d<double> node_scores = array_1d<double>::from_shape({num_vertices(tree)});
+            visit_card_intersection_tree_ground_truth(
+                    tree, ground_truth, region_gt_areas.size(), vertex_map,
+                    [&node_scores, &region_gt_areas, &partition_scorer](index_t n, const auto &row, index_t row_card) {
+                        node_scores(n) = partition_scorer.score_row(row, (double) row_card, region_gt_areas);
+                    });
+            const double num_elements = (double) ground_truth.size();
+            return [node_scores = std::move(node_scores), num_elements](const array_1d<index_t> &nodes) {
+                double score = 0;
+                for (auto n: nodes) {
+                    score += node_scores(n);
+                }
+                return score / num_elements;
+            };
+        }
+
+        /**
+         * Function computing the score of a cut of the tree from the list of its nodes, for a scorer without
+         * score_row function: the scorer is applied on the rows of the cut nodes in the dense contingency table
+         * between the tree nodes and the ground truth regions.
+         */
+        template<typename tree_t, typename T, typename scorer_t>
+        auto make_cut_scorer(const tree_t &tree,
+                             const T &ground_truth,
+                             const array_1d<double> &region_gt_areas,
+                             const scorer_t &partition_scorer,
+                             const array_1d<index_t> &vertex_map,
+                             std::false_type) {
+            array_2d<double> card_intersection({num_vertices(tree), region_gt_areas.size()}, 0);
+            visit_card_intersection_tree_ground_truth(
+                    tree, ground_truth, region_gt_areas.size(), vertex_map,
+                    [&card_intersection](index_t n, const auto &row, index_t) {
+                        for (size_t k = 0; k < row.size; k++) {
+                            card_intersection(n, row.labels[k]) = (double) row.cards[k];
+                        }
+                    });
+            return [card_intersection = std::move(card_intersection), &partition_scorer](
+                    const array_1d<index_t> &nodes) {
+                return (double) partition_scorer.score(xt::view(card_intersection, xt::keep(nodes), xt::all()));
+            };
+        }
+
+        /**
+         * Fragmentation curve of the horizontal cuts of a tree given a horizontal cut explorer of this tree.
+         */
+        template<typename tree_t, typename explorer_t, typename T, typename scorer_t>
+        auto horizontal_cut_fragmentation_curve(
+                const tree_t &tree,
+                const explorer_t &hc_explorer,
+                const T &ground_truth,
+                const scorer_t &partition_scorer,
+                const array_1d<index_t> &vertex_map,
+                size_t max_regions) {
+            hg_assert_integral_value_type(ground_truth);
+            hg_assert_1d_array(ground_truth);
+            max_regions = (std::min)(max_regions, num_leaves(tree));
+
+            auto region_gt_areas = ground_truth_region_cards(ground_truth);
+
+            // the score of a cut is computed from the intersections of its nodes with the ground truth regions
+            auto cut_scorer = make_cut_scorer(tree, ground_truth, region_gt_areas, partition_scorer, vertex_map,
+                                              partition_internal::has_score_row<scorer_t>());
+
+            auto &num_regions_cuts = hc_explorer.num_regions_cuts();
+            auto last_cut = std::upper_bound(num_regions_cuts.begin(), num_regions_cuts.end(),
+                                             (index_t) max_regions);
+
+            index_t num_cuts = std::distance(num_regions_cuts.begin(), last_cut);
+
+            array_1d<double> scores = xt::empty<double>({num_cuts});
+            array_1d<index_t> num_regions = xt::empty<index_t>({num_cuts});
+            std::copy(num_regions_cuts.begin(), num_regions_cuts.begin() + num_cuts, num_regions.begin());
+
+            for (index_t i = 0; i < num_cuts; i++) {
+                auto hc = hc_explorer.horizontal_cut_from_index(i);
+                scores(i) = cut_scorer(hc.nodes);
+            }
+
+            size_t num_regions_ground_truth = xt::count_nonzero(region_gt_areas)();
+
+            return hg::fragmentation_curve<>{std::move(num_regions),
+                                             std::move(scores),
+                                             num_regions_ground_truth};
+        }
+    }
+
     template<typename tree_t, typename T1, typename T2, typename scorer_t>
     auto assess_fragmentation_horizontal_cut(
             const tree_t &tree,
@@ -400,33 +520,10 @@ namespace hg {
         auto &ground_truth = xground_truth.derived_cast();
 
         hg_assert_node_weights(tree, altitudes);
-        hg_assert_integral_value_type(ground_truth);
-        hg_assert_1d_array(ground_truth);
-        max_regions = (std::min)(max_regions, num_leaves(tree));
-
-        auto card_intersection = fragmentation_curve_internal::compute_card_intersection_tree_ground_truth<double>(
-                tree, ground_truth, vertex_map);
 
         auto hc_explorer = make_horizontal_cut_explorer(tree, altitudes);
-        auto &num_regions_cuts = hc_explorer.num_regions_cuts();
-        auto last_cut = std::upper_bound(num_regions_cuts.begin(), num_regions_cuts.end(), (index_t)max_regions);
-
-        index_t num_cuts = std::distance(num_regions_cuts.begin(), last_cut);
-
-        array_1d<double> scores = xt::empty<double>({num_cuts});
-        array_1d<index_t> num_regions = xt::empty<index_t>({num_cuts});
-        std::copy(num_regions_cuts.begin(), num_regions_cuts.begin() + num_cuts, num_regions.begin());
-
-        for (index_t i = 0; i < num_cuts; i++) {
-            auto hc = hc_explorer.horizontal_cut_from_index(i);
-            scores(i) = partition_scorer.score(xt::view(card_intersection, xt::keep(hc.nodes), xt::all()));
-        }
-
-        size_t num_regions_ground_truth = xt::count_nonzero(xt::view(card_intersection, root(tree), xt::all()))();;
-
-        return hg::fragmentation_curve<>{std::move(num_regions),
-                                         std::move(scores),
-                                         num_regions_ground_truth};
+        return fragmentation_curve_internal::horizontal_cut_fragmentation_curve(
+                tree, hc_explorer, ground_truth, partition_scorer, vertex_map, max_regions);
     };
 
 };
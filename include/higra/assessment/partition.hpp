@@ -11,8 +11,13 @@
 #pragma once
 
 #include "../structure/array.hpp"
+#include <algorithm>
+#include <numeric>
+#include <type_traits>
+#include <utility>
 #include <vector>
 #include <xtensor/xview.hpp>
+#include <xtensor/xadapt.hpp>
 
 namespace hg {
 
@@ -60,7 +65,353 @@ namespace hg {
         return result;
     }
 
+    /**
+     * Row of a sparse contingency table: the non empty intersections between a candidate region and the ground truth
+     * regions (see sparse_card_intersection).
+     *
+     * @tparam value_t type of the cardinals
+     */
+    template<typename value_t>
+    struct sparse_card_intersection_row {
+        // labels of the ground truth regions intersected by the candidate region (increasing order)
+        const index_t *labels;
+        // cardinal of each intersection
+        const value_t *cards;
+        // number of non empty intersections
+        size_t size;
+    };
+
+    /**
+     * Sparse contingency table between a candidate partition and a ground truth partition: only the non empty
+     * intersections between the regions of the two partitions are stored (compressed row layout).
+     *
+     * Memory usage is thus proportional to the number of non empty intersections instead of the product of the
+     * numbers of regions of the two partitions (see card_intersections for the dense equivalent).
+     *
+     * @tparam value_t type of the cardinals
+     */
+    template<typename value_t=index_t>
+    struct sparse_card_intersection {
+        using value_type = value_t;
+
+        sparse_card_intersection(array_1d<index_t> &&row_begin,
+                                 array_1d<index_t> &&labels,
+                                 array_1d<value_t> &&cards,
+                                 array_1d<value_t> &&row_cards,
+                                 array_1d<value_t> &&column_cards) :
+                m_row_begin(std::move(row_begin)),
+                m_labels(std::move(labels)),
+                m_cards(std::move(cards)),
+                m_row_cards(std::move(row_cards)),
+                m_column_cards(std::move(column_cards)) {
+        }
+
+        /**
+         * Number of candidate regions
+         */
+        size_t num_rows() const {
+            return m_row_cards.size();
+        }
+
+        /**
+         * Number of ground truth regions
+         */
+        size_t num_columns() const {
+            return m_column_cards.size();
+        }
+
+        /**
+         * Number of non empty intersections
+         */
+        size_t num_non_zeros() const {
+            return m_labels.size();
+        }
+
+        /**
+         * Non empty intersections of the i-th candidate region
+         */
+        auto row(index_t i) const {
+            return sparse_card_intersection_row<value_t>{&m_labels(m_row_begin(i)),
+                                                         &m_cards(m_row_begin(i)),
+                                                         (size_t) (m_row_begin(i + 1) - m_row_begin(i))};
+        }
+
+        /**
+         * Cardinal of each candidate region
+         */
+        const auto &row_cards() const {
+            return m_row_cards;
+        }
+
+        /**
+         * Cardinal of each ground truth region
+         */
+        const auto &column_cards() const {
+            return m_column_cards;
+        }
+
+        /**
+         * Dense contingency table (see card_intersections)
+         */
+        auto to_dense() const {
+            array_2d<value_t> result({num_rows(), num_columns()}, 0);
+            for (index_t i = 0; i < (index_t) num_rows(); i++) {
+                for (index_t k = m_row_begin(i); k < m_row_begin(i + 1); k++) {
+                    result(i, m_labels(k)) = m_cards(k);
+                }
+            }
+            return result;
+        }
+
+    private:
+        array_1d<index_t> m_row_begin;
+        array_1d<index_t> m_labels;
+        array_1d<value_t> m_cards;
+        array_1d<value_t> m_row_cards;
+        array_1d<value_t> m_column_cards;
+    };
+
+    namespace partition_internal {
+
+        /**
+         * Accumulates the intersections of a region with the ground truth regions in a dense buffer with one
+         * element per ground truth region: only the elements touched since the last call to finalize are visited.
+         */
+        template<typename value_t>
+        struct card_intersection_accumulator {
+
+            explicit card_intersection_accumulator(size_t num_columns) : m_cards(num_columns, 0) {
+            }
+
+            void add(index_t label, value_t card) {
+                if (m_cards[label] == 0) {
+                    m_labels.push_back(label);
+                }
+                m_cards[label] += card;
+            }
+
+            /**
+             * Append the accumulated intersections (by increasing labels) to the given vectors and reset the
+             * accumulator.
+             *
+             * @return the sum of the accumulated cardinals
+             */
+            value_t finalize(std::vector<index_t> &labels, std::vector<value_t> &cards) {
+                std::sort(m_labels.begin(), m_labels.end());
+                value_t total = 0;
+                for (auto l: m_labels) {
+                    labels.push_back(l);
+                    cards.push_back(m_cards[l]);
+                    total += m_cards[l];
+                    m_cards[l] = 0;
+                }
+                m_labels.clear();
+                return total;
+            }
+
+        private:
+            std::vector<value_t> m_cards;
+            std::vector<index_t> m_labels;
+        };
+
+        template<typename value_t, typename T1, typename T2>
+        auto make_sparse_card_intersection(const T1 &candidate,
+                                           const T2 &ground_truth,
+                                           size_t num_regions_candidate,
+                                           size_t num_regions_ground_truth) {
+            const index_t num_elements = candidate.size();
+
+            // ground truth labels grouped by candidate region (counting sort)
+            array_1d<index_t> group_begin({num_regions_candidate + 1}, 0);
+            for (index_t i = 0; i < num_elements; i++) {
+                group_begin(candidate(i) + 1)++;
+            }
+            std::partial_sum(group_begin.begin(), group_begin.end(), group_begin.begin());
+            std::vector<index_t> position(group_begin.begin(), group_begin.end() - 1);
+            array_1d<index_t> grouped_ground_truth = array_1d<index_t>::from_shape({(size_t) num_elements});
+            for (index_t i = 0; i < num_elements; i++) {
+                grouped_ground_truth(position[candidate(i)]++) = ground_truth(i);
+            }
+
+            card_intersection_accumulator<value_t> accumulator(num_regions_ground_truth);
+            std::vector<index_t> labels;
+            std::vector<value_t> cards;
+            array_1d<index_t> row_begin = array_1d<index_t>::from_shape({num_regions_candidate + 1});
+            array_1d<value_t> row_cards = array_1d<value_t>::from_shape({num_regions_candidate});
+            array_1d<value_t> column_cards({num_regions_ground_truth}, 0);
+            row_begin(0) = 0;
+            for (index_t r = 0; r < (index_t) num_regions_candidate; r++) {
+                for (index_t k = group_begin(r); k < group_begin(r + 1); k++) {
+                    accumulator.add(grouped_ground_truth(k), 1);
+                }
+                auto first = labels.size();
+                row_cards(r) = accumulator.finalize(labels, cards);
+                for (auto k = first; k < labels.size(); k++) {
+                    column_cards(labels[k]) += cards[k];
+                }
+                row_begin(r + 1) = labels.size();
+            }
+
+            return sparse_card_intersection<value_t>(std::move(row_begin),
+                                                     xt::adapt(labels, {labels.size()}),
+                                                     xt::adapt(cards, {cards.size()}),
+                                                     std::move(row_cards),
+                                                     std::move(column_cards));
+        }
+
+        template<typename... Ts>
+        struct make_void {
+            using type = void;
+        };
+
+        /**
+         * True if the partition scorer scorer_t can score the rows of a sparse contingency table (see the partition
+         * scorers below), false if it can only score dense contingency tables.
+         */
+        template<typename scorer_t, typename = void>
+        struct has_score_row : std::false_type {
+        };
+
+        template<typename scorer_t>
+        struct has_score_row<scorer_t, typename make_void<decltype(std::declval<const scorer_t &>().score_row(
+                std::declval<const sparse_card_intersection_row<index_t> &>(),
+                0.0,
+                std::declval<const array_1d<double> &>()))>::type> : std::true_type {
+        };
+
+        /**
+         * Score of a partition from its sparse contingency table: sum of the row scores of the given scorer
+         * normalized by the number of elements.
+         */
+        template<typename scorer_t, typename value_t>
+        double score_sparse(const scorer_t &scorer, const sparse_card_intersection<value_t> &card_intersection) {
+            double score = 0;
+            double total = 0;
+            const auto &column_cards = card_intersection.column_cards();
+            for (index_t i = 0; i < (index_t) card_intersection.num_rows(); i++) {
+                double row_card = card_intersection.row_cards()(i);
+                score += scorer.score_row(card_intersection.row(i), row_card, column_cards);
+                total += row_card;
+            }
+            return score / total;
+        }
+
+        template<typename scorer_t, typename value_t>
+        double score_card_intersection(const scorer_t &scorer,
+                                       const sparse_card_intersection<value_t> &card_intersection,
+                                       std::true_type) {
+            return score_sparse(scorer, card_intersection);
+        }
+
+        template<typename scorer_t, typename value_t>
+        double score_card_intersection(const scorer_t &scorer,
+                                       const sparse_card_intersection<value_t> &card_intersection,
+                                       std::false_type) {
+            array_2d<double> dense_card_intersection = card_intersection.to_dense();
+            return scorer.score(dense_card_intersection);
+        }
+
+        /**
+         * Score of a partition from its sparse contingency table: the table is scored row by row if the scorer
+         * has a score_row function, and it is converted to a dense table otherwise.
+         */
+        template<typename scorer_t, typename value_t>
+        double score_card_intersection(const scorer_t &scorer,
+                                       const sparse_card_intersection<value_t> &card_intersection) {
+            return score_card_intersection(scorer, card_intersection, has_score_row<scorer_t>());
+        }
+
+        /**
+         * Score of a partition from its dense contingency table.
+         */
+        template<typename scorer_t, typename T>
+        double score_card_intersection(const scorer_t &scorer, const T &card_intersection) {
+            return scorer.score(card_intersection);
+        }
+    }
+
+    /**
+     * Sparse equivalent of card_intersections: computes the sparse contingency table between the candidate partition
+     * and each ground truth partition (see sparse_card_intersection).
+     *
+     * @tparam value_type type of the cardinals
+     * @param xcandidate candidate labelisation
+     * @param xground_truths a ground truth labelisation with the same shape as the candidate, or a stack of ground
+     * truth labelisations (first dimension)
+     * @return a vector of sparse_card_intersection
+     */
+    template<typename value_type=index_t, typename T1, typename T2>
+    auto sparse_card_intersections(const xt::xexpression<T1> &xcandidate,
+                                   const xt::xexpression<T2> &xground_truths) {
+        auto &candidate = xcandidate.derived_cast();
+        auto &ground_truths = xground_truths.derived_cast();
+
+        hg_assert_integral_value_type(candidate);
+        hg_assert_integral_value_type(ground_truths);
+
+        std::vector<sparse_card_intersection<value_type>> result;
+        size_t num_regions_candidate = xt::amax(candidate)() + 1;
+        const auto &cf = xt::flatten(candidate);
+
+        auto compute = [&cf, &candidate, &result, num_regions_candidate](const auto &ground_truth) {
+            hg_assert_same_shape(candidate, ground_truth);
+            const auto &gtf = xt::flatten(ground_truth);
+            size_t num_regions_ground_truth = xt::amax(gtf)() + 1;
+            result.push_back(partition_internal::make_sparse_card_intersection<value_type>(
+                    cf, gtf, num_regions_candidate, num_regions_ground_truth));
+        };
+
+        if (xt::same_shape(candidate.shape(), ground_truths.shape())) {
+            compute(ground_truths);
+        } else {
+            for (index_t i = 0; i < (index_t) ground_truths.shape()[0]; i++) {
+                compute(xt::view(ground_truths, i));
+            }
+        }
+
+        return result;
+    }
+
+    /*
+     * Partition scorers: the score of a candidate partition is computed from its contingency table with the ground
+     * truth partition, either dense (score of a 2d array), or sparse (score of a sparse_card_intersection).
+     *
+     * The score of a partition is the sum of the scores of its regions (rows of the contingency table, see score_row)
+     * normalized by the number of elements.
+     *
+     * A user defined scorer must provide a function score(card_intersection) on dense contingency tables (2d arrays
+     * of doubles). It may also provide a function score_row(row, row_card, column_cards) with the same contract as
+     * the scorers below: sparse contingency tables and hierarchies are then scored row by row (see
+     * partition_internal::has_score_row), otherwise dense contingency tables are computed and given to score.
+     * Scorers are always called on the instance given to the assessment functions.
+     */
+
     struct scorer_partition_BCE {
+
+        /**
+         * Score of a candidate region, not normalized
+         *
+         * @param row non empty intersections of the region with the ground truth regions
+         * @param row_card cardinal of the region
+         * @param column_cards cardinal of each ground truth region
+         */
+        template<typename value_t, typename T>
+        static
+        double score_row(const sparse_card_intersection_row<value_t> &row, double row_card, const T &column_cards) {
+            double score = 0;
+            for (size_t k = 0; k < row.size; k++) {
+                double card = row.cards[k];
+                score += card * (std::min)(card / column_cards[row.labels[k]], card / row_card);
+            }
+            return score;
+        }
+
+        template<typename value_t>
+        static
+        auto score(const sparse_card_intersection<value_t> &card_intersection) {
+            return partition_internal::score_sparse(scorer_partition_BCE(), card_intersection);
+        }
+
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
@@ -77,6 +428,30 @@ namespace hg {
     };
 
     struct scorer_partition_DHamming {
+
+        /**
+         * Score of a candidate region, not normalized
+         *
+         * @param row non empty intersections of the region with the ground truth regions
+         * @param row_card cardinal of the region
+         * @param column_cards cardinal of each ground truth region
+         */
+        template<typename value_t, typename T>
+        static
+        double score_row(const sparse_card_intersection_row<value_t> &row, double, const T &) {
+            double score = 0;
+            for (size_t k = 0; k < row.size; k++) {
+                score = (std::max)(score, (double) row.cards[k]);
+            }
+            return score;
+        }
+
+        template<typename value_t>
+        static
+        auto score(const sparse_card_intersection<value_t> &card_intersection) {
+            return partition_internal::score_sparse(scorer_partition_DHamming(), card_intersection);
+        }
+
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
@@ -87,6 +462,31 @@ namespace hg {
     };
 
     struct scorer_partition_DCovering {
+
+        /**
+         * Score of a candidate region, not normalized
+         *
+         * @param row non empty intersections of the region with the ground truth regions
+         * @param row_card cardinal of the region
+         * @param column_cards cardinal of each ground truth region
+         */
+        template<typename value_t, typename T>
+        static
+        double score_row(const sparse_card_intersection_row<value_t> &row, double row_card, const T &column_cards) {
+            double score = 0;
+            for (size_t k = 0; k < row.size; k++) {
+                double card = row.cards[k];
+                score = (std::max)(score, card / (row_card + column_cards[row.labels[k]] - card));
+            }
+            return score * row_card;
+        }
+
+        template<typename value_t>
+        static
+        auto score(const sparse_card_intersection<value_t> &card_intersection) {
+            return partition_internal::score_sparse(scorer_partition_DCovering(), card_intersection);
+        }
+
         template<typename T>
         static
         auto score(const xt::xexpression<T> &xcard_intersection) {
@@ -106,7 +506,7 @@ namespace hg {
     auto assess_partition(const std::vector<T> &card_intersections, const scorer_t &scorer) {
         double score = 0;
         for (const auto &card_intersection: card_intersections) {
-            score += scorer.score(card_intersection);
+            score += partition_internal::score_card_intersection(scorer, card_intersection);
         }
         return score / card_intersections.size();
     }
@@ -115,7 +515,7 @@ namespace hg {
     auto assess_partition(const xt::xexpression<T1> &xcandidate,
                           const xt::xexpression<T2> &xground_truths,
                           const scorer_t &scorer) {
-        auto card_intersections = hg::card_intersections<double>(xcandidate, xground_truths);
+        auto card_intersections = hg::sparse_card_intersections<index_t>(xcandidate, xground_truths);
         return assess_partition(card_intersections, scorer);
     }
 
@@ -15,6 +15,8 @@
 #include "xtensor/xview.hpp"
 #include "xtensor/xindex_view.hpp"
 #include "xtensor/xnoalias.hpp"
+#include <algorithm>
+#include <vector>
 
 namespace hg {
 
@@ -76,12 +78,18 @@ namespace hg {
         auto &parent = tree.parents();
         array_1d<double> volume = xt::empty<double>({tree.num_vertices()});
         xt::view(volume, xt::range(0, num_leaves(tree))) = 0;
-        for (auto i: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-            volume(i) = std::fabs(node_altitude(i) - node_altitude(parent(i))) * node_area(i);
-            for (auto c: children_iterator(i, tree)) {
-                volume(i) += volume(c);
+        tree_internal::schedule_leaves_to_root(tree, [&](auto first, auto last) {
+            for (; first != last; ++first) {
+                auto i = *first;
+                if (is_leaf(i, tree)) {
+                    continue;
+                }
+                volume(i) = std::fabs(node_altitude(i) - node_altitude(parent(i))) * node_area(i);
+                for (auto c: children_iterator(i, tree)) {
+                    volume(i) += volume(c);
+                }
             }
-        }
+        });
         return volume;
     }
 
@@ -96,9 +104,14 @@ namespace hg {
     auto attribute_depth(const tree_t &tree) {
         array_1d<index_t> depth = xt::empty<index_t>({tree.num_vertices()});
         depth(tree.root()) = 0;
-        for (auto i: root_to_leaves_iterator(tree, leaves_it::include, root_it::exclude)) {
-            depth(i) = depth(parent(i, tree)) + 1;
-        }
+        tree_internal::schedule_root_to_leaves(tree, [&](auto first, auto last) {
+            for (; first != last; ++first) {
+                auto i = *first;
+                if (i != tree.root()) {
+                    depth(i) = depth(parent(i, tree)) + 1;
+                }
+            }
+        });
         return depth;
     };
 
@@ -134,41 +147,53 @@ namespace hg {
             auto min_depth = xt::empty_like(altitudes);
             xt::noalias(xt::view(min_depth, xt::range(0, num_leaves(tree)))) =
                     xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                min_depth(n) = (std::numeric_limits<value_type>::max)();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (min_depth(c) < min_depth(n)) {
-                            min_depth(n) = min_depth(c);
+            tree_internal::schedule_leaves_to_root(tree, [&](auto first, auto last) {
+                for (; first != last; ++first) {
+                    auto n = *first;
+                    if (is_leaf(n, tree)) {
+                        continue;
+                    }
+                    min_depth(n) = (std::numeric_limits<value_type>::max)();
+                    bool flag = true;
+                    for (auto c: children_iterator(n, tree)) {
+                        if (!is_leaf(c, tree)) {
+                            flag = false;
+                            if (min_depth(c) < min_depth(n)) {
+                                min_depth(n) = min_depth(c);
+                            }
                         }
                     }
+                    if (flag) {
+                        min_depth(n) = altitudes(n);
+                    }
                 }
-                if (flag) {
-                    min_depth(n) = altitudes(n);
-                }
-            }
+            });
             return xt::eval(xt::index_view(altitudes, tree.parents()) - min_depth);
         } else {
             auto max_depth = xt::empty_like(altitudes);
             xt::noalias(xt::view(max_depth, xt::range(0, num_leaves(tree)))) =
                     xt::view(xt::index_view(altitudes, tree.parents()), xt::range(0, num_leaves(tree)));
-            for (auto n: leaves_to_root_iterator(tree, leaves_it::exclude)) {
-                max_depth(n) = std::numeric_limits<value_type>::lowest();
-                bool flag = true;
-                for (auto c: children_iterator(n, tree)) {
-                    if (!is_leaf(c, tree)) {
-                        flag = false;
-                        if (max_depth(c) > max_depth(n)) {
-                            max_depth(n) = max_depth(c);
+            tree_internal::schedule_leaves_to_root(tree, [&](auto first, auto last) {
+                for (; first != last; ++first) {
+                    auto n = *first;
+                    if (is_leaf(n, tree)) {
+                        continue;
+                    }
+                    max_depth(n) = std::numeric_limits<value_type>::lowest();
+                    bool flag = true;
+                    for (auto c: children_iterator(n, tree)) {
+                        if (!is_leaf(c, tree)) {
+                            flag = false;
+                            if (max_depth(c) > max_depth(n)) {
+                                max_depth(n) = max_depth(c);
+                            }
                         }
                     }
+                    if (flag) {
+                        max_depth(n) = altitudes(n);
+                    }
                 }
-                if (flag) {
-                    max_depth(n) = altitudes(n);
-                }
-            }
+            });
             return xt::eval(max_depth - xt::index_view(altitudes, tree.parents()));
         }
     };
@@ -561,4 +586,295 @@ namespace hg {
         return res;
     }
 
+    /**
+     * Attributes that can be computed together by compute_tree_attributes.
+     */
+    enum class tree_attribute {
+        area,
+        volume,
+        depth,
+        height,
+        extrema,
+        dynamics,
+        topological_height
+    };
+
+    /**
+     * Result of compute_tree_attributes: the arrays of the attributes that were not requested are empty.
+     *
+     * @tparam area_t value type of the area
+     * @tparam altitude_t value type of the altitudes
+     */
+    template<typename area_t, typename altitude_t>
+    struct fused_tree_attributes {
+        array_1d<area_t> area;
+        array_1d<double> volume;
+        array_1d<index_t> depth;
+        array_1d<altitude_t> height;
+        array_1d<bool> extrema;
+        array_1d<altitude_t> dynamics;
+        array_1d<index_t> topological_height;
+    };
+
+    /**
+     * Compute several attributes of a tree at once.
+     *
+     * The requested attributes and their dependencies (area for volume, height and extrema for dynamics) are
+     * computed together during a single leaves to root traversal of the tree followed, if depth or dynamics is
+     * requested, by a single root to leaves traversal: the children of each node are thus read only once for all
+     * the attributes. Independent subtrees are processed in parallel on large trees (see
+     * tree_internal::schedule_leaves_to_root).
+     *
+     * The results are equal to the ones of the corresponding functions attribute_area, attribute_volume,
+     * attribute_depth, attribute_height, attribute_extrema, attribute_dynamics, and to the topological height (the
+     * number of edges on the longest path from a node to a leaf).
+     *
+     * The altitudes are only used (and can thus be empty otherwise) if volume, height, extrema or dynamics is
+     * requested.
+     *
+     * @tparam tree_t tree type
+     * @tparam T1 xexpression derived type of xleaf_area
+     * @tparam T2 xexpression derived type of xaltitudes
+     * @param tree input tree
+     * @param attributes requested attributes
+     * @param xleaf_area area of the leaves of the input tree
+     * @param xaltitudes altitude of the nodes of the input tree
+     * @param increasing_altitudes must be true if altitude is increasing, false if it is decreasing
+     * @return a fused_tree_attributes holding the requested attributes
+     */
+    template<typename tree_t, typename T1, typename T2>
+    auto compute_tree_attributes(const tree_t &tree,
+                                 const std::vector<tree_attribute> &attributes,
+                                 const xt::xexpression<T1> &xleaf_area,
+                                 const xt::xexpression<T2> &xaltitudes,
+                                 bool increasing_altitudes = true) {
+        auto &leaf_area = xleaf_area.derived_cast();
+        auto &altitudes = xaltitudes.derived_cast();
+        using area_t = typename T1::value_type;
+        using altitude_t = typename T2::value_type;
+
+        auto requested = [&attributes](tree_attribute a) {
+            return std::find(attributes.begin(), attributes.end(), a) != attributes.end();
+        };
+        const bool want_area = requested(tree_attribute::area);
+        const bool want_volume = requested(tree_attribute::volume);
+        const bool want_depth = requested(tree_attribute::depth);
+        const bool want_height = requested(tree_attribute::height);
+        const bool want_extrema = requested(tree_attribute::extrema);
+        const bool want_dynamics = requested(tree_attribute::dynamics);
+        const bool want_topological_height = requested(tree_attribute::topological_height);
+
+        // dependencies
+        const bool need_area = want_area || want_volume;
+        const bool need_height = want_height || want_dynamics;
+        const bool need_extrema = want_extrema || want_dynamics;
+        const bool need_altitudes = want_volume || need_height || need_extrema;
+
+        if (need_area) {
+            hg_assert_leaf_weights(tree, leaf_area);
+            hg_assert_1d_array(leaf_area);
+        }
+        if (need_altitudes) {
+            hg_assert_node_weights(tree, altitudes);
+            hg_assert_1d_array(altitudes);
+        }
+
+        tree.compute_children();
+        const size_t num_v = num_vertices(tree);
+        const index_t root_node = root(tree);
+
+        fused_tree_attributes<area_t, altitude_t> res;
+        auto &area = res.area;
+        auto &volume = res.volume;
+        auto &depth = res.depth;
+        auto &height = res.height;
+        auto &extrema = res.extrema;
+        auto &dynamics = res.dynamics;
+        auto &topological_height = res.topological_height;
+
+        // deepest non leaf altitude in the subtree of each node and child leading to it
+        array_1d<altitude_t> min_depth;
+        array_1d<index_t> ref_son;
+        // true if all the non leaf nodes of the subtree of a node have the same altitude
+        array_1d<bool> flat;
+
+        if (need_area) {
+            area = array_1d<area_t>::from_shape({num_v});
+        }
+        if (want_volume) {
+            volume = array_1d<double>::from_shape({num_v});
+        }
+        if (need_height) {
+            height = array_1d<altitude_t>::from_shape({num_v});
+            min_depth = array_1d<altitude_t>::from_shape({num_v});
+            ref_son = array_1d<index_t>::from_shape({num_v});
+        }
+        if (need_extrema) {
+            extrema = array_1d<bool>::from_shape({num_v});
+            flat = array_1d<bool>::from_shape({num_v});
+        }
+        if (want_topological_height) {
+            topological_height = array_1d<index_t>::from_shape({num_v});
+        }
+
+        const altitude_t worst_depth = increasing_altitudes ?
+                                       (std::numeric_limits<altitude_t>::max)() :
+                                       std::numeric_limits<altitude_t>::lowest();
+        auto deeper = [increasing_altitudes](altitude_t a, altitude_t b) {
+            return increasing_altitudes ? a < b : a > b;
+        };
+
+        if (need_area || want_volume || need_height || need_extrema || want_topological_height) {
+            tree_internal::schedule_leaves_to_root(tree, [&](auto first, auto last) {
+                for (; first != last; ++first) {
+                    index_t n = *first;
+                    if (is_leaf(n, tree)) {
+                        if (need_area) {
+                            area(n) = leaf_area(n);
+                        }
+                        if (want_volume) {
+                            volume(n) = 0;
+                        }
+                        if (need_height) {
+                            height(n) = 0;
+                        }
+                        if (need_extrema) {
+                            extrema(n) = false;
+                        }
+                        if (want_topological_height) {
+                            topological_height(n) = 0;
+                        }
+                        continue;
+                    }
+
+                    area_t n_area = 0;
+                    double n_volume = 0;
+                    index_t n_topological_height = 0;
+                    altitude_t n_min_depth = worst_depth;
+                    index_t n_ref_son = invalid_index;
+                    bool has_non_leaf_child = false;
+                    bool n_flat = true;
+                    for (auto c: children_iterator(n, tree)) {
+                        if (need_area) {
+                            n_area += area(c);
+                        }
+                        if (want_volume) {
+                            n_volume += volume(c);
+                        }
+                        if (want_topological_height) {
+                            n_topological_height = (std::max)(n_topological_height, topological_height(c));
+                        }
+                        if (!is_leaf(c, tree)) {
+                            has_non_leaf_child = true;
+                            if (need_height && deeper(min_depth(c), n_min_depth)) {
+                                n_min_depth = min_depth(c);
+                                n_ref_son = c;
+                            }
+                            if (need_extrema) {
+                                n_flat = n_flat && flat(c) && altitudes(c) == altitudes(n);
+                            }
+                        }
+                    }
+
+                    const index_t p = parent(n, tree);
+                    if (need_area) {
+                        area(n) = n_area;
+                    }
+                    if (want_volume) {
+                        volume(n) = std::fabs((double) altitudes(n) - (double) altitudes(p)) * n_area + n_volume;
+                    }
+                    if (need_height) {
+                        if (!has_non_leaf_child) {
+                            n_min_depth = altitudes(n);
+                        }
+                        min_depth(n) = n_min_depth;
+                        ref_son(n) = n_ref_son;
+                        height(n) = increasing_altitudes ?
+                                    altitudes(p) - n_min_depth :
+                                    n_min_depth - altitudes(p);
+                    }
+                    if (need_extrema) {
+                        flat(n) = n_flat;
+                        extrema(n) = n_flat && (n == root_node || altitudes(n) != altitudes(p));
+                    }
+                    if (want_topological_height) {
+                        topological_height(n) = n_topological_height + 1;
+                    }
+                }
+            });
+        }
+
+        if (want_depth || want_dynamics) {
+            // closest ancestor of each non leaf node which is an extremum
+            array_1d<index_t> extremum;
+            if (want_dynamics) {
+                dynamics = array_1d<altitude_t>::from_shape({num_v});
+                extremum = array_1d<index_t>::from_shape({num_v});
+            }
+            if (want_depth) {
+                depth = array_1d<index_t>::from_shape({num_v});
+            }
+            tree_internal::schedule_root_to_leaves(tree, [&](auto first, auto last) {
+                for (; first != last; ++first) {
+                    index_t n = *first;
+                    if (n == root_node) {
+                        if (want_depth) {
+                            depth(n) = 0;
+                        }
+                        if (want_dynamics) {
+                            dynamics(n) = height(n);
+                            extremum(n) = extrema(n) ? n : invalid_index;
+                        }
+                        continue;
+                    }
+                    const index_t p = parent(n, tree);
+                    if (want_depth) {
+                        depth(n) = depth(p) + 1;
+                    }
+                    if (want_dynamics) {
+                        if (is_leaf(n, tree)) {
+                            dynamics(n) = (extremum(p) != invalid_index) ? dynamics(extremum(p)) : 0;
+                        } else {
+                            dynamics(n) = (n == ref_son(p)) ? dynamics(p) : height(n);
+                            extremum(n) = extrema(n) ? n : extremum(p);
+                        }
+                    }
+                }
+            });
+        }
+
+        // intermediate results that were not requested
+        if (!want_area) {
+            area = array_1d<area_t>();
+        }
+        if (!want_height) {
+            height = array_1d<altitude_t>();
+        }
+        if (!want_extrema) {
+            extrema = array_1d<bool>();
+        }
+        return res;
+    }
+
+    /**
+     * Compute several attributes of a tree at once, see compute_tree_attributes above: the area of the leaves is
+     * equal to 1.
+     *
+     * @tparam tree_t tree type
+     * @tparam T xexpression derived type of xaltitudes
+     * @param tree input tree
+     * @param attributes requested attributes
+     * @param xaltitudes altitude of the nodes of the input tree
+     * @param increasing_altitudes must be true if altitude is increasing, false if it is decreasing
+     * @return a fused_tree_attributes holding the requested attributes
+     */
+    template<typename tree_t, typename T>
+    auto compute_tree_attributes(const tree_t &tree,
+                                 const std::vector<tree_attribute> &attributes,
+                                 const xt::xexpression<T> &xaltitudes,
+                                 bool increasing_altitudes = true) {
+        return compute_tree_attributes(tree, attributes, xt::ones<index_t>({num_leaves(tree)}), xaltitudes,
+                                       increasing_altitudes);
+    }
+
 }
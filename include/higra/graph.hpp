@@ -11,6 +11,7 @@
 
 #include "utils.hpp"
 #include "structure/undirected_graph.hpp"
+#include "structure/csr_graph.hpp"
 #include "structure/regular_graph.hpp"
 #include "structure/tree_graph.hpp"
 
@@ -37,7 +38,7 @@ namespace hg {
      * @return 1d expression with num_edges(t) element
      */
     template<typename graph_t>
-    auto sources(const graph_t &t) {
+    decltype(auto) sources(const graph_t &t) {
         return t.sources();
     }
 
@@ -62,7 +63,7 @@ namespace hg {
      * @return 1d expression with num_edges(t) element
      */
     template<typename graph_t>
-    auto targets(const graph_t &t) {
+    decltype(auto) targets(const graph_t &t) {
         return t.targets();
     }
 
@@ -296,6 +297,14 @@ namespace hg {
             size_t estimate_number_of_edge_per_vertex(const ugraph &) { return 0; }
         };
 
+        template<>
+        struct graph_size_estimator<csr_graph> {
+
+            size_t estimate_edge_number(const csr_graph &g) { return num_edges(g); }
+
+            size_t estimate_number_of_edge_per_vertex(const csr_graph &) { return 0; }
+        };
+
         template<>
         struct graph_size_estimator<regular_grid_graph_1d> {
 
@@ -13,35 +13,19 @@
 #include "common.hpp"
 #include "../graph.hpp"
 #include "hierarchy_core.hpp"
-#include "../structure/fibonacci_heap.hpp"
+#include "../structure/indexed_heap.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
 #include <string>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <utility>
 
 namespace hg {
 
     namespace binary_partition_tree_internal {
 
-        template<typename T>
-        struct heap_element {
-            using self_t = heap_element<T>;
-            T value;
-            index_t index;
-
-            bool operator==(const self_t &rhs) const { return value == rhs.value; }
-
-            bool operator!=(const self_t &rhs) const { return value != rhs.value; }
-
-            bool operator<(const self_t &rhs) const { return value < rhs.value; }
-
-            bool operator>(const self_t &rhs) const { return value > rhs.value; }
-
-            bool operator<=(const self_t &rhs) const { return value <= rhs.value; }
-
-            bool operator>=(const self_t &rhs) const { return value >= rhs.value; }
-
-        };
-
         /**
          * This structure is provided by the binary partition algorithm when two nodes are merged in order to
          * compute the edge weight between the newly created node and one of its neighbouring node.
@@ -434,6 +418,20 @@ namespace hg {
 
     }
 
+    /**
+     * Algorithms available to compute a binary partition tree with a linkage rule:
+     *
+     *  - heap: the edge of minimal weight is searched in a global priority queue (default,
+     *      see binary_partition_tree)
+     *  - rnn: reciprocal nearest neighbours are merged by rounds (parallel when compiled with TBB), only valid
+     *      for reducible linkage rules and graphs without parallel edges (see
+     *      binary_partition_tree_reciprocal_nearest_neighbours)
+     */
+    enum class bpt_engine {
+        heap,
+        rnn
+    };
+
     /**
      * Compute the binary partition tree of the graph.
      *
@@ -478,6 +476,13 @@ namespace hg {
      *
      * Example of weighting function: binary_partition_tree_min_linkage
      *
+     * The priority queue of edges is selected with the heap_policy template parameter:
+     *  - fibonacci_heap_policy: fibonacci heap (default)
+     *  - dary_heap_policy<arity>: array based d-ary heap, usually faster thanks to its cache friendly layout
+     *  - radix_heap_policy: monotone radix heap, only for integral edge weights and reducible linkage rules (the
+     *      weight of a new edge must not be smaller than the weight of the last merged edge)
+     *
+     * @tparam heap_policy
      * @tparam graph_t
      * @tparam weighter
      * @tparam T
@@ -486,11 +491,11 @@ namespace hg {
      * @param weight_function
      * @return a node weighted tree
      */
-    template<typename graph_t, typename weighter, typename T>
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename weighter, typename T>
     auto
     binary_partition_tree(const graph_t &graph, const xt::xexpression<T> &xedge_weights, weighter weight_function) {
         using weight_t = typename T::value_type;
-        using heap_t = fibonacci_heap<binary_partition_tree_internal::heap_element<weight_t> >;
+        using heap_t = typename heap_policy::template heap_t<weight_t>;
 
         auto &edge_weights = xedge_weights.derived_cast();
         hg_assert_edge_weights(graph, edge_weights);
@@ -515,13 +520,12 @@ namespace hg {
         const decltype(new_neighbours) &const_new_neighbours = new_neighbours;
 
         // init heap
-        heap_t heap;
-        array_1d<typename heap_t::value_handle> heap_handles({num_edges(g)}, nullptr);
+        heap_t heap(num_edges(g));
 
         for (auto v: vertex_iterator(graph)) {
             for (auto &e: out_edge_iterator(v, g)) {
                 if (!active(e)) {
-                    heap_handles(e) = heap.push({edge_weights(e), e});
+                    heap.push(e, edge_weights(e));
                     active(e) = true;
                 }
             }
@@ -531,14 +535,10 @@ namespace hg {
         size_t current_num_nodes_tree = num_points;
         while (!heap.empty() && current_num_nodes_tree < num_nodes_tree) {
 
-            auto heap_handle = heap.top();
-            auto min_element = heap_handle->get_value();
-
-            auto fusion_edge_index = min_element.index;
-            auto fusion_edge_weight = min_element.value;
+            auto fusion_edge_index = heap.top();
+            auto fusion_edge_weight = heap.top_value();
 
             heap.pop();
-            heap_handles[fusion_edge_index] = nullptr;
 
             if (active[fusion_edge_index]) {
                 active[fusion_edge_index] = false;
@@ -594,7 +594,7 @@ namespace hg {
                             remove_edge(nn.second_edge_index(), g);
                         }
                         set_edge(nn.first_edge_index(), nn.neighbour_vertex(), new_parent, g);
-                        heap.update(heap_handles[nn.first_edge_index()], {nn.new_edge_weight(), nn.first_edge_index()});
+                        heap.update(nn.first_edge_index(), nn.new_edge_weight());
                         active[nn.first_edge_index()] = true;
                     }
                 }
@@ -603,6 +603,256 @@ namespace hg {
         return make_node_weighted_tree(tree(parents), std::move(levels));
     }
 
+    /**
+     * Compute the binary partition tree of the graph with the reciprocal nearest neighbours algorithm.
+     *
+     * On a graph without parallel edges, this function produces the same hierarchy as binary_partition_tree (up to
+     * the order of merges between equal weight edges) for any reducible linkage rule, i.e. if the distance between a
+     * cluster and the union of two other clusters is never smaller than the smallest of the two distances (this is
+     * the case of the single, complete, average and exponential linkages).
+     *
+     * Instead of maintaining a global priority queue of edges, each cluster stores the list of its neighbours and
+     * its nearest neighbour. At each round, all pairs of reciprocal nearest neighbours (two clusters that are the nearest
+     * neighbour of each other) are merged, and only the nearest neighbours of the clusters whose adjacency was modified
+     * during the round are recomputed. When the library is compiled with TBB, the nearest neighbour searches of a
+     * round are done in parallel.
+     *
+     * Ties are broken with the index of the neighbouring cluster, the result is thus deterministic and does not depend
+     * on the number of threads. With a non reducible linkage (Ward linkage on a non complete graph), the merges
+     * performed may differ from the ones of binary_partition_tree. Tree nodes are numbered in increasing order of
+     * the maximal altitude in their subtree such that the result is always a valid tree.
+     *
+     * The graph must be connected and must not contain parallel edges (an exception is thrown otherwise): the
+     * weighting functions only combine one edge per merged cluster, several edges linking the same pair of clusters
+     * cannot be aggregated consistently. Self loops are ignored.
+     *
+     * The weight_function callback follows the same pattern as in binary_partition_tree except that its first
+     * argument is the input graph (and not the current state of the contracted graph): the edge
+     * first_edge_index() of each new neighbour is the one reused for the new edge (new_edge_index()).
+     *
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function
+     * @return a node weighted tree
+     */
+    template<typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree_reciprocal_nearest_neighbours(const graph_t &graph,
+                                                             const xt::xexpression<T> &xedge_weights,
+                                                             weighter weight_function) {
+        using weight_t = typename T::value_type;
+        using adjacency_t = std::vector<std::pair<index_t, index_t> >; // (neighbour cluster, edge index)
+
+        auto &edge_weights = xedge_weights.derived_cast();
+        hg_assert_edge_weights(graph, edge_weights);
+
+        index_t num_points = num_vertices(graph);
+        index_t num_nodes_tree = num_points * 2 - 1;
+
+        array_1d<weight_t> weights = edge_weights;
+        array_1d<index_t> parents = xt::arange<index_t>(num_nodes_tree);
+        array_1d<weight_t> levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
+
+        // adjacency list of each cluster, sorted by neighbour index
+        std::vector<adjacency_t> adjacency(num_nodes_tree);
+        for (auto v: vertex_iterator(graph)) {
+            auto &adj = adjacency[v];
+            for (auto e: out_edge_iterator(v, graph)) {
+                auto n = target(e, graph);
+                if (n != (index_t) v) {
+                    adj.emplace_back(n, index(e, graph));
+                }
+            }
+            std::sort(adj.begin(), adj.end());
+            hg_assert(std::adjacent_find(adj.begin(), adj.end(), [](const std::pair<index_t, index_t> &a,
+                                                                   const std::pair<index_t, index_t> &b) {
+                return a.first == b.first;
+            }) == adj.end(), "The input graph must not contain parallel edges.");
+        }
+
+        // nearest neighbour of each cluster: (neighbour cluster, edge index)
+        std::vector<std::pair<index_t, index_t> > nearest(num_nodes_tree, {invalid_index, invalid_index});
+        auto find_nearest = [&adjacency, &weights, &nearest](index_t c) {
+            auto &adj = adjacency[c];
+            std::pair<index_t, index_t> best{invalid_index, invalid_index};
+            for (auto &a: adj) {
+                if (best.first == invalid_index || weights(a.second) < weights(best.second)) {
+                    best = a;
+                }
+            }
+            nearest[c] = best;
+        };
+
+        // clusters whose nearest neighbour must be recomputed
+        std::vector<index_t> dirty(num_points);
+        std::iota(dirty.begin(), dirty.end(), 0);
+        array_1d<bool> is_dirty = xt::zeros<bool>({(size_t) num_nodes_tree});
+        std::vector<std::pair<index_t, index_t> > pairs;
+
+        // special structure to store the list of neighbours adjacent to the fused regions.
+        std::vector<binary_partition_tree_internal::new_neighbour<weight_t> > new_neighbours;
+        const decltype(new_neighbours) &const_new_neighbours = new_neighbours;
+
+        index_t new_parent = num_points;
+        while (!dirty.empty()) {
+            parfor(0, dirty.size(), [&dirty, &find_nearest](index_t i) {
+                find_nearest(dirty[i]);
+            });
+
+            // reciprocal pairs involve at least one cluster modified during the previous round
+            pairs.clear();
+            for (auto c: dirty) {
+                is_dirty(c) = true;
+            }
+            for (auto c: dirty) {
+                auto n = nearest[c].first;
+                if (n != invalid_index && nearest[n].first == c && (c < n || !is_dirty(n))) {
+                    pairs.emplace_back(c, nearest[c].second);
+                }
+            }
+            for (auto c: dirty) {
+                is_dirty(c) = false;
+            }
+            dirty.clear();
+
+            for (auto &p: pairs) {
+                auto region1 = p.first;
+                auto region2 = nearest[region1].first;
+                auto fusion_edge_index = p.second;
+
+                parents(region1) = new_parent;
+                parents(region2) = new_parent;
+                levels(new_parent) = weights(fusion_edge_index);
+
+                // merge the sorted adjacency lists of region1 and region2
+                new_neighbours.clear();
+                auto &adj1 = adjacency[region1];
+                auto &adj2 = adjacency[region2];
+                auto it1 = adj1.begin();
+                auto it2 = adj2.begin();
+                while (it1 != adj1.end() || it2 != adj2.end()) {
+                    if (it2 == adj2.end() || (it1 != adj1.end() && it1->first < it2->first)) {
+                        if (it1->first != region2) {
+                            new_neighbours.emplace_back(it1->first, it1->second);
+                        }
+                        it1++;
+                    } else if (it1 == adj1.end() || it2->first < it1->first) {
+                        if (it2->first != region1) {
+                            new_neighbours.emplace_back(it2->first, it2->second);
+                        }
+                        it2++;
+                    } else {
+                        new_neighbours.emplace_back(it1->first, it1->second, it2->second);
+                        it1++;
+                        it2++;
+                    }
+                }
+                adjacency_t().swap(adj1);
+                adjacency_t().swap(adj2);
+
+                auto &new_adj = adjacency[new_parent];
+                if (!new_neighbours.empty()) {
+                    // external callback : compute new edge weights
+                    weight_function(graph, fusion_edge_index, new_parent, region1, region2, const_new_neighbours);
+
+                    new_adj.reserve(new_neighbours.size());
+                    for (auto &nn: new_neighbours) {
+                        auto n = nn.neighbour_vertex();
+                        weights(nn.first_edge_index()) = nn.new_edge_weight();
+                        new_adj.emplace_back(n, nn.first_edge_index());
+
+                        // new_parent is the largest cluster index: the adjacency of n remains sorted
+                        auto &adjn = adjacency[n];
+                        adjn.erase(std::remove_if(adjn.begin(), adjn.end(),
+                                                  [region1, region2](const std::pair<index_t, index_t> &a) {
+                                                      return a.first == region1 || a.first == region2;
+                                                  }), adjn.end());
+                        adjn.emplace_back(new_parent, nn.first_edge_index());
+                        dirty.push_back(n);
+                    }
+                    dirty.push_back(new_parent);
+                }
+                new_parent++;
+            }
+
+            // keep only clusters that have not been merged during the round
+            for (auto &c: dirty) {
+                if (parents(c) != c || is_dirty(c)) {
+                    c = invalid_index;
+                } else {
+                    is_dirty(c) = true;
+                }
+            }
+            dirty.erase(std::remove(dirty.begin(), dirty.end(), invalid_index), dirty.end());
+            for (auto c: dirty) {
+                is_dirty(c) = false;
+            }
+        }
+
+        hg_assert(new_parent == num_nodes_tree, "The input graph must be connected.");
+
+        // renumber internal nodes by increasing order of the maximal altitude in their subtree (identical to levels
+        // for reducible linkages)
+        index_t num_merges = num_points - 1;
+        if (num_merges <= 0) {
+            return make_node_weighted_tree(tree(parents), std::move(levels));
+        }
+        array_1d<weight_t> keys = xt::view(levels, xt::range(num_points, num_nodes_tree));
+        for (index_t i = 0; i < num_merges - 1; i++) {
+            auto p = parents(num_points + i) - num_points;
+            keys(p) = (std::max)(keys(p), keys(i));
+        }
+        array_1d<index_t> order = xt::arange<index_t>(num_merges);
+        std::stable_sort(order.begin(), order.end(), [&keys](index_t i, index_t j) {
+            return keys(i) < keys(j);
+        });
+        array_1d<index_t> rank = xt::empty<index_t>({(size_t) num_merges});
+        for (index_t i = 0; i < num_merges; i++) {
+            rank(order(i)) = i + num_points;
+        }
+
+        array_1d<index_t> final_parents = xt::empty<index_t>({(size_t) num_nodes_tree});
+        array_1d<weight_t> final_levels = xt::zeros<weight_t>({(size_t) num_nodes_tree});
+        for (index_t i = 0; i < num_points; i++) {
+            final_parents(i) = rank(parents(i) - num_points);
+        }
+        for (index_t i = 0; i < num_merges; i++) {
+            auto r = rank(i);
+            final_parents(r) = (i == num_merges - 1) ? r : rank(parents(i + num_points) - num_points);
+            final_levels(r) = levels(i + num_points);
+        }
+        return make_node_weighted_tree(tree(final_parents), std::move(final_levels));
+    }
+
+    /**
+     * Compute the binary partition tree of the graph with the given engine:
+     *
+     *  - bpt_engine::heap: binary_partition_tree
+     *  - bpt_engine::rnn: binary_partition_tree_reciprocal_nearest_neighbours
+     *
+     * @tparam heap_policy priority queue used by the heap engine (see binary_partition_tree)
+     * @tparam graph_t
+     * @tparam weighter
+     * @tparam T
+     * @param graph
+     * @param xedge_weights
+     * @param weight_function
+     * @param engine
+     * @return a node weighted tree
+     */
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename weighter, typename T>
+    auto binary_partition_tree(const graph_t &graph,
+                               const xt::xexpression<T> &xedge_weights,
+                               weighter weight_function,
+                               bpt_engine engine) {
+        if (engine == bpt_engine::rnn) {
+            return binary_partition_tree_reciprocal_nearest_neighbours(graph, xedge_weights, weight_function);
+        }
+        return binary_partition_tree<heap_policy>(graph, xedge_weights, weight_function);
+    }
+
 
     /**
      * Binary partition tree, i.e. the agglomerative clustering, with the  minimum/single linkage rule.
@@ -640,19 +890,24 @@ namespace hg {
      *
      * Regions are then iteratively merged following the above distance (closest first) until a single region remains
      *
+     * @tparam heap_policy priority queue used by the heap engine (see binary_partition_tree)
      * @tparam graph_t
      * @tparam T
      * @param graph
      * @param xedge_weights
+     * @param engine algorithm used to compute the tree (see bpt_engine)
      * @return a node weighted tree
      */
-    template<typename graph_t, typename T>
-    auto binary_partition_tree_complete_linkage(const graph_t &graph, const xt::xexpression<T> &xedge_weights) {
-        return binary_partition_tree(
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename T>
+    auto binary_partition_tree_complete_linkage(const graph_t &graph,
+                                                const xt::xexpression<T> &xedge_weights,
+                                                bpt_engine engine = bpt_engine::heap) {
+        return binary_partition_tree<heap_policy>(
                 graph,
                 xedge_weights,
                 binary_partition_tree_internal::binary_partition_tree_complete_linkage_weighting_functor<T>(
-                        xedge_weights));
+                        xedge_weights),
+                engine);
     }
 
     /**
@@ -669,23 +924,27 @@ namespace hg {
      *
      * Regions are then iteratively merged following the above distance (closest first) until a single region remains
      *
+     * @tparam heap_policy priority queue used by the heap engine (see binary_partition_tree)
      * @tparam graph_t
      * @tparam T
      * @param graph
      * @param xedge_weights
      * @param xedge_weight_weights
+     * @param engine algorithm used to compute the tree (see bpt_engine)
      * @return a node weighted tree
      */
-    template<typename graph_t, typename T>
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename T>
     auto binary_partition_tree_average_linkage(const graph_t &graph,
                                                const xt::xexpression<T> &xedge_weights,
-                                               const xt::xexpression<T> &xedge_weight_weights) {
-        return binary_partition_tree(
+                                               const xt::xexpression<T> &xedge_weight_weights,
+                                               bpt_engine engine = bpt_engine::heap) {
+        return binary_partition_tree<heap_policy>(
                 graph,
                 xedge_weights,
                 binary_partition_tree_internal::binary_partition_tree_average_linkage_weighting_functor<T>(
                         xedge_weights,
-                        xedge_weight_weights));
+                        xedge_weight_weights),
+                engine);
     }
 
     /**
@@ -714,26 +973,30 @@ namespace hg {
      *      Supervised Hierarchical Clustering with Exponential Linkage
      *      Proceedings of the 36th International Conference on Machine Learning, PMLR 97:6973-6983, 2019.
      *
+     * @tparam heap_policy priority queue used by the heap engine (see binary_partition_tree)
      * @tparam graph_t
      * @tparam T
      * @param graph
      * @param xedge_weights
      * @param alpha
      * @param xedge_weight_weights
+     * @param engine algorithm used to compute the tree (see bpt_engine)
      * @return a node weighted tree
      */
-    template<typename graph_t, typename T>
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename T>
     auto binary_partition_tree_exponential_linkage(const graph_t &graph,
                                                const xt::xexpression<T> &xedge_weights,
                                                const typename T::value_type &alpha,
-                                               const xt::xexpression<T> &xedge_weight_weights) {
-        return binary_partition_tree(
+                                               const xt::xexpression<T> &xedge_weight_weights,
+                                               bpt_engine engine = bpt_engine::heap) {
+        return binary_partition_tree<heap_policy>(
                 graph,
                 xedge_weights,
                 binary_partition_tree_internal::binary_partition_tree_exponential_linkage_weighting_functor<T>(
                         xedge_weights,
                         xedge_weight_weights,
-                        alpha));
+                        alpha),
+                engine);
     }
 
     /**
@@ -758,6 +1021,7 @@ namespace hg {
      *      - ``"max"``: the altitude of a node :math:`n` is defined as the maximum of the the Ward distance associated
      *          to each node in the subtree rooted in :math:`n`.
      *
+     * @tparam heap_policy priority queue used by the heap engine (see binary_partition_tree)
      * @tparam graph_t
      * @tparam T1
      * @tparam T2
@@ -765,21 +1029,25 @@ namespace hg {
      * @param xvertex_centroids Centroids of the graph vertices (must be a 2d array)
      * @param xvertex_sizes Size (number of elements) of the graph vertices
      * @param altitude_correction can be ``"none"`` or ``"max"`` (default)
+     * @param engine algorithm used to compute the tree (see bpt_engine), with the ``rnn`` engine the merges may
+     *      differ from the ones of the ``heap`` engine on non complete graphs
      * @return a node weighted tree
      */
-    template<typename graph_t, typename T1, typename T2>
+    template<typename heap_policy = fibonacci_heap_policy, typename graph_t, typename T1, typename T2>
     auto binary_partition_tree_ward_linkage(const graph_t &graph,
                                             const xt::xexpression<T1> &xvertex_centroids,
                                             const xt::xexpression<T2> &xvertex_sizes,
-                                            const std::string &altitude_correction = "max") {
+                                            const std::string &altitude_correction = "max",
+                                            bpt_engine engine = bpt_engine::heap) {
 
         auto f = binary_partition_tree_internal::binary_partition_tree_ward_linkage_weighting_functor<T1, T2>
                 (xvertex_centroids, xvertex_sizes);
 
-        auto res = binary_partition_tree(
+        auto res = binary_partition_tree<heap_policy>(
                 graph,
                 f.get_weights(graph),
-                f);
+                f,
+                engine);
 
         auto &tree = res.tree;
         auto &altitudes = res.altitudes;
@@ -15,6 +15,7 @@
 #include "higra/graph.hpp"
 #include "higra/sorting.hpp"
 #include "xtensor/xadapt.hpp"
+#include "xtensor/xview.hpp"
 
 namespace hg {
     namespace component_tree_internal {
@@ -125,17 +126,214 @@ namespace hg {
             return std::make_pair(std::move(new_parents), std::move(altitudes));
         }
 
-        template<typename graph_t, typename T1, typename T2>
-        auto
-        tree_from_sorted_vertices(const graph_t &graph, const T1 &vertex_weights, const T2 &sorted_vertex_indices) {
-            auto parents = pre_tree_construction(graph, sorted_vertex_indices);
+        /**
+         * Component tree from a pre-parent relation (as constructed by pre_tree_construction)
+         *
+         * Parent relation is modified in-place!
+         *
+         * @tparam T1
+         * @tparam T2
+         * @tparam T3
+         * @param parents a pre-parent relation
+         * @param vertex_weights the node levels associated to the pre-parent relation
+         * @param sorted_vertex_indices the sorted vertex indices
+         * @return a node weighted tree
+         */
+        template<typename T1, typename T2, typename T3>
+        auto tree_from_pre_tree(T1 &parents, const T2 &vertex_weights, const T3 &sorted_vertex_indices) {
             canonize_tree(parents, vertex_weights, sorted_vertex_indices);
             auto res = expand_canonized_parent_relation(parents, vertex_weights, sorted_vertex_indices);
-            array_1d<typename T1::value_type> altitudes = xt::adapt(res.second, {res.second.size()});
+            array_1d<typename T2::value_type> altitudes = xt::adapt(res.second, {res.second.size()});
             return make_node_weighted_tree(
                     tree(xt::adapt(res.first, {res.first.size()}), tree_category::component_tree),
                     std::move(altitudes));
         }
+
+        template<typename graph_t, typename T1, typename T2>
+        auto
+        tree_from_sorted_vertices(const graph_t &graph, const T1 &vertex_weights, const T2 &sorted_vertex_indices) {
+            auto parents = pre_tree_construction(graph, sorted_vertex_indices);
+            return tree_from_pre_tree(parents, vertex_weights, sorted_vertex_indices);
+        }
+
+        /**
+         * Minimum number of vertices for the parallel pre-tree construction to be used by component_tree_max_tree and
+         * component_tree_min_tree.
+         */
+        const index_t parallel_pre_tree_min_size = 1 << 18;
+
+        /**
+         * Number of vertices per slab in the parallel pre-tree construction.
+         */
+        const index_t parallel_pre_tree_slab_size = 1 << 16;
+
+        /**
+         * Merge the two pre-trees containing the adjacent vertices x and y (Wilkinson et al. connect procedure).
+         *
+         * A pre-tree is the component tree of the strict total order processed_before: the parent of a vertex is
+         * processed after it, the root paths of x and y are thus merged as two sorted lists.
+         *
+         * @param parents pre-parent relation, modified in place
+         * @param x a vertex
+         * @param y a vertex adjacent to x
+         * @param processed_before strict total order on the vertices
+         */
+        template<typename T, typename order_t>
+        void connect_pre_trees(T &parents, index_t x, index_t y, const order_t &processed_before) {
+            if (processed_before(y, x)) {
+                std::swap(x, y);
+            }
+            // invariant: x is processed before y
+            while (true) {
+                auto z = parents(x);
+                if (z == y) {
+                    return;
+                }
+                if (z == x) {
+                    parents(x) = y;
+                    return;
+                }
+                if (processed_before(z, y)) {
+                    x = z;
+                } else {
+                    parents(x) = y;
+                    x = y;
+                    y = z;
+                }
+            }
+        }
+
+        /**
+         * Parallel version of pre_tree_construction where the vertices are sorted according to comp (stable sort).
+         *
+         * The vertex set is split into num_slabs ranges of consecutive indices (slabs of rows for a grid graph
+         * in row major order). The pre-tree of the subgraph induced by each slab is computed independently with
+         * the union-find algorithm. The pre-trees are then merged along the edges linking the slabs with a binary
+         * reduction: at level l, the slabs are grouped by blocks of 2^(l + 1) and the two halves of each block are
+         * merged in parallel.
+         *
+         * The result is identical to pre_tree_construction(graph, stable_arg_sort(vertex_weights, comp)).
+         *
+         * @tparam graph_t
+         * @tparam T
+         * @tparam comp_t
+         * @param graph input graph
+         * @param vertex_weights vertex weights of the input graph
+         * @param comp weight comparison function used to sort the vertices
+         * @param num_slabs number of independent slabs
+         * @return pre-parent relation
+         */
+        template<typename graph_t, typename T, typename comp_t>
+        auto parallel_pre_tree_construction(const graph_t &graph,
+                                            const T &vertex_weights,
+                                            const comp_t &comp,
+                                            index_t num_slabs) {
+            HG_TRACE();
+            const index_t num_v = (index_t) num_vertices(graph);
+            num_slabs = (std::max)((index_t) 1, (std::min)(num_slabs, num_v));
+            array_1d<index_t> parents = array_1d<index_t>::from_shape({(size_t) num_v});
+
+            // processed_before(x, y) is true if x comes after y in the stable sort of the vertices
+            auto processed_before = [&vertex_weights, &comp](index_t x, index_t y) {
+                return comp(vertex_weights(y), vertex_weights(x)) ||
+                       (!comp(vertex_weights(x), vertex_weights(y)) && x > y);
+            };
+            auto slab_start = [num_v, num_slabs](index_t s) {
+                return (index_t) (((double) num_v * s) / num_slabs);
+            };
+
+            // edges between a slab and a slab of larger index
+            std::vector<std::vector<std::pair<index_t, index_t>>> cross_edges(num_slabs);
+
+            parfor(0, num_slabs, [&](index_t s) {
+                const index_t start = slab_start(s);
+                const index_t end = slab_start(s + 1);
+                const index_t size = end - start;
+                auto slab_weights = xt::view(vertex_weights, xt::range(start, end));
+                array_1d<index_t> sorted_vertex_indices = stable_arg_sort(slab_weights, comp);
+
+                array_1d<index_t> representing = array_1d<index_t>::from_shape({(size_t) size});
+                array_1d<bool> processed({(size_t) size}, false);
+                union_find uf(size);
+                auto &slab_cross_edges = cross_edges[s];
+
+                for (index_t i = size - 1; i >= 0; i--) {
+                    auto current_vertex = sorted_vertex_indices(i);
+                    parents(current_vertex + start) = current_vertex + start;
+                    representing(current_vertex) = current_vertex;
+                    processed(current_vertex) = true;
+                    auto current_vertex_reprez = current_vertex;
+                    for (auto n: adjacent_vertex_iterator(current_vertex + start, graph)) {
+                        if (n >= end) {
+                            slab_cross_edges.emplace_back(current_vertex + start, n);
+                            continue;
+                        }
+                        if (n < start) {
+                            continue;
+                        }
+                        n -= start;
+                        if (processed(n)) {
+                            auto neighbor_component = uf.find(n);
+                            if (neighbor_component != current_vertex_reprez) {
+                                parents(representing(neighbor_component) + start) = current_vertex + start;
+                                current_vertex_reprez = uf.link(neighbor_component, current_vertex_reprez);
+                                representing(current_vertex_reprez) = current_vertex;
+                            }
+                        }
+                    }
+                }
+            });
+
+            auto slab_of = [num_v, num_slabs, &slab_start](index_t v) {
+                index_t s = (index_t) (((double) v * num_slabs) / num_v);
+                // fix rounding errors
+                while (s > 0 && v < slab_start(s)) {
+                    s--;
+                }
+                while (s < num_slabs - 1 && v >= slab_start(s + 1)) {
+                    s++;
+                }
+                return s;
+            };
+
+            for (index_t level = 0; ((index_t) 1 << level) < num_slabs; level++) {
+                const index_t block_size = (index_t) 2 << level;
+                const index_t half_size = (index_t) 1 << level;
+                const index_t num_blocks = (num_slabs + block_size - 1) / block_size;
+                parfor(0, num_blocks, [&](index_t b) {
+                    const index_t block_start = b * block_size;
+                    const index_t block_middle = (std::min)(block_start + half_size, num_slabs);
+                    const index_t block_end = (std::min)(block_start + block_size, num_slabs);
+                    for (index_t s = block_start; s < block_middle; s++) {
+                        for (auto &e: cross_edges[s]) {
+                            auto t = slab_of(e.second);
+                            if (t >= block_middle && t < block_end) {
+                                connect_pre_trees(parents, e.first, e.second, processed_before);
+                            }
+                        }
+                    }
+                });
+            }
+            return parents;
+        }
+
+        /**
+         * Component tree of the vertex weighted graph where the vertices are sorted with the given comparison
+         * function. The pre-tree is computed in parallel on large graphs when TBB is enabled.
+         */
+        template<typename graph_t, typename T, typename comp_t>
+        auto tree_from_vertex_weights(const graph_t &graph, const T &vertex_weights, const comp_t &comp) {
+            array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights, comp);
+#ifdef HG_USE_TBB
+            const index_t num_v = (index_t) num_vertices(graph);
+            if (num_v >= parallel_pre_tree_min_size) {
+                auto parents = parallel_pre_tree_construction(graph, vertex_weights, comp,
+                                                              num_v / parallel_pre_tree_slab_size);
+                return tree_from_pre_tree(parents, vertex_weights, sorted_vertex_indices);
+            }
+#endif
+            return tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices);
+        }
     }
 
     /**
@@ -167,8 +365,8 @@ namespace hg {
         hg_assert_vertex_weights(graph, vertex_weights);
         hg_assert_1d_array(vertex_weights);
 
-        array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights);
-        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices);
+        return component_tree_internal::tree_from_vertex_weights(graph, vertex_weights,
+                                                                 std::less<typename T::value_type>());
     }
 
     /**
@@ -200,9 +398,8 @@ namespace hg {
         hg_assert_vertex_weights(graph, vertex_weights);
         hg_assert_1d_array(vertex_weights);
 
-        array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights,
-                                                                  std::greater<typename T::value_type>());
-        return component_tree_internal::tree_from_sorted_vertices(graph, vertex_weights, sorted_vertex_indices);
+        return component_tree_internal::tree_from_vertex_weights(graph, vertex_weights,
+                                                                 std::greater<typename T::value_type>());
     }
 
 }
@@ -19,6 +19,7 @@
 #include "xtensor/xindex_view.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
+#include <array>
 #include <utility>
 #include <tuple>
 #include <queue>
@@ -102,6 +103,182 @@ namespace hg {
                     parents,
                     std::move(mst_edge_map));
         };
+
+        /**
+         * Filter-Kruskal variant of bpt_canonical_from_sorted_edges: the edges are not fully sorted beforehand.
+         *
+         * The set of edges is recursively partitioned around a pivot (quicksort like): the light part is processed
+         * first and, before processing the heavy part, the edges whose extremities are already in the same region are
+         * discarded (filtered). Small ranges are sorted and processed with the usual Kruskal union-find pass.
+         *
+         * Edges are processed with the strict total order (edge_weights(i), i) which corresponds to a stable sort
+         * of the edge weights: the result is thus identical to the one of bpt_canonical_from_sorted_edges
+         * with the edge indices given by stable_arg_sort(edge_weights).
+         *
+         * If TBB is enabled, partitioning, filtering and base case sorting are done in parallel. The union-find pass
+         * remains sequential.
+         *
+         * P. Sanders, J. Singler and V. Osipov. The Filter-Kruskal Minimum Spanning Tree Algorithm.
+         * ALENEX 2009.
+         *
+         * @tparam E1
+         * @tparam E2
+         * @tparam T
+         * @param xsources sources of the graph edges
+         * @param xtargets targets of the graph edges
+         * @param xedge_weights weights of the graph edges
+         * @param num_vertices number of vertices in the graph
+         * @return a pair composed of the parent array of the tree and of the mst_edge_map
+         */
+        template<typename E1, typename E2, typename T>
+        auto bpt_canonical_filter_kruskal(const xt::xexpression<E1> &xsources,
+                                          const xt::xexpression<E2> &xtargets,
+                                          const xt::xexpression<T> &xedge_weights,
+                                          const index_t num_vertices) {
+            HG_TRACE();
+            auto &edge_weights = xedge_weights.derived_cast();
+            auto &sources = xsources.derived_cast();
+            auto &targets = xtargets.derived_cast();
+            hg_assert_1d_array(sources);
+            hg_assert_1d_array(edge_weights);
+            hg_assert_same_shape(sources, targets);
+            hg_assert_same_shape(sources, edge_weights);
+            hg_assert_integral_value_type(sources);
+            hg_assert_integral_value_type(targets);
+
+            const index_t base_case_size = (std::max)(num_vertices, (index_t) (1 << 14));
+            const index_t num_samples = 31;
+
+            auto num_edge_mst = num_vertices - 1;
+
+            array_1d<index_t> mst_edge_map = xt::empty<index_t>({num_edge_mst});
+
+            union_find uf(num_vertices);
+
+            array_1d<index_t> roots = xt::arange<index_t>(num_vertices);
+            array_1d<index_t> parents = xt::arange<index_t>(num_vertices * 2 - 1);
+
+            index_t num_nodes = num_vertices;
+            index_t num_edge_found = 0;
+
+            auto edge_less = [&edge_weights](index_t i, index_t j) {
+                return edge_weights(i) < edge_weights(j) || (!(edge_weights(j) < edge_weights(i)) && i < j);
+            };
+
+            array_1d<index_t> edges = xt::arange<index_t>(edge_weights.size());
+
+            // a range of edges [start, end) and a flag indicating if it must be filtered
+            struct range_t {
+                index_t start;
+                index_t end;
+                bool filter;
+            };
+            stackv<range_t> stack;
+            stack.push({0, (index_t) edges.size(), false});
+
+            while (!stack.empty() && num_edge_found < num_edge_mst) {
+                auto range = stack.top();
+                stack.pop();
+                auto start = edges.begin() + range.start;
+                auto end = edges.begin() + range.end;
+
+                if (range.filter) {
+                    end = hg::stable_partition(start, end, [&uf, &sources, &targets](index_t ei) {
+                        return uf.find_no_compression(sources(ei)) != uf.find_no_compression(targets(ei));
+                    });
+                }
+
+                if (end - start <= base_case_size) {
+                    hg::sort(start, end, edge_less);
+                    for (auto it = start; it != end && num_edge_found < num_edge_mst; it++) {
+                        auto ei = *it;
+                        auto c1 = uf.find(sources(ei));
+                        auto c2 = uf.find(targets(ei));
+                        if (c1 != c2) {
+                            parents[roots[c1]] = num_nodes;
+                            parents[roots[c2]] = num_nodes;
+                            auto newRoot = uf.link(c1, c2);
+                            roots[newRoot] = num_nodes;
+                            mst_edge_map(num_edge_found) = ei;
+                            num_nodes++;
+                            num_edge_found++;
+                        }
+                    }
+                } else {
+                    // pivot is the median of regularly spaced samples
+                    index_t size = end - start;
+                    std::array<index_t, num_samples> samples;
+                    for (index_t i = 0; i < num_samples; i++) {
+                        samples[i] = start[(i * size) / num_samples];
+                    }
+                    std::nth_element(samples.begin(), samples.begin() + num_samples / 2, samples.end(), edge_less);
+                    index_t pivot = samples[num_samples / 2];
+
+                    auto middle = hg::stable_partition(start, end, [&edge_less, pivot](index_t ei) {
+                        return !edge_less(pivot, ei);
+                    });
+
+                    // heavy part is pushed first to be processed after the light part
+                    stack.push({(index_t) (middle - edges.begin()), (index_t) (end - edges.begin()), true});
+                    stack.push({range.start, (index_t) (middle - edges.begin()), false});
+                }
+            }
+            hg_assert(num_edge_found == num_edge_mst, "Input graph must be connected.");
+
+            return std::make_pair(
+                    std::move(parents),
+                    std::move(mst_edge_map));
+        };
+
+        template<typename E1, typename E2, typename T>
+        auto bpt_canonical_from_edge_weights(const E1 &sources,
+                                             const E2 &targets,
+                                             const T &edge_weights,
+                                             const index_t num_vertices,
+                                             std::true_type /* small integral weights */) {
+            array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
+            return bpt_canonical_from_sorted_edges(sources, targets, sorted_edges_indices, num_vertices);
+        }
+
+        template<typename E1, typename E2, typename T>
+        auto bpt_canonical_from_edge_weights(const E1 &sources,
+                                             const E2 &targets,
+                                             const T &edge_weights,
+                                             const index_t num_vertices,
+                                             std::false_type /* small integral weights */) {
+            return bpt_canonical_filter_kruskal(sources, targets, edge_weights, num_vertices);
+        }
+
+        /**
+         * Computes the parent array and the mst_edge_map of the canonical binary partition tree of the given graph.
+         *
+         * Edge weights of small integral types (at most 16 bits) are fully sorted with a radix sort in a few linear
+         * passes, which is faster than the Filter-Kruskal algorithm. Other edge weights are processed with
+         * bpt_canonical_filter_kruskal. In both cases, the result is the one of bpt_canonical_from_sorted_edges
+         * with the edge indices given by stable_arg_sort(edge_weights).
+         *
+         * @tparam E1
+         * @tparam E2
+         * @tparam T
+         * @param xsources sources of the graph edges
+         * @param xtargets targets of the graph edges
+         * @param xedge_weights weights of the graph edges
+         * @param num_vertices number of vertices in the graph
+         * @return a pair composed of the parent array of the tree and of the mst_edge_map
+         */
+        template<typename E1, typename E2, typename T>
+        auto bpt_canonical_from_edge_weights(const xt::xexpression<E1> &xsources,
+                                             const xt::xexpression<E2> &xtargets,
+                                             const xt::xexpression<T> &xedge_weights,
+                                             const index_t num_vertices) {
+            using value_type = typename T::value_type;
+            return bpt_canonical_from_edge_weights(xsources.derived_cast(),
+                                                   xtargets.derived_cast(),
+                                                   xedge_weights.derived_cast(),
+                                                   num_vertices,
+                                                   std::integral_constant<bool, std::is_integral<value_type>::value &&
+                                                                                sizeof(value_type) <= 2>());
+        }
     }
 
     /**
@@ -129,11 +306,9 @@ namespace hg {
         hg_assert_edge_weights(graph, edge_weights);
         hg_assert_1d_array(edge_weights);
 
-        array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
-
-        auto res = hierarchy_core_internal::bpt_canonical_from_sorted_edges(sources(graph),
+        auto res = hierarchy_core_internal::bpt_canonical_from_edge_weights(sources(graph),
                                                                             targets(graph),
-                                                                            sorted_edges_indices,
+                                                                            edge_weights,
                                                                             num_vertices(graph));
         auto &parents = res.first;
         auto &mst_edge_map = res.second;
@@ -354,6 +529,9 @@ namespace hg {
      * The weight of an edge {x, y} is the altitude of the lowest common ancestor of x and y in the
      * hierarchy.
      *
+     * The lowest common ancestors are computed with the linear memory solver lca_schieber_vishkin, the edges are
+     * processed in parallel and the altitudes are written directly in the result.
+     *
      * @tparam graph_t Input graph type
      * @tparam tree_t Input tree type
      * @tparam T xepression derived type of input altitudes
@@ -366,10 +544,103 @@ namespace hg {
     auto saliency_map(const graph_t &graph,
                       const tree_t &tree,
                       const xt::xexpression<T> &xaltitudes) {
+        HG_TRACE();
         auto &altitudes = xaltitudes.derived_cast();
-        lca_fast lca(tree);
-        auto lca_edges = lca.lca(edge_iterator(graph));
-        return xt::eval(xt::index_view(altitudes, lca_edges));
+        hg_assert_node_weights(tree, altitudes);
+        hg_assert_1d_array(altitudes);
+        hg_assert(num_vertices(graph) == num_leaves(tree),
+                  "Graph number of vertices does not match the number of leaves of the tree.");
+        using value_type = typename T::value_type;
+
+        lca_schieber_vishkin lca(tree);
+        index_t num_e = num_edges(graph);
+        auto saliency = array_1d<value_type>::from_shape({(size_t) num_e});
+        auto edges = edge_iterator(graph);
+        auto it = edges.begin();
+        parfor(0, num_e, [&](index_t i) {
+            auto e = it[i];
+            saliency(i) = altitudes(lca.lca(source(e, graph), target(e, graph)));
+        });
+        return saliency;
+    }
+
+    /**
+     * Compute the saliency map of the given hierarchy for the given implicit regular graph.
+     *
+     * Edges are indexed as in the explicit copy of the graph (copy_graph): by increasing source vertex, and for each
+     * source vertex, in the order of the neighbour list of the regular graph (only the neighbours of larger index
+     * are considered). The edges are never materialized.
+     *
+     * @tparam embedding_t Embedding type of the regular graph
+     * @tparam tree_t Input tree type
+     * @tparam T xepression derived type of input altitudes
+     * @param graph Input regular graph
+     * @param tree Input tree
+     * @param xaltitudes Input node altitudes of the given tree
+     * @return An array of shape (num_edges(graph)) and with the same value type as T.
+     */
+    template<typename embedding_t, typename tree_t, typename T>
+    auto saliency_map(const regular_graph<embedding_t> &graph,
+                      const tree_t &tree,
+                      const xt::xexpression<T> &xaltitudes) {
+        HG_TRACE();
+        auto &altitudes = xaltitudes.derived_cast();
+        hg_assert_node_weights(tree, altitudes);
+        hg_assert_1d_array(altitudes);
+        using value_type = typename T::value_type;
+        using point_type = typename embedding_t::point_type;
+
+        const auto &embedding = graph.embedding();
+        const index_t num_v = (index_t) num_vertices(graph);
+        hg_assert(num_v == (index_t) num_leaves(tree),
+                  "Graph number of vertices does not match the number of leaves of the tree.");
+
+        // neighbours of larger index, in the order of the neighbour list
+        point_type origin;
+        origin.fill(0);
+        std::vector<point_type> forward_neighbours;
+        std::vector<index_t> forward_offsets;
+        for (const auto &n: graph.neighbours()) {
+            index_t offset = embedding.grid2lin(xt::eval(origin + n));
+            if (offset > 0) {
+                forward_neighbours.push_back(n);
+                forward_offsets.push_back(offset);
+            }
+        }
+        const index_t num_forward = (index_t) forward_neighbours.size();
+
+        // index of the first edge of each vertex
+        array_1d<index_t> first_edge = array_1d<index_t>::from_shape({(size_t) num_v + 1});
+        first_edge(0) = 0;
+        parfor(0, num_v, [&](index_t v) {
+            auto coordinates = embedding.lin2grid(v);
+            index_t count = 0;
+            for (index_t i = 0; i < num_forward; i++) {
+                if (embedding.contains(xt::eval(coordinates + forward_neighbours[i]))) {
+                    count++;
+                }
+            }
+            first_edge(v + 1) = count;
+        });
+        for (index_t v = 0; v < num_v; v++) {
+            first_edge(v + 1) += first_edge(v);
+        }
+
+        lca_schieber_vishkin lca(tree);
+        auto saliency = array_1d<value_type>::from_shape({(size_t) first_edge(num_v)});
+        parfor(0, num_v, [&](index_t v) {
+            index_t e = first_edge(v);
+            if (e == first_edge(v + 1)) {
+                return;
+            }
+            auto coordinates = embedding.lin2grid(v);
+            for (index_t i = 0; i < num_forward; i++) {
+                if (embedding.contains(xt::eval(coordinates + forward_neighbours[i]))) {
+                    saliency(e++) = altitudes(lca.lca(v, v + forward_offsets[i]));
+                }
+            }
+        });
+        return saliency;
     }
 
     /**
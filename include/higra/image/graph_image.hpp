@@ -11,11 +11,65 @@
 #pragma once
 
 #include "../graph.hpp"
+#include "../structure/lca_fast.hpp"
 #include <stack>
 #include <unordered_map>
 
 namespace hg {
 
+    namespace graph_image_internal {
+
+        /**
+         * Finalize a 2d Khalimsky contour image whose 1-faces are set (and whose 0-faces are uninitialized): set the
+         * 1-faces of the extra border (if any) to the given value, and set each 0-face to the maximum of its
+         * adjacent 1-faces.
+         */
+        template<typename result_type>
+        void khalimsky_fill_borders_and_0_faces(array_2d<result_type> &res,
+                                                bool add_extra_border,
+                                                result_type extra_border_value) {
+            const index_t h = res.shape()[0];
+            const index_t w = res.shape()[1];
+
+            if (add_extra_border && extra_border_value != 0) {
+                for (index_t x = 1; x < w; x += 2) {
+                    res(0, x) = extra_border_value;
+                    res(h - 1, x) = extra_border_value;
+                }
+                for (index_t y = 1; y < h; y += 2) {
+                    res(y, 0) = extra_border_value;
+                    res(y, w - 1) = extra_border_value;
+                }
+            }
+
+            index_t ymin = (add_extra_border) ? 0 : 1;
+            index_t ymax = (add_extra_border) ? h : h - 1;
+            index_t xmin = (add_extra_border) ? 0 : 1;
+            index_t xmax = (add_extra_border) ? w : w - 1;
+            index_t num_rows = (ymax - ymin + 1) / 2;
+
+            parfor(0, num_rows, [&](index_t r) {
+                index_t y = ymin + 2 * r;
+                for (index_t x = xmin; x < xmax; x += 2) {
+                    result_type max_v = std::numeric_limits<result_type>::lowest();
+                    if (y > 0) {
+                        max_v = (std::max)(max_v, res(y - 1, x));
+                    }
+                    if (x > 0) {
+                        max_v = (std::max)(max_v, res(y, x - 1));
+                    }
+                    if (x < w - 1) {
+                        max_v = (std::max)(max_v, res(y, x + 1));
+                    }
+                    if (y < h - 1) {
+                        max_v = (std::max)(max_v, res(y + 1, x));
+                    }
+                    res(y, x) = max_v;
+                }
+            });
+        }
+    }
+
     /**
      * Create a 4 adjacency implicit regular graph for the given embedding
      * @param embedding
@@ -127,39 +181,113 @@ namespace hg {
             }
         }
 
-        embedding_grid_2d res_embedding(res_shape);
-        auto adj4 = get_4_adjacency_implicit_graph(res_embedding);
-        auto h = res_embedding.shape()[0];
-        auto w = res_embedding.shape()[1];
-        auto flat_res = xt::flatten(res);
-
-        if (add_extra_border && extra_border_value != 0) {
-            for (index_t x = 1; x < w; x += 2) {
-                res(0, x) = extra_border_value;
-                res(h - 1, x) = extra_border_value;
-            }
-            for (index_t y = 1; y < h; y += 2) {
-                res(y, 0) = extra_border_value;
-                res(y, w - 1) = extra_border_value;
+        graph_image_internal::khalimsky_fill_borders_and_0_faces(res, add_extra_border, extra_border_value);
+
+        return res;
+    };
+
+    /**
+     * Saliency map of the given hierarchy for the 4 adjacency graph of the given embedding represented in 2d
+     * Khalimsky space: the result is the same as
+     *
+     *     graph_4_adjacency_2_khalimsky(graph, embedding, saliency_map(graph, tree, altitudes), add_extra_border,
+     *                                   extra_border_value)
+     *
+     * but the saliency map is not computed: the lowest common ancestor of each pair of adjacent pixels is computed
+     * (in parallel) with the linear memory solver lca_schieber_vishkin and its altitude is written directly in the
+     * Khalimsky grid.
+     *
+     * The leaf graph of the tree must be the 4 adjacency graph of the embedding (each edge linking two pixels that
+     * are horizontal or vertical neighbours, each such pair being linked exactly once): this is checked in linear
+     * time and an exception is thrown otherwise.
+     *
+     * @tparam graph_t Input graph type
+     * @tparam tree_t Input tree type
+     * @tparam T xepression derived type of input altitudes
+     * @param graph Leaf graph of the tree: 4 adjacency graph of the embedding
+     * @param tree Input tree whose leaves are the pixels of the embedding
+     * @param embedding 2d embedding
+     * @param xaltitudes Input node altitudes of the given tree
+     * @param add_extra_border if false result size is 2 * shape - 1 and 2 * shape + 1 otherwise
+     * @param extra_border_value value of the 1-faces of the extra border
+     * @return a 2d array
+     */
+    template<typename graph_t, typename tree_t, typename T, typename result_type = typename T::value_type>
+    auto saliency_map_khalimsky(const graph_t &graph,
+                                const tree_t &tree,
+                                const embedding_grid_2d &embedding,
+                                const xt::xexpression<T> &xaltitudes,
+                                bool add_extra_border = false,
+                                result_type extra_border_value = 0) {
+        HG_TRACE();
+        const auto &altitudes = xaltitudes.derived_cast();
+        hg_assert_node_weights(tree, altitudes);
+        hg_assert_1d_array(altitudes);
+        hg_assert(num_vertices(graph) == embedding.size(),
+                  "Graph number of vertices does not match the size of the embedding.");
+        hg_assert(num_leaves(tree) == num_vertices(graph),
+                  "Tree number of leaves does not match the number of vertices of the graph.");
+        auto &shape = embedding.shape();
+        const index_t height = shape[0];
+        const index_t width = shape[1];
+
+        hg_assert((index_t) num_edges(graph) == height * (width - 1) + (height - 1) * width,
+                  "Graph is not the 4 adjacency graph of the embedding.");
+        // horizontal_edge[v] (resp. vertical_edge[v]) is set when the edge {v, v + 1} (resp. {v, v + width}) is found
+        std::vector<char> horizontal_edge(num_vertices(graph), false);
+        std::vector<char> vertical_edge(num_vertices(graph), false);
+        for (const auto &e: edge_iterator(graph)) {
+            index_t s = (std::min)((index_t) source(e, graph), (index_t) target(e, graph));
+            index_t t = (std::max)((index_t) source(e, graph), (index_t) target(e, graph));
+            bool ok;
+            if (t == s + 1 && t % width != 0) {
+                ok = !horizontal_edge[s];
+                horizontal_edge[s] = true;
+            } else if (t == s + width) {
+                ok = !vertical_edge[s];
+                vertical_edge[s] = true;
+            } else {
+                ok = false;
             }
+            hg_assert(ok, "Graph is not the 4 adjacency graph of the embedding.");
         }
 
-        index_t ymin = (add_extra_border) ? 0 : 1;
-        index_t ymax = (add_extra_border) ? h : h - 1;
-        index_t xmin = (add_extra_border) ? 0 : 1;
-        index_t xmax = (add_extra_border) ? w : w - 1;
-
-        for (index_t y = ymin; y < ymax; y += 2) {
-            for (index_t x = xmin; x < xmax; x += 2) {
-                auto v = res_embedding.grid2lin({y, x});
-                result_type max_v = std::numeric_limits<result_type>::lowest();
-                for (auto av: adjacent_vertex_iterator(v, adj4)) {
-                    max_v = (std::max)(max_v, flat_res(av));
+        index_t border = (add_extra_border) ? 1 : -1;
+        index_t offset = (add_extra_border) ? 1 : 0;
+        std::array<index_t, 2> res_shape{height * 2 + border, width * 2 + border};
+        array_2d<result_type> res = array_2d<result_type>::from_shape(res_shape);
+
+        lca_schieber_vishkin lca(tree);
+
+        // 1-faces from the lowest common ancestors of adjacent pixels and 2-faces
+        parfor(0, height, [&](index_t y) {
+            index_t ky = 2 * y + offset;
+            for (index_t x = 0; x < width; x++) {
+                index_t v = y * width + x;
+                index_t kx = 2 * x + offset;
+                res(ky, kx) = 0;
+                if (x + 1 < width) {
+                    res(ky, kx + 1) = altitudes(lca.lca(v, v + 1));
+                }
+                if (y + 1 < height) {
+                    res(ky + 1, kx) = altitudes(lca.lca(v, v + width));
                 }
-                res(y, x) = max_v;
+            }
+        });
+
+        if (add_extra_border) {
+            for (index_t x = 0; x < res_shape[1]; x++) {
+                res(0, x) = 0;
+                res(res_shape[0] - 1, x) = 0;
+            }
+            for (index_t y = 0; y < res_shape[0]; y++) {
+                res(y, 0) = 0;
+                res(y, res_shape[1] - 1) = 0;
             }
         }
 
+        graph_image_internal::khalimsky_fill_borders_and_0_faces(res, add_extra_border, extra_border_value);
+
         return res;
     };
 
@@ -15,13 +15,15 @@
 #include "higra/hierarchy/component_tree.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/accumulator/tree_accumulator.hpp"
+#include "higra/sorting.hpp"
 #include "xtensor/xview.hpp"
 #include "xtensor/xnoalias.hpp"
 #include "xtensor/xindex_view.hpp"
 #include "xtensor/xio.hpp"
 
-#include <map>
+#include <algorithm>
 #include <deque>
+#include <vector>
 
 namespace hg {
 
@@ -51,6 +53,7 @@ namespace hg {
         struct integer_level_multi_queue {
             using value_type = value_t;
             using level_type = level_t;
+            using level_value_type = level_t;
 
             /**
              * Create a queue with the given number of levels
@@ -71,6 +74,24 @@ namespace hg {
                 return m_max_level;
             }
 
+            /**
+             * Queue level associated to the given value: levels are the values themselves
+             * @param value in [min_level, max_level]
+             * @return a queue level
+             */
+            auto level_of(level_type value) const {
+                return value;
+            }
+
+            /**
+             * Value associated to the given queue level: levels are the values themselves
+             * @param level in [min_level, max_level]
+             * @return a value
+             */
+            auto level_value(level_type level) const {
+                return level;
+            }
+
             /**
              *
              * @return number of levels in the queue
@@ -192,6 +213,384 @@ namespace hg {
             index_t m_size = 0;
         };
 
+        /**
+         * Distance between two values a >= b: integral values are subtracted as unsigned integers to avoid
+         * overflows.
+         */
+        template<typename value_t, typename std::enable_if_t<std::is_integral<value_t>::value, int> = 0>
+        auto level_distance(value_t a, value_t b) {
+            using unsigned_t = typename std::make_unsigned<value_t>::type;
+            return (unsigned_t) a - (unsigned_t) b;
+        }
+
+        template<typename value_t, typename std::enable_if_t<!std::is_integral<value_t>::value, int> = 0>
+        auto level_distance(value_t a, value_t b) {
+            return a - b;
+        }
+
+        /**
+         * A set of integers in [0, size[ stored as a hierarchy of bitmaps: the first bitmap has one bit per element
+         * and each following bitmap has one bit per 64 bits word of the previous one, which is set if the word is
+         * not zero. The last bitmap is made of a single word.
+         *
+         * Insertion and removal run in O(log_64(size)) and the closest elements before and after a given position
+         * are found in O(log_64(size)) with count leading/trailing zeros instructions.
+         */
+        struct hierarchical_bitset {
+
+            explicit hierarchical_bitset(size_t size) {
+                do {
+                    size = (size + 63) / 64;
+                    m_bitmaps.emplace_back(size, 0);
+                } while (size > 1);
+            }
+
+            void set(index_t i) {
+                for (auto &bitmap: m_bitmaps) {
+                    auto &word = bitmap[i >> 6];
+                    bool was_empty = word == 0;
+                    word |= (uint64_t) 1 << (i & 63);
+                    if (!was_empty) {
+                        return;
+                    }
+                    i >>= 6;
+                }
+            }
+
+            void reset(index_t i) {
+                for (auto &bitmap: m_bitmaps) {
+                    auto &word = bitmap[i >> 6];
+                    word &= ~((uint64_t) 1 << (i & 63));
+                    if (word != 0) {
+                        return;
+                    }
+                    i >>= 6;
+                }
+            }
+
+            /**
+             * Largest element of the set strictly smaller than i, or invalid_index
+             */
+            index_t find_previous(index_t i) const {
+                const index_t num_bitmaps = (index_t) m_bitmaps.size();
+                for (index_t k = 0; k < num_bitmaps; k++) {
+                    auto word = m_bitmaps[k][i >> 6] & (((uint64_t) 1 << (i & 63)) - 1);
+                    if (word != 0) {
+                        i = (i & ~(index_t) 63) | most_significant_bit(word);
+                        for (k--; k >= 0; k--) {
+                            i = (i << 6) | most_significant_bit(m_bitmaps[k][i]);
+                        }
+                        return i;
+                    }
+                    i >>= 6;
+                }
+                return invalid_index;
+            }
+
+            /**
+             * Smallest element of the set strictly larger than i, or invalid_index
+             */
+            index_t find_next(index_t i) const {
+                const index_t num_bitmaps = (index_t) m_bitmaps.size();
+                for (index_t k = 0; k < num_bitmaps; k++) {
+                    auto word = ((i & 63) == 63) ? 0 : m_bitmaps[k][i >> 6] & (~(uint64_t) 0 << ((i & 63) + 1));
+                    if (word != 0) {
+                        i = (i & ~(index_t) 63) | least_significant_bit(word);
+                        for (k--; k >= 0; k--) {
+                            i = (i << 6) | least_significant_bit(m_bitmaps[k][i]);
+                        }
+                        return i;
+                    }
+                    i >>= 6;
+                }
+                return invalid_index;
+            }
+
+        private:
+            std::vector<std::vector<uint64_t>> m_bitmaps;
+        };
+
+        /**
+         * A multi-level priority queue whose levels are the ranks of a sorted sequence of distinct values
+         * levels[0] < levels[1] < ... < levels[n - 1] of any type (for example floating point values): values
+         * are not quantized and the closest non empty level is determined from the actual values of the levels.
+         *
+         * The queue stores indices in [0, capacity[, each index being in the queue at most once. Each level is a
+         * FIFO linked list and the non empty levels are tracked in a hierarchical_bitset: the queue uses
+         * O(capacity + num_levels) memory.
+         *
+         * All operations are done in constant time, except:
+         * - level_of which runs in O(log(num_levels)), and
+         * - push, pop and find_closest_non_empty_level which run in O(log_64(num_levels)).
+         *
+         * @tparam level_value_t type of the level values
+         */
+        template<typename level_value_t>
+        struct ranked_level_multi_queue {
+            using value_type = index_t;
+            using level_type = index_t;
+            using level_value_type = level_value_t;
+
+            /**
+             * Create a queue with the given levels
+             * @param levels sorted sequence of distinct values
+             * @param capacity queue will store indices in [0, capacity[
+             */
+            ranked_level_multi_queue(std::vector<level_value_t> levels, size_t capacity) :
+                    m_levels(std::move(levels)),
+                    m_head(m_levels.size(), invalid_index),
+                    m_tail(m_levels.size(), invalid_index),
+                    m_next(capacity),
+                    m_non_empty_levels(m_levels.size()) {
+                hg_assert(m_levels.size() > 0, "Queue must have at least one level.");
+            }
+
+            auto min_level() const {
+                return (level_type) 0;
+            }
+
+            auto max_level() const {
+                return (level_type) m_levels.size() - 1;
+            }
+
+            /**
+             * Queue level (rank) associated to the given value
+             * @param value a value of the sequence of levels
+             * @return a queue level
+             */
+            auto level_of(const level_value_t &value) const {
+                auto it = std::lower_bound(m_levels.begin(), m_levels.end(), value);
+                hg_assert(it != m_levels.end() && !(value < *it), "Value is not a level of the queue.");
+                return (level_type) (it - m_levels.begin());
+            }
+
+            /**
+             * Value associated to the given queue level
+             * @param level in [min_level, max_level]
+             * @return a value
+             */
+            auto level_value(level_type level) const {
+                return m_levels[level];
+            }
+
+            /**
+             *
+             * @return number of levels in the queue
+             */
+            auto num_levels() const {
+                return (index_t) m_levels.size();
+            }
+
+            /**
+             *
+             * @return number of elements in the queue
+             */
+            auto size() const {
+                return m_size;
+            }
+
+            /**
+             *
+             * @return true if the queue is empty
+             */
+            auto empty() const {
+                return m_size == 0;
+            }
+
+            /**
+             *
+             * @param level in [min_level, max_level]
+             * @return true if the given level of the queue is empty
+             */
+            auto level_empty(level_type level) const {
+                return m_head[level] == invalid_index;
+            }
+
+            /**
+             * Add a new element to the given level of the queue
+             * @param level in [min_level, max_level]
+             * @param v new element in [0, capacity[
+             */
+            void push(level_type level, value_type v) {
+                m_next[v] = invalid_index;
+                if (m_head[level] == invalid_index) {
+                    m_head[level] = v;
+                    m_non_empty_levels.set(level);
+                } else {
+                    m_next[m_tail[level]] = v;
+                }
+                m_tail[level] = v;
+                m_size++;
+            }
+
+            /**
+             * Return the first element of the given queue level
+             * @param level in [min_level, max_level]
+             * @return a value_type element
+             */
+            auto top(level_type level) const {
+                return m_head[level];
+            }
+
+            /**
+             * Removes the first element of the given queue level
+             * @param level in [min_level, max_level]
+             */
+            void pop(level_type level) {
+                m_head[level] = m_next[m_head[level]];
+                if (m_head[level] == invalid_index) {
+                    m_non_empty_levels.reset(level);
+                }
+                m_size--;
+            }
+
+            /**
+             * Given a queue level, find the non empty level in the queue whose value is the closest to the value of
+             * the given level. In case of equality the smallest level is returned.
+             *
+             * @param level in [min_level, max_level]
+             * @return a queue level
+             */
+            auto find_closest_non_empty_level(level_type level) const {
+                if (!level_empty(level)) {
+                    return level;
+                }
+                // only the closest non empty levels below and above can be the closest in value
+                level_type level_low = m_non_empty_levels.find_previous(level);
+                level_type level_high = m_non_empty_levels.find_next(level);
+                if (level_low == invalid_index && level_high == invalid_index) {
+                    throw std::runtime_error("Empty queue!");
+                }
+                if (level_high == invalid_index) {
+                    return level_low;
+                }
+                if (level_low == invalid_index) {
+                    return level_high;
+                }
+                const auto &value = m_levels[level];
+                return (level_distance(m_levels[level_high], value) < level_distance(value, m_levels[level_low])) ?
+                       level_high : level_low;
+            }
+
+        private:
+            std::vector<level_value_t> m_levels;
+            std::vector<index_t> m_head;
+            std::vector<index_t> m_tail;
+            std::vector<index_t> m_next;
+            hierarchical_bitset m_non_empty_levels;
+            index_t m_size = 0;
+        };
+
+        /**
+         * Level queue used to sort the vertices of a plain map whose bounds take their values in the given
+         * container: small integer values are directly used as levels of an integer_level_multi_queue.
+         */
+        template<typename T,
+                typename value_type = typename T::value_type,
+                typename std::enable_if_t<sizeof(value_type) <= 2 && std::is_integral<value_type>::value, int> = 0>
+        auto make_level_queue(const T &values, value_type extra_level, size_t) {
+            auto minmax = std::minmax_element(values.begin(), values.end());
+            return integer_level_multi_queue<value_type, index_t>(
+                    (std::min)(*minmax.first, extra_level), (std::max)(*minmax.second, extra_level));
+        }
+
+        /**
+         * Level queue used to sort the vertices of a plain map whose bounds take their values in the given
+         * container: the levels of the ranked_level_multi_queue are the sorted distinct values of the container
+         * and the extra level.
+         */
+        template<typename T,
+                typename value_type = typename T::value_type,
+                typename std::enable_if_t<3 <= sizeof(value_type) || !std::is_integral<value_type>::value, int> = 0>
+        auto make_level_queue(const T &values, value_type extra_level, size_t capacity) {
+            std::vector<value_type> levels(values.begin(), values.end());
+            levels.push_back(extra_level);
+            hg::sort(levels.begin(), levels.end());
+            levels.erase(std::unique(levels.begin(), levels.end()), levels.end());
+            return ranked_level_multi_queue<value_type>(std::move(levels), capacity);
+        }
+
+        /**
+         * Plain map stored in an array of shape (num_vertices, 2): the bounds of vertex v are plain_map(v, 0) and
+         * plain_map(v, 1).
+         */
+        template<typename T>
+        struct explicit_plain_map {
+            using value_type = typename T::value_type;
+            const T &plain_map;
+
+            std::pair<value_type, value_type> operator()(index_t v) const {
+                return {plain_map(v, 0), plain_map(v, 1)};
+            }
+        };
+
+        /**
+         * Implicit plain map of a (padded) 3d image: the bounds of the vertices are computed on the fly from the
+         * image instead of being stored.
+         *
+         * With immersion, the plain map is the Khalimsky interpolation of the image: its shape is 2 * shape - 1
+         * (except along an axis of size 1) and the bounds of a face are the minimum and maximum of the image
+         * pixels adjacent to this face. Otherwise, the bounds of a vertex are both equal to the value of the
+         * pixel.
+         */
+        template<typename value_t>
+        struct implicit_plain_map {
+            using value_type = value_t;
+
+            implicit_plain_map(array_3d<value_t> &&image, bool immersion) :
+                    m_image(std::move(image)),
+                    m_immersion(immersion) {
+                auto &shape = m_image.shape();
+                m_image_h = shape[1];
+                m_image_w = shape[2];
+                m_w = (immersion) ? m_image_w * 2 - 1 : m_image_w;
+                m_hw = ((immersion) ? m_image_h * 2 - 1 : m_image_h) * m_w;
+            }
+
+            /**
+             * Pixel values of the image: every bound of the plain map is one of these values
+             */
+            const auto &values() const {
+                return m_image;
+            }
+
+            std::pair<value_t, value_t> operator()(index_t v) const {
+                const value_t *data = m_image.data();
+                if (!m_immersion) {
+                    return {data[v], data[v]};
+                }
+                index_t z = v / m_hw;
+                index_t r = v - z * m_hw;
+                index_t y = r / m_w;
+                index_t x = r - y * m_w;
+                index_t x0 = x / 2;
+                index_t x1 = (x + 1) / 2;
+                index_t y0 = y / 2;
+                index_t y1 = (y + 1) / 2;
+                index_t z1 = (z + 1) / 2;
+                value_t vmin = data[((z / 2) * m_image_h + y0) * m_image_w + x0];
+                value_t vmax = vmin;
+                for (index_t zz = z / 2; zz <= z1; zz++) {
+                    for (index_t yy = y0; yy <= y1; yy++) {
+                        const value_t *line = data + (zz * m_image_h + yy) * m_image_w;
+                        for (index_t xx = x0; xx <= x1; xx++) {
+                            vmin = (std::min)(vmin, line[xx]);
+                            vmax = (std::max)(vmax, line[xx]);
+                        }
+                    }
+                }
+                return {vmin, vmax};
+            }
+
+        private:
+            array_3d<value_t> m_image;
+            bool m_immersion;
+            index_t m_image_h;
+            index_t m_image_w;
+            index_t m_w;
+            index_t m_hw;
+        };
+
         template<typename T1, typename T2>
         auto fill_khalimsky_plane_2d(const xt::xexpression<T1> &ximage2d, xt::xexpression<T2> &xplain_map2d) {
             auto &image2d = ximage2d.derived_cast();
@@ -274,22 +673,49 @@ namespace hg {
             }
         }
 
-        template<typename graph_t,
-                typename T,
-                typename value_type = typename T::value_type,
-                typename std::enable_if_t<sizeof(value_type) <= 2 && std::is_integral<value_type>::value, int> = 0>
-        auto sort_vertices_tree_of_shapes(const graph_t &graph,
-                                          const xt::xexpression<T> &xplain_map, index_t exterior_vertex = 0) {
+        /**
+         * Replace the values of a container by their levels in the given queue (see make_level_queue).
+         */
+        template<typename T1, typename queue_t, typename T2>
+        void values_to_levels(const T1 &values, const queue_t &queue, T2 &levels) {
+            hg_assert(values.size() == levels.size(), "Values and levels sizes do not match.");
+            const auto *values_data = values.data();
+            auto *levels_data = levels.data();
+            parfor(0, (index_t) values.size(), [values_data, levels_data, &queue](index_t i) {
+                levels_data[i] = queue.level_of(values_data[i]);
+            });
+        }
 
-            auto &plain_map = xplain_map.derived_cast();
+        /**
+         * Sort the vertices of the graph by propagation from the exterior vertex in the plain map (Géraud et al.
+         * algorithm): the next vertex is always taken in the non empty level of the queue closest to the current
+         * level.
+         *
+         * The bounds of the plain map are given as levels of the queue (see make_level_queue and values_to_levels).
+         *
+         * @tparam graph_t
+         * @tparam plain_map_t callable returning the pair of bounds (lower, upper) of a vertex
+         * @tparam queue_t
+         * @param graph input graph
+         * @param plain_map plain map on the graph vertices
+         * @param queue an empty level queue
+         * @param initial_level level of the exterior vertex
+         * @param exterior_vertex starting vertex of the propagation
+         * @return a pair (sorted vertex indices, enqueued level value of each vertex)
+         */
+        template<typename graph_t, typename plain_map_t, typename queue_t>
+        auto propagation_sort(const graph_t &graph,
+                              const plain_map_t &plain_map,
+                              queue_t &queue,
+                              typename queue_t::level_type initial_level,
+                              index_t exterior_vertex) {
+            using value_type = typename queue_t::level_value_type;
             auto num_v = num_vertices(graph);
             array_1d<bool> dejavu({num_v}, false);
             array_1d<index_t> sorted_vertex_indices = array_1d<index_t>::from_shape({num_v});
             array_1d<value_type> enqueued_level = array_1d<value_type>::from_shape({num_v});
-            integer_level_multi_queue<value_type, index_t> queue(xt::amin(plain_map)(), xt::amax(plain_map)());
 
-            value_type current_level = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) /
-                                                     2.0);
+            auto current_level = initial_level;
             queue.push(current_level, exterior_vertex);
             dejavu(exterior_vertex) = true;
 
@@ -298,79 +724,65 @@ namespace hg {
                 current_level = queue.find_closest_non_empty_level(current_level);
                 auto current_point = queue.top(current_level);
                 queue.pop(current_level);
-                enqueued_level(current_point) = current_level;
+                enqueued_level(current_point) = queue.level_value(current_level);
                 sorted_vertex_indices(i++) = current_point;
                 for (auto n: adjacent_vertex_iterator(current_point, graph)) {
                     if (!dejavu(n)) {
-                        auto newLevel = (std::min)(plain_map(n, 1), (std::max)(plain_map(n, 0), current_level));
-                        queue.push(newLevel, n);
+                        auto bounds = plain_map(n);
+                        auto new_level = (std::min)(bounds.second, (std::max)(bounds.first, current_level));
+                        queue.push(new_level, n);
                         dejavu(n) = true;
                     }
                 }
-
             }
             return std::make_pair(std::move(sorted_vertex_indices), std::move(enqueued_level));
         }
 
-        template<typename graph_t,
-                typename T,
-                typename value_type = typename T::value_type,
-                typename std::enable_if_t<3 <= sizeof(value_type) || !std::is_integral<value_type>::value, int> = 0>
+        /**
+         * Component tree of the vertices sorted by propagation: the pre-tree is the max-tree of the rank of the
+         * vertices in the propagation order, it is computed in parallel slabs on large graphs if TBB is enabled
+         * (see component_tree_internal::parallel_pre_tree_construction).
+         */
+        template<typename graph_t, typename T1, typename T2>
+        auto tree_from_propagation_order(const graph_t &graph,
+                                         const T1 &enqueued_levels,
+                                         const T2 &sorted_vertex_indices) {
+#ifdef HG_USE_TBB
+            const index_t num_v = (index_t) num_vertices(graph);
+            if (num_v >= component_tree_internal::parallel_pre_tree_min_size) {
+                array_1d<index_t> ranks = array_1d<index_t>::from_shape({(size_t) num_v});
+                parfor(0, num_v, [&ranks, &sorted_vertex_indices](index_t i) {
+                    ranks(sorted_vertex_indices(i)) = i;
+                });
+                auto parents = component_tree_internal::parallel_pre_tree_construction(
+                        graph, ranks, std::less<index_t>(),
+                        num_v / component_tree_internal::parallel_pre_tree_slab_size);
+                return component_tree_internal::tree_from_pre_tree(parents, enqueued_levels, sorted_vertex_indices);
+            }
+#endif
+            return component_tree_internal::tree_from_sorted_vertices(graph, enqueued_levels, sorted_vertex_indices);
+        }
+
+        template<typename graph_t, typename T>
         auto sort_vertices_tree_of_shapes(const graph_t &graph,
                                           const xt::xexpression<T> &xplain_map, index_t exterior_vertex = 0) {
-
             auto &plain_map = xplain_map.derived_cast();
             hg_assert(plain_map.dimension() == 2, "Invalid plain map");
             hg_assert(plain_map.shape()[1] == 2, "Invalid plain map");
             hg_assert_vertex_weights(graph, plain_map);
+            using value_type = typename T::value_type;
             auto num_v = num_vertices(graph);
-            array_1d<bool> dejavu({num_v}, false);
-            array_1d<index_t> sorted_vertex_indices = array_1d<index_t>::from_shape({num_v});
-            array_1d<value_type> enqueued_level = array_1d<value_type>::from_shape({num_v});
-
-            std::multimap<value_type, index_t> queue{};
-            auto find_closest_non_empty_level = [&queue](const auto position) {
-                auto next = std::next(position);
-                if (position == queue.begin()) {
-                    return next;
-                }
-                auto prev = std::prev(position);
-                if (next == queue.end()) {
-                    return prev;
-                }
-                if (next->first - position->first < position->first - prev->first) {
-                    return next;
-                } else {
-                    return prev;
-                }
-            };
-
-            value_type current_level = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) /
-                                                     2.0);
-
-            auto position = queue.insert({current_level, exterior_vertex});
-            dejavu(exterior_vertex) = true;
-
-            index_t i = 0;
-            do {
-                current_level = position->first;
-                index_t current_point = position->second;
 
-                enqueued_level(current_point) = current_level;
-                sorted_vertex_indices(i++) = current_point;
-                for (auto n: adjacent_vertex_iterator(current_point, graph)) {
-                    if (!dejavu(n)) {
-                        auto newLevel = (std::min)(plain_map(n, 1), (std::max)(plain_map(n, 0), current_level));
-                        queue.insert({newLevel, n});
-                        dejavu(n) = true;
-                    }
-                }
-
-                auto new_position = find_closest_non_empty_level(position);
-                queue.erase(position);
-                position = new_position;
-            } while (!queue.empty());
-            return std::make_pair(std::move(sorted_vertex_indices), std::move(enqueued_level));
+            auto initial_value = (value_type) ((plain_map(exterior_vertex, 0) + plain_map(exterior_vertex, 1)) / 2.0);
+            auto queue = make_level_queue(plain_map, initial_value, num_v);
+            using level_type = typename decltype(queue)::level_type;
+            array_2d<level_type> levels = array_2d<level_type>::from_shape({num_v, 2});
+            for (index_t i = 0; i < (index_t) num_v; i++) {
+                levels(i, 0) = queue.level_of(plain_map(i, 0));
+                levels(i, 1) = queue.level_of(plain_map(i, 1));
+            }
+            return propagation_sort(graph, explicit_plain_map<array_2d<level_type>>{levels}, queue,
+                                    queue.level_of(initial_value), exterior_vertex);
         }
 
         template<typename T>
@@ -612,6 +1024,11 @@ namespace hg {
      * of a shape is defined with respect to this point). The coordinate of this point must be given in the
      * padded/interpolated space.
      *
+     * The interpolated plain map is never stored: its bounds are computed on the fly from the padded image. Image
+     * values are first replaced by their ranks among the distinct values of the image, the propagation then relies on
+     * a hierarchical queue for any value type (including floating point values). With TBB, the union-find phase is
+     * computed in parallel on large images.
+     *
      * [1] Pa. Monasse, and F. Guichard, "Fast computation of a contrast-invariant image representation,"
      *     Image Processing, IEEE Transactions on, vol.9, no.5, pp.860-872, May 2000
      *
@@ -647,13 +1064,13 @@ namespace hg {
         size_t w = (is_input_3d) ? shape[2] : shape[1];
 
         auto image3d = xt::reshape_view(image, {d, h, w});
-        auto shape3d = image3d.shape();
 
         // ----------------
         // Compute intermediate plain map representation size
         // ----------------
         bool do_padding = padding != tos_padding::none;
         size_t padding_size = (do_padding) ? 1 : 0;
+        size_t padding_size_d = (is_input_3d) ? padding_size : 0;
         size_t immersion_factor = (immersion)? 2 : 1;
         size_t border_size_hw = padding_size * immersion_factor;
         size_t border_size_d = (is_input_3d)? border_size_hw : 0;
@@ -669,45 +1086,56 @@ namespace hg {
 
 
         // ----------------
-        // Compute plain map, do Khalimsky interpolation if needed, then fill padding is needed
+        // Compute padded image, the plain map is then obtained implicitly by Khalimsky interpolation if needed
         // ----------------
-        array_4d<value_type> plain_map({d_plain_map, h_plain_map, w_plain_map, (size_t)2});
-
-        auto plain_map_interior = xt::view(plain_map, xt::range(border_size_d, d_plain_map - border_size_d),
-                                           xt::range(border_size_hw, h_plain_map - border_size_hw),
-                                           xt::range(border_size_hw, w_plain_map - border_size_hw), xt::all());
-
-        if(immersion){
-            tree_of_shapes_internal::interpolate_plain_map_khalimsky_3d(image3d, embedding_grid_3d(shape3d), plain_map_interior);
-        } else {
-            for(size_t z = 0; z < d; z++){
-                for(size_t y = 0; y < h; y++){
-                    for(size_t x = 0; x < w; x++){
-                        plain_map_interior(z, y, x, 0) = image3d(z, y, x);
-                        plain_map_interior(z, y, x, 1) = image3d(z, y, x);
-                    }
+        array_3d<value_type> padded_image = array_3d<value_type>::from_shape(
+                {d + padding_size_d * 2, h + padding_size * 2, w + padding_size * 2});
+        if (do_padding) {
+            auto padding_value = tree_of_shapes_internal::get_padding_value(image, padding);
+            std::fill(padded_image.begin(), padded_image.end(), padding_value);
+        }
+        for (size_t z = 0; z < d; z++) {
+            for (size_t y = 0; y < h; y++) {
+                for (size_t x = 0; x < w; x++) {
+                    padded_image(z + padding_size_d, y + padding_size, x + padding_size) = image3d(z, y, x);
                 }
             }
         }
 
-        if(do_padding){
-            auto padding_value = tree_of_shapes_internal::get_padding_value(image, padding);
-            tree_of_shapes_internal::fill_padding(plain_map, padding_value, immersion, is_input_3d);
-        }
+        // ----------------
+        // Convert image values to queue levels
+        // ----------------
+        const size_t num_v = d_plain_map * h_plain_map * w_plain_map;
+        tree_of_shapes_internal::implicit_plain_map<value_type> value_plain_map(std::move(padded_image), immersion);
+        auto exterior_bounds = value_plain_map(exterior_vertex);
+        auto initial_value = (value_type) ((exterior_bounds.first + exterior_bounds.second) / 2.0);
+        auto queue = tree_of_shapes_internal::make_level_queue(value_plain_map.values(), initial_value, num_v);
+
+        using level_type = typename decltype(queue)::level_type;
+        array_3d<level_type> level_image = array_3d<level_type>::from_shape(value_plain_map.values().shape());
+        tree_of_shapes_internal::values_to_levels(value_plain_map.values(), queue, level_image);
+        tree_of_shapes_internal::implicit_plain_map<level_type> plain_map(std::move(level_image), immersion);
 
         // ----------------
         // Sort vertices with flooding from the exterior vertex and then compute the associated component tree
         // ----------------
-        auto graph = get_6_adjacency_implicit_graph({(index_t) d_plain_map, (index_t) h_plain_map, (index_t) w_plain_map});
-
-        auto res_sort = tree_of_shapes_internal::sort_vertices_tree_of_shapes(
-                graph,
-                xt::reshape_view(plain_map, {d_plain_map * h_plain_map * w_plain_map, (size_t)2}),
-                exterior_vertex);
-        auto &sorted_vertex_indices = res_sort.first;
-        auto &enqueued_levels = res_sort.second;
+        auto initial_level = queue.level_of(initial_value);
+        auto tree_from_graph = [&](const auto &graph) {
+            auto res_sort = tree_of_shapes_internal::propagation_sort(graph, plain_map, queue, initial_level,
+                                                                      exterior_vertex);
+            auto &sorted_vertex_indices = res_sort.first;
+            auto &enqueued_levels = res_sort.second;
+            return tree_of_shapes_internal::tree_from_propagation_order(graph, enqueued_levels,
+                                                                        sorted_vertex_indices);
+        };
 
-        auto res_tree = component_tree_internal::tree_from_sorted_vertices(graph, enqueued_levels, sorted_vertex_indices);
+        // a 2d graph with the same neighbour order as the 6 adjacency avoids bound checks on the unit depth axis
+        auto res_tree = (is_input_3d) ?
+                        tree_from_graph(get_6_adjacency_implicit_graph(
+                                {(index_t) d_plain_map, (index_t) h_plain_map, (index_t) w_plain_map})) :
+                        tree_from_graph(regular_grid_graph_2d(
+                                embedding_grid_2d({(index_t) h_plain_map, (index_t) w_plain_map}),
+                                {{{-1, 0}}, {{1, 0}}, {{0, -1}}, {{0, 1}}}));
 
         // ----------------
         // Remove nodes corresponding to padding and Khalimsky interpolation if needed
@@ -11,10 +11,16 @@
 #pragma once
 
 #include "../graph.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
 #include <istream>
 #include <ostream>
 #include <fstream>
+#include <limits>
+#include <sstream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include "higra/structure/array.hpp"
 #include "xtensor/xscalar.hpp"
@@ -31,70 +37,518 @@ namespace hg {
         B edge_weights;
     };
 
-    inline
-    auto read_pink_graph(std::istream &in) {
-        HG_TRACE();
-        std::string discard;
-
+    /**
+     * Content of a pink graph file as flat arrays: the i-th edge links sources(i) and targets(i).
+     */
+    struct pink_graph_edge_list {
+        index_t num_vertices;
+        array_1d<index_t> sources;
+        array_1d<index_t> targets;
         std::vector<std::size_t> shape;
+        array_1d<double> vertex_weights;
+        array_1d<double> edge_weights;
+    };
+
+    namespace pink_graph_io_internal {
 
-        // maybe shape
-        if (in.peek() == '#') {
-            std::size_t rs;
-            std::size_t cs;
-            in >> discard >> rs >> discard >> cs;
-            shape.push_back(cs);
-            shape.push_back(rs);
+        /**
+         * Number of bytes read from the input stream at once.
+         */
+        const std::size_t read_block_size = 1 << 24;
+
+        /**
+         * Minimum number of bytes of a block parsed by a single task.
+         */
+        const std::size_t parse_chunk_size = 1 << 20;
+
+        /**
+         * Size of the output buffer used to format numbers before writing them to the output stream.
+         */
+        const std::size_t write_buffer_size = 1 << 16;
+
+        inline bool is_blank(char c) {
+            return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
         }
 
-        index_t num_points;
-        index_t num_edges;
-        in >> num_points >> num_edges;
+        inline void skip_blanks(const char *&p) {
+            while (is_blank(*p)) {
+                p++;
+            }
+        }
 
-        hg_assert(num_points > 0, "The number of vertices cannot be negative.");
-        hg_assert(num_edges > 0, "The number of edges cannot be negative.");
+        inline bool is_blank_line(const char *p) {
+            skip_blanks(p);
+            return *p == '\n';
+        }
 
-        if (shape.empty()) // construct valid shape
-        {
-            shape.push_back(num_points);
+        /**
+         * Parse a non negative integer starting at p (after optional blanks), p is moved after the number.
+         * The sequence must be terminated by a new line character. Numbers that do not fit in an index_t are
+         * rejected.
+         */
+        inline index_t parse_index(const char *&p) {
+            skip_blanks(p);
+            hg_assert(*p >= '0' && *p <= '9', "Invalid graph file: integer expected.");
+            const index_t max_value = std::numeric_limits<index_t>::max();
+            index_t value = 0;
+            while (*p >= '0' && *p <= '9') {
+                index_t digit = *p - '0';
+                hg_assert(value <= (max_value - digit) / 10, "Invalid graph file: integer too large.");
+                value = value * 10 + digit;
+                p++;
+            }
+            return value;
+        }
+
+        /**
+         * Parse a floating point number starting at p (after optional blanks), p is moved after the number.
+         * The sequence must be terminated by a new line character.
+         *
+         * Decimal numbers with at most 19 significant digits whose mantissa is exactly representable and with
+         * a small exponent are converted with a single multiplication or division by an exact power of 10 which is
+         * correctly rounded (Clinger's fast path), other numbers are converted with strtod.
+         */
+        inline double parse_double(const char *&p) {
+            static const double powers_of_10[] = {1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                                  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+            skip_blanks(p);
+            const char *start = p;
+            bool negative = false;
+            if (*p == '-' || *p == '+') {
+                negative = *p == '-';
+                p++;
+            }
+            uint64_t mantissa = 0;
+            int num_digits = 0;
+            int exponent = 0;
+            bool has_digits = false;
+            while (*p >= '0' && *p <= '9') {
+                has_digits = true;
+                if (mantissa != 0 || *p != '0') {
+                    num_digits++;
+                }
+                mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+                p++;
+            }
+            if (*p == '.') {
+                p++;
+                while (*p >= '0' && *p <= '9') {
+                    has_digits = true;
+                    if (mantissa != 0 || *p != '0') {
+                        num_digits++;
+                    }
+                    mantissa = mantissa * 10 + (uint64_t) (*p - '0');
+                    exponent--;
+                    p++;
+                }
+            }
+            if (has_digits && (*p == 'e' || *p == 'E')) {
+                const char *q = p + 1;
+                bool negative_exponent = false;
+                if (*q == '-' || *q == '+') {
+                    negative_exponent = *q == '-';
+                    q++;
+                }
+                if (*q >= '0' && *q <= '9') {
+                    int e = 0;
+                    while (*q >= '0' && *q <= '9') {
+                        if (e < 10000) {
+                            e = e * 10 + (*q - '0');
+                        }
+                        q++;
+                    }
+                    exponent += negative_exponent ? -e : e;
+                    p = q;
+                }
+            }
+
+            if (has_digits && num_digits <= 19 && mantissa <= ((uint64_t) 1 << 53) &&
+                exponent >= -22 && exponent <= 22) {
+                double value = (double) mantissa;
+                value = (exponent < 0) ? value / powers_of_10[-exponent] : value * powers_of_10[exponent];
+                return negative ? -value : value;
+            }
+
+            // slow path: long mantissa, large exponent, inf, nan...
+            // the input is not null terminated: strtod works on a null terminated copy of the current token
+            const char *token_end = start;
+            while (*token_end != '\n' && !is_blank(*token_end)) {
+                token_end++;
+            }
+            std::string token(start, token_end);
+            char *end;
+            double value = std::strtod(token.c_str(), &end);
+            hg_assert(end != token.c_str(), "Invalid graph file: number expected.");
+            p = start + (end - token.c_str());
+            return value;
         }
 
-        //useless line to announce vertex list
-        in >> discard >> discard;
+        /**
+         * Reads an input stream by blocks of fixed size and gives access to the complete lines of the
+         * unprocessed data. The end of the stream is considered as a line end.
+         */
+        struct line_block_reader {
 
-        // vertex list
-        ugraph g(num_points);
-        auto vertex_weight = array_1d<double>::from_shape({(size_t)num_points});
+            line_block_reader(std::istream &in, std::size_t block_size = read_block_size) :
+                    m_in(in), m_block_size(block_size) {
+            }
+
+            /**
+             * Beginning of the unprocessed data.
+             */
+            const char *begin() const {
+                return m_buffer.data() + m_begin;
+            }
+
+            /**
+             * End of the last complete line of the unprocessed data.
+             */
+            const char *end() const {
+                return m_buffer.data() + m_end;
+            }
+
+            void consume(const char *position) {
+                m_begin = (std::size_t) (position - m_buffer.data());
+            }
+
+            /**
+             * Append a new block of the stream to the unprocessed data, return false if the end of the stream was
+             * already reached.
+             */
+            bool fill() {
+                if (m_eof) {
+                    return false;
+                }
+                m_buffer.erase(m_buffer.begin(), m_buffer.begin() + m_begin);
+                m_begin = 0;
+                auto size = m_buffer.size();
+                m_buffer.resize(size + m_block_size);
+                m_in.read(&m_buffer[size], std::streamsize(m_block_size));
+                m_buffer.resize(size + (std::size_t) m_in.gcount());
+                if (!m_in) {
+                    m_eof = true;
+                    if (!m_buffer.empty() && m_buffer.back() != '\n') {
+                        m_buffer.push_back('\n');
+                    }
+                }
+                m_end = m_buffer.size();
+                while (m_end > 0 && m_buffer[m_end - 1] != '\n') {
+                    m_end--;
+                }
+                return true;
+            }
+
+            /**
+             * Next non blank line, empty string if the end of the stream is reached.
+             */
+            std::string next_line() {
+                do {
+                    const char *p = begin();
+                    while (p != end()) {
+                        const char *line_end = p;
+                        while (*line_end != '\n') {
+                            line_end++;
+                        }
+                        if (!is_blank_line(p)) {
+                            consume(line_end + 1);
+                            return std::string(p, line_end);
+                        }
+                        p = line_end + 1;
+                    }
+                    consume(p);
+                } while (fill());
+                return std::string();
+            }
+
+        private:
+            std::istream &m_in;
+            std::size_t m_block_size;
+            std::vector<char> m_buffer;
+            std::size_t m_begin = 0;
+            std::size_t m_end = 0;
+            bool m_eof = false;
+        };
 
-        for (index_t l = 0; l < num_points; ++l) {
-            index_t i;
-            double d;
-            in >> i >> d;
-            hg_assert(0 <= i && i < num_points, "Invalid graph file: vertex index out of range.");
-            vertex_weight(i) = d;
+        /**
+         * Position after the num_lines first non blank lines of the sequence of complete lines starting at p.
+         */
+        inline const char *skip_lines(const char *p, index_t num_lines) {
+            while (num_lines > 0) {
+                if (!is_blank_line(p)) {
+                    num_lines--;
+                }
+                while (*p != '\n') {
+                    p++;
+                }
+                p++;
+            }
+            return p;
+        }
+
+        inline index_t count_lines(const char *p, const char *end) {
+            index_t count = 0;
+            while (p != end) {
+                if (!is_blank_line(p)) {
+                    count++;
+                }
+                while (*p != '\n') {
+                    p++;
+                }
+                p++;
+            }
+            return count;
         }
 
-        //useless line to announce edge list
-        in >> discard >> discard;
+        /**
+         * Calls fun(i, line) for each of the next num_lines non blank lines of the reader where i is the index of
+         * the line and line a pointer to its first character.
+         *
+         * Each block of the reader is split in chunks of complete lines: the lines of each chunk are counted and
+         * then processed in parallel.
+         */
+        template<typename fun_t>
+        void parse_lines(line_block_reader &reader, index_t num_lines, const fun_t &fun) {
+            index_t line_index = 0;
+            while (line_index < num_lines) {
+                const char *begin = reader.begin();
+                const char *end = reader.end();
+                if (begin == end) {
+                    hg_assert(reader.fill(), "Invalid graph file: unexpected end of file.");
+                    continue;
+                }
+
+                std::vector<const char *> chunks{begin};
+                while (chunks.back() != end) {
+                    const char *c = chunks.back();
+                    if ((std::size_t) (end - c) <= parse_chunk_size) {
+                        c = end;
+                    } else {
+                        c += parse_chunk_size;
+                        while (*(c - 1) != '\n') {
+                            c++;
+                        }
+                    }
+                    chunks.push_back(c);
+                }
+
+                index_t num_chunks = (index_t) chunks.size() - 1;
+                std::vector<index_t> first_line(num_chunks + 1, 0);
+                parfor(0, num_chunks, [&chunks, &first_line](index_t i) {
+                    first_line[i + 1] = count_lines(chunks[i], chunks[i + 1]);
+                });
+                for (index_t i = 0; i < num_chunks; i++) {
+                    first_line[i + 1] += first_line[i];
+                }
 
-        auto edge_weight = array_1d<double>::from_shape({(size_t)num_edges});
+                // the block contains lines of the next section
+                index_t remaining = num_lines - line_index;
+                if (first_line[num_chunks] > remaining) {
+                    index_t last = 0;
+                    while (first_line[last + 1] < remaining) {
+                        last++;
+                    }
+                    num_chunks = last + 1;
+                    chunks[num_chunks] = skip_lines(chunks[last], remaining - first_line[last]);
+                    first_line[num_chunks] = remaining;
+                }
 
-        for (index_t l = 0; l < num_edges; ++l) {
-            index_t i, j;
-            double d;
-            in >> i >> j >> d;
-            hg_assert(0 <= i && 0 <= j && i < num_points && j < num_points,
-                      "Invalid graph file: vertex index out of range in edge definition.");
-            g.add_edge(i, j);
-            edge_weight(l) = d;
+                parfor(0, num_chunks, [&chunks, &first_line, &fun, line_index](index_t i) {
+                    index_t l = line_index + first_line[i];
+                    const char *p = chunks[i];
+                    while (p != chunks[i + 1]) {
+                        if (!is_blank_line(p)) {
+                            fun(l++, p);
+                        }
+                        while (*p != '\n') {
+                            p++;
+                        }
+                        p++;
+                    }
+                });
+
+                line_index += first_line[num_chunks];
+                reader.consume(chunks[num_chunks]);
+            }
         }
 
-        return pink_graph<>{std::move(g), std::move(shape), std::move(vertex_weight), std::move(edge_weight)};
+        /**
+         * Formats numbers in a buffer written to the output stream when full.
+         *
+         * Integral values (including 8 bits integers and chars) are always written as numbers, floating point
+         * values are written as with std::ostream default format and precision.
+         */
+        struct buffered_writer {
+
+            buffered_writer(std::ostream &out) : m_out(out), m_precision((int) out.precision()) {
+                m_buffer.resize(write_buffer_size);
+            }
+
+            ~buffered_writer() {
+                flush();
+            }
+
+            buffered_writer &operator<<(const char *s) {
+                while (*s != 0) {
+                    reserve(1);
+                    m_buffer[m_size++] = *s++;
+                }
+                return *this;
+            }
+
+            template<typename T>
+            std::enable_if_t<std::is_integral<T>::value, buffered_writer &>
+            operator<<(T value) {
+                reserve(24);
+                char digits[24];
+                int num_digits = 0;
+                bool negative = value < 0;
+                // works for the most negative value of signed types
+                auto v = negative ? (uint64_t) 0 - (uint64_t) value : (uint64_t) value;
+                do {
+                    digits[num_digits++] = (char) ('0' + v % 10);
+                    v /= 10;
+                } while (v != 0);
+                if (negative) {
+                    m_buffer[m_size++] = '-';
+                }
+                while (num_digits > 0) {
+                    m_buffer[m_size++] = digits[--num_digits];
+                }
+                return *this;
+            }
+
+            template<typename T>
+            std::enable_if_t<std::is_floating_point<T>::value, buffered_writer &>
+            operator<<(T value) {
+                reserve(64);
+                // same representation as std::ostream default floating point format
+                m_size += (std::size_t) std::snprintf(&m_buffer[m_size], 64, "%.*g", m_precision, (double) value);
+                return *this;
+            }
+
+            void flush() {
+                m_out.write(m_buffer.data(), std::streamsize(m_size));
+                m_size = 0;
+            }
+
+        private:
+
+            void reserve(std::size_t size) {
+                if (m_size + size > m_buffer.size()) {
+                    flush();
+                }
+            }
+
+            std::ostream &m_out;
+            int m_precision;
+            std::vector<char> m_buffer;
+            std::size_t m_size = 0;
+        };
+    }
+
+    namespace pink_graph_io_internal {
+
+        inline
+        pink_graph_edge_list read_pink_graph_edge_list(line_block_reader &reader) {
+            std::string discard;
+
+            std::vector<std::size_t> shape;
+
+            std::string line = reader.next_line();
+            // maybe shape
+            if (!line.empty() && line[0] == '#') {
+                std::size_t rs;
+                std::size_t cs;
+                std::istringstream(line) >> discard >> rs >> discard >> cs;
+                shape.push_back(cs);
+                shape.push_back(rs);
+                line = reader.next_line();
+            }
+
+            index_t num_points = -1;
+            index_t num_edges = -1;
+            std::istringstream(line) >> num_points >> num_edges;
+
+            hg_assert(num_points > 0, "The number of vertices cannot be negative.");
+            hg_assert(num_edges > 0, "The number of edges cannot be negative.");
+
+            if (shape.empty()) // construct valid shape
+            {
+                shape.push_back(num_points);
+            }
+
+            //useless line to announce vertex list
+            reader.next_line();
+
+            // vertex list
+            auto vertex_weights = array_1d<double>::from_shape({(size_t) num_points});
+            parse_lines(reader, num_points, [&vertex_weights, num_points](index_t, const char *p) {
+                auto i = parse_index(p);
+                hg_assert(0 <= i && i < num_points, "Invalid graph file: vertex index out of range.");
+                vertex_weights(i) = parse_double(p);
+            });
+
+            //useless line to announce edge list
+            reader.next_line();
+
+            // edge list
+            auto sources = array_1d<index_t>::from_shape({(size_t) num_edges});
+            auto targets = array_1d<index_t>::from_shape({(size_t) num_edges});
+            auto edge_weights = array_1d<double>::from_shape({(size_t) num_edges});
+            parse_lines(reader, num_edges, [&sources, &targets, &edge_weights, num_points](index_t l,
+                                                                                           const char *p) {
+                auto i = parse_index(p);
+                auto j = parse_index(p);
+                hg_assert(0 <= i && i < num_points && 0 <= j && j < num_points,
+                          "Invalid graph file: vertex index out of range in edge definition.");
+                sources(l) = i;
+                targets(l) = j;
+                edge_weights(l) = parse_double(p);
+            });
+
+            return pink_graph_edge_list{num_points, std::move(sources), std::move(targets), std::move(shape),
+                                        std::move(vertex_weights), std::move(edge_weights)};
+        }
+    }
+
+    /**
+     * Read a graph in the pink ascii format as flat arrays.
+     *
+     * The stream is read by blocks of fixed size and each block is parsed in parallel when TBB is enabled.
+     *
+     * @param in input stream
+     * @return a pink_graph_edge_list
+     */
+    inline
+    pink_graph_edge_list read_pink_graph_edge_list(std::istream &in) {
+        HG_TRACE();
+        pink_graph_io_internal::line_block_reader reader(in);
+        return pink_graph_io_internal::read_pink_graph_edge_list(reader);
+    }
+
+    inline
+    pink_graph_edge_list read_pink_graph_edge_list(const std::string &filename) {
+        std::ifstream file(filename, std::ios::binary);
+        return read_pink_graph_edge_list(file);
+    };
+
+    inline
+    auto read_pink_graph(std::istream &in) {
+        HG_TRACE();
+        auto res = read_pink_graph_edge_list(in);
+
+        ugraph g(res.num_vertices, res.sources.size());
+        for (index_t i = 0; i < (index_t) res.sources.size(); i++) {
+            g.add_edge(res.sources(i), res.targets(i));
+        }
+
+        return pink_graph<>{std::move(g), std::move(res.shape), std::move(res.vertex_weights),
+                            std::move(res.edge_weights)};
     }
 
     inline
     auto read_pink_graph(const std::string &filename) {
-        std::ifstream file(filename);
+        std::ifstream file(filename, std::ios::binary);
         return read_pink_graph(file);
     };
 
@@ -116,44 +570,46 @@ namespace hg {
         hg_assert(vertex_values.dimension() <= 1, "Too many dimensions for vertex values!");
         hg_assert(edge_values.dimension() <= 1, "Too many dimensions for edge values!");
 
+        pink_graph_io_internal::buffered_writer writer(out);
+
         switch (shape.size()) {
             case 0:
                 break;
             case 1:
-                out << "#rs " << shape[0] << " cs 1\n";
+                writer << "#rs " << shape[0] << " cs 1\n";
                 break;
             case 2:
-                out << "#rs " << shape[1] << " cs " << shape[0] << "\n";
+                writer << "#rs " << shape[1] << " cs " << shape[0] << "\n";
                 break;
             default:
                 throw std::runtime_error("Too many dimensions !");
         }
 
-        out << num_vertices(graph) << " " << num_edges(graph) << "\n";
+        writer << num_vertices(graph) << " " << num_edges(graph) << "\n";
 
-        out << "val sommets\n";
+        writer << "val sommets\n";
 
         if (vertex_values.size() == 0) {
             for (std::size_t i = 0; i < num_vertices(graph); ++i) {
-                out << i << " 1\n";
+                writer << i << " 1\n";
             }
         } else {
             hg_assert_vertex_weights(graph, vertex_values);
             for (std::size_t i = 0; i < num_vertices(graph); ++i) {
-                out << i << " " << vertex_values(i) << "\n";
+                writer << i << " " << vertex_values(i) << "\n";
             }
         }
 
-        out << "arcs values\n";
+        writer << "arcs values\n";
 
         if (edge_values.size() == 0) {
             for (auto e: edge_iterator(graph)) {
-                out << source(e, graph) << " " << target(e, graph) << " 1\n";
+                writer << source(e, graph) << " " << target(e, graph) << " 1\n";
             }
         } else {
             hg_assert_edge_weights(graph, edge_values);
             for (auto &e: edge_iterator(graph)) {
-                out << source(e, graph) << " " << target(e, graph) << " " << edge_values(e) << "\n";
+                writer << source(e, graph) << " " << target(e, graph) << " " << edge_values(e) << "\n";
             }
         }
 
@@ -12,9 +12,25 @@
 
 #include "../graph.hpp"
 #include "xtensor/xexpression.hpp"
+#include "xtensor/xadapt.hpp"
+#include "xtensor/xeval.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <fstream>
 #include <istream>
 #include <ostream>
 #include <map>
+#include <memory>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define HG_TREE_IO_USE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 namespace hg {
 
@@ -108,10 +124,503 @@ namespace hg {
         return tree_io_internal::tree_saver_helper(out, t);
     }
 
+    /*
+     * Binary tree format
+     *
+     * The binary format stores the tree and its attributes as raw little/big endian (native) arrays aligned on
+     * HG_TREE_IO_BINARY_ALIGNMENT bytes boundaries, such that a file can be memory mapped and its arrays used
+     * in place without any copy or conversion. The file is made of:
+     *
+     *  - a header of HG_TREE_IO_BINARY_ALIGNMENT bytes:
+     *      - char[8]  magic number HG_TREE_IO_BINARY_MAGIC
+     *      - uint32   format version HG_TREE_IO_BINARY_VERSION
+     *      - uint32   byte order mark HG_TREE_IO_BINARY_BYTE_ORDER_MARK
+     *      - uint64   number of nodes of the tree
+     *      - uint64   number of arrays in the file
+     *      - uint32   tree category
+     *      - zero padding
+     *  - a sequence of array records, each record starting on an aligned offset:
+     *      - uint64   length of the array name
+     *      - uint8    element kind: 'b' (bool), 'i' (signed integer), 'u' (unsigned integer) or 'f' (floating point)
+     *      - uint8    element size in bytes
+     *      - uint16   reserved
+     *      - uint32   number of dimensions d of the array
+     *      - uint64[d] shape of the array
+     *      - uint64   offset of the array data from the beginning of the file (aligned)
+     *      - uint64   size in bytes of the array data
+     *      - char[]   array name
+     *      - zero padding
+     *      - array data in row major order
+     *      - zero padding
+     *
+     * The first array is always the parent array of the tree (named "parents", 64 bits signed integers). The other
+     * arrays can have any shape and numeric type: typical content are node altitudes, node attributes or the mst
+     * edge map of a binary partition tree.
+     */
+
+#define HG_TREE_IO_BINARY_MAGIC "HGBTREE"
+#define HG_TREE_IO_BINARY_VERSION 1
+#define HG_TREE_IO_BINARY_BYTE_ORDER_MARK 0x01020304u
+#define HG_TREE_IO_BINARY_ALIGNMENT 64
+#define HG_TREE_IO_BINARY_PARENTS_NAME "parents"
+
+    namespace tree_io_internal {
+
+        inline std::size_t binary_align(std::size_t position) {
+            return (position + HG_TREE_IO_BINARY_ALIGNMENT - 1) / HG_TREE_IO_BINARY_ALIGNMENT *
+                   HG_TREE_IO_BINARY_ALIGNMENT;
+        }
+
+        template<typename T>
+        struct binary_dtype {
+            static_assert(std::is_arithmetic<T>::value, "Only arithmetic types are supported.");
+            static const char kind = std::is_same<T, bool>::value ? 'b' :
+                                     (std::is_floating_point<T>::value ? 'f' :
+                                      (std::is_signed<T>::value ? 'i' : 'u'));
+            static const std::size_t size = sizeof(T);
+        };
+
+        struct tree_binary_saver_helper {
+
+            using out_type = std::ostream &;
+
+            tree_binary_saver_helper(out_type out, const tree &t) : m_tree(t), m_out(out) {
+                init();
+            }
+
+            tree_binary_saver_helper(tree_binary_saver_helper &&other) :
+                    m_tree(other.m_tree),
+                    m_out(other.m_out),
+                    m_start_position(other.m_start_position),
+                    m_position(other.m_position),
+                    m_num_arrays(other.m_num_arrays),
+                    finalized(other.finalized) {
+                other.finalized = true;
+            }
+
+            ~tree_binary_saver_helper() {
+                finalize();
+            }
+
+            /**
+             * Add an array of arbitrary shape and numeric type to the file.
+             */
+            template<typename T>
+            tree_binary_saver_helper &add_attribute(const std::string &name, const xt::xexpression<T> &xarray) {
+                using value_type = typename T::value_type;
+                auto &&array = xt::eval(xarray.derived_cast());
+                std::vector<std::size_t> shape(array.shape().begin(), array.shape().end());
+                if (array.layout() == xt::layout_type::row_major) {
+                    return add_raw_attribute(name, binary_dtype<value_type>::kind, binary_dtype<value_type>::size,
+                                             shape, array.data());
+                } else {
+                    array_nd<value_type> a = array;
+                    return add_raw_attribute(name, binary_dtype<value_type>::kind, binary_dtype<value_type>::size,
+                                             shape, a.data());
+                }
+            }
+
+            /**
+             * Add an array given by its element kind ('b', 'i', 'u', or 'f'), element size in bytes, shape and
+             * contiguous row major data.
+             */
+            tree_binary_saver_helper &add_raw_attribute(const std::string &name,
+                                                        char kind,
+                                                        std::size_t item_size,
+                                                        const std::vector<std::size_t> &shape,
+                                                        const void *data) {
+                hg_assert(!finalized, "Cannot add an attribute to a finalized file.");
+                hg_assert(kind == 'b' || kind == 'i' || kind == 'u' || kind == 'f', "Unsupported element kind.");
+                hg_assert(m_num_arrays == 0 || name != HG_TREE_IO_BINARY_PARENTS_NAME,
+                          "Attribute name '" HG_TREE_IO_BINARY_PARENTS_NAME "' is reserved.");
+                std::size_t size = item_size;
+                for (auto s: shape) {
+                    size *= s;
+                }
+
+                std::size_t record_size = 8 + 8 + 8 * shape.size() + 8 + 8 + name.size();
+                std::size_t data_offset = binary_align(m_position + record_size);
+
+                write_value((uint64_t) name.size());
+                write_value((uint8_t) kind);
+                write_value((uint8_t) item_size);
+                write_value((uint16_t) 0);
+                write_value((uint32_t) shape.size());
+                for (auto s: shape) {
+                    write_value((uint64_t) s);
+                }
+                write_value((uint64_t) data_offset);
+                write_value((uint64_t) size);
+                write_bytes(name.data(), name.size());
+                write_padding(data_offset);
+                write_bytes(data, size);
+                write_padding(binary_align(m_position));
+
+                m_num_arrays++;
+                return *this;
+            }
+
+            void finalize() {
+                if (!finalized) {
+                    auto end_position = m_out.tellp();
+                    m_out.seekp(m_start_position + std::streamoff(24));
+                    uint64_t num_arrays = m_num_arrays;
+                    m_out.write(reinterpret_cast<const char *>(&num_arrays), sizeof(num_arrays));
+                    m_out.seekp(end_position);
+                    m_out.flush();
+                    finalized = true;
+                }
+            }
+
+        private:
+
+            void init() {
+                m_start_position = m_out.tellp();
+                char magic[8] = HG_TREE_IO_BINARY_MAGIC;
+                write_bytes(magic, 8);
+                write_value((uint32_t) HG_TREE_IO_BINARY_VERSION);
+                write_value((uint32_t) HG_TREE_IO_BINARY_BYTE_ORDER_MARK);
+                write_value((uint64_t) m_tree.num_vertices());
+                // this will be filled later ....
+                write_value((uint64_t) 0);
+                write_value((uint32_t) m_tree.category());
+                write_padding(HG_TREE_IO_BINARY_ALIGNMENT);
+
+                auto &p = parents(m_tree);
+                add_raw_attribute(HG_TREE_IO_BINARY_PARENTS_NAME, binary_dtype<index_t>::kind,
+                                  binary_dtype<index_t>::size, {p.size()}, p.data());
+            }
+
+            template<typename T>
+            void write_value(T value) {
+                write_bytes(&value, sizeof(T));
+            }
+
+            void write_bytes(const void *data, std::size_t size) {
+                m_out.write(reinterpret_cast<const char *>(data), std::streamsize(size));
+                m_position += size;
+            }
+
+            void write_padding(std::size_t position) {
+                static const char zeros[HG_TREE_IO_BINARY_ALIGNMENT] = {0};
+                write_bytes(zeros, position - m_position);
+            }
+
+            const tree &m_tree;
+            out_type m_out;
+            std::streampos m_start_position;
+            std::size_t m_position = 0;
+            std::size_t m_num_arrays = 0;
+            bool finalized = false;
+        };
+
+        template<typename T>
+        T binary_read_value(const char *&ptr) {
+            T value;
+            std::memcpy(&value, ptr, sizeof(T));
+            ptr += sizeof(T);
+            return value;
+        }
+    }
+
+    /**
+     * Description of an array stored in a binary tree file: the array data are not owned and remain valid as long
+     * as the binary_tree_archive they come from (or a copy of its storage) is alive.
+     */
+    struct binary_tree_array {
+        std::string name;
+        char kind;
+        std::size_t item_size;
+        std::vector<std::size_t> shape;
+        const char *data;
+
+        std::size_t size() const {
+            std::size_t s = 1;
+            for (auto e: shape) {
+                s *= e;
+            }
+            return s;
+        }
+
+        template<typename T>
+        bool has_type() const {
+            return kind == tree_io_internal::binary_dtype<T>::kind &&
+                   item_size == tree_io_internal::binary_dtype<T>::size;
+        }
+
+        /**
+         * Calls fun with a pointer of the actual element type (const T *) on the array data.
+         */
+        template<typename fun_t>
+        void visit(fun_t &&fun) const {
+#define HG_TREE_IO_VISIT(type) if (has_type<type>()) {fun(reinterpret_cast<const type *>(data)); return;}
+            HG_TREE_IO_VISIT(bool)
+            HG_TREE_IO_VISIT(int8_t)
+            HG_TREE_IO_VISIT(uint8_t)
+            HG_TREE_IO_VISIT(int16_t)
+            HG_TREE_IO_VISIT(uint16_t)
+            HG_TREE_IO_VISIT(int32_t)
+            HG_TREE_IO_VISIT(uint32_t)
+            HG_TREE_IO_VISIT(int64_t)
+            HG_TREE_IO_VISIT(uint64_t)
+            HG_TREE_IO_VISIT(float)
+            HG_TREE_IO_VISIT(double)
+#undef HG_TREE_IO_VISIT
+            throw std::runtime_error("Unsupported element type in binary tree file for array '" + name + "'.");
+        }
+    };
+
+    /**
+     * A tree and its attributes stored in the binary tree format.
+     *
+     * Arrays are exposed as xtensor adaptors on the underlying storage, which is either a memory mapped file
+     * (see map_tree_binary) or a memory buffer (see read_tree_binary): no data is copied except when
+     * the tree object itself is built.
+     */
+    class binary_tree_archive {
+    public:
+
+        binary_tree_archive(std::shared_ptr<const char> storage, std::size_t size) :
+                m_storage(std::move(storage)), m_size(size) {
+            using namespace tree_io_internal;
+            const char *begin = m_storage.get();
+            hg_assert(m_size >= HG_TREE_IO_BINARY_ALIGNMENT &&
+                      std::memcmp(begin, HG_TREE_IO_BINARY_MAGIC, 8) == 0,
+                      "Invalid binary tree file.");
+            const char *ptr = begin + 8;
+            auto version = binary_read_value<uint32_t>(ptr);
+            hg_assert(version <= HG_TREE_IO_BINARY_VERSION,
+                      "Unsupported binary tree file version " + std::to_string(version) + ".");
+            hg_assert(binary_read_value<uint32_t>(ptr) == HG_TREE_IO_BINARY_BYTE_ORDER_MARK,
+                      "Binary tree file byte order does not match the byte order of the platform.");
+            m_num_vertices = (std::size_t) binary_read_value<uint64_t>(ptr);
+            auto num_arrays = (std::size_t) binary_read_value<uint64_t>(ptr);
+            auto category = binary_read_value<uint32_t>(ptr);
+            hg_assert(category == (uint32_t) tree_category::component_tree ||
+                      category == (uint32_t) tree_category::partition_tree,
+                      "Invalid tree category " + std::to_string(category) + " in binary tree file.");
+            m_category = (tree_category) category;
+
+            // all the offsets and sizes read from the file are checked against the remaining number of bytes
+            // before being used, such that corrupted values cannot overflow
+            std::size_t position = HG_TREE_IO_BINARY_ALIGNMENT;
+            for (std::size_t i = 0; i < num_arrays; i++) {
+                hg_assert(position <= m_size && m_size - position >= 24, "Truncated binary tree file.");
+                ptr = begin + position;
+                binary_tree_array a;
+                auto name_size = binary_read_value<uint64_t>(ptr);
+                a.kind = binary_read_value<char>(ptr);
+                a.item_size = binary_read_value<uint8_t>(ptr);
+                binary_read_value<uint16_t>(ptr);
+                auto dim = (std::size_t) binary_read_value<uint32_t>(ptr);
+                std::size_t remaining = m_size - position - 24;
+                hg_assert(remaining >= 16 && name_size <= remaining - 16 &&
+                          dim <= (remaining - 16 - (std::size_t) name_size) / 8,
+                          "Truncated binary tree file.");
+                std::size_t num_elements = 1;
+                bool overflow = false;
+                for (std::size_t d = 0; d < dim; d++) {
+                    auto e = (std::size_t) binary_read_value<uint64_t>(ptr);
+                    if (e != 0 && num_elements > std::numeric_limits<std::size_t>::max() / e) {
+                        overflow = true;
+                    }
+                    num_elements *= e;
+                    a.shape.push_back(e);
+                }
+                auto data_offset = binary_read_value<uint64_t>(ptr);
+                auto data_size = binary_read_value<uint64_t>(ptr);
+                a.name.assign(ptr, (std::size_t) name_size);
+                hg_assert(!overflow && (a.item_size == 0 ||
+                                        num_elements <= std::numeric_limits<std::size_t>::max() / a.item_size),
+                          "Invalid shape for array '" + a.name + "' in binary tree file.");
+                hg_assert(data_offset % HG_TREE_IO_BINARY_ALIGNMENT == 0 &&
+                          data_offset <= m_size && data_size <= m_size - data_offset &&
+                          data_size == num_elements * a.item_size,
+                          "Invalid record for array '" + a.name + "' in binary tree file.");
+                a.data = begin + data_offset;
+                position = binary_align((std::size_t) (data_offset + data_size));
+                m_arrays.push_back(std::move(a));
+            }
+
+            hg_assert(!m_arrays.empty() && m_arrays[0].name == HG_TREE_IO_BINARY_PARENTS_NAME &&
+                      m_arrays[0].has_type<index_t>() && m_arrays[0].shape.size() == 1 &&
+                      m_arrays[0].shape[0] == m_num_vertices,
+                      "Invalid or missing parent array in binary tree file.");
+        }
+
+        std::size_t num_vertices() const {
+            return m_num_vertices;
+        }
+
+        tree_category category() const {
+            return m_category;
+        }
+
+        /**
+         * Parent array of the tree, without copy.
+         */
+        auto parents() const {
+            return xt::adapt(reinterpret_cast<const index_t *>(m_arrays[0].data), m_num_vertices, xt::no_ownership(),
+                             std::array<std::size_t, 1>{m_num_vertices});
+        }
+
+        /**
+         * Build the tree stored in the archive (the parent array is copied).
+         */
+        hg::tree get_tree() const {
+            return hg::tree(array_1d<index_t>(parents()), m_category);
+        }
+
+        /**
+         * Attributes stored in the archive (the parent array is not included).
+         */
+        std::vector<binary_tree_array> attributes() const {
+            return std::vector<binary_tree_array>(m_arrays.begin() + 1, m_arrays.end());
+        }
+
+        bool has_attribute(const std::string &name) const {
+            return find(name) != m_arrays.end();
+        }
+
+        const binary_tree_array &attribute_info(const std::string &name) const {
+            auto it = find(name);
+            hg_assert(it != m_arrays.end(), "Unknown attribute '" + name + "'.");
+            return *it;
+        }
+
+        /**
+         * Attribute of the given name as an xtensor adaptor on the archive storage, without copy. The element type
+         * T must be the type of the stored array.
+         */
+        template<typename T>
+        auto attribute(const std::string &name) const {
+            auto &a = attribute_info(name);
+            hg_assert(a.has_type<T>(), "Requested element type does not match the type of attribute '" + name + "'.");
+            return xt::adapt(reinterpret_cast<const T *>(a.data), a.size(), xt::no_ownership(), a.shape);
+        }
+
+        /**
+         * Underlying storage: the data of the arrays remain valid as long as a copy of this pointer exists.
+         */
+        const std::shared_ptr<const char> &storage() const {
+            return m_storage;
+        }
+
+    private:
+
+        std::vector<binary_tree_array>::const_iterator find(const std::string &name) const {
+            return std::find_if(m_arrays.begin() + 1, m_arrays.end(),
+                                [&name](const binary_tree_array &a) { return a.name == name; });
+        }
+
+        std::shared_ptr<const char> m_storage;
+        std::size_t m_size;
+        std::size_t m_num_vertices;
+        tree_category m_category;
+        std::vector<binary_tree_array> m_arrays;
+    };
+
+    /**
+     * Save a tree in the binary format: attributes (of any shape and numeric type) can then be added with the
+     * method add_attribute of the returned object. The output stream must be opened in binary mode.
+     *
+     * @param out output stream
+     * @param t input tree
+     * @return a tree_binary_saver_helper
+     */
+    inline
+    auto
+    save_tree_binary(std::ostream &out, const tree &t) {
+        return tree_io_internal::tree_binary_saver_helper(out, t);
+    }
+
+    /**
+     * Test if the given stream contains a tree in the binary format. The position of the stream is not modified.
+     */
+    inline
+    bool
+    is_binary_tree(std::istream &in) {
+        char magic[8] = {0};
+        auto position = in.tellg();
+        in.read(magic, 8);
+        bool result = in.gcount() == 8 && std::memcmp(magic, HG_TREE_IO_BINARY_MAGIC, 8) == 0;
+        in.clear();
+        in.seekg(position);
+        return result;
+    }
+
+    /**
+     * Read a tree in the binary format from the given stream (opened in binary mode): the content of the stream is
+     * copied into a memory buffer owned by the returned archive.
+     */
+    inline
+    binary_tree_archive
+    read_tree_binary(std::istream &in) {
+        auto start = in.tellg();
+        in.seekg(0, std::ios::end);
+        auto size = (std::size_t) (in.tellg() - start);
+        in.seekg(start);
+        std::shared_ptr<const char> storage(new char[(std::max)(size, (std::size_t) 1)], std::default_delete<char[]>());
+        in.read(const_cast<char *>(storage.get()), std::streamsize(size));
+        hg_assert((std::size_t) in.gcount() == size, "Could not read binary tree file.");
+        return binary_tree_archive(std::move(storage), size);
+    }
+
+    /**
+     * Memory map a file containing a tree in the binary format: arrays of the returned archive directly refer to
+     * the mapped memory and are loaded lazily by the operating system.
+     *
+     * The mapping is private: the content of the file is never modified. When memory mapping is not available
+     * on the platform, the file is read into memory.
+     */
+    inline
+    binary_tree_archive
+    map_tree_binary(const std::string &filename) {
+#ifdef HG_TREE_IO_USE_MMAP
+        int fd = ::open(filename.c_str(), O_RDONLY);
+        hg_assert(fd >= 0, "Cannot open file '" + filename + "'.");
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0) {
+            ::close(fd);
+            hg_assert(false, "Invalid binary tree file '" + filename + "'.");
+        }
+        auto size = (std::size_t) st.st_size;
+        void *ptr = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        hg_assert(ptr != MAP_FAILED, "Cannot map file '" + filename + "'.");
+        std::shared_ptr<const char> storage(reinterpret_cast<const char *>(ptr),
+                                            [size](const char *p) { ::munmap(const_cast<char *>(p), size); });
+        return binary_tree_archive(std::move(storage), size);
+#else
+        std::ifstream in(filename, std::ios::binary);
+        hg_assert(in.good(), "Cannot open file '" + filename + "'.");
+        return read_tree_binary(in);
+#endif
+    }
+
+
 
     inline
     auto
     read_tree(std::istream &in) {
+        if (is_binary_tree(in)) {
+            // scalar node attributes are converted to double
+            auto archive = read_tree_binary(in);
+            std::map<std::string, array_1d<double>> attributes;
+            for (const auto &a: archive.attributes()) {
+                if (a.shape.size() == 1 && a.shape[0] == archive.num_vertices()) {
+                    auto &attribute = attributes[a.name] = array_1d<double>::from_shape({a.shape[0]});
+                    a.visit([&attribute](const auto *data) {
+                        std::copy(data, data + attribute.size(), attribute.begin());
+                    });
+                } else {
+                    HG_LOG_WARNING("Attribute '%s' is not a scalar node attribute and will be ignored.",
+                                   a.name.c_str());
+                }
+            }
+            return std::make_pair(archive.get_tree(), std::move(attributes));
+        }
+
         std::string key = "";
         char dummy;
         std::string tmp;
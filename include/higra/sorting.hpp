@@ -11,16 +11,16 @@
 #pragma once
 
 #include "structure/array.hpp"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <vector>
 
 #ifdef HG_USE_TBB
 
 #include "tbb/parallel_sort.h"
 #include "tbb-ssort/parallel_stable_sort.h"
 
-#else
-
-#include <algorithm>
-
 #endif
 
 namespace hg {
@@ -82,6 +82,235 @@ namespace hg {
         hg::sort(arrayx, std::less<typename T::value_type>());
     }
 
+    /**
+     * Reorders the elements of the range [xs, xe) such that all the elements for which the predicate pred returns
+     * true precede the elements for which pred returns false. The relative order of the elements is preserved.
+     *
+     * If TBB is enabled, the predicate is evaluated concurrently on blocks of elements: it must thus be thread safe.
+     *
+     * @tparam RandomAccessIterator
+     * @tparam Predicate
+     * @param xs start of the range
+     * @param xe end of the range
+     * @param pred unary predicate
+     * @return iterator to the first element of the second group
+     */
+    template<typename RandomAccessIterator, typename Predicate>
+    RandomAccessIterator stable_partition(RandomAccessIterator xs, RandomAccessIterator xe, Predicate pred) {
+#ifdef HG_USE_TBB
+        using value_type = typename std::iterator_traits<RandomAccessIterator>::value_type;
+        const index_t block_size = 1 << 14;
+        const index_t size = xe - xs;
+        if (size <= block_size) {
+            return std::stable_partition(xs, xe, pred);
+        }
+        const index_t num_blocks = (size + block_size - 1) / block_size;
+        std::vector<char> flags(size);
+        std::vector<index_t> block_offsets(num_blocks + 1, 0);
+
+        tbb::parallel_for(index_t(0), num_blocks, [&](index_t b) {
+            index_t count = 0;
+            auto end = (std::min)((b + 1) * block_size, size);
+            for (index_t i = b * block_size; i < end; i++) {
+                flags[i] = pred(xs[i]);
+                count += flags[i];
+            }
+            block_offsets[b + 1] = count;
+        });
+
+        for (index_t b = 0; b < num_blocks; b++) {
+            block_offsets[b + 1] += block_offsets[b];
+        }
+        const index_t num_true = block_offsets[num_blocks];
+
+        std::vector<value_type> tmp(size);
+        tbb::parallel_for(index_t(0), num_blocks, [&](index_t b) {
+            index_t pos_true = block_offsets[b];
+            index_t pos_false = num_true + b * block_size - block_offsets[b];
+            auto end = (std::min)((b + 1) * block_size, size);
+            for (index_t i = b * block_size; i < end; i++) {
+                if (flags[i]) {
+                    tmp[pos_true++] = std::move(xs[i]);
+                } else {
+                    tmp[pos_false++] = std::move(xs[i]);
+                }
+            }
+        });
+
+        tbb::parallel_for(index_t(0), size, [&](index_t i) {
+            xs[i] = std::move(tmp[i]);
+        });
+        return xs + num_true;
+#else
+        return std::stable_partition(xs, xe, pred);
+#endif
+    }
+
+    namespace sorting_internal {
+
+        /**
+         * Unsigned integer type with the same size as T
+         */
+        template<size_t size>
+        struct radix_key_type;
+
+        template<>
+        struct radix_key_type<1> {
+            using type = uint8_t;
+        };
+
+        template<>
+        struct radix_key_type<2> {
+            using type = uint16_t;
+        };
+
+        template<>
+        struct radix_key_type<4> {
+            using type = uint32_t;
+        };
+
+        template<>
+        struct radix_key_type<8> {
+            using type = uint64_t;
+        };
+
+        /**
+         * True if elements of type T can be sorted with radix_stable_arg_sort
+         */
+        template<typename T>
+        struct is_radix_sortable : std::integral_constant<bool,
+                std::is_arithmetic<T>::value &&
+                (sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)> {
+        };
+
+        /**
+         * Order preserving transform of an arithmetic value into an unsigned integer:
+         * for any x, y, x < y iff to_radix_key(x) < to_radix_key(y)
+         */
+        template<typename T>
+        auto to_radix_key(T value, std::true_type /* is_integral */) {
+            using key_t = typename radix_key_type<sizeof(T)>::type;
+            key_t key = static_cast<key_t>(value);
+            if (std::is_signed<T>::value) {
+                key ^= key_t(1) << (sizeof(T) * 8 - 1);
+            }
+            return key;
+        }
+
+        template<typename T>
+        auto to_radix_key(T value, std::false_type /* is_integral */) {
+            using key_t = typename radix_key_type<sizeof(T)>::type;
+            const key_t sign_bit = key_t(1) << (sizeof(T) * 8 - 1);
+            // -0 and +0 are equivalent
+            if (value == 0) {
+                value = 0;
+            }
+            key_t key;
+            std::memcpy(&key, &value, sizeof(T));
+            return (key & sign_bit) ? (key_t) ~key : (key_t) (key | sign_bit);
+        }
+
+        /**
+         * Stable arg sort of a 1d array of arithmetic values with a least significant digit radix sort.
+         *
+         * Values are transformed into unsigned integer keys with an order preserving transform, keys are then sorted
+         * byte by byte: the number of passes is at most equal to sizeof(T) (passes where all the keys share the
+         * same digit are skipped).
+         *
+         * If TBB is enabled, each pass is done in parallel on blocks of elements.
+         *
+         * @tparam T
+         * @param array 1d array
+         * @param descending if true the array is sorted in decreasing order
+         * @return array of indices
+         */
+        template<typename T>
+        auto radix_stable_arg_sort(const T &array, bool descending = false) {
+            using value_type = typename T::value_type;
+            using key_t = typename radix_key_type<sizeof(value_type)>::type;
+            constexpr index_t num_buckets = 256;
+            constexpr index_t num_passes = sizeof(key_t);
+
+            const index_t size = array.size();
+#ifdef HG_USE_TBB
+            const index_t block_size = 1 << 16;
+            const index_t num_blocks = (std::max)((size + block_size - 1) / block_size, (index_t) 1);
+#else
+            const index_t block_size = (std::max)(size, (index_t) 1);
+            const index_t num_blocks = 1;
+#endif
+            std::vector<key_t> keys(size);
+            std::vector<key_t> keys_tmp(size);
+            array_1d<index_t> indices = xt::arange<index_t>(size);
+            array_1d<index_t> indices_tmp = array_1d<index_t>::from_shape({(size_t) size});
+
+            parfor(0, size, [&array, &keys, descending](index_t i) {
+                auto key = to_radix_key(array(i), std::is_integral<value_type>());
+                keys[i] = descending ? (key_t) ~key : key;
+            });
+
+            std::vector<index_t> histograms(num_blocks * num_buckets);
+
+            for (index_t pass = 0; pass < num_passes; pass++) {
+                const auto shift = pass * 8;
+                std::fill(histograms.begin(), histograms.end(), 0);
+
+                parfor(0, num_blocks, [&](index_t b) {
+                    auto histogram = histograms.data() + b * num_buckets;
+                    auto end = (std::min)((b + 1) * block_size, size);
+                    for (index_t i = b * block_size; i < end; i++) {
+                        histogram[(keys[i] >> shift) & 0xFF]++;
+                    }
+                });
+
+                // skip the pass if all the keys have the same digit
+                bool skip = false;
+                for (index_t d = 0; d < num_buckets; d++) {
+                    index_t count = 0;
+                    for (index_t b = 0; b < num_blocks; b++) {
+                        count += histograms[b * num_buckets + d];
+                    }
+                    if (count != 0) {
+                        skip = count == size;
+                        break;
+                    }
+                }
+                if (skip) {
+                    continue;
+                }
+
+                // exclusive prefix sum in digit major, block minor order
+                index_t sum = 0;
+                for (index_t d = 0; d < num_buckets; d++) {
+                    for (index_t b = 0; b < num_blocks; b++) {
+                        auto count = histograms[b * num_buckets + d];
+                        histograms[b * num_buckets + d] = sum;
+                        sum += count;
+                    }
+                }
+
+                parfor(0, num_blocks, [&](index_t b) {
+                    auto offsets = histograms.data() + b * num_buckets;
+                    auto end = (std::min)((b + 1) * block_size, size);
+                    for (index_t i = b * block_size; i < end; i++) {
+                        auto pos = offsets[(keys[i] >> shift) & 0xFF]++;
+                        keys_tmp[pos] = keys[i];
+                        indices_tmp(pos) = indices(i);
+                    }
+                });
+
+                std::swap(keys, keys_tmp);
+                std::swap(indices, indices_tmp);
+            }
+            return indices;
+        }
+
+        /**
+         * Minimal size of an array to be sorted with radix_stable_arg_sort, smaller arrays are sorted with a
+         * comparison sort.
+         */
+        const index_t radix_sort_min_size = 1 << 10;
+
 #define HIGRA_ARG_SORT(sort_function)                                                                   \
     auto &array = arrayx.derived_cast();                                                                \
     hg_assert(array.dimension() > 0 && array.dimension() <= 2,                                          \
@@ -106,9 +335,74 @@ namespace hg {
     }                                                                                                   \
 return indices;
 
+        template<typename T, typename Compare>
+        auto comparison_arg_sort(const xt::xexpression<T> &arrayx, Compare comp) {
+            HIGRA_ARG_SORT(hg::sort);
+        }
+
+        template<typename T, typename Compare>
+        auto comparison_stable_arg_sort(const xt::xexpression<T> &arrayx, Compare comp) {
+            HIGRA_ARG_SORT(hg::stable_sort);
+        }
+
+#undef HIGRA_ARG_SORT
+
+        template<bool stable, typename T, typename Compare>
+        auto arg_sort(const T &array, Compare comp, bool /* descending */, std::false_type /* use radix */) {
+            return stable ? comparison_stable_arg_sort(array, comp) : comparison_arg_sort(array, comp);
+        }
+
+        template<bool stable, typename T, typename Compare>
+        auto arg_sort(const T &array, Compare comp, bool descending, std::true_type /* use radix */) {
+            if (array.dimension() == 1 && (index_t) array.size() >= radix_sort_min_size) {
+                // radix sort is always stable
+                return radix_stable_arg_sort(array, descending);
+            }
+            return arg_sort<stable>(array, comp, descending, std::false_type());
+        }
+
+        /**
+         * Radix sort can be used if the comparison function is the natural order (or its reverse) on the
+         * value type of the array.
+         */
+        template<typename T, typename V>
+        using use_radix_sort = std::integral_constant<bool,
+                is_radix_sortable<typename T::value_type>::value &&
+                std::is_same<typename T::value_type, V>::value>;
+
+        template<bool stable, typename T, typename Compare>
+        auto arg_sort(const T &array, Compare comp) {
+            return arg_sort<stable>(array, comp, false, std::false_type());
+        }
+
+        template<bool stable, typename T, typename V>
+        auto arg_sort(const T &array, std::less<V> comp) {
+            return arg_sort<stable>(array, comp, false, use_radix_sort<T, V>());
+        }
+
+        template<bool stable, typename T, typename V>
+        auto arg_sort(const T &array, std::greater<V> comp) {
+            return arg_sort<stable>(array, comp, true, use_radix_sort<T, V>());
+        }
+    }
+
+    /**
+     * Indices that would sort the given array according to the comparison function comp.
+     *
+     * If the array is 2d, rows are compared lexicographically.
+     *
+     * If the array is 1d and the comparison function is std::less or std::greater on the arithmetic value type of
+     * the array, a radix sort is used instead of a comparison sort.
+     *
+     * @tparam T
+     * @tparam Compare
+     * @param arrayx 1d or 2d array
+     * @param comp comparison function
+     * @return 1d array of indices
+     */
     template<typename T, typename Compare>
     auto arg_sort(const xt::xexpression<T> &arrayx, Compare comp) {
-        HIGRA_ARG_SORT(hg::sort);
+        return sorting_internal::arg_sort<false>(arrayx.derived_cast(), comp);
     }
 
     template<typename T>
@@ -116,15 +410,27 @@ return indices;
         return arg_sort(arrayx, std::less<typename T::value_type>());
     }
 
+    /**
+     * Indices that would stably sort the given array according to the comparison function comp.
+     *
+     * If the array is 2d, rows are compared lexicographically.
+     *
+     * If the array is 1d and the comparison function is std::less or std::greater on the arithmetic value type of
+     * the array, a radix sort is used instead of a comparison sort.
+     *
+     * @tparam T
+     * @tparam Compare
+     * @param arrayx 1d or 2d array
+     * @param comp comparison function
+     * @return 1d array of indices
+     */
     template<typename T, typename Compare>
     auto stable_arg_sort(const xt::xexpression<T> &arrayx, Compare comp) {
-        HIGRA_ARG_SORT(hg::stable_sort);
+        return sorting_internal::arg_sort<true>(arrayx.derived_cast(), comp);
     }
 
     template<typename T>
     auto stable_arg_sort(const xt::xexpression<T> &arrayx) {
         return stable_arg_sort(arrayx, std::less<typename T::value_type>());
     }
-
-#undef HIGRA_ARG_SORT
 }
\ No newline at end of file
@@ -0,0 +1,444 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "details/graph_concepts.hpp"
+#include "details/indexed_edge.hpp"
+#include "details/iterators.hpp"
+#include "array.hpp"
+#include "../sorting.hpp"
+
+namespace hg {
+
+    /**
+     * Immutable undirected graph stored in compressed sparse row (CSR) format
+     */
+    namespace csr_graph_internal {
+
+        struct csr_graph_traversal_category :
+                virtual public graph::incidence_graph_tag,
+                virtual public graph::bidirectional_graph_tag,
+                virtual public graph::adjacency_graph_tag,
+                virtual public graph::vertex_list_graph_tag,
+                virtual public graph::edge_list_graph_tag {
+        };
+
+        /**
+         * Iterator on the edges incident to a vertex v.
+         *
+         * If out is true, the edges are oriented from v to its neighbours, otherwise they are oriented from the
+         * neighbours to v.
+         *
+         * @tparam out
+         */
+        template<bool out>
+        struct incident_edge_iterator :
+                public random_iterator_facade<incident_edge_iterator<out>, indexed_edge<index_t, index_t>> {
+
+            using self_type = incident_edge_iterator<out>;
+            using edge_t = indexed_edge<index_t, index_t>;
+
+            incident_edge_iterator() : m_vertex(invalid_index), m_adjacent_vertex(nullptr), m_edge_index(nullptr) {}
+
+            incident_edge_iterator(index_t vertex, const index_t *adjacent_vertex, const index_t *edge_index) :
+                    m_vertex(vertex),
+                    m_adjacent_vertex(adjacent_vertex),
+                    m_edge_index(edge_index) {}
+
+            void increment() {
+                m_adjacent_vertex++;
+                m_edge_index++;
+            }
+
+            void decrement() {
+                m_adjacent_vertex--;
+                m_edge_index--;
+            }
+
+            void advance(std::ptrdiff_t n) {
+                m_adjacent_vertex += n;
+                m_edge_index += n;
+            }
+
+            auto distance_to(const self_type &rhs) const {
+                return rhs.m_adjacent_vertex - m_adjacent_vertex;
+            }
+
+            bool equal(const self_type &other) const {
+                return m_adjacent_vertex == other.m_adjacent_vertex;
+            }
+
+            edge_t dereference() const {
+                return out ?
+                       edge_t(m_vertex, *m_adjacent_vertex, *m_edge_index) :
+                       edge_t(*m_adjacent_vertex, m_vertex, *m_edge_index);
+            }
+
+        private:
+            index_t m_vertex;
+            const index_t *m_adjacent_vertex;
+            const index_t *m_edge_index;
+        };
+
+        /**
+         * Iterator on all the edges of a graph (ordered by edge index)
+         *
+         * @tparam graph_t
+         */
+        template<typename graph_t>
+        struct edge_list_iterator :
+                public random_iterator_facade<edge_list_iterator<graph_t>, indexed_edge<index_t, index_t>> {
+
+            using self_type = edge_list_iterator<graph_t>;
+            using edge_t = indexed_edge<index_t, index_t>;
+
+            edge_list_iterator() : m_graph(nullptr), m_edge_index(0) {}
+
+            edge_list_iterator(const graph_t &graph, index_t edge_index) :
+                    m_graph(&graph),
+                    m_edge_index(edge_index) {}
+
+            void increment() {
+                m_edge_index++;
+            }
+
+            void decrement() {
+                m_edge_index--;
+            }
+
+            void advance(std::ptrdiff_t n) {
+                m_edge_index += n;
+            }
+
+            auto distance_to(const self_type &rhs) const {
+                return rhs.m_edge_index - m_edge_index;
+            }
+
+            bool equal(const self_type &other) const {
+                return m_edge_index == other.m_edge_index;
+            }
+
+            edge_t dereference() const {
+                return m_graph->edge_from_index(m_edge_index);
+            }
+
+        private:
+            const graph_t *m_graph;
+            index_t m_edge_index;
+        };
+
+        /**
+         * Immutable undirected graph in compressed sparse row format.
+         *
+         * The edges are given by two 1d arrays sources and targets which are stored as is (no copy is made if
+         * the given arrays are moved into the graph or if array_t is a reference counted array type like
+         * xt::pytensor). The incidence lists of all the vertices are stored contiguously in two flat arrays (adjacent
+         * vertices and edge indices) indexed by an offset array of size num_vertices + 1.
+         *
+         * The incidence list of a vertex is ordered by increasing edge index, like in undirected_graph. A self-loop
+         * appears only once in the incidence list of its vertex.
+         *
+         * @tparam array_t type of the sources and targets arrays (1d array of index_t)
+         */
+        template<typename array_t = array_1d<index_t>>
+        struct csr_graph {
+
+            // Graph associated types
+            using self_type = csr_graph<array_t>;
+            using vertex_descriptor = index_t;
+            using edge_index_t = index_t;
+            using edge_descriptor = indexed_edge<vertex_descriptor, edge_index_t>;
+            using directed_category = graph::undirected_tag;
+            using edge_parallel_category = graph::allow_parallel_edge_tag;
+            using traversal_category = csr_graph_traversal_category;
+
+            // VertexListGraph associated types
+            using vertex_iterator = counting_iterator<vertex_descriptor>;
+            using vertices_size_type = size_t;
+
+            // EdgeListGraph associated types
+            using edges_size_type = size_t;
+            using edge_iterator = edge_list_iterator<self_type>;
+
+            // IncidenceGraph associated types
+            using out_edge_iterator = incident_edge_iterator<true>;
+            using degree_size_type = size_t;
+
+            //BidirectionalGraph associated types
+            using in_edge_iterator = incident_edge_iterator<false>;
+
+            //AdjacencyGraph associated types
+            using adjacency_iterator = const vertex_descriptor *;
+
+            csr_graph(const size_t num_vertices = 0) :
+                    m_num_vertices(num_vertices),
+                    m_sources(array_1d<index_t>::from_shape({0})),
+                    m_targets(array_1d<index_t>::from_shape({0})) {
+                build();
+            }
+
+            /**
+             * Create a graph with the given number of vertices and the edges given by the two arrays sources and
+             * targets.
+             *
+             * If TBB is enabled, the incidence lists are constructed in parallel.
+             *
+             * @param sources source vertex of each edge
+             * @param targets target vertex of each edge
+             * @param num_vertices number of vertices in the graph
+             */
+            csr_graph(array_t sources, array_t targets, const size_t num_vertices) :
+                    m_num_vertices(num_vertices),
+                    m_sources(std::move(sources)),
+                    m_targets(std::move(targets)) {
+                build();
+            }
+
+            vertices_size_type num_vertices() const {
+                return m_num_vertices;
+            }
+
+            edges_size_type num_edges() const {
+                return m_sources.size();
+            }
+
+            degree_size_type degree(vertex_descriptor v) const {
+                return m_offsets(v + 1) - m_offsets(v);
+            }
+
+            edge_descriptor edge_from_index(edge_index_t ei) const {
+                return edge_descriptor(m_sources(ei), m_targets(ei), ei);
+            }
+
+            auto edges_cbegin() const {
+                return edge_iterator(*this, 0);
+            }
+
+            auto edges_cend() const {
+                return edge_iterator(*this, num_edges());
+            }
+
+            auto out_edges_cbegin(vertex_descriptor v) const {
+                return out_edge_iterator(v,
+                                         m_adjacent_vertices.data() + m_offsets(v),
+                                         m_edge_indices.data() + m_offsets(v));
+            }
+
+            auto out_edges_cend(vertex_descriptor v) const {
+                return out_edge_iterator(v,
+                                         m_adjacent_vertices.data() + m_offsets(v + 1),
+                                         m_edge_indices.data() + m_offsets(v + 1));
+            }
+
+            auto in_edges_cbegin(vertex_descriptor v) const {
+                return in_edge_iterator(v,
+                                        m_adjacent_vertices.data() + m_offsets(v),
+                                        m_edge_indices.data() + m_offsets(v));
+            }
+
+            auto in_edges_cend(vertex_descriptor v) const {
+                return in_edge_iterator(v,
+                                        m_adjacent_vertices.data() + m_offsets(v + 1),
+                                        m_edge_indices.data() + m_offsets(v + 1));
+            }
+
+            adjacency_iterator adjacent_vertices_cbegin(vertex_descriptor v) const {
+                return m_adjacent_vertices.data() + m_offsets(v);
+            }
+
+            adjacency_iterator adjacent_vertices_cend(vertex_descriptor v) const {
+                return m_adjacent_vertices.data() + m_offsets(v + 1);
+            }
+
+            const array_t &sources() const {
+                return m_sources;
+            }
+
+            const array_t &targets() const {
+                return m_targets;
+            }
+
+            /**
+             * Offset of the incidence list of each vertex in the arrays adjacent_vertices and edge_indices
+             * (array of size num_vertices + 1)
+             */
+            const array_1d<index_t> &offsets() const {
+                return m_offsets;
+            }
+
+            const array_1d<index_t> &adjacent_vertices() const {
+                return m_adjacent_vertices;
+            }
+
+            const array_1d<index_t> &edge_indices() const {
+                return m_edge_indices;
+            }
+
+        private:
+
+            /**
+             * Compute the incidence lists: each edge ei has two incidences 2 * ei (in the list of its source) and
+             * 2 * ei + 1 (in the list of its target). A stable sort of the incidences by vertex then gives the CSR
+             * layout with incidence lists ordered by edge index.
+             */
+            void build() {
+                hg_assert_1d_array(m_sources);
+                hg_assert_same_shape(m_sources, m_targets);
+                const index_t num_e = num_edges();
+                const index_t num_v = m_num_vertices;
+
+                // self-loops are only counted once: their second incidence is sent after the last vertex
+                array_1d<index_t> incidence_vertex = array_1d<index_t>::from_shape({(size_t) (2 * num_e)});
+                parfor(0, num_e, [this, &incidence_vertex, num_v](index_t ei) {
+                    auto s = m_sources(ei);
+                    auto t = m_targets(ei);
+                    hg_assert(s >= 0 && s < num_v && t >= 0 && t < num_v, "Invalid vertex index.");
+                    incidence_vertex(2 * ei) = s;
+                    incidence_vertex(2 * ei + 1) = (s != t) ? t : num_v;
+                });
+
+                array_1d<index_t> sorted_incidences = stable_arg_sort(incidence_vertex);
+
+                // offset of vertex v is the position of its first incidence in sorted order
+                m_offsets = array_1d<index_t>::from_shape({(size_t) (num_v + 1)});
+                parfor(0, 2 * num_e, [this, &incidence_vertex, &sorted_incidences, num_v](index_t i) {
+                    auto v = (std::min)(incidence_vertex(sorted_incidences(i)), num_v);
+                    auto previous = (i == 0) ? (index_t) -1 : incidence_vertex(sorted_incidences(i - 1));
+                    for (index_t w = previous + 1; w <= v; w++) {
+                        m_offsets(w) = i;
+                    }
+                });
+                auto last = (num_e == 0) ? (index_t) -1 : incidence_vertex(sorted_incidences(2 * num_e - 1));
+                for (index_t w = last + 1; w <= num_v; w++) {
+                    m_offsets(w) = 2 * num_e;
+                }
+
+                const index_t num_incidences = m_offsets(num_v);
+                m_adjacent_vertices = array_1d<index_t>::from_shape({(size_t) num_incidences});
+                m_edge_indices = array_1d<index_t>::from_shape({(size_t) num_incidences});
+                parfor(0, num_incidences, [this, &sorted_incidences](index_t i) {
+                    auto incidence = sorted_incidences(i);
+                    auto ei = incidence / 2;
+                    m_edge_indices(i) = ei;
+                    m_adjacent_vertices(i) = (incidence % 2 == 0) ? m_targets(ei) : m_sources(ei);
+                });
+            }
+
+            size_t m_num_vertices;
+            array_t m_sources;
+            array_t m_targets;
+            array_1d<index_t> m_offsets;
+            array_1d<index_t> m_adjacent_vertices;
+            array_1d<index_t> m_edge_indices;
+        };
+    }
+
+    using csr_graph = csr_graph_internal::csr_graph<>;
+
+    namespace graph {
+        template<typename array_t>
+        struct graph_traits<csr_graph_internal::csr_graph<array_t>> {
+            using G = csr_graph_internal::csr_graph<array_t>;
+
+            using vertex_descriptor = typename G::vertex_descriptor;
+            using edge_descriptor = typename G::edge_descriptor;
+            using edge_iterator = typename G::edge_iterator;
+            using out_edge_iterator = typename G::out_edge_iterator;
+
+            using directed_category = typename G::directed_category;
+            using edge_parallel_category = typename G::edge_parallel_category;
+            using traversal_category = typename G::traversal_category;
+
+            using degree_size_type = typename G::degree_size_type;
+
+            using in_edge_iterator = typename G::in_edge_iterator;
+            using vertex_iterator = typename G::vertex_iterator;
+            using vertices_size_type = typename G::vertices_size_type;
+            using edges_size_type = typename G::edges_size_type;
+            using adjacency_iterator = typename G::adjacency_iterator;
+
+            using edge_index = typename G::edge_index_t;
+        };
+    }
+
+    template<typename T>
+    auto edge_from_index(const typename csr_graph_internal::csr_graph<T>::edge_index_t ei,
+                         const csr_graph_internal::csr_graph<T> &g) {
+        return g.edge_from_index(ei);
+    }
+
+    template<typename T>
+    auto num_vertices(const csr_graph_internal::csr_graph<T> &g) {
+        return g.num_vertices();
+    }
+
+    template<typename T>
+    auto num_edges(const csr_graph_internal::csr_graph<T> &g) {
+        return g.num_edges();
+    }
+
+    template<typename T>
+    auto degree(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                const csr_graph_internal::csr_graph<T> &g) {
+        return g.degree(v);
+    }
+
+    template<typename T>
+    auto in_degree(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                   const csr_graph_internal::csr_graph<T> &g) {
+        return g.degree(v);
+    }
+
+    template<typename T>
+    auto out_degree(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                    const csr_graph_internal::csr_graph<T> &g) {
+        return g.degree(v);
+    }
+
+    template<typename T>
+    auto vertices(const csr_graph_internal::csr_graph<T> &g) {
+        using vertex_iterator = typename csr_graph_internal::csr_graph<T>::vertex_iterator;
+        return std::make_pair(
+                vertex_iterator(0),                 // The first iterator position
+                vertex_iterator(num_vertices(g))); // The last iterator position
+    }
+
+    template<typename T>
+    auto edges(const csr_graph_internal::csr_graph<T> &g) {
+        return std::make_pair(
+                g.edges_cbegin(),                 // The first iterator position
+                g.edges_cend()); // The last iterator position
+    }
+
+    template<typename T>
+    auto out_edges(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                   const csr_graph_internal::csr_graph<T> &g) {
+        return std::make_pair(
+                g.out_edges_cbegin(v),
+                g.out_edges_cend(v));
+    }
+
+    template<typename T>
+    auto in_edges(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                  const csr_graph_internal::csr_graph<T> &g) {
+        return std::make_pair(
+                g.in_edges_cbegin(v),
+                g.in_edges_cend(v));
+    }
+
+    template<typename T>
+    auto adjacent_vertices(const typename csr_graph_internal::csr_graph<T>::vertex_descriptor v,
+                           const csr_graph_internal::csr_graph<T> &g) {
+        return std::make_pair(
+                g.adjacent_vertices_cbegin(v),
+                g.adjacent_vertices_cend(v));
+    }
+}
@@ -292,6 +292,55 @@ namespace hg {
         value_type m_stop;
 
     };
+
+    /**
+     * A non owning view on a contiguous sequence of elements [begin, end).
+     *
+     * @tparam value_type
+     */
+    template<typename value_type>
+    struct span {
+
+        using iterator = value_type *;
+        using const_iterator = const value_type *;
+
+        span() : m_begin(nullptr), m_end(nullptr) {}
+
+        span(value_type *begin, value_type *end) : m_begin(begin), m_end(end) {}
+
+        iterator begin() const {
+            return m_begin;
+        }
+
+        iterator end() const {
+            return m_end;
+        }
+
+        const_iterator cbegin() const {
+            return m_begin;
+        }
+
+        const_iterator cend() const {
+            return m_end;
+        }
+
+        size_t size() const {
+            return (size_t) (m_end - m_begin);
+        }
+
+        bool empty() const {
+            return m_begin == m_end;
+        }
+
+        value_type &operator[](index_t i) const {
+            return m_begin[i];
+        }
+
+    private:
+
+        value_type *m_begin;
+        value_type *m_end;
+    };
 }
 
 
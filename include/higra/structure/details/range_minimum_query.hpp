@@ -100,6 +100,45 @@ namespace hg {
                 return m_data[p1] < m_data[p2] ? p1 : p2;
             }
 
+            /**
+             * Batch of queries: result[i] = query(l[i], r[i]) for all i in [0, size).
+             *
+             * Queries are processed by chunks in several passes such that the random memory accesses of the
+             * different queries of a chunk overlap: the sparse table entries of all the queries are prefetched
+             * before being read, and then the data values.
+             *
+             * Precondition l[i] < r[i]
+             * @param l
+             * @param r
+             * @param result
+             * @param size
+             */
+            void query_batch(const index_t *l, const index_t *r, index_t *result, index_t size) const {
+                const index_t chunk_size = 64;
+                const size_t *row1[chunk_size];
+                const size_t *row2[chunk_size];
+                for (index_t start = 0; start < size; start += chunk_size) {
+                    const index_t n = (std::min)(chunk_size, size - start);
+                    for (index_t i = 0; i < n; i++) {
+                        auto level = fast_log2(r[start + i] - l[start + i]);
+                        const size_t *row = m_sparse_table[level].data();
+                        row1[i] = row + l[start + i];
+                        row2[i] = row + r[start + i] - ((size_t) 1 << level);
+                        HG_PREFETCH(row1[i]);
+                        HG_PREFETCH(row2[i]);
+                    }
+                    for (index_t i = 0; i < n; i++) {
+                        HG_PREFETCH(m_data + *row1[i]);
+                        HG_PREFETCH(m_data + *row2[i]);
+                    }
+                    for (index_t i = 0; i < n; i++) {
+                        auto p1 = *row1[i];
+                        auto p2 = *row2[i];
+                        result[start + i] = m_data[p1] < m_data[p2] ? p1 : p2;
+                    }
+                }
+            }
+
             template<template<typename> typename container_t>
             struct internal_state {
                 using type = self_type;
@@ -238,7 +277,7 @@ namespace hg {
                         return m_block_minimum_prefix(r);
                     if (m_block_minimum_suffix(l) <= r)
                         return m_block_minimum_suffix(l);
-                    return std::min_element(m_data + l, m_data + r) - m_data;
+                    return argmin(l, r);
                 }
                 //index_t lbase = lb * m_block_size;
                 index_t rbase = rb * m_block_size;
@@ -252,6 +291,35 @@ namespace hg {
                 return m_data[vv] < m_data[v] ? vv : v;
             }
 
+            /**
+             * Batch of queries: result[i] = query(l[i], r[i]) for all i in [0, size).
+             *
+             * Queries are processed by chunks: the block minimum prefix and suffix entries of all the queries of a
+             * chunk are prefetched before the queries are solved.
+             *
+             * Precondition l[i] < r[i]
+             * @param l
+             * @param r
+             * @param result
+             * @param size
+             */
+            void query_batch(const index_t *l, const index_t *r, index_t *result, index_t size) const {
+                const index_t chunk_size = 64;
+                const index_t *prefix = m_block_minimum_prefix.data();
+                const index_t *suffix = m_block_minimum_suffix.data();
+                for (index_t start = 0; start < size; start += chunk_size) {
+                    const index_t end = (std::min)(start + chunk_size, size);
+                    for (index_t i = start; i < end; i++) {
+                        HG_PREFETCH(suffix + l[i]);
+                        HG_PREFETCH(prefix + r[i] - 1);
+                        HG_PREFETCH(prefix + r[i]);
+                    }
+                    for (index_t i = start; i < end; i++) {
+                        result[i] = query(l[i], r[i]);
+                    }
+                }
+            }
+
             template<template<typename> typename container_t>
             struct internal_state {
                 using type = self_type;
@@ -315,6 +383,23 @@ namespace hg {
 
         private:
 
+            /**
+             * Position of the first minimum element in the range [l, r) of the data.
+             *
+             * The minimum value is computed first with a branchless reduction that can be vectorized by the
+             * compiler, its first position is then searched.
+             */
+            index_t argmin(index_t l, index_t r) const {
+                auto minimum = m_data[l];
+                for (index_t i = l + 1; i < r; i++) {
+                    minimum = (std::min)(minimum, m_data[i]);
+                }
+                while (m_data[l] != minimum) {
+                    l++;
+                }
+                return l;
+            }
+
             template<template<typename> typename container_t, typename T>
             void set_state(internal_state<container_t> &&state, const T &data) {
                 m_data_size = state.data_size;
@@ -0,0 +1,206 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../tree_graph.hpp"
+#include <iterator>
+#include <memory>
+#include <vector>
+
+namespace hg {
+
+    namespace tree_internal {
+
+        /**
+         * Minimum number of nodes for a tree to be processed in parallel by schedule_leaves_to_root and
+         * schedule_root_to_leaves.
+         */
+        const index_t tree_schedule_min_size = 1 << 16;
+
+        /**
+         * Minimum number of nodes in the subtrees of a tree_schedule built by schedule_leaves_to_root and
+         * schedule_root_to_leaves.
+         */
+        const index_t tree_schedule_min_subtree_size = 1 << 12;
+
+        /**
+         * Partition of the nodes of a tree into independent subtrees that can be processed concurrently.
+         *
+         * The nodes are split into disjoint subtrees of at most max_subtree_size nodes, whose roots are the
+         * largest nodes satisfying this size constraint, and the top of the tree made of the remaining nodes
+         * (ie. the ancestors of the subtree roots). Within each part, the nodes are stored by increasing index:
+         * a node always comes after its descendants in the same part.
+         *
+         * A leaves to root traversal processes the subtrees in parallel and then the top of the tree, a root
+         * to leaves traversal processes the top of the tree and then the subtrees in parallel.
+         */
+        struct tree_schedule {
+
+            template<typename tree_t>
+            tree_schedule(const tree_t &tree, index_t max_subtree_size) {
+                HG_TRACE();
+                const index_t num_v = (index_t) num_vertices(tree);
+                const index_t root_v = root(tree);
+                auto &parents = tree.parents();
+
+                array_1d<index_t> subtree_size = xt::ones<index_t>({(size_t) num_v});
+                for (index_t i = 0; i < root_v; i++) {
+                    subtree_size(parents(i)) += subtree_size(i);
+                }
+
+                // label of each node: index of its subtree or -1 for the top of the tree
+                array_1d<index_t> label = array_1d<index_t>::from_shape({(size_t) num_v});
+                std::vector<index_t> counts;
+                index_t top_count = 0;
+                for (index_t i = root_v; i >= 0; i--) {
+                    if (subtree_size(i) > max_subtree_size) {
+                        label(i) = -1;
+                        top_count++;
+                    } else if (i == root_v || subtree_size(parents(i)) > max_subtree_size) {
+                        label(i) = (index_t) counts.size();
+                        counts.push_back(1);
+                    } else {
+                        label(i) = label(parents(i));
+                        counts[label(i)]++;
+                    }
+                }
+
+                // counting sort of the nodes by label, top of the tree last
+                const index_t num_s = (index_t) counts.size();
+                m_offsets = array_1d<index_t>::from_shape({(size_t) num_s + 2});
+                m_offsets(0) = 0;
+                for (index_t i = 0; i < num_s; i++) {
+                    m_offsets(i + 1) = m_offsets(i) + counts[i];
+                }
+                m_offsets(num_s + 1) = m_offsets(num_s) + top_count;
+
+                std::vector<index_t> cursors(m_offsets.begin(), m_offsets.end() - 1);
+                m_nodes = array_1d<index_t>::from_shape({(size_t) num_v});
+                for (index_t i = 0; i < num_v; i++) {
+                    auto l = (label(i) == -1) ? num_s : label(i);
+                    m_nodes(cursors[l]++) = i;
+                }
+            }
+
+            index_t num_subtrees() const {
+                return (index_t) m_offsets.size() - 2;
+            }
+
+            /**
+             * Nodes of the i-th subtree, if i is equal to num_subtrees(), nodes of the top of the tree.
+             */
+            auto nodes(index_t i) const {
+                return span<const index_t>(m_nodes.data() + m_offsets(i), m_nodes.data() + m_offsets(i + 1));
+            }
+
+            /**
+             * Calls fun(first, last) on ranges of nodes covering the whole tree, such that the descendants of a
+             * node are processed before it if fun processes the nodes of each range in order.
+             */
+            template<typename fun_t>
+            void leaves_to_root(const fun_t &fun) const {
+                const index_t num_s = num_subtrees();
+                parfor(0, num_s, [this, &fun](index_t i) {
+                    auto s = nodes(i);
+                    fun(s.begin(), s.end());
+                });
+                auto r = nodes(num_s);
+                fun(r.begin(), r.end());
+            }
+
+            /**
+             * Calls fun(first, last) on ranges of nodes covering the whole tree, such that the ancestors of a
+             * node are processed before it if fun processes the nodes of each range in order.
+             */
+            template<typename fun_t>
+            void root_to_leaves(const fun_t &fun) const {
+                using it = std::reverse_iterator<const index_t *>;
+                const index_t num_s = num_subtrees();
+                auto r = nodes(num_s);
+                fun(it(r.end()), it(r.begin()));
+                parfor(0, num_s, [this, &fun](index_t i) {
+                    auto s = nodes(i);
+                    fun(it(s.end()), it(s.begin()));
+                });
+            }
+
+        private:
+            array_1d<index_t> m_nodes;
+            array_1d<index_t> m_offsets;
+        };
+
+        /**
+         * True if the given tree is processed in parallel by schedule_leaves_to_root and schedule_root_to_leaves.
+         */
+        template<typename tree_t>
+        bool use_tree_schedule(const tree_t &tree) {
+#ifdef HG_USE_TBB
+            return (index_t) num_vertices(tree) >= tree_schedule_min_size;
+#else
+            (void) tree;
+            return false;
+#endif
+        }
+
+        template<typename tree_t>
+        auto make_tree_schedule(const tree_t &tree) {
+            index_t max_subtree_size = (std::max)(tree_schedule_min_subtree_size,
+                                                  (index_t) num_vertices(tree) / 1024);
+            return tree_schedule(tree, max_subtree_size);
+        }
+
+        /**
+         * Calls fun(first, last) on ranges of nodes covering the whole tree such that processing the nodes of
+         * each range in order visits the children of a node before the node. Independent ranges are processed in
+         * parallel on large trees when TBB is enabled, otherwise fun is called once on all the nodes in increasing
+         * order.
+         */
+        template<typename tree_t, typename fun_t>
+        void schedule_leaves_to_root(const tree_t &tree, const fun_t &fun) {
+            if (use_tree_schedule(tree)) {
+                tree.schedule().leaves_to_root(fun);
+            } else {
+                auto nodes = leaves_to_root_iterator(tree);
+                fun(nodes.begin(), nodes.end());
+            }
+        }
+
+        /**
+         * Calls fun(first, last) on ranges of nodes covering the whole tree such that processing the nodes of
+         * each range in order visits the parent of a node before the node. Independent ranges are processed in
+         * parallel on large trees when TBB is enabled, otherwise fun is called once on all the nodes in decreasing
+         * order.
+         */
+        template<typename tree_t, typename fun_t>
+        void schedule_root_to_leaves(const tree_t &tree, const fun_t &fun) {
+            if (use_tree_schedule(tree)) {
+                tree.schedule().root_to_leaves(fun);
+            } else {
+                auto nodes = root_to_leaves_iterator(tree);
+                fun(nodes.begin(), nodes.end());
+            }
+        }
+    }
+
+    inline
+    const tree_internal::tree_schedule &tree::schedule() const {
+        // concurrent callers may both build the schedule, only one of them is kept
+        auto schedule = std::atomic_load(&_schedule);
+        if (!schedule) {
+            std::shared_ptr<const tree_internal::tree_schedule> new_schedule =
+                    std::make_shared<const tree_internal::tree_schedule>(tree_internal::make_tree_schedule(*this));
+            if (std::atomic_compare_exchange_strong(&_schedule, &schedule, new_schedule)) {
+                schedule = std::move(new_schedule);
+            }
+        }
+        return *schedule;
+    }
+}
@@ -0,0 +1,447 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#pragma once
+
+#include "../utils.hpp"
+#include "fibonacci_heap.hpp"
+#include <vector>
+#include <limits>
+#include <type_traits>
+
+namespace hg {
+
+    /*
+     * Indexed min-heaps: the elements of the heap are integers in [0, capacity) (for example edge indices), each
+     * element is associated to a value and an element can be present at most once in the heap.
+     *
+     * All indexed heaps share the following interface:
+     *
+     *  - heap_t(size_t capacity): creates an empty heap that can hold the elements [0, capacity)
+     *  - bool empty() const: true if the heap is empty
+     *  - size_t size() const: number of elements in the heap
+     *  - bool contains(index_t element) const: true if the element is in the heap
+     *  - void push(index_t element, const T &value): insert an element (not already in the heap)
+     *  - index_t top(): element of minimal value
+     *  - T top_value(): minimal value
+     *  - void pop(): removes the element of minimal value
+     *  - void update(index_t element, const T &value): change the value of an element of the heap
+     *  - void erase(index_t element): removes an element of the heap
+     *  - T value(index_t element) const: value associated to an element of the heap
+     */
+
+    namespace indexed_heap_internal {
+
+        template<typename T>
+        struct heap_element {
+            using self_t = heap_element<T>;
+            T value;
+            index_t index;
+
+            bool operator<(const self_t &rhs) const { return value < rhs.value; }
+
+            bool operator>(const self_t &rhs) const { return value > rhs.value; }
+
+            bool operator<=(const self_t &rhs) const { return value <= rhs.value; }
+
+            bool operator>=(const self_t &rhs) const { return value >= rhs.value; }
+
+            bool operator==(const self_t &rhs) const { return value == rhs.value; }
+
+            bool operator!=(const self_t &rhs) const { return value != rhs.value; }
+        };
+    }
+
+    /**
+     * Indexed heap based on the fibonacci heap (fibonacci_heap.hpp): node based structure with O(1) amortized
+     * push and decrease key.
+     *
+     * Warning: fibonacci heaps share a global object pool which is not thread safe.
+     *
+     * @tparam T value type
+     */
+    template<typename T>
+    struct indexed_fibonacci_heap {
+        using value_type = T;
+        using element_t = indexed_heap_internal::heap_element<T>;
+        using heap_t = fibonacci_heap<element_t>;
+
+        explicit indexed_fibonacci_heap(size_t capacity) : m_handles(capacity, nullptr) {
+        }
+
+        bool empty() const {
+            return m_heap.empty();
+        }
+
+        size_t size() const {
+            return m_heap.size();
+        }
+
+        bool contains(index_t element) const {
+            return m_handles[element] != nullptr;
+        }
+
+        void push(index_t element, const T &value) {
+            hg_assert(!contains(element), "Element is already in the heap.");
+            m_handles[element] = m_heap.push({value, element});
+        }
+
+        index_t top() {
+            return m_heap.top()->get_value().index;
+        }
+
+        T top_value() {
+            return m_heap.top()->get_value().value;
+        }
+
+        void pop() {
+            m_handles[top()] = nullptr;
+            m_heap.pop();
+        }
+
+        void update(index_t element, const T &value) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            m_heap.update(m_handles[element], {value, element});
+        }
+
+        void erase(index_t element) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            m_heap.erase(m_handles[element]);
+            m_handles[element] = nullptr;
+        }
+
+        T value(index_t element) const {
+            return m_handles[element]->get_value().value;
+        }
+
+    private:
+        heap_t m_heap;
+        std::vector<typename heap_t::value_handle> m_handles;
+    };
+
+    /**
+     * Array based indexed d-ary heap.
+     *
+     * All operations (except top and empty which are O(1)) are in O(log_arity(n)), elements of equal values are
+     * ordered by increasing index: the order of the elements does not depend on the sequence of operations.
+     *
+     * @tparam T value type
+     * @tparam arity number of children of each node of the heap
+     */
+    template<typename T, index_t arity = 4>
+    struct indexed_dary_heap {
+        static_assert(arity >= 2, "Heap arity must be at least 2.");
+        using value_type = T;
+
+        explicit indexed_dary_heap(size_t capacity) :
+                m_positions(capacity, invalid_index),
+                m_values(capacity) {
+        }
+
+        bool empty() const {
+            return m_heap.empty();
+        }
+
+        size_t size() const {
+            return m_heap.size();
+        }
+
+        bool contains(index_t element) const {
+            return m_positions[element] != invalid_index;
+        }
+
+        void push(index_t element, const T &value) {
+            hg_assert(!contains(element), "Element is already in the heap.");
+            m_values[element] = value;
+            m_heap.push_back(element);
+            m_positions[element] = m_heap.size() - 1;
+            sift_up(m_heap.size() - 1);
+        }
+
+        index_t top() const {
+            return m_heap[0];
+        }
+
+        T top_value() const {
+            return m_values[m_heap[0]];
+        }
+
+        void pop() {
+            erase(m_heap[0]);
+        }
+
+        void update(index_t element, const T &value) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            m_values[element] = value;
+            auto position = sift_up(m_positions[element]);
+            sift_down(position);
+        }
+
+        void erase(index_t element) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            index_t position = m_positions[element];
+            index_t last = m_heap.back();
+            m_heap.pop_back();
+            m_positions[element] = invalid_index;
+            if (last != element) {
+                m_heap[position] = last;
+                m_positions[last] = position;
+                position = sift_up(position);
+                sift_down(position);
+            }
+        }
+
+        T value(index_t element) const {
+            return m_values[element];
+        }
+
+    private:
+
+        bool less(index_t element1, index_t element2) const {
+            return m_values[element1] < m_values[element2] ||
+                   (!(m_values[element2] < m_values[element1]) && element1 < element2);
+        }
+
+        index_t sift_up(index_t position) {
+            index_t element = m_heap[position];
+            while (position > 0) {
+                index_t parent = (position - 1) / arity;
+                index_t parent_element = m_heap[parent];
+                if (!less(element, parent_element)) {
+                    break;
+                }
+                m_heap[position] = parent_element;
+                m_positions[parent_element] = position;
+                position = parent;
+            }
+            m_heap[position] = element;
+            m_positions[element] = position;
+            return position;
+        }
+
+        void sift_down(index_t position) {
+            const index_t size = m_heap.size();
+            index_t element = m_heap[position];
+            while (true) {
+                index_t first_child = position * arity + 1;
+                if (first_child >= size) {
+                    break;
+                }
+                index_t last_child = (std::min)(first_child + arity, size);
+                index_t min_child = first_child;
+                for (index_t c = first_child + 1; c < last_child; c++) {
+                    if (less(m_heap[c], m_heap[min_child])) {
+                        min_child = c;
+                    }
+                }
+                index_t min_child_element = m_heap[min_child];
+                if (!less(min_child_element, element)) {
+                    break;
+                }
+                m_heap[position] = min_child_element;
+                m_positions[min_child_element] = position;
+                position = min_child;
+            }
+            m_heap[position] = element;
+            m_positions[element] = position;
+        }
+
+        std::vector<index_t> m_heap;
+        std::vector<index_t> m_positions;
+        std::vector<T> m_values;
+    };
+
+    /**
+     * Indexed monotone radix heap for integral values.
+     *
+     * The heap is monotone: the value of an element pushed or updated cannot be smaller than the last minimal value
+     * obtained with top, top_value, or pop (this is the case in Dijkstra like algorithms and in agglomerative
+     * clustering with a reducible linkage rule).
+     *
+     * Elements are stored in buckets according to the position of the highest bit where their value differs from
+     * the last removed minimum: push, update, and erase are in O(1), and pop is amortized in O(number of bits of T).
+     *
+     * @tparam T integral value type
+     */
+    template<typename T>
+    struct indexed_radix_heap {
+        static_assert(std::is_integral<T>::value, "Radix heap only supports integral value types.");
+        using value_type = T;
+
+    private:
+        using key_t = typename std::make_unsigned<T>::type;
+        static const index_t num_bits = std::numeric_limits<key_t>::digits;
+
+    public:
+
+        explicit indexed_radix_heap(size_t capacity) :
+                m_buckets(num_bits + 1),
+                m_bucket_of(capacity, invalid_index),
+                m_positions(capacity),
+                m_keys(capacity) {
+        }
+
+        bool empty() const {
+            return m_size == 0;
+        }
+
+        size_t size() const {
+            return m_size;
+        }
+
+        bool contains(index_t element) const {
+            return m_bucket_of[element] != invalid_index;
+        }
+
+        void push(index_t element, const T &value) {
+            hg_assert(!contains(element), "Element is already in the heap.");
+            auto key = to_key(value);
+            hg_assert(key >= m_last, "Radix heap is monotone: value must not be smaller than the last minimum.");
+            m_keys[element] = key;
+            insert(element);
+            m_size++;
+        }
+
+        index_t top() {
+            refill();
+            return m_buckets[0].back();
+        }
+
+        T top_value() {
+            return from_key(m_keys[top()]);
+        }
+
+        void pop() {
+            erase(top());
+        }
+
+        void update(index_t element, const T &value) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            auto key = to_key(value);
+            hg_assert(key >= m_last, "Radix heap is monotone: value must not be smaller than the last minimum.");
+            remove(element);
+            m_keys[element] = key;
+            insert(element);
+        }
+
+        void erase(index_t element) {
+            hg_assert(contains(element), "Element is not in the heap.");
+            remove(element);
+            m_size--;
+        }
+
+        T value(index_t element) const {
+            return from_key(m_keys[element]);
+        }
+
+    private:
+
+        // order preserving conversion to an unsigned key
+        static key_t to_key(T value) {
+            return std::is_signed<T>::value ?
+                   (key_t) value ^ ((key_t) 1 << (num_bits - 1)) :
+                   (key_t) value;
+        }
+
+        static T from_key(key_t key) {
+            return std::is_signed<T>::value ?
+                   (T) (key ^ ((key_t) 1 << (num_bits - 1))) :
+                   (T) key;
+        }
+
+        index_t bucket_index(key_t key) const {
+            key_t diff = key ^ m_last;
+#if defined(__GNUC__) || defined(__clang__)
+            return (diff == 0) ? 0 : 64 - __builtin_clzll((unsigned long long) diff);
+#else
+            index_t b = 0;
+            while (diff != 0) {
+                diff >>= 1;
+                b++;
+            }
+            return b;
+#endif
+        }
+
+        void insert(index_t element) {
+            auto b = bucket_index(m_keys[element]);
+            auto &bucket = m_buckets[b];
+            m_bucket_of[element] = b;
+            m_positions[element] = bucket.size();
+            bucket.push_back(element);
+        }
+
+        void remove(index_t element) {
+            auto &bucket = m_buckets[m_bucket_of[element]];
+            auto position = m_positions[element];
+            auto last = bucket.back();
+            bucket[position] = last;
+            m_positions[last] = position;
+            bucket.pop_back();
+            m_bucket_of[element] = invalid_index;
+        }
+
+        // ensure that the first bucket (elements equal to the last minimum) is not empty
+        void refill() {
+            hg_assert(m_size > 0, "Heap is empty.");
+            if (!m_buckets[0].empty()) {
+                return;
+            }
+            index_t b = 1;
+            while (m_buckets[b].empty()) {
+                b++;
+            }
+            auto &bucket = m_buckets[b];
+            key_t min_key = m_keys[bucket[0]];
+            for (auto e: bucket) {
+                if (m_keys[e] < min_key) {
+                    min_key = m_keys[e];
+                }
+            }
+            m_last = min_key;
+            std::vector<index_t> elements;
+            elements.swap(bucket);
+            for (auto e: elements) {
+                insert(e);
+            }
+            // keep the memory of the bucket
+            elements.clear();
+            if (bucket.capacity() < elements.capacity()) {
+                bucket.swap(elements);
+            }
+        }
+
+        std::vector<std::vector<index_t>> m_buckets;
+        std::vector<index_t> m_bucket_of;
+        std::vector<index_t> m_positions;
+        std::vector<key_t> m_keys;
+        key_t m_last = 0;
+        size_t m_size = 0;
+    };
+
+    /**
+     * Heap policies: select the indexed heap used by an algorithm (see binary_partition_tree).
+     */
+    struct fibonacci_heap_policy {
+        template<typename T>
+        using heap_t = indexed_fibonacci_heap<T>;
+    };
+
+    template<index_t arity = 4>
+    struct dary_heap_policy {
+        template<typename T>
+        using heap_t = indexed_dary_heap<T, arity>;
+    };
+
+    struct radix_heap_policy {
+        template<typename T>
+        using heap_t = indexed_radix_heap<T>;
+    };
+}
@@ -13,6 +13,8 @@
 #include "../graph.hpp"
 #include "details/range_minimum_query.hpp"
 #include <stack>
+#include <limits>
+#include <type_traits>
 
 namespace hg {
     namespace lca_internal {
@@ -83,10 +85,10 @@ namespace hg {
                 auto result = array_1d<index_t>::from_shape({size});
 
                 auto it = range.begin();
-                parfor(0, size, [&result, &it, this](index_t i) {
+                lca_batch(size, [&it](index_t i) {
                     auto e = it[i];
-                    result(i) = this->lca(e.first, e.second);
-                });
+                    return std::make_pair((index_t) e.first, (index_t) e.second);
+                }, result);
                 return result;
             }
 
@@ -112,9 +114,9 @@ namespace hg {
                 auto size = vertices1.size();
                 auto result = array_1d<index_t>::from_shape({size});
 
-                parfor(0, size, [&vertices1, &vertices2, &result, this](index_t i) {
-                    result(i) = this->lca(vertices1(i), vertices2(i));
-                });
+                lca_batch(size, [&vertices1, &vertices2](index_t i) {
+                    return std::make_pair((index_t) vertices1(i), (index_t) vertices2(i));
+                }, result);
                 return result;
             }
 
@@ -177,6 +179,64 @@ namespace hg {
 
             lca_rmq(){};
 
+            /**
+             * Computes result(i) = lca(pair(i).first, pair(i).second) for all i in [0, size).
+             *
+             * Queries are split into batches processed in parallel. Each batch is solved in several passes (first
+             * visits in the Euler tour, range minimum queries, Euler tour map) in which the random memory accesses
+             * of the different queries are prefetched and overlap.
+             */
+            template<typename pair_accessor_t>
+            void lca_batch(index_t size, const pair_accessor_t &pair, array_1d<index_t> &result) const {
+                const index_t batch_size = 256;
+                const index_t num_batches = (size + batch_size - 1) / batch_size;
+                const index_t *first_visit = m_first_visit_in_Euler_tour.data();
+                const index_t *Euler_tour_map = m_tree_Euler_tour_map.data();
+
+                parfor(0, num_batches, [&](index_t b) {
+                    const index_t start = b * batch_size;
+                    const index_t n = (std::min)(batch_size, size - start);
+                    index_t nodes1[batch_size];
+                    index_t nodes2[batch_size];
+                    index_t positions[batch_size];
+                    index_t ls[batch_size];
+                    index_t rs[batch_size];
+                    index_t rmq[batch_size];
+
+                    for (index_t i = 0; i < n; i++) {
+                        auto p = pair(start + i);
+                        nodes1[i] = p.first;
+                        nodes2[i] = p.second;
+                        HG_PREFETCH(first_visit + p.first);
+                        HG_PREFETCH(first_visit + p.second);
+                    }
+
+                    // queries with distinct nodes
+                    index_t num_queries = 0;
+                    for (index_t i = 0; i < n; i++) {
+                        if (nodes1[i] == nodes2[i]) {
+                            result(start + i) = nodes1[i];
+                        } else {
+                            index_t ii = first_visit[nodes1[i]];
+                            index_t jj = first_visit[nodes2[i]];
+                            positions[num_queries] = start + i;
+                            ls[num_queries] = (std::min)(ii, jj);
+                            rs[num_queries] = (std::max)(ii, jj);
+                            num_queries++;
+                        }
+                    }
+
+                    m_rmq_solver.query_batch(ls, rs, rmq, num_queries);
+
+                    for (index_t i = 0; i < num_queries; i++) {
+                        HG_PREFETCH(Euler_tour_map + rmq[i]);
+                    }
+                    for (index_t i = 0; i < num_queries; i++) {
+                        result(positions[i]) = Euler_tour_map[rmq[i]];
+                    }
+                });
+            }
+
             template<template<typename> typename container_t>
             void set_state(internal_state<container_t> &&state) {
                 m_tree_Euler_tour_map = std::move(state.tree_Euler_tour_map);
@@ -239,10 +299,255 @@ namespace hg {
 
         };
 
+        /**
+         * Lowest common ancestor solver of Schieber and Vishkin.
+         *
+         * B. Schieber and U. Vishkin, "On finding lowest common ancestors: simplification and parallelization,"
+         * SIAM Journal on Computing, 17(6), 1253-1262, 1988.
+         *
+         * The tree is partitioned into paths that are mapped on the nodes of a complete binary tree through the
+         * preorder numbering of the nodes: a query is then solved in constant time with a few bit operations and at
+         * most two random accesses in each array.
+         *
+         * The structure stores 3 arrays of n elements (n being the number of nodes of the tree) and the peak memory
+         * usage of the preprocessing is the same: with value_t = uint32_t, it requires 12 bytes per node while the
+         * Euler tour based solvers (lca_rmq) require more than 72 bytes per node.
+         *
+         * The tree must be topologically sorted (which is guaranteed by hg::tree): an ancestor of a node has a larger
+         * index than the node.
+         *
+         * @tparam tree_t
+         * @tparam value_t integral type used to store node indices, the number of nodes of the tree must be smaller
+         * than the largest value of this type
+         */
+        template<typename tree_t, typename value_t = index_t>
+        struct lca_schieber_vishkin {
+
+            static_assert(std::is_integral<value_t>::value, "value_t must be an integral type.");
+
+        public:
+            using self_type = lca_schieber_vishkin<tree_t, value_t>;
+
+            lca_schieber_vishkin(const tree_t &tree) {
+                HG_TRACE();
+                index_t num_nodes = hg::num_vertices(tree);
+                hg_assert((uint64_t) num_nodes < (uint64_t) (std::numeric_limits<value_t>::max)(),
+                          "The tree is too large for the value type of the lowest common ancestor solver.");
+                compute_inlabels(tree);
+            }
+
+            /**
+             * Return the lowest common ancestor of two nodes
+             * @param n1
+             * @param n2
+             * @return
+             */
+            index_t lca(index_t n1, index_t n2) const {
+                uint64_t inlabel1 = m_inlabel.data()[n1];
+                uint64_t inlabel2 = m_inlabel.data()[n2];
+                if (inlabel1 == inlabel2) {
+                    // same path: the ancestor has the largest index
+                    return (std::max)(n1, n2);
+                }
+
+                // height of the lowest common ancestor of the inlabels in the complete binary tree
+                index_t height = (std::max)(most_significant_bit(inlabel1 ^ inlabel2),
+                                            (std::max)(least_significant_bit(inlabel1),
+                                                       least_significant_bit(inlabel2)));
+                // height of the inlabel of the path containing the lowest common ancestor
+                uint64_t common = (uint64_t) m_ascendant.data()[n1] & (uint64_t) m_ascendant.data()[n2] &
+                                  (~(uint64_t) 0 << height);
+                index_t path_height = least_significant_bit(common);
+
+                return (std::max)(climb(n1, inlabel1, path_height), climb(n2, inlabel2, path_height));
+            }
+
+            /**
+             * Return the lowest common ancestors of a range of pairs of nodes
+             * @tparam T
+             * @param range
+             * @return
+             */
+            template<typename T>
+            auto lca(const T &range) const {
+                HG_TRACE();
+                index_t size = range.end() - range.begin();
+                auto result = array_1d<index_t>::from_shape({(size_t) size});
+
+                auto it = range.begin();
+                parfor(0, size, [&it, &result, this](index_t i) {
+                    auto e = it[i];
+                    result(i) = lca((index_t) e.first, (index_t) e.second);
+                });
+                return result;
+            }
+
+            /**
+             * Given two 1d array of graph vertex indices v1 and v2, both containing n elements,
+             * this function returns a 1d array or tree vertex indices of size n such that
+             * for all i in 0..n-1, res(i) = lca(v1(i); v2(i))
+             *
+             * @tparam T
+             * @param xvertices1 first array of graph vertices
+             * @param xvertices2 second array of graph vertices
+             * @return array of lowest common ancestors
+             */
+            template<typename T>
+            auto lca(const xt::xexpression<T> &xvertices1, const xt::xexpression<T> &xvertices2) const {
+                HG_TRACE();
+                auto &vertices1 = xvertices1.derived_cast();
+                auto &vertices2 = xvertices2.derived_cast();
+                hg_assert_1d_array(vertices1);
+                hg_assert_integral_value_type(vertices1);
+                hg_assert_same_shape(vertices1, vertices2);
+
+                index_t size = vertices1.size();
+                auto result = array_1d<index_t>::from_shape({(size_t) size});
+
+                parfor(0, size, [&vertices1, &vertices2, &result, this](index_t i) {
+                    result(i) = lca((index_t) vertices1(i), (index_t) vertices2(i));
+                });
+                return result;
+            }
+
+            template<template<typename> typename container_t>
+            struct internal_state {
+                using type = self_type;
+                container_t<value_t> inlabel;
+                container_t<value_t> ascendant;
+                container_t<value_t> head_parent;
+
+                internal_state(const container_t<value_t> &_inlabel,
+                               const container_t<value_t> &_ascendant,
+                               const container_t<value_t> &_head_parent) :
+                        inlabel(_inlabel),
+                        ascendant(_ascendant),
+                        head_parent(_head_parent) {}
+
+                internal_state(container_t<value_t> &&_inlabel,
+                               container_t<value_t> &&_ascendant,
+                               container_t<value_t> &&_head_parent) :
+                        inlabel(std::move(_inlabel)),
+                        ascendant(std::move(_ascendant)),
+                        head_parent(std::move(_head_parent)) {}
+            };
+
+            auto get_state() const {
+                return internal_state<array_1d>(m_inlabel, m_ascendant, m_head_parent);
+            }
+
+            template<template<typename> typename container_t>
+            static auto make_from_state(internal_state<container_t> &&state) {
+                self_type lca;
+                lca.m_inlabel = std::move(state.inlabel);
+                lca.m_ascendant = std::move(state.ascendant);
+                lca.m_head_parent = std::move(state.head_parent);
+                return lca;
+            }
+
+            template<template<typename> typename container_t>
+            static auto make_from_state(const internal_state<container_t> &state) {
+                self_type lca;
+                lca.m_inlabel = state.inlabel;
+                lca.m_ascendant = state.ascendant;
+                lca.m_head_parent = state.head_parent;
+                return lca;
+            }
+
+            index_t num_elements() const {
+                return m_inlabel.size();
+            }
+
+        private:
+
+            lca_schieber_vishkin() {};
+
+            /**
+             * Ancestor of node n (of given inlabel) in the path of height path_height (path_height must be larger
+             * than or equal to the height of the inlabel of n and must be in the ascendant bitset of n)
+             */
+            index_t climb(index_t n, uint64_t inlabel, index_t path_height) const {
+                if (least_significant_bit(inlabel) == path_height) {
+                    return n;
+                }
+                // highest path below path_height on the way from n to the root
+                uint64_t below = (uint64_t) m_ascendant.data()[n] & (((uint64_t) 1 << path_height) - 1);
+                index_t height = most_significant_bit(below);
+                uint64_t path_inlabel = ((inlabel >> (height + 1)) << (height + 1)) | ((uint64_t) 1 << height);
+                return m_head_parent.data()[path_inlabel];
+            }
+
+            /**
+             * Computes inlabel, ascendant and head_parent arrays with a constant number of linear passes on the
+             * topologically sorted tree (no Euler tour nor stack). The arrays are used as temporary storage for the
+             * subtree sizes, preorder numbers, and next free preorder numbers.
+             */
+            void compute_inlabels(const tree_t &tree) {
+                index_t num_nodes = hg::num_vertices(tree);
+                index_t root = tree.root();
+                auto &parents = tree.parents();
+
+                m_inlabel.resize({(size_t) num_nodes});
+                m_ascendant.resize({(size_t) num_nodes});
+                m_head_parent.resize({(size_t) num_nodes + 1});
+
+                // subtree sizes (in ascendant)
+                auto &size = m_ascendant;
+                std::fill(size.begin(), size.end(), 1);
+                for (index_t n = 0; n < root; n++) {
+                    size(parents(n)) += size(n);
+                }
+
+                // preorder numbers starting from 1 (in inlabel) and next free number in the subtree of each node
+                // (in head_parent)
+                auto &preorder = m_inlabel;
+                auto &next = m_head_parent;
+                preorder(root) = 1;
+                next(root) = 2;
+                for (index_t n = root - 1; n >= 0; n--) {
+                    auto p = parents(n);
+                    preorder(n) = next(p);
+                    next(p) += size(n);
+                    next(n) = preorder(n) + 1;
+                }
+
+                // inlabel: number with the maximal number of trailing zeros in [preorder, preorder + size - 1]
+                for (index_t n = 0; n < num_nodes; n++) {
+                    uint64_t first = preorder(n);
+                    uint64_t last = first + size(n) - 1;
+                    index_t height = most_significant_bit((first - 1) ^ last);
+                    m_inlabel(n) = (value_t) ((last >> height) << height);
+                }
+
+                // ascendant: bitset of the heights of the inlabels of the ancestors, and parent of the head (highest
+                // node) of each path
+                m_ascendant(root) = m_inlabel(root) & (~m_inlabel(root) + 1);
+                m_head_parent(m_inlabel(root)) = (value_t) root;
+                for (index_t n = root - 1; n >= 0; n--) {
+                    auto p = parents(n);
+                    value_t inlabel = m_inlabel(n);
+                    m_ascendant(n) = m_ascendant(p) | (inlabel & (~inlabel + 1));
+                    if (inlabel != m_inlabel(p)) {
+                        m_head_parent(inlabel) = (value_t) p;
+                    }
+                }
+            }
+
+            // inlabel of each node: index of the path containing the node in the complete binary tree
+            array_1d<value_t> m_inlabel;
+            // bitset of the heights of the inlabels of the ancestors of each node
+            array_1d<value_t> m_ascendant;
+            // parent of the highest node of the path of each inlabel
+            array_1d<value_t> m_head_parent;
+        };
+
     }
 
     using lca_sparse_table_block = lca_internal::lca_rmq<tree, range_minimum_query_internal::rmq_sparse_table_block<index_t>>;
     using lca_sparse_table = lca_internal::lca_rmq<tree, range_minimum_query_internal::rmq_sparse_table<index_t>>;
 
+    using lca_schieber_vishkin = lca_internal::lca_schieber_vishkin<tree, index_t>;
+    using lca_schieber_vishkin_32 = lca_internal::lca_schieber_vishkin<tree, uint32_t>;
+
     using lca_fast = lca_sparse_table_block;
 }
\ No newline at end of file
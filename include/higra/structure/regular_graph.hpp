@@ -35,6 +35,27 @@ namespace hg {
         template<typename embedding_t>
         struct regular_graph_adjacent_vertex_iterator;
 
+        /**
+         * Transforms a vertex t adjacent to the vertex v into the edge (v, t) (out edges) or (t, v) (in edges).
+         *
+         * @tparam out
+         */
+        template<bool out>
+        struct regular_graph_incident_edge_transform {
+            using edge_descriptor = std::pair<index_t, index_t>;
+
+            regular_graph_incident_edge_transform() : m_vertex(invalid_index) {}
+
+            regular_graph_incident_edge_transform(index_t vertex) : m_vertex(vertex) {}
+
+            edge_descriptor operator()(index_t t) const {
+                return out ? edge_descriptor(m_vertex, t) : edge_descriptor(t, m_vertex);
+            }
+
+        private:
+            index_t m_vertex;
+        };
+
         struct regular_graph_traversal_category :
                 virtual public graph::incidence_graph_tag,
                 virtual public graph::bidirectional_graph_tag,
@@ -62,15 +83,16 @@ namespace hg {
 
             // IncidenceGraph associated types
             using edge_descriptor = std::pair<vertex_descriptor, vertex_descriptor>;
-            using iterator_transform_function = std::function<edge_descriptor(vertex_descriptor)>;
 
-            using out_edge_iterator = transform_forward_iterator<iterator_transform_function,
+            using out_edge_iterator = transform_forward_iterator<regular_graph_incident_edge_transform<true>,
                     adjacency_iterator,
                     edge_descriptor>;
             using degree_size_type = size_t;
 
             //BidirectionalGraph associated types
-            using in_edge_iterator = out_edge_iterator;
+            using in_edge_iterator = transform_forward_iterator<regular_graph_incident_edge_transform<false>,
+                    adjacency_iterator,
+                    edge_descriptor>;
 
             using point_type = typename embedding_t::point_type;
 
@@ -288,34 +310,23 @@ namespace hg {
     template<typename embedding_t>
     std::pair<typename hg::regular_graph<embedding_t>::out_edge_iterator, typename hg::regular_graph<embedding_t>::out_edge_iterator>
     out_edges(typename hg::regular_graph<embedding_t>::vertex_descriptor u, const hg::regular_graph<embedding_t> &g) {
+        regular_graph_internal::regular_graph_incident_edge_transform<true> fun(u);
         return std::make_pair(
                 hg::regular_graph_out_edge_iterator<embedding_t>(
-                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g),
-                        [u](typename hg::regular_graph<embedding_t>::vertex_descriptor v) {
-                            return std::make_pair(u, v);
-                        }),
+                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g), fun),
                 hg::regular_graph_out_edge_iterator<embedding_t>(
-                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g, true),
-                        [u](typename hg::regular_graph<embedding_t>::vertex_descriptor v) {
-                            return std::make_pair(u, v);
-                        })
+                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g, true), fun)
         );
     }
 
     template<typename embedding_t>
-    std::pair<typename hg::regular_graph<embedding_t>::out_edge_iterator, typename hg::regular_graph<embedding_t>::out_edge_iterator>
+    std::pair<typename hg::regular_graph<embedding_t>::in_edge_iterator, typename hg::regular_graph<embedding_t>::in_edge_iterator>
     in_edges(typename hg::regular_graph<embedding_t>::vertex_descriptor u, const hg::regular_graph<embedding_t> &g) {
+        using it = typename hg::regular_graph<embedding_t>::in_edge_iterator;
+        regular_graph_internal::regular_graph_incident_edge_transform<false> fun(u);
         return std::make_pair(
-                hg::regular_graph_out_edge_iterator<embedding_t>(
-                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g),
-                        [u](typename hg::regular_graph<embedding_t>::vertex_descriptor v) {
-                            return std::make_pair(v, u);
-                        }),
-                hg::regular_graph_out_edge_iterator<embedding_t>(
-                        hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g, true),
-                        [u](typename hg::regular_graph<embedding_t>::vertex_descriptor v) {
-                            return std::make_pair(v, u);
-                        })
+                it(hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g), fun),
+                it(hg::regular_graph_adjacent_vertex_iterator<embedding_t>(u, g, true), fun)
         );
     }
 
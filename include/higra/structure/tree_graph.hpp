@@ -14,6 +14,9 @@
 #include "details/indexed_edge.hpp"
 #include "details/graph_concepts.hpp"
 #include "higra/structure/details/iterators.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <utility>
 #include "../utils.hpp"
@@ -21,6 +24,9 @@
 
 namespace hg {
 
+    namespace tree_internal {
+        struct tree_schedule;
+    }
 
     enum class tree_category {
         component_tree,
@@ -54,6 +60,32 @@ namespace hg {
         // forward declaration
         struct tree_graph_node_to_root_iterator;
 
+        // forward declaration
+        struct tree_graph_edge_transform;
+
+        /**
+         * Transforms a vertex t adjacent to the vertex v into the edge (v, t) (out edges) or (t, v) (in edges).
+         *
+         * @tparam out
+         */
+        template<bool out>
+        struct tree_graph_incident_edge_transform {
+            using edge_descriptor = indexed_edge<index_t, index_t>;
+
+            tree_graph_incident_edge_transform() : m_vertex(invalid_index) {}
+
+            tree_graph_incident_edge_transform(index_t vertex) : m_vertex(vertex) {}
+
+            edge_descriptor operator()(index_t t) const {
+                return out ?
+                       edge_descriptor(m_vertex, t, (std::min)(m_vertex, t)) :
+                       edge_descriptor(t, m_vertex, (std::min)(m_vertex, t));
+            }
+
+        private:
+            index_t m_vertex;
+        };
+
         struct tree_graph_traversal_category :
                 virtual public graph::incidence_graph_tag,
                 virtual public graph::bidirectional_graph_tag,
@@ -66,7 +98,7 @@ namespace hg {
             // Graph associated types
             using vertex_descriptor = index_t;
             using edge_index_t = index_t;
-            using children_list_t = std::vector<vertex_descriptor>;
+            using children_list_t = span<const vertex_descriptor>;
             using children_iterator = children_list_t::const_iterator;
             using ancestors_iterator = tree_graph_node_to_root_iterator;
             using edge_descriptor = indexed_edge<vertex_descriptor, edge_index_t>;
@@ -89,20 +121,21 @@ namespace hg {
 
             // EdgeListGraph associated types
             using edges_size_type = size_t;
-            using _edge_iterator_transform_function = std::function<edge_descriptor(edge_index_t)>;
-            using edge_iterator = transform_forward_iterator <_edge_iterator_transform_function,
-            counting_iterator<vertex_descriptor>, edge_descriptor>;
+            using edge_iterator = transform_forward_iterator<tree_graph_edge_transform,
+                    counting_iterator<vertex_descriptor>,
+                    edge_descriptor>;
 
 
             // IncidenceGraph associated types
-            using out_iterator_transform_function = std::function<edge_descriptor(vertex_descriptor)>;
-            using out_edge_iterator = transform_forward_iterator<out_iterator_transform_function,
+            using out_edge_iterator = transform_forward_iterator<tree_graph_incident_edge_transform<true>,
                     tree_graph_adjacent_vertex_iterator<false>,
                     edge_descriptor>;
             using degree_size_type = size_t;
 
             //BidirectionalGraph associated types
-            using in_edge_iterator = out_edge_iterator;
+            using in_edge_iterator = transform_forward_iterator<tree_graph_incident_edge_transform<false>,
+                    tree_graph_adjacent_vertex_iterator<false>,
+                    edge_descriptor>;
 
             tree() : _root(invalid_index), _num_vertices(0), _num_leaves(0), _children_computed(false), _category(tree_category::partition_tree){
 
@@ -113,7 +146,6 @@ namespace hg {
                  tree_category category = tree_category::partition_tree) :
                     _parents(parents),
                     _children_computed(false),
-                    _children(0),
                     _category(category) {
                 HG_TRACE();
                 _init();
@@ -124,7 +156,6 @@ namespace hg {
                  tree_category category = tree_category::partition_tree) :
                     _parents(std::move(parents.derived_cast())),
                     _children_computed(false),
-                    _children(0),
                     _category(category) {
                 HG_TRACE();
                 _init();
@@ -146,18 +177,24 @@ namespace hg {
                 return (_num_vertices == 0) ? 0 : _num_vertices - 1;
             }
 
-            const auto &children(vertex_descriptor v) const {
+            /**
+             * Children of the node v (ordered by increasing index) as a view on the children storage of the tree.
+             * Requires compute_children to have been called.
+             */
+            children_list_t children(vertex_descriptor v) const {
                 if (v < _num_leaves) {
-                    return _empty_children;
+                    return children_list_t();
                 }
-                return _children[v - _num_leaves];
+                auto data = _children_indices.data();
+                return children_list_t(data + _children_offsets(v - _num_leaves),
+                                       data + _children_offsets(v - _num_leaves + 1));
             }
 
             size_t num_children(const vertex_descriptor v) const {
                 if (v < _num_leaves) {
                     return 0;
                 }
-                return _children[v - _num_leaves].size();
+                return (size_t) (_children_offsets(v - _num_leaves + 1) - _children_offsets(v - _num_leaves));
             }
 
             vertex_descriptor root() const {
@@ -177,7 +214,7 @@ namespace hg {
             }
 
             auto child(index_t i, vertex_descriptor v) const {
-                return _children[v - _num_leaves][i];
+                return _children_indices(_children_offsets(v - _num_leaves) + i);
             }
 
             template<typename... Args>
@@ -223,19 +260,23 @@ namespace hg {
                 return v;
             }
 
+            /**
+             * Compute the children of every node of the tree.
+             *
+             * The children are stored in compressed sparse row format: the children of the internal node n
+             * are the elements of children_indices in the range [children_offsets(n - num_leaves),
+             * children_offsets(n - num_leaves + 1)), ordered by increasing index.
+             */
             void compute_children() const {
                 if (!_children_computed) {
-                    _children.resize(_num_vertices - _num_leaves);
-                    for (vertex_descriptor v = 0; v < _root; ++v) {
-                        vertex_descriptor parent_v = _parents(v);
-                        _children[parent_v - _num_leaves].push_back(v);
-                    }
+                    _compute_children();
                     _children_computed = true;
                 }
             }
 
             void clear_children() const {
-                _children.clear();
+                _children_offsets = array_1d<index_t>();
+                _children_indices = array_1d<vertex_descriptor>();
                 _children_computed = false;
             }
 
@@ -243,6 +284,15 @@ namespace hg {
                 return _children_computed;
             }
 
+            /**
+             * Partition of the nodes into independent subtrees used by the parallel traversals of the tree
+             * (see tree_internal::schedule_leaves_to_root). It is built on first use, can safely be requested
+             * concurrently, and is shared by the copies of the tree.
+             *
+             * Defined in details/tree_schedule.hpp.
+             */
+            const tree_internal::tree_schedule &schedule() const;
+
             auto sources() const{
                 return xt::arange<index_t>(0, _num_vertices - 1);
             }
@@ -254,6 +304,55 @@ namespace hg {
 
         private:
 
+            void _compute_children() const {
+                const index_t num_internal_nodes = (index_t) _num_vertices - _num_leaves;
+                const index_t num_edges = (index_t) this->num_edges();
+                _children_offsets = array_1d<index_t>::from_shape({(size_t) num_internal_nodes + 1});
+                _children_indices = array_1d<vertex_descriptor>::from_shape({(size_t) num_edges});
+                const auto &parents = _parents;
+                auto &offsets = _children_offsets;
+                auto &indices = _children_indices;
+                const index_t num_leaves = _num_leaves;
+#ifdef HG_USE_TBB
+                // count and scatter with atomic cursors, then restore the ordering inside each children list
+                std::unique_ptr<std::atomic<index_t>[]> cursors(new std::atomic<index_t>[num_internal_nodes]);
+                parfor(0, num_internal_nodes, [&cursors](index_t i) {
+                    cursors[i].store(0, std::memory_order_relaxed);
+                });
+                parfor(0, num_edges, [&cursors, &parents, num_leaves](index_t v) {
+                    cursors[parents(v) - num_leaves].fetch_add(1, std::memory_order_relaxed);
+                });
+                offsets(0) = 0;
+                for (index_t i = 0; i < num_internal_nodes; i++) {
+                    offsets(i + 1) = offsets(i) + cursors[i].load(std::memory_order_relaxed);
+                    cursors[i].store(offsets(i), std::memory_order_relaxed);
+                }
+                parfor(0, num_edges, [&cursors, &parents, &indices, num_leaves](index_t v) {
+                    indices(cursors[parents(v) - num_leaves].fetch_add(1, std::memory_order_relaxed)) = v;
+                });
+                parfor(0, num_internal_nodes, [&offsets, &indices](index_t i) {
+                    std::sort(indices.data() + offsets(i), indices.data() + offsets(i + 1));
+                });
+#else
+                // counting sort of the non root nodes by parent
+                std::fill(offsets.begin(), offsets.end(), 0);
+                for (index_t v = 0; v < num_edges; v++) {
+                    offsets(parents(v) - num_leaves + 1)++;
+                }
+                for (index_t i = 0; i < num_internal_nodes; i++) {
+                    offsets(i + 1) += offsets(i);
+                }
+                // offsets(i) is used as the insertion cursor of node i and ends up equal to the original offsets(i + 1)
+                for (index_t v = 0; v < num_edges; v++) {
+                    indices(offsets(parents(v) - num_leaves)++) = v;
+                }
+                for (index_t i = num_internal_nodes; i > 0; i--) {
+                    offsets(i) = offsets(i - 1);
+                }
+                offsets(0) = 0;
+#endif
+            }
+
             void _init() {
                 if (_parents.size() == 0) {
                     _root = invalid_index;
@@ -291,11 +390,10 @@ namespace hg {
             index_t _num_leaves;
             array_1d <vertex_descriptor> _parents;
             mutable bool _children_computed;
-            mutable std::vector<children_list_t> _children;
+            mutable array_1d<index_t> _children_offsets;
+            mutable array_1d<vertex_descriptor> _children_indices;
+            mutable std::shared_ptr<const tree_internal::tree_schedule> _schedule;
             tree_category _category;
-
-            // for leaf nodes
-            children_list_t _empty_children;
         };
 
 
@@ -370,6 +468,23 @@ namespace hg {
         };
 
 
+        /**
+         * Transforms an edge index into the corresponding edge of the tree.
+         */
+        struct tree_graph_edge_transform {
+
+            tree_graph_edge_transform() : m_tree(nullptr) {}
+
+            tree_graph_edge_transform(const tree &t) : m_tree(&t) {}
+
+            tree::edge_descriptor operator()(tree::edge_index_t ei) const {
+                return m_tree->edge_from_index(ei);
+            }
+
+        private:
+            const tree *m_tree;
+        };
+
         struct tree_graph_node_to_root_iterator :
                 public forward_iterator_facade<tree_graph_node_to_root_iterator, tree::vertex_descriptor> {
         public:
@@ -554,7 +669,7 @@ namespace hg {
     inline
     std::pair<tree::children_iterator, tree::children_iterator>
     children(const tree::vertex_descriptor v, const tree &g) {
-        auto &c = g.children(v);
+        auto c = g.children(v);
         return std::make_pair(c.cbegin(), c.cend());
     }
 
@@ -624,9 +739,7 @@ namespace hg {
     std::pair<typename hg::tree::edge_iterator, typename hg::tree::edge_iterator>
     edges(const hg::tree &g) {
         using it = hg::tree::edge_iterator;
-        auto fun = [&g](hg::tree::edge_index_t i) {
-            return g.edge_from_index(i);
-        };
+        tree_internal::tree_graph_edge_transform fun(g);
         return std::make_pair(
                 it(counting_iterator<hg::tree::vertex_descriptor>(0),
                    fun),                 // The first iterator position
@@ -638,7 +751,7 @@ namespace hg {
     std::pair<typename hg::tree::adjacency_iterator, typename hg::tree::adjacency_iterator>
     adjacent_vertices(typename hg::tree::vertex_descriptor v, const hg::tree &g) {
         using it = typename hg::tree::adjacency_iterator;
-        auto &c = g.children(v);
+        auto c = g.children(v);
         auto par = g.parent(v);
         return std::make_pair(
                 it(v, par, c.cbegin()),
@@ -649,10 +762,8 @@ namespace hg {
     inline
     std::pair<hg::tree::out_edge_iterator, hg::tree::out_edge_iterator>
     out_edges(hg::tree::vertex_descriptor v, const hg::tree &g) {
-        auto fun = [v](const typename hg::tree::vertex_descriptor t) {
-            return hg::tree::edge_descriptor(v, t, (std::min)(v, t));
-        };
-        auto &c = g.children(v);
+        tree_internal::tree_graph_incident_edge_transform<true> fun(v);
+        auto c = g.children(v);
         using it = typename hg::tree::out_edge_iterator;
         using ita = typename hg::tree::adjacency_iterator;
         auto par = g.parent(v);
@@ -662,13 +773,11 @@ namespace hg {
     }
 
     inline
-    std::pair<hg::tree::out_edge_iterator, hg::tree::out_edge_iterator>
+    std::pair<hg::tree::in_edge_iterator, hg::tree::in_edge_iterator>
     in_edges(hg::tree::vertex_descriptor v, const hg::tree &g) {
-        auto fun = [v](const typename hg::tree::vertex_descriptor t) {
-            return hg::tree::edge_descriptor(t, v, (std::min)(v, t));
-        };
-        auto &c = g.children(v);
-        using it = typename hg::tree::out_edge_iterator;
+        tree_internal::tree_graph_incident_edge_transform<false> fun(v);
+        auto c = g.children(v);
+        using it = typename hg::tree::in_edge_iterator;
         using ita = typename hg::tree::adjacency_iterator;
         auto par = g.parent(v);
         return std::make_pair(
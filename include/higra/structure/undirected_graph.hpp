@@ -77,6 +77,54 @@ namespace hg {
             c.insert(v);
         }
 
+        /**
+         * Transforms the index of an edge incident to the vertex v into an edge descriptor oriented from v
+         * (out edges) or toward v (in edges).
+         *
+         * @tparam graph_t
+         * @tparam out
+         */
+        template<typename graph_t, bool out>
+        struct incident_edge_transform {
+            using edge_descriptor = indexed_edge<index_t, index_t>;
+
+            incident_edge_transform() : m_vertex(invalid_index), m_graph(nullptr) {}
+
+            incident_edge_transform(index_t vertex, const graph_t &graph) : m_vertex(vertex), m_graph(&graph) {}
+
+            edge_descriptor operator()(index_t ei) const {
+                const auto &e = m_graph->edge_from_index(ei);
+                auto other = (m_vertex == e.source) ? e.target : e.source;
+                return out ? edge_descriptor(m_vertex, other, e.index) : edge_descriptor(other, m_vertex, e.index);
+            }
+
+        private:
+            index_t m_vertex;
+            const graph_t *m_graph;
+        };
+
+        /**
+         * Transforms the index of an edge incident to the vertex v into the other extremity of the edge.
+         *
+         * @tparam graph_t
+         */
+        template<typename graph_t>
+        struct adjacent_vertex_transform {
+
+            adjacent_vertex_transform() : m_vertex(invalid_index), m_graph(nullptr) {}
+
+            adjacent_vertex_transform(index_t vertex, const graph_t &graph) : m_vertex(vertex), m_graph(&graph) {}
+
+            index_t operator()(index_t ei) const {
+                const auto &e = m_graph->edge_from_index(ei);
+                return (m_vertex == e.source) ? e.target : e.source;
+            }
+
+        private:
+            index_t m_vertex;
+            const graph_t *m_graph;
+        };
+
         template<typename edgeS=vecS>
         struct undirected_graph {
 
@@ -103,18 +151,18 @@ namespace hg {
             using edge_iterator = std::vector<edge_descriptor>::const_iterator;
 
             // IncidenceGraph associated types
-            using out_iterator_transform_function = std::function<edge_descriptor(edge_index_t)>;
-            using out_edge_iterator = transform_forward_iterator<out_iterator_transform_function,
+            using out_edge_iterator = transform_forward_iterator<incident_edge_transform<undirected_graph, true>,
                     out_edge_index_iterator,
                     edge_descriptor>;
             using degree_size_type = size_t;
 
             //BidirectionalGraph associated types
-            using in_edge_iterator = out_edge_iterator;
+            using in_edge_iterator = transform_forward_iterator<incident_edge_transform<undirected_graph, false>,
+                    in_edge_index_iterator,
+                    edge_descriptor>;
 
             //AdjacencyGraph associated types
-            using adjacent_iterator_transform_function = std::function<vertex_descriptor(edge_index_t)>;
-            using adjacency_iterator = transform_forward_iterator<adjacent_iterator_transform_function,
+            using adjacency_iterator = transform_forward_iterator<adjacent_vertex_transform<undirected_graph>,
                     out_edge_index_iterator,
                     vertex_descriptor>;
 
@@ -359,11 +407,7 @@ namespace hg {
     template<typename T>
     std::pair<typename hg::undirected_graph<T>::out_edge_iterator, typename hg::undirected_graph<T>::out_edge_iterator>
     out_edges(typename hg::undirected_graph<T>::vertex_descriptor v, const hg::undirected_graph<T> &g) {
-        auto fun = [v, &g](const typename hg::undirected_graph<T>::edge_index_t &oei) {
-            const auto &oe = g.edge_from_index(oei);
-            return typename hg::undirected_graph<T>::edge_descriptor(v, (v == oe.source) ? oe.target : oe.source,
-                                                                     oe.index);
-        };
+        undirected_graph_internal::incident_edge_transform<hg::undirected_graph<T>, true> fun(v, g);
         using it = typename hg::undirected_graph<T>::out_edge_iterator;
         return std::make_pair(
                 it(g.out_edges_cbegin(v), fun),
@@ -371,14 +415,10 @@ namespace hg {
     }
 
     template<typename T>
-    std::pair<typename hg::undirected_graph<T>::out_edge_iterator, typename hg::undirected_graph<T>::out_edge_iterator>
+    std::pair<typename hg::undirected_graph<T>::in_edge_iterator, typename hg::undirected_graph<T>::in_edge_iterator>
     in_edges(typename hg::undirected_graph<T>::vertex_descriptor v, const hg::undirected_graph<T> &g) {
-        auto fun = [v, &g](const typename hg::undirected_graph<T>::edge_index_t &oei) {
-            const auto &oe = g.edge_from_index(oei);
-            return typename hg::undirected_graph<T>::edge_descriptor((v == oe.source) ? oe.target : oe.source, v,
-                                                                     oe.index);
-        };
-        using it = typename hg::undirected_graph<T>::out_edge_iterator;
+        undirected_graph_internal::incident_edge_transform<hg::undirected_graph<T>, false> fun(v, g);
+        using it = typename hg::undirected_graph<T>::in_edge_iterator;
         return std::make_pair(
                 it(g.out_edges_cbegin(v), fun),
                 it(g.out_edges_cend(v), fun));
@@ -387,10 +427,7 @@ namespace hg {
     template<typename T>
     std::pair<typename hg::undirected_graph<T>::adjacency_iterator, typename hg::undirected_graph<T>::adjacency_iterator>
     adjacent_vertices(typename hg::undirected_graph<T>::vertex_descriptor v, const hg::undirected_graph<T> &g) {
-        auto fun = [v, &g](const typename hg::undirected_graph<T>::edge_index_t &oei) {
-            const auto &oe = g.edge_from_index(oei);
-            return (v == oe.source) ? oe.target : oe.source;
-        };
+        undirected_graph_internal::adjacent_vertex_transform<hg::undirected_graph<T>> fun(v, g);
         using it = typename hg::undirected_graph<T>::adjacency_iterator;
         return std::make_pair(
                 it(g.out_edges_cbegin(v), fun),
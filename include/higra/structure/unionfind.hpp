@@ -50,6 +50,21 @@ namespace hg {
                 return i;
             }
 
+            /**
+             * Find the canonical element of the given element without modifying the structure (no path compression).
+             *
+             * Contrarily to find, this method can be called concurrently by several threads as long as no other
+             * thread is modifying the structure.
+             *
+             * @param element
+             * @return index of the canonical node of element
+             */
+            idx_t find_no_compression(idx_t element) const {
+                while (parent[element] != element)
+                    element = parent[element];
+                return element;
+            }
+
             /**
              * Union by rank
              * @param i index of canonical node
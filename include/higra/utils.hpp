@@ -26,6 +26,12 @@
 
 #endif
 
+#ifdef _MSC_VER
+#include <intrin.h>
+#pragma intrinsic(_BitScanReverse64)
+#pragma intrinsic(_BitScanForward64)
+#endif
+
 namespace hg {
 
     /**
@@ -151,6 +157,13 @@ namespace hg {
 #define HG_XSTR(a) HG_STR(a)
 #define HG_STR(a) #a
 
+// hint the processor to load the cache line containing the given address (no-op if not supported)
+#if defined(__GNUC__) || defined(__clang__)
+#define HG_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define HG_PREFETCH(address) ((void)0)
+#endif
+
 
 #define HG_TEMPLATE_SINTEGRAL_TYPES   int8_t, int16_t, int32_t, int64_t
 
@@ -210,6 +223,32 @@ namespace hg {
     }
 
 
+    /**
+     * Index of the most significant bit set in x (precondition x > 0)
+     */
+    inline index_t most_significant_bit(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanReverse64(&index, x);
+        return index;
+#else
+        return 63 - __builtin_clzll(x);
+#endif
+    }
+
+    /**
+     * Index of the least significant bit set in x (precondition x > 0)
+     */
+    inline index_t least_significant_bit(uint64_t x) {
+#ifdef _MSC_VER
+        unsigned long index = 0;
+        _BitScanForward64(&index, x);
+        return index;
+#else
+        return __builtin_ctzll(x);
+#endif
+    }
+
     /**
      * Insert all elements of collection b at the end of collection a.
      * @tparam T1 must have an insert method (STL like) and a range interface (begin, end)
@@ -10,7 +10,10 @@
 
 #include "../test_utils.hpp"
 #include "higra/accumulator/tree_accumulator.hpp"
+#include "xtensor/xrandom.hpp"
 #include <functional>
+#include <numeric>
+#include <random>
 
 
 using namespace hg;
@@ -262,4 +265,54 @@ namespace tree_accumulator {
                            {8,  1}};
         REQUIRE(xt::allclose(ref5, output5));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("accumulators large tree", "[tree_accumulator]") {
+        // random binary tree large enough to be processed by subtrees (see tree_internal::tree_schedule)
+        const index_t num_leaves = tree_internal::tree_schedule_min_size;
+        const index_t num_nodes = 2 * num_leaves - 1;
+        xt::random::seed(42);
+        array_1d<index_t> parents = array_1d<index_t>::from_shape({(size_t) num_nodes});
+        vector<index_t> roots(num_leaves);
+        std::iota(roots.begin(), roots.end(), 0);
+        std::mt19937 generator(42);
+        for (index_t n = num_leaves; n < num_nodes; n++) {
+            for (index_t k = 0; k < 2; k++) {
+                std::uniform_int_distribution<index_t> distribution(0, (index_t) roots.size() - 1);
+                auto i = distribution(generator);
+                parents(roots[i]) = n;
+                roots[i] = roots.back();
+                roots.pop_back();
+            }
+            roots.push_back(n);
+        }
+        parents(num_nodes - 1) = num_nodes - 1;
+        hg::tree tree(parents);
+        REQUIRE((index_t) num_vertices(tree) >= tree_internal::tree_schedule_min_size);
+
+        array_1d<index_t> input = xt::random::randint<index_t>({(size_t) num_nodes}, -100, 100);
+        array_1d<bool> condition = xt::random::randint<int>({(size_t) num_nodes}, 0, 2);
+
+        // serial references: parents have larger indices than their children
+        array_1d<index_t> ref_accumulate = xt::zeros<index_t>({(size_t) num_nodes});
+        array_1d<index_t> ref_accumulate_sequential = xt::zeros<index_t>({(size_t) num_nodes});
+        xt::view(ref_accumulate_sequential, xt::range(0, num_leaves)) = xt::view(input, xt::range(0, num_leaves));
+        for (index_t n = 0; n < num_nodes - 1; n++) {
+            ref_accumulate(parents(n)) += input(n);
+            ref_accumulate_sequential(parents(n)) += ref_accumulate_sequential(n);
+        }
+        array_1d<index_t> ref_propagate = array_1d<index_t>::from_shape({(size_t) num_nodes});
+        array_1d<index_t> ref_propagate_accumulate = array_1d<index_t>::from_shape({(size_t) num_nodes});
+        ref_propagate(num_nodes - 1) = input(num_nodes - 1);
+        ref_propagate_accumulate(num_nodes - 1) = input(num_nodes - 1);
+        for (index_t n = num_nodes - 2; n >= 0; n--) {
+            ref_propagate(n) = condition(n) ? ref_propagate(parents(n)) : input(n);
+            ref_propagate_accumulate(n) = input(n) + ref_propagate_accumulate(parents(n));
+        }
+
+        REQUIRE((accumulate_parallel(tree, input, accumulator_sum()) == ref_accumulate));
+        REQUIRE((accumulate_sequential(tree, xt::view(input, xt::range(0, num_leaves)), accumulator_sum()) ==
+                 ref_accumulate_sequential));
+        REQUIRE((propagate_sequential(tree, input, condition) == ref_propagate));
+        REQUIRE((propagate_sequential_and_accumulate(tree, input, accumulator_sum()) == ref_propagate_accumulate));
+    }
+}
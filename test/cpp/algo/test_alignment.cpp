@@ -12,6 +12,7 @@
 #include "higra/image/graph_image.hpp"
 #include "../test_utils.hpp"
 #include "higra/algo/tree.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 
@@ -110,4 +111,66 @@ namespace test_alignment {
         REQUIRE((sm_k == sm_k_ref));
     }
 
-}
\ No newline at end of file
+    TEST_CASE("hierarchy alignment random", "[alignment]") {
+        xt::random::seed(42);
+        auto g = get_4_adjacency_graph({15, 12});
+        array_1d<int> fine_cut = xt::random::randint<int>({num_edges(g)}, 0, 2);
+        auto aligner = make_hierarchy_aligner_from_graph_cut(g, fine_cut);
+        auto fine_rag = make_region_adjacency_graph_from_graph_cut(g, fine_cut);
+
+        std::vector<tree> trees;
+        std::vector<array_1d<double>> altitudes;
+        std::vector<array_1d<double>> saliency_maps;
+        for (index_t i = 0; i < 4; i++) {
+            // some edges of weight 0 create non trivial supervertices
+            array_1d<double> edge_weights = xt::random::randint<int>({num_edges(g)}, 0, 6);
+            auto res = bpt_canonical(g, edge_weights);
+            trees.push_back(std::move(res.tree));
+            altitudes.push_back(std::move(res.altitudes));
+            saliency_maps.push_back(saliency_map(g, trees.back(), altitudes.back()));
+        }
+
+        auto sms_trees = aligner.align_hierarchies(trees, altitudes);
+        auto sms_graph = aligner.align_hierarchies(g, saliency_maps);
+        REQUIRE(sms_trees.size() == trees.size());
+        REQUIRE(sms_graph.size() == trees.size());
+
+        for (index_t i = 0; i < (index_t) trees.size(); i++) {
+            // naive projection
+            auto sv = supervertices_hierarchy(trees[i], altitudes[i]);
+            array_1d<double> sv_altitudes = xt::index_view(altitudes[i], sv.node_map);
+            auto fine_to_coarse = project_fine_to_coarse_labelisation(fine_rag.vertex_map,
+                                                                      sv.supervertex_labelisation);
+            array_1d<double> ref = xt::zeros<double>({num_edges(g)});
+            for (auto e: edge_iterator(g)) {
+                auto r1 = fine_rag.vertex_map(source(e, g));
+                auto r2 = fine_rag.vertex_map(target(e, g));
+                if (r1 != r2) {
+                    auto lca = lowest_common_ancestor(fine_to_coarse(r1), fine_to_coarse(r2), sv.tree);
+                    ref(index(e, g)) = sv_altitudes(lca);
+                }
+            }
+
+            REQUIRE((sms_trees[i] == ref));
+            REQUIRE((aligner.align_hierarchy(trees[i], altitudes[i]) == ref));
+            REQUIRE((sms_graph[i] == ref));
+        }
+
+        std::vector<std::reference_wrapper<const tree>> tree_refs(trees.begin(), trees.end());
+        std::vector<array_1d<index_t>> supervertices;
+        std::vector<array_1d<double>> sv_altitudes;
+        std::vector<tree> sv_trees;
+        for (index_t i = 0; i < (index_t) trees.size(); i++) {
+            auto sv = supervertices_hierarchy(trees[i], altitudes[i]);
+            supervertices.push_back(sv.supervertex_labelisation);
+            sv_altitudes.push_back(xt::index_view(altitudes[i], sv.node_map));
+            sv_trees.push_back(std::move(sv.tree));
+        }
+        auto sms_sv = aligner.align_hierarchies(supervertices, sv_trees, sv_altitudes);
+        auto sms_refs = aligner.align_hierarchies(tree_refs, altitudes);
+        for (index_t i = 0; i < (index_t) trees.size(); i++) {
+            REQUIRE((sms_sv[i] == sms_trees[i]));
+            REQUIRE((sms_refs[i] == sms_trees[i]));
+        }
+    }
+}
@@ -11,6 +11,7 @@
 #include "../test_utils.hpp"
 #include "higra/algo/rag.hpp"
 #include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 
@@ -284,4 +285,119 @@ namespace test_rag {
         REQUIRE((rag_edge_weights_vec == expected_rag_edge_weights_vec));
     }
 
-}
\ No newline at end of file
+    TEST_CASE("parallel rag", "[rag]") {
+
+        auto g = hg::get_4_adjacency_graph({4, 4});
+        array_1d<int> vertex_labels{1, 1, 5, 5,
+                                    1, 1, 5, 5,
+                                    1, 1, 3, 3,
+                                    1, 1, 10, 10};
+
+        auto data = make_region_adjacency_graph_from_labelisation_parallel(g, vertex_labels);
+        auto &rag = data.rag;
+
+        REQUIRE(num_vertices(rag) == 4);
+        REQUIRE(num_edges(rag) == 5);
+
+        std::vector<ugraph::edge_descriptor> expected_edges = {
+                {0, 1, 0},
+                {0, 2, 1},
+                {0, 3, 2},
+                {1, 2, 3},
+                {2, 3, 4}
+        };
+        index_t i = 0;
+        for (auto e: edge_iterator(rag)) {
+            REQUIRE(e == expected_edges[i++]);
+        }
+
+        array_1d<index_t> expected_vertex_map{
+                0, 0, 1, 1,
+                0, 0, 1, 1,
+                0, 0, 2, 2,
+                0, 0, 3, 3
+        };
+        REQUIRE((data.vertex_map == expected_vertex_map));
+
+        auto iv = invalid_index;
+        array_1d<index_t> expected_edge_map{
+                iv, iv, 0, iv, iv, iv, iv,
+                iv, iv, 0, iv, iv, 3, 3,
+                iv, iv, 1, iv, iv, 4, 4,
+                iv, 2, iv
+        };
+        REQUIRE((data.edge_map == expected_edge_map));
+
+        array_1d<int> edge_weights({24}, 1);
+        auto rag_edge_weights = rag_accumulate(data.edge_map, edge_weights, accumulator_sum());
+        array_nd<double> expected_rag_edge_weights{2, 1, 1, 2, 2};
+        REQUIRE((rag_edge_weights == expected_rag_edge_weights));
+    }
+
+    TEST_CASE("parallel rag slabs", "[rag]") {
+
+        xt::random::seed(42);
+        auto g = copy_graph<ugraph>(get_8_adjacency_implicit_graph({37, 53}));
+        array_1d<int> vertex_labels = xt::random::randint<int>({num_vertices(g)}, 0, 4);
+        auto reference = make_region_adjacency_graph_from_labelisation(g, vertex_labels);
+
+        for (index_t num_slabs: {1, 2, 3, 7, 100, 10000}) {
+            auto res = rag_internal::parallel_region_adjacency_graph_from_labelisation(g, vertex_labels, num_slabs);
+            REQUIRE(num_vertices(res.rag) == num_vertices(reference.rag));
+            REQUIRE(num_edges(res.rag) == num_edges(reference.rag));
+            REQUIRE((res.vertex_map == reference.vertex_map));
+
+            for (index_t i = 1; i < (index_t) num_edges(res.rag); i++) {
+                auto e1 = edge_from_index(i - 1, res.rag);
+                auto e2 = edge_from_index(i, res.rag);
+                REQUIRE(source(e1, res.rag) < target(e1, res.rag));
+                REQUIRE(std::make_pair(source(e1, res.rag), target(e1, res.rag)) <
+                        std::make_pair(source(e2, res.rag), target(e2, res.rag)));
+            }
+
+            for (index_t i = 0; i < (index_t) num_edges(g); i++) {
+                auto ref_edge = reference.edge_map(i);
+                auto res_edge = res.edge_map(i);
+                if (ref_edge == invalid_index) {
+                    REQUIRE(res_edge == invalid_index);
+                } else {
+                    REQUIRE(res_edge != invalid_index);
+                    auto e1 = edge_from_index(ref_edge, reference.rag);
+                    auto e2 = edge_from_index(res_edge, res.rag);
+                    REQUIRE((std::min)(source(e1, reference.rag), target(e1, reference.rag)) == source(e2, res.rag));
+                    REQUIRE((std::max)(source(e1, reference.rag), target(e1, reference.rag)) == target(e2, res.rag));
+                }
+            }
+        }
+    }
+
+    TEST_CASE("parallel rag csr", "[rag]") {
+
+        xt::random::seed(42);
+        auto g = get_4_adjacency_graph({23, 31});
+        array_1d<int> vertex_labels = xt::random::randint<int>({num_vertices(g)}, 0, 5);
+        auto reference = make_region_adjacency_graph_from_labelisation_parallel(g, vertex_labels);
+        auto res = make_region_adjacency_csr_graph_from_labelisation(g, vertex_labels);
+
+        REQUIRE(num_vertices(res.rag) == num_vertices(reference.rag));
+        REQUIRE(num_edges(res.rag) == num_edges(reference.rag));
+        REQUIRE((res.vertex_map == reference.vertex_map));
+        REQUIRE((res.edge_map == reference.edge_map));
+
+        for (index_t i = 0; i < (index_t) num_edges(res.rag); i++) {
+            REQUIRE(source(edge_from_index(i, res.rag), res.rag) ==
+                    source(edge_from_index(i, reference.rag), reference.rag));
+            REQUIRE(target(edge_from_index(i, res.rag), res.rag) ==
+                    target(edge_from_index(i, reference.rag), reference.rag));
+        }
+
+        for (index_t v = 0; v < (index_t) num_vertices(res.rag); v++) {
+            REQUIRE(degree(v, res.rag) == degree(v, reference.rag));
+        }
+
+        array_1d<int> edge_weights({num_edges(g)}, 1);
+        auto rag_edge_weights = rag_accumulate(res.edge_map, edge_weights, accumulator_sum());
+        auto expected_rag_edge_weights = rag_accumulate(reference.edge_map, edge_weights, accumulator_sum());
+        REQUIRE((rag_edge_weights == expected_rag_edge_weights));
+    }
+}
@@ -11,6 +11,7 @@
 #include "../test_utils.hpp"
 #include "higra/algo/watershed.hpp"
 #include "higra/image/graph_image.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 
@@ -45,6 +46,34 @@ namespace test_watershed {
         REQUIRE((labels == expected));
     }
 
+    template<typename graph_t>
+    void test_watershed_regular_graph(const graph_t &graph) {
+        auto explicit_graph = copy_graph<ugraph>(graph);
+        for (int max_value: {2, 5, 1000}) {
+            array_1d<int> edge_weights = xt::random::randint<int>({num_edges(explicit_graph)}, 0, max_value);
+            auto reference = labelisation_watershed(explicit_graph, edge_weights);
+            auto labels = labelisation_watershed(graph, edge_weights);
+            REQUIRE((labels == reference));
+        }
+    }
+
+    TEST_CASE("watershed cut regular graph", "[watershed_cut]") {
+        xt::random::seed(1);
+        auto g = get_4_adjacency_implicit_graph({4, 4});
+        array_1d<int> edge_weights{1, 2, 5, 5, 5, 8, 1, 4, 3, 4, 4, 1, 5, 2, 6, 3, 5, 4, 0, 7, 0, 3, 4, 0};
+        auto labels = labelisation_watershed(g, edge_weights);
+        array_1d<int> expected{1, 1, 1, 2,
+                               1, 1, 2, 2,
+                               1, 1, 3, 3,
+                               1, 1, 3, 3};
+        REQUIRE((labels == expected));
+
+        test_watershed_regular_graph(get_4_adjacency_implicit_graph({23, 31}));
+        test_watershed_regular_graph(get_8_adjacency_implicit_graph({23, 31}));
+        test_watershed_regular_graph(get_6_adjacency_implicit_graph({7, 9, 11}));
+        test_watershed_regular_graph(get_4_adjacency_implicit_graph({1, 17}));
+    }
+
     TEST_CASE("seeded watersed 1", "[seeded_watersed_cut]") {
         auto g = hg::get_4_adjacency_graph({4, 4});
         array_1d<int> edge_weights{1, 2, 5, 5, 4, 8, 1, 4, 3, 4, 4, 1, 5, 2, 6, 2, 5, 2, 0, 7, 0, 3, 4, 0};
@@ -128,4 +157,66 @@ namespace test_watershed {
         REQUIRE((labels == expected));
     }
 
+    // reference implementation: union-find flooding on all the edges of the graph sorted by increasing weights
+    template<typename graph_t, typename T1, typename T2>
+    auto seeded_watershed_reference(const graph_t &graph, const T1 &edge_weights, const T2 &vertex_seeds,
+                                    typename T2::value_type background_label = 0) {
+        array_1d<index_t> sorted_edges_indices = stable_arg_sort(edge_weights);
+        union_find uf(num_vertices(graph));
+        T2 labels = vertex_seeds;
+        for (auto ei: sorted_edges_indices) {
+            auto e = edge_from_index(ei, graph);
+            auto c1 = uf.find(source(e, graph));
+            auto c2 = uf.find(target(e, graph));
+            if (c1 != c2 && (labels(c1) == background_label || labels(c2) == background_label)) {
+                if (labels(c1) == background_label) {
+                    labels(c1) = labels(c2);
+                } else {
+                    labels(c2) = labels(c1);
+                }
+                uf.link(c1, c2);
+            }
+        }
+        for (index_t i = 0; i < (index_t) num_vertices(graph); i++) {
+            if (labels(i) == background_label) {
+                labels(i) = labels(uf.find(i));
+            }
+        }
+        return labels;
+    }
+
+    TEST_CASE("seeded watersed reuse minimum spanning forest", "[seeded_watersed_cut]") {
+        xt::random::seed(3);
+        auto g = hg::get_4_adjacency_graph({20, 30});
+        // few distinct values to test ties
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(g)}, 0, 5);
+        auto msf = make_seeded_watershed_msf(g, edge_weights);
+        REQUIRE(msf.num_vertices == 600);
+        REQUIRE(msf.sources.size() == 599);
+
+        for (index_t i = 0; i < 5; i++) {
+            array_1d<int> seeds = xt::random::randint<int>({num_vertices(g)}, 0, 30);
+            seeds = xt::where(seeds < 5, seeds, 0);
+            auto expected = seeded_watershed_reference(g, edge_weights, seeds);
+            REQUIRE((labelisation_seeded_watershed(msf, seeds) == expected));
+            REQUIRE((labelisation_seeded_watershed(g, edge_weights, seeds) == expected));
+        }
+    }
+
+    TEST_CASE("seeded watersed parallel minimum spanning forest", "[seeded_watersed_cut]") {
+        xt::random::seed(4);
+        auto g = copy_graph<ugraph>(get_6_adjacency_implicit_graph({9, 11, 13}));
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(g)}, 0, 10);
+        array_1d<index_t> seeds = xt::random::randint<index_t>({num_vertices(g)}, 0, 50);
+        seeds = xt::where(seeds < 6, seeds, 0);
+        auto expected_msf = watershed_internal::sorted_minimum_spanning_forest(g, edge_weights, 1);
+        auto expected = seeded_watershed_reference(g, edge_weights, seeds);
+
+        for (index_t num_slabs: {2, 3, 9, 100, 2000}) {
+            auto msf = watershed_internal::sorted_minimum_spanning_forest(g, edge_weights, num_slabs);
+            REQUIRE((msf == expected_msf));
+        }
+        REQUIRE((labelisation_seeded_watershed(g, edge_weights, seeds) == expected));
+    }
+
 }
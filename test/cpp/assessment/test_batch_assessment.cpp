@@ -0,0 +1,161 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/assessment/batch_assessment.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "../test_utils.hpp"
+#include "xtensor/xrandom.hpp"
+
+using namespace hg;
+
+namespace assessment_batch_assessment {
+
+    struct batch_data {
+        std::vector<tree> trees;
+        std::vector<array_1d<double>> altitudes;
+        std::vector<array_2d<index_t>> ground_truths;
+    };
+
+    // random binary hierarchies on 6x5 images, each with a stack of num_ground_truths(i) random ground truths
+    batch_data make_batch_data(const std::vector<index_t> &num_ground_truths) {
+        xt::random::seed(42);
+        auto graph = get_4_adjacency_graph({6, 5});
+        batch_data data;
+        for (auto num_gt: num_ground_truths) {
+            array_1d<double> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 5);
+            auto res = bpt_canonical(graph, edge_weights);
+            data.trees.push_back(std::move(res.tree));
+            data.altitudes.push_back(std::move(res.altitudes));
+            data.ground_truths.push_back(xt::random::randint<index_t>({(size_t) num_gt, num_vertices(graph)}, 0, 4));
+        }
+        return data;
+    }
+
+    void require_same_curves(const fragmentation_curve<> &c1, const fragmentation_curve<> &c2) {
+        REQUIRE(c1.num_regions_ground_truth() == c2.num_regions_ground_truth());
+        REQUIRE((c1.num_regions() == c2.num_regions()));
+        REQUIRE(xt::allclose(c1.scores(), c2.scores()));
+    }
+
+    TEST_CASE("assess partition batch", "[batch_assessment]") {
+        auto data = make_batch_data({3, 1, 2});
+        std::vector<array_1d<index_t>> candidates;
+        for (index_t i = 0; i < (index_t) data.trees.size(); i++) {
+            auto hc = make_horizontal_cut_explorer(data.trees[i], data.altitudes[i]);
+            candidates.push_back(hc.horizontal_cut_from_num_regions(4).labelisation_leaves(data.trees[i]));
+        }
+
+        auto scores = assess_partition_batch(candidates, data.ground_truths, scorer_partition_BCE());
+
+        REQUIRE(scores.size() == 3);
+        for (index_t i = 0; i < (index_t) scores.size(); i++) {
+            REQUIRE(scores[i].size() == data.ground_truths[i].shape()[0]);
+            for (index_t j = 0; j < (index_t) scores[i].size(); j++) {
+                array_1d<index_t> gt = xt::view(data.ground_truths[i], j, xt::all());
+                REQUIRE(almost_equal(scores[i](j), assess_partition(candidates[i], gt, scorer_partition_BCE())));
+            }
+        }
+    }
+
+    TEST_CASE("dendrogram purity batch", "[batch_assessment]") {
+        auto data = make_batch_data({2, 3, 1});
+        std::vector<std::reference_wrapper<const tree>> trees(data.trees.begin(), data.trees.end());
+
+        auto scores = dendrogram_purity_batch(trees, data.ground_truths);
+
+        REQUIRE(scores.size() == 3);
+        for (index_t i = 0; i < (index_t) scores.size(); i++) {
+            REQUIRE(scores[i].size() == data.ground_truths[i].shape()[0]);
+            for (index_t j = 0; j < (index_t) scores[i].size(); j++) {
+                array_1d<index_t> labels = xt::view(data.ground_truths[i], j, xt::all());
+                REQUIRE(almost_equal(scores[i](j), dendrogram_purity(data.trees[i], labels)));
+            }
+        }
+    }
+
+    TEST_CASE("fragmentation curves batch", "[batch_assessment]") {
+        auto data = make_batch_data({2, 1, 3});
+
+        auto curves_oc = assess_fragmentation_optimal_cut_batch(data.trees,
+                                                                data.ground_truths,
+                                                                optimal_cut_measure::DHamming,
+                                                                {},
+                                                                10);
+        auto curves_hc = assess_fragmentation_horizontal_cut_batch(data.trees,
+                                                                   data.altitudes,
+                                                                   data.ground_truths,
+                                                                   scorer_partition_DHamming(),
+                                                                   {},
+                                                                   10);
+
+        REQUIRE(curves_oc.size() == 3);
+        REQUIRE(curves_hc.size() == 3);
+        for (index_t i = 0; i < (index_t) data.trees.size(); i++) {
+            REQUIRE(curves_oc[i].size() == data.ground_truths[i].shape()[0]);
+            REQUIRE(curves_hc[i].size() == data.ground_truths[i].shape()[0]);
+            for (index_t j = 0; j < (index_t) data.ground_truths[i].shape()[0]; j++) {
+                array_1d<index_t> gt = xt::view(data.ground_truths[i], j, xt::all());
+                assesser_fragmentation_optimal_cut assesser(data.trees[i], gt, optimal_cut_measure::DHamming, {}, 10);
+                require_same_curves(curves_oc[i][j], assesser.fragmentation_curve());
+                require_same_curves(curves_hc[i][j],
+                                    assess_fragmentation_horizontal_cut(data.trees[i],
+                                                                        data.altitudes[i],
+                                                                        gt,
+                                                                        scorer_partition_DHamming(),
+                                                                        {},
+                                                                        10));
+            }
+        }
+    }
+
+    TEST_CASE("dendrogram purity batch negative label", "[batch_assessment]") {
+        auto data = make_batch_data({2, 3, 1});
+        std::vector<std::reference_wrapper<const tree>> trees(data.trees.begin(), data.trees.end());
+        data.ground_truths[1](1, 0) = -1;
+
+        REQUIRE_THROWS(dendrogram_purity_batch(trees, data.ground_truths));
+    }
+
+    TEST_CASE("batch assessment repeated tree", "[batch_assessment]") {
+        auto data = make_batch_data({2, 1, 3});
+        std::vector<std::reference_wrapper<const tree>> trees(3, std::cref(data.trees[0]));
+        std::vector<array_1d<double>> altitudes(3, data.altitudes[0]);
+
+        auto purities = dendrogram_purity_batch(trees, data.ground_truths);
+        auto curves_oc = assess_fragmentation_optimal_cut_batch(trees,
+                                                                data.ground_truths,
+                                                                optimal_cut_measure::DHamming,
+                                                                {},
+                                                                10);
+        auto curves_hc = assess_fragmentation_horizontal_cut_batch(trees,
+                                                                   altitudes,
+                                                                   data.ground_truths,
+                                                                   scorer_partition_DHamming(),
+                                                                   {},
+                                                                   10);
+
+        for (index_t i = 0; i < (index_t) trees.size(); i++) {
+            for (index_t j = 0; j < (index_t) data.ground_truths[i].shape()[0]; j++) {
+                array_1d<index_t> gt = xt::view(data.ground_truths[i], j, xt::all());
+                REQUIRE(almost_equal(purities[i](j), dendrogram_purity(data.trees[0], gt)));
+                assesser_fragmentation_optimal_cut assesser(data.trees[0], gt, optimal_cut_measure::DHamming, {}, 10);
+                require_same_curves(curves_oc[i][j], assesser.fragmentation_curve());
+                require_same_curves(curves_hc[i][j],
+                                    assess_fragmentation_horizontal_cut(data.trees[0],
+                                                                        data.altitudes[0],
+                                                                        gt,
+                                                                        scorer_partition_DHamming(),
+                                                                        {},
+                                                                        10));
+            }
+        }
+    }
+}
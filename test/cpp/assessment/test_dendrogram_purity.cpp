@@ -10,6 +10,8 @@
 
 #include "higra/assessment/dendrogram_purity.hpp"
 #include "../test_utils.hpp"
+#include <random>
+#include <numeric>
 
 using namespace hg;
 
@@ -32,5 +34,65 @@ namespace assessment_dendrogram_purity {
 
             REQUIRE(almost_equal(p, 0.5666666666666667));
         }
+        SECTION("negative label"){
+            tree t(array_1d <index_t>{5,5,6,7,7,6,8,8,8});
+            array_1d<int> labels{1,1,-1,1,0};
+
+            REQUIRE_THROWS(dendrogram_purity(t, labels));
+        }
+    }
+
+    TEST_CASE("dendrogram purity random trees", "[dendrogram purity]") {
+        std::mt19937 gen(42);
+        const index_t num_leaves = 60;
+        const index_t num_labels = 4;
+
+        for (index_t trial = 0; trial < 5; trial++) {
+            // random non binary tree obtained by merging random sets of 2 or 3 roots
+            std::vector<index_t> roots(num_leaves);
+            std::iota(roots.begin(), roots.end(), 0);
+            std::vector<index_t> parents(num_leaves);
+            while (roots.size() > 1) {
+                std::shuffle(roots.begin(), roots.end(), gen);
+                index_t k = (std::min)((index_t) roots.size(), (index_t) (2 + gen() % 2));
+                index_t new_node = parents.size();
+                parents.push_back(new_node);
+                for (index_t i = 0; i < k; i++) {
+                    parents[roots.back()] = new_node;
+                    roots.pop_back();
+                }
+                roots.push_back(new_node);
+            }
+            tree t(xt::adapt(parents, {parents.size()}));
+            array_1d<int> labels = xt::zeros<int>({(size_t) num_leaves});
+            for (index_t i = 0; i < num_leaves; i++) {
+                labels(i) = gen() % num_labels;
+            }
+
+            // naive computation
+            array_2d<double> histograms = xt::zeros<double>({num_vertices(t), (size_t) num_labels});
+            for (index_t i = 0; i < num_leaves; i++) {
+                index_t n = i;
+                histograms(n, labels(i)) += 1;
+                while (n != root(t)) {
+                    n = parent(n, t);
+                    histograms(n, labels(i)) += 1;
+                }
+            }
+            auto area = xt::sum(histograms, {1});
+            double total = 0;
+            double Z = 0;
+            for (index_t i = 0; i < num_leaves; i++) {
+                for (index_t j = i + 1; j < num_leaves; j++) {
+                    if (labels(i) == labels(j)) {
+                        auto a = lowest_common_ancestor(i, j, t);
+                        total += histograms(a, labels(i)) / area(a);
+                        Z += 1;
+                    }
+                }
+            }
+
+            REQUIRE(almost_equal(dendrogram_purity(t, labels), total / Z));
+        }
     }
 }
@@ -11,7 +11,9 @@
 #include "higra/assessment/fragmentation_curve.hpp"
 #include "higra/assessment/partition.hpp"
 #include "higra/image/graph_image.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
 #include "../test_utils.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 
@@ -238,4 +240,73 @@ namespace assessment_fragmentation_curve {
             REQUIRE(xt::allclose(res_scores, ref_scores / 11));
             REQUIRE(res_k == ref_k);
     }
+
+    TEST_CASE("fragmentation curve horizontal cut and assess partition", "[fragmentation_curve]") {
+            xt::random::seed(42);
+            auto graph = get_4_adjacency_graph({15, 20});
+            array_1d<int> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 20);
+            auto res = bpt_canonical(graph, edge_weights);
+            auto &tree = res.tree;
+            auto &altitudes = res.altitudes;
+            array_1d<int> ground_truth = xt::random::randint<int>({num_vertices(graph)}, 0, 5);
+
+            auto check = [&](const auto &scorer) {
+                auto curve = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth, scorer, {}, 1000);
+                auto hc_explorer = make_horizontal_cut_explorer(tree, altitudes);
+                REQUIRE(curve.scores().size() == hc_explorer.num_cuts());
+                for (index_t i = 0; i < (index_t) curve.scores().size(); i++) {
+                    auto labels = hc_explorer.horizontal_cut_from_index(i).labelisation_leaves(tree);
+                    REQUIRE(almost_equal(curve.scores()(i), assess_partition(labels, ground_truth, scorer)));
+                }
+            };
+            check(scorer_partition_BCE());
+            check(scorer_partition_DHamming());
+            check(scorer_partition_DCovering());
+    }
+
+    // user scorer with a state and only a dense score function
+    struct scaled_dense_scorer {
+        double scale;
+
+        template<typename T>
+        double score(const xt::xexpression<T> &card_intersection) const {
+            return scale * scorer_partition_DCovering::score(card_intersection);
+        }
+    };
+
+    // user scorer with a state and a (non static) score_row function
+    struct scaled_row_scorer {
+        double scale;
+
+        template<typename value_t, typename T>
+        double score_row(const sparse_card_intersection_row<value_t> &row, double row_card,
+                         const T &column_cards) const {
+            return scale * scorer_partition_BCE::score_row(row, row_card, column_cards);
+        }
+    };
+
+    TEST_CASE("fragmentation curve horizontal cut user scorer", "[fragmentation_curve]") {
+            xt::random::seed(42);
+            auto graph = get_4_adjacency_graph({15, 20});
+            array_1d<int> edge_weights = xt::random::randint<int>({num_edges(graph)}, 0, 20);
+            auto res = bpt_canonical(graph, edge_weights);
+            auto &tree = res.tree;
+            auto &altitudes = res.altitudes;
+            array_1d<int> ground_truth = xt::random::randint<int>({num_vertices(graph)}, 0, 5);
+
+            auto curve_dense = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth,
+                                                                   scaled_dense_scorer{2}, {}, 1000);
+            auto ref_dense = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth,
+                                                                 scorer_partition_DCovering(), {}, 1000);
+            REQUIRE((curve_dense.num_regions() == ref_dense.num_regions()));
+            REQUIRE(xt::allclose(curve_dense.scores(), 2 * ref_dense.scores()));
+
+            auto curve_row = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth,
+                                                                 scaled_row_scorer{3}, {}, 1000);
+            auto ref_row = assess_fragmentation_horizontal_cut(tree, altitudes, ground_truth,
+                                                               scorer_partition_BCE(), {}, 1000);
+            REQUIRE((curve_row.num_regions() == ref_row.num_regions()));
+            REQUIRE(xt::allclose(curve_row.scores(), 3 * ref_row.scores()));
+    }
+
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 
 #include "higra/assessment/partition.hpp"
 #include "../test_utils.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 
@@ -92,4 +93,79 @@ namespace assessment_partition {
             REQUIRE(almost_equal((s1 + s2) / 2.0, cov));
     }
 
+    TEST_CASE("sparse cardinal of intersections", "[assessment_partition]") {
+            array_1d<int> candidate{ 0, 0, 0, 1, 1, 1, 2, 2, 2 };
+            array_1d<int> gt1{ 0, 0, 1, 1, 1, 2, 2, 3, 3 };
+            array_1d<int> gt2{ 0, 0, 0, 0, 1, 1, 1, 1, 1 };
+
+            auto r = sparse_card_intersections(candidate, xt::stack(xt::xtuple(gt1, gt2)));
+            auto ref = card_intersections(candidate, xt::stack(xt::xtuple(gt1, gt2)));
+
+            REQUIRE(r.size() == ref.size());
+            for (int i = 0; i < (int)ref.size(); i++) {
+                REQUIRE((ref[i] == r[i].to_dense()));
+                REQUIRE((r[i].row_cards() == xt::sum(ref[i], {1})));
+                REQUIRE((r[i].column_cards() == xt::sum(ref[i], {0})));
+            }
+            REQUIRE(r[0].num_non_zeros() == 6);
+            REQUIRE(r[1].num_non_zeros() == 4);
+
+            auto row = r[0].row(1);
+            REQUIRE(row.size == 2);
+            REQUIRE(row.labels[0] == 1);
+            REQUIRE(row.labels[1] == 2);
+            REQUIRE(row.cards[0] == 2);
+            REQUIRE(row.cards[1] == 1);
+    }
+
+    TEST_CASE("assess partition sparse and dense", "[assessment_partition]") {
+            xt::random::seed(42);
+            array_2d<int> candidate = xt::random::randint<int>({40, 50}, 0, 30);
+            array_2d<int> ground_truth = xt::random::randint<int>({40, 50}, 0, 7);
+
+            auto sparse = sparse_card_intersections(candidate, ground_truth)[0];
+            auto dense = card_intersections<double>(candidate, ground_truth)[0];
+            REQUIRE((sparse.to_dense() == dense));
+
+            REQUIRE(almost_equal(scorer_partition_BCE::score(sparse), scorer_partition_BCE::score(dense)));
+            REQUIRE(almost_equal(scorer_partition_DHamming::score(sparse), scorer_partition_DHamming::score(dense)));
+            REQUIRE(almost_equal(scorer_partition_DCovering::score(sparse), scorer_partition_DCovering::score(dense)));
+    }
+
+    // user scorer with a state and only a dense score function
+    struct scaled_dense_scorer {
+        double scale;
+
+        template<typename T>
+        double score(const xt::xexpression<T> &card_intersection) const {
+            return scale * scorer_partition_DHamming::score(card_intersection);
+        }
+    };
+
+    // user scorer with a state and a (non static) score_row function
+    struct scaled_row_scorer {
+        double scale;
+
+        template<typename value_t, typename T>
+        double score_row(const sparse_card_intersection_row<value_t> &row, double row_card,
+                         const T &column_cards) const {
+            return scale * scorer_partition_BCE::score_row(row, row_card, column_cards);
+        }
+    };
+
+    TEST_CASE("assess partition user scorer", "[assessment_partition]") {
+            xt::random::seed(42);
+            array_2d<int> candidate = xt::random::randint<int>({40, 50}, 0, 30);
+            array_2d<int> ground_truth = xt::random::randint<int>({40, 50}, 0, 7);
+
+            REQUIRE(!partition_internal::has_score_row<scaled_dense_scorer>::value);
+            REQUIRE(partition_internal::has_score_row<scaled_row_scorer>::value);
+            REQUIRE(partition_internal::has_score_row<scorer_partition_BCE>::value);
+
+            REQUIRE(almost_equal(assess_partition(candidate, ground_truth, scaled_dense_scorer{2}),
+                                 2 * assess_partition(candidate, ground_truth, scorer_partition_DHamming())));
+            REQUIRE(almost_equal(assess_partition(candidate, ground_truth, scaled_row_scorer{3}),
+                                 3 * assess_partition(candidate, ground_truth, scorer_partition_BCE())));
+    }
+
 }
@@ -13,6 +13,7 @@
 #include "higra/image/graph_image.hpp"
 #include "higra/hierarchy/component_tree.hpp"
 #include "higra/io/tree_io.hpp"
+#include "xtensor/xrandom.hpp"
 
 namespace tree_attributes {
 
@@ -155,6 +156,78 @@ namespace tree_attributes {
         REQUIRE((ref == res));
     }
 
+    TEST_CASE("tree attribute fused", "[tree_attributes]") {
+        auto check = [](const tree &t, const array_1d<double> &altitudes, bool increasing) {
+            auto res = compute_tree_attributes(t,
+                                               {tree_attribute::area,
+                                                tree_attribute::volume,
+                                                tree_attribute::depth,
+                                                tree_attribute::height,
+                                                tree_attribute::extrema,
+                                                tree_attribute::dynamics,
+                                                tree_attribute::topological_height},
+                                               altitudes,
+                                               increasing);
+            auto area = attribute_area(t);
+            REQUIRE((res.area == area));
+            REQUIRE(xt::allclose(res.volume, attribute_volume(t, altitudes, area)));
+            REQUIRE((res.depth == attribute_depth(t)));
+            REQUIRE((res.height == attribute_height(t, altitudes, increasing)));
+            REQUIRE((res.extrema == attribute_extrema(t, altitudes)));
+            REQUIRE((res.dynamics == attribute_dynamics(t, altitudes, increasing)));
+            array_1d<index_t> topological_height = xt::zeros<index_t>({num_vertices(t)});
+            for (auto n: leaves_to_root_iterator(t, leaves_it::exclude)) {
+                for (auto c: children_iterator(n, t)) {
+                    topological_height(n) = (std::max)(topological_height(n), topological_height(c) + 1);
+                }
+            }
+            REQUIRE((res.topological_height == topological_height));
+        };
+
+        SECTION("dynamics trees") {
+            check(tree(xt::xarray<index_t>{8, 8, 9, 7, 7, 11, 11, 9, 10, 10, 12, 12, 12}),
+                  {0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 10},
+                  true);
+            check(tree(xt::xarray<index_t>{11, 11, 9, 9, 8, 8, 13, 13, 10, 10, 12, 12, 14, 14, 14}),
+                  {0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 1, 4, 8, 10},
+                  true);
+        }
+
+        SECTION("random component trees") {
+            xt::random::seed(42);
+            auto graph = get_4_adjacency_implicit_graph({50, 40});
+            array_1d<double> vertex_weights = xt::random::randint<int>({num_vertices(graph)}, 0, 20);
+
+            auto max_tree = component_tree_max_tree(graph, vertex_weights);
+            check(max_tree.tree, max_tree.altitudes, false);
+
+            auto min_tree = component_tree_min_tree(graph, vertex_weights);
+            check(min_tree.tree, min_tree.altitudes, true);
+        }
+
+        SECTION("subset and leaf area") {
+            tree t(xt::xarray<index_t>{5, 5, 6, 6, 6, 7, 7, 7});
+            array_1d<index_t> leaf_area{2, 1, 1, 3, 2};
+            array_1d<double> altitudes{0, 0, 0, 0, 0, 1, 2, 4};
+            auto res = compute_tree_attributes(t, {tree_attribute::volume}, leaf_area, altitudes);
+            REQUIRE(res.area.size() == 0);
+            REQUIRE(res.depth.size() == 0);
+            REQUIRE(res.height.size() == 0);
+            REQUIRE(res.extrema.size() == 0);
+            REQUIRE(res.dynamics.size() == 0);
+            REQUIRE(res.topological_height.size() == 0);
+            array_1d<double> ref_volume{0, 0, 0, 0, 0, 9, 12, 21};
+            REQUIRE(xt::allclose(res.volume, ref_volume));
+
+            auto res2 = compute_tree_attributes(t, {tree_attribute::area, tree_attribute::depth}, leaf_area,
+                                                array_1d<double>());
+            array_1d<index_t> ref_area{2, 1, 1, 3, 2, 3, 6, 9};
+            array_1d<index_t> ref_depth{2, 2, 2, 2, 2, 1, 1, 0};
+            REQUIRE((res2.area == ref_area));
+            REQUIRE((res2.depth == ref_depth));
+        }
+    }
+
     TEST_CASE("tree attribute siblings", "[tree_attributes]") {
         auto t = data.t;
 
@@ -14,6 +14,7 @@
 #include "xtensor/xrandom.hpp"
 #include "higra/hierarchy/hierarchy_core.hpp"
 #include "higra/algo/tree.hpp"
+#include <random>
 
 
 using namespace hg;
@@ -234,4 +235,125 @@ namespace binary_partition_tree {
         REQUIRE(r3.tree.parents() == r3_ref.tree.parents());
     }
 
+    TEST_CASE("reciprocal nearest neighbours engine simple", "[binary_partition_tree]") {
+        auto graph = get_4_adjacency_graph({3, 3});
+        array_1d<double> edge_weights({1, 8, 2, 10, 15, 3, 11, 4, 12, 13, 5, 6});
+        auto res = binary_partition_tree_complete_linkage(graph, edge_weights, bpt_engine::rnn);
+
+        array_1d<index_t> expected_parents({9, 9, 10, 11, 11, 12, 13, 13, 14, 10, 16, 12, 15, 14, 15, 16, 16});
+        array_1d<double> expected_levels({0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 13, 15});
+        REQUIRE((expected_parents == res.tree.parents()));
+        REQUIRE((expected_levels == res.altitudes));
+
+        array_1d<double> edge_weights2({1, 7, 2, 10, 16, 3, 11, 4, 12, 14, 5, 6});
+        array_1d<double> edge_weight_weights({7, 1, 7, 3, 2, 8, 2, 2, 2, 1, 5, 9});
+        auto res2 = binary_partition_tree_average_linkage(graph, edge_weights2, edge_weight_weights, bpt_engine::rnn);
+
+        array_1d<index_t> expected_parents2({9, 9, 10, 11, 11, 12, 13, 13, 14, 10, 15, 12, 15, 14, 16, 16, 16});
+        array_1d<double> expected_levels2({0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4, 5, 6, 11.5, 12});
+        REQUIRE((expected_parents2 == res2.tree.parents()));
+        REQUIRE((expected_levels2 == res2.altitudes));
+
+        ugraph single(1);
+        auto res3 = binary_partition_tree_complete_linkage(single, array_1d<double>::from_shape({0}), bpt_engine::rnn);
+        REQUIRE(num_vertices(res3.tree) == 1);
+
+        ugraph disconnected(3);
+        add_edge(0, 1, disconnected);
+        REQUIRE_THROWS(binary_partition_tree_complete_linkage(disconnected, array_1d<double>{1}, bpt_engine::rnn));
+
+        ugraph multigraph(3);
+        add_edge(0, 1, multigraph);
+        add_edge(1, 2, multigraph);
+        add_edge(1, 2, multigraph);
+        array_1d<double> multigraph_weights{1, 2, 3};
+        REQUIRE_NOTHROW(binary_partition_tree_complete_linkage(multigraph, multigraph_weights));
+        REQUIRE_THROWS(binary_partition_tree_complete_linkage(multigraph, multigraph_weights, bpt_engine::rnn));
+    }
+
+    TEST_CASE("reciprocal nearest neighbours engine equivalence", "[binary_partition_tree]") {
+        xt::random::seed(42);
+        auto graph = get_4_adjacency_graph({25, 37});
+        // add some long range edges
+        for (index_t i = 0; i < 100; i++) {
+            add_edge(i * 7 % num_vertices(graph), (i * 13 + 200) % num_vertices(graph), graph);
+        }
+        array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+        array_1d<double> edge_weight_weights = xt::random::randint<int>({num_edges(graph)}, 1, 10);
+
+        auto r1 = binary_partition_tree_complete_linkage(graph, edge_weights, bpt_engine::rnn);
+        auto r1_ref = binary_partition_tree_complete_linkage(graph, edge_weights);
+        REQUIRE((r1.tree.parents() == r1_ref.tree.parents()));
+        REQUIRE((r1.altitudes == r1_ref.altitudes));
+
+        auto r2 = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights, bpt_engine::rnn);
+        auto r2_ref = binary_partition_tree_average_linkage(graph, edge_weights, edge_weight_weights);
+        REQUIRE((r2.tree.parents() == r2_ref.tree.parents()));
+        REQUIRE(xt::allclose(r2.altitudes, r2_ref.altitudes));
+
+        auto r3 = binary_partition_tree_exponential_linkage(graph, edge_weights, 2, edge_weight_weights,
+                                                            bpt_engine::rnn);
+        auto r3_ref = binary_partition_tree_exponential_linkage(graph, edge_weights, 2, edge_weight_weights);
+        REQUIRE((r3.tree.parents() == r3_ref.tree.parents()));
+        REQUIRE(xt::allclose(r3.altitudes, r3_ref.altitudes));
+
+        // Ward linkage is reducible on a complete graph
+        ugraph complete(30);
+        for (index_t i = 0; i < 30; i++) {
+            for (index_t j = i + 1; j < 30; j++) {
+                add_edge(i, j, complete);
+            }
+        }
+        array_2d<double> vertex_centroids = xt::random::rand<double>({30, 3});
+        array_1d<double> vertex_sizes = xt::random::randint<int>({30}, 1, 5);
+        auto r4 = binary_partition_tree_ward_linkage(complete, vertex_centroids, vertex_sizes, "none", bpt_engine::rnn);
+        auto r4_ref = binary_partition_tree_ward_linkage(complete, vertex_centroids, vertex_sizes, "none");
+        REQUIRE((r4.tree.parents() == r4_ref.tree.parents()));
+        REQUIRE(xt::allclose(r4.altitudes, r4_ref.altitudes));
+
+        // on a non complete graph, the result is a valid hierarchy with non decreasing corrected altitudes
+        array_2d<double> vertex_centroids2 = xt::random::rand<double>({(size_t) num_vertices(graph), (size_t) 3});
+        array_1d<double> vertex_sizes2 = xt::ones<double>({num_vertices(graph)});
+        auto r5 = binary_partition_tree_ward_linkage(graph, vertex_centroids2, vertex_sizes2, "max", bpt_engine::rnn);
+        auto &t5 = r5.tree;
+        REQUIRE(num_vertices(t5) == num_vertices(graph) * 2 - 1);
+        for (auto n: leaves_to_root_iterator(t5, leaves_it::exclude, root_it::exclude)) {
+            REQUIRE(r5.altitudes(n) <= r5.altitudes(parent(n, t5)));
+        }
+    }
+
+    TEST_CASE("binary partition tree heap policies", "[binary_partition_tree]") {
+        xt::random::seed(7);
+        auto graph = get_4_adjacency_graph({31, 29});
+        // distinct weights: the result does not depend on the heap
+        array_1d<index_t> edge_weights = xt::arange<index_t>(num_edges(graph));
+        std::shuffle(edge_weights.begin(), edge_weights.end(), std::mt19937(12));
+        array_1d<double> edge_weights_d = xt::random::rand<double>({num_edges(graph)});
+        array_1d<double> edge_weight_weights = xt::random::randint<int>({num_edges(graph)}, 1, 10);
+
+        auto ref = binary_partition_tree_complete_linkage(graph, edge_weights);
+        auto r1 = binary_partition_tree_complete_linkage<dary_heap_policy<>>(graph, edge_weights);
+        REQUIRE((ref.tree.parents() == r1.tree.parents()));
+        REQUIRE((ref.altitudes == r1.altitudes));
+        auto r2 = binary_partition_tree_complete_linkage<dary_heap_policy<2>>(graph, edge_weights);
+        REQUIRE((ref.tree.parents() == r2.tree.parents()));
+        REQUIRE((ref.altitudes == r2.altitudes));
+        auto r3 = binary_partition_tree_complete_linkage<radix_heap_policy>(graph, edge_weights);
+        REQUIRE((ref.tree.parents() == r3.tree.parents()));
+        REQUIRE((ref.altitudes == r3.altitudes));
+
+        auto ref2 = binary_partition_tree_average_linkage(graph, edge_weights_d, edge_weight_weights);
+        auto r4 = binary_partition_tree_average_linkage<dary_heap_policy<8>>(graph, edge_weights_d,
+                                                                            edge_weight_weights);
+        REQUIRE((ref2.tree.parents() == r4.tree.parents()));
+        REQUIRE(xt::allclose(ref2.altitudes, r4.altitudes));
+
+        array_2d<double> vertex_centroids = xt::random::rand<double>({(size_t) num_vertices(graph), (size_t) 2});
+        array_1d<double> vertex_sizes = xt::ones<double>({num_vertices(graph)});
+        auto ref3 = binary_partition_tree_ward_linkage(graph, vertex_centroids, vertex_sizes);
+        auto r5 = binary_partition_tree_ward_linkage<dary_heap_policy<>>(graph, vertex_centroids, vertex_sizes);
+        REQUIRE((ref3.tree.parents() == r5.tree.parents()));
+        REQUIRE(xt::allclose(ref3.altitudes, r5.altitudes));
+    }
+
 }
@@ -14,6 +14,7 @@
 #include "higra/image/graph_image.hpp"
 #include "higra/algo/tree.hpp"
 #include "xtensor/xadapt.hpp"
+#include "xtensor/xrandom.hpp"
 
 using namespace hg;
 using namespace std;
@@ -38,6 +39,31 @@ namespace binary_partition_tree {
         REQUIRE((expected_parents == parents));
     }
 
+    TEST_CASE("test parallel_pre_tree_construction", "[component_tree]") {
+        xt::random::seed(1);
+        index_t height = 37;
+        index_t width = 23;
+        auto graph = get_4_adjacency_graph({height, width});
+        auto implicit_graph = get_8_adjacency_implicit_graph({height, width});
+        // few distinct values to test ties
+        array_1d<int> vertex_weights = xt::random::randint<int>({(size_t) (height * width)}, 0, 10);
+
+        auto check = [&vertex_weights](const auto &g, const auto &comp) {
+            array_1d<index_t> sorted_vertex_indices = stable_arg_sort(vertex_weights, comp);
+            auto expected_parents = component_tree_internal::pre_tree_construction(g, sorted_vertex_indices);
+            for (index_t num_slabs: {1, 2, 3, 5, 8, 17, 64, 10000}) {
+                auto parents = component_tree_internal::parallel_pre_tree_construction(g, vertex_weights, comp,
+                                                                                        num_slabs);
+                REQUIRE((expected_parents == parents));
+            }
+        };
+
+        check(graph, std::less<int>());
+        check(graph, std::greater<int>());
+        check(implicit_graph, std::less<int>());
+        check(implicit_graph, std::greater<int>());
+    }
+
     TEST_CASE("test canonize_tree", "[component_tree]") {
         auto graph = get_4_adjacency_implicit_graph({4, 4});
         array_1d<double> vertex_weights({0, 1, 4, 4,
@@ -65,6 +65,24 @@ namespace hierarchy_core {
         REQUIRE((mst_edge_map == array_1d<int>({1, 0, 3, 4, 2})));
     }
 
+    TEST_CASE("canonical binary partition tree filter kruskal", "[hierarchy_core]") {
+        // large enough to trigger the partitioning and filtering steps
+        auto graph = get_8_adjacency_graph({200, 200});
+        auto edge_weights = xt::eval(xt::random::randint<int>({num_edges(graph)}, 0, 50));
+
+        auto res = hierarchy_core_internal::bpt_canonical_filter_kruskal(sources(graph),
+                                                                         targets(graph),
+                                                                         edge_weights,
+                                                                         num_vertices(graph));
+        array_1d<index_t> sorted_edges = stable_arg_sort(edge_weights);
+        auto ref = hierarchy_core_internal::bpt_canonical_from_sorted_edges(sources(graph),
+                                                                            targets(graph),
+                                                                            sorted_edges,
+                                                                            num_vertices(graph));
+        REQUIRE((res.first == ref.first));
+        REQUIRE((res.second == ref.second));
+    }
+
 
     TEST_CASE("simplify tree", "[hierarchy_core]") {
 
@@ -216,6 +234,82 @@ namespace hierarchy_core {
         REQUIRE((sm_bpt == sm_qfz));
     }
 
+    TEST_CASE("saliency map regular graph", "[hierarchy_core]") {
+        xt::random::seed(42);
+        embedding_grid_2d embedding{13, 17};
+        for (auto implicit_graph: {get_4_adjacency_implicit_graph(embedding),
+                                   get_8_adjacency_implicit_graph(embedding)}) {
+            auto graph = copy_graph<ugraph>(implicit_graph);
+            auto edge_weights = xt::eval(xt::random::randint<int>({num_edges(graph)}, 0, 25));
+            auto bpt = bpt_canonical(graph, edge_weights);
+
+            auto sm_ref = saliency_map(graph, bpt.tree, bpt.altitudes);
+            auto sm = saliency_map(implicit_graph, bpt.tree, bpt.altitudes);
+            REQUIRE((sm == sm_ref));
+        }
+    }
+
+    TEST_CASE("saliency map khalimsky", "[hierarchy_core]") {
+        xt::random::seed(42);
+        for (auto shape: {std::vector<size_t>{1, 1}, std::vector<size_t>{1, 5}, std::vector<size_t>{7, 1},
+                          std::vector<size_t>{11, 9}}) {
+            embedding_grid_2d embedding(shape);
+            auto graph = get_4_adjacency_graph(embedding);
+            array_1d<double> edge_weights = xt::random::rand<double>({num_edges(graph)});
+            auto bpt = bpt_canonical(graph, edge_weights);
+            auto sm = saliency_map(graph, bpt.tree, bpt.altitudes);
+
+            auto ref = graph_4_adjacency_2_khalimsky(graph, embedding, sm);
+            auto res = saliency_map_khalimsky(graph, bpt.tree, embedding, bpt.altitudes);
+            REQUIRE((res == ref));
+
+            auto ref2 = graph_4_adjacency_2_khalimsky(graph, embedding, sm, true);
+            auto res2 = saliency_map_khalimsky(graph, bpt.tree, embedding, bpt.altitudes, true);
+            REQUIRE((res2 == ref2));
+
+            auto ref3 = graph_4_adjacency_2_khalimsky(graph, embedding, sm, true, 2.0);
+            auto res3 = saliency_map_khalimsky(graph, bpt.tree, embedding, bpt.altitudes, true, 2.0);
+            REQUIRE((res3 == ref3));
+        }
+    }
+
+    TEST_CASE("saliency map khalimsky invalid graph", "[hierarchy_core]") {
+        embedding_grid_2d embedding{3, 4};
+        auto graph4 = get_4_adjacency_graph(embedding);
+        auto bpt4 = bpt_canonical(graph4, array_1d<double>::from_shape({num_edges(graph4)}));
+        REQUIRE_NOTHROW(saliency_map_khalimsky(graph4, bpt4.tree, embedding, bpt4.altitudes));
+
+        // 8 adjacency graph
+        auto graph8 = get_8_adjacency_graph(embedding);
+        auto bpt8 = bpt_canonical(graph8, array_1d<double>::from_shape({num_edges(graph8)}));
+        REQUIRE_THROWS(saliency_map_khalimsky(graph8, bpt8.tree, embedding, bpt8.altitudes));
+
+        // same number of edges as the 4 adjacency graph, but one edge wraps around a row
+        ugraph graph_wrap(num_vertices(graph4));
+        for (const auto &e: edge_iterator(graph4)) {
+            if (source(e, graph4) == 6 && target(e, graph4) == 7) {
+                add_edge(3, 4, graph_wrap);
+            } else {
+                add_edge(source(e, graph4), target(e, graph4), graph_wrap);
+            }
+        }
+        REQUIRE_THROWS(saliency_map_khalimsky(graph_wrap, bpt4.tree, embedding, bpt4.altitudes));
+
+        // same number of edges as the 4 adjacency graph, but one edge is duplicated
+        ugraph graph_dup(num_vertices(graph4));
+        for (const auto &e: edge_iterator(graph4)) {
+            if (source(e, graph4) == 6 && target(e, graph4) == 7) {
+                add_edge(0, 1, graph_dup);
+            } else {
+                add_edge(source(e, graph4), target(e, graph4), graph_dup);
+            }
+        }
+        REQUIRE_THROWS(saliency_map_khalimsky(graph_dup, bpt4.tree, embedding, bpt4.altitudes));
+
+        // graph and embedding sizes differ
+        REQUIRE_THROWS(saliency_map_khalimsky(graph4, bpt4.tree, embedding_grid_2d{4, 3}, bpt4.altitudes));
+    }
+
     TEST_CASE("tree_2_binary_tree", "[hierarchy_core]") {
         array_1d<index_t> parents{9, 9, 10, 10, 10, 10, 11, 11, 11, 12, 12, 12, 12};
         tree t(parents);
@@ -14,6 +14,7 @@
 #include "xtensor/xstrided_view.hpp"
 #include "xtensor/xrandom.hpp"
 #include "../test_utils.hpp"
+#include <numeric>
 #include <set>
 
 namespace tree_of_shapes {
@@ -57,6 +58,98 @@ namespace tree_of_shapes {
             }
         }
     }
+    TEST_CASE("test ranked_level_multi_queue", "[tree_of_shapes]") {
+        using qt = hg::tree_of_shapes_internal::ranked_level_multi_queue<float>;
+
+        qt q({-1.5f, 0, 0.5f, 3, 4.5f}, 10);
+
+        SECTION("empty queue") {
+            REQUIRE(q.size() == 0);
+            REQUIRE(q.empty());
+            REQUIRE(q.num_levels() == 5);
+            REQUIRE(q.min_level() == 0);
+            REQUIRE(q.max_level() == 4);
+            for (int i = 0; i < 5; i++) {
+                REQUIRE(q.level_empty(i));
+            }
+            REQUIRE(q.level_of(-1.5f) == 0);
+            REQUIRE(q.level_of(3) == 3);
+            REQUIRE(q.level_value(2) == 0.5f);
+        }SECTION("push top pop") {
+            q.push(1, 9);
+            REQUIRE(!q.level_empty(1));
+            REQUIRE(q.size() == 1);
+            q.push(1, 7);
+            REQUIRE(q.size() == 2);
+            REQUIRE(q.top(1) == 9);
+            q.pop(1);
+            REQUIRE(q.size() == 1);
+            REQUIRE(q.top(1) == 7);
+            q.pop(1);
+            REQUIRE(q.size() == 0);
+            REQUIRE(q.level_empty(1));
+        }SECTION("closest non empty") {
+            // the closest level is determined by the level values and not by the ranks
+            q.push(0, 4);
+            q.push(3, 7);
+            std::vector<int> res{0, 0, 0, 3, 3};
+            for (int i = 0; i < 5; i++) {
+                REQUIRE(q.find_closest_non_empty_level(i) == res[i]);
+            }
+            q.pop(0);
+            q.push(4, 2);
+            q.pop(3);
+            REQUIRE(q.find_closest_non_empty_level(0) == 4);
+        }
+    }
+
+    TEST_CASE("test ranked_level_multi_queue many levels", "[tree_of_shapes]") {
+        // enough levels to have three levels of bitmaps in the occupancy bitset
+        const index_t num_levels = 64 * 64 * 2 + 17;
+        xt::random::seed(42);
+        array_1d<double> increments = xt::random::rand<double>({(size_t) num_levels}, 0.01, 1);
+        std::vector<double> levels(num_levels);
+        std::partial_sum(increments.begin(), increments.end(), levels.begin());
+        hg::tree_of_shapes_internal::ranked_level_multi_queue<double> q(levels, num_levels);
+
+        // closest non empty level by linear search, smallest level in case of equality
+        auto closest = [&q, &levels](index_t level) {
+            index_t best = -1;
+            for (index_t i = 0; i < (index_t) levels.size(); i++) {
+                if (!q.level_empty(i) &&
+                    (best == -1 || std::abs(levels[i] - levels[level]) < std::abs(levels[best] - levels[level]))) {
+                    best = i;
+                }
+            }
+            return best;
+        };
+
+        std::vector<index_t> queue_levels;
+        array_1d<index_t> pushed = xt::random::randint<index_t>({(size_t) 2000}, 0, num_levels);
+        array_1d<index_t> queries = xt::random::randint<index_t>({(size_t) 50}, 0, num_levels);
+        for (index_t i = 0; i < (index_t) pushed.size(); i++) {
+            q.push(pushed(i), i);
+            queue_levels.push_back(pushed(i));
+            if (i % 100 == 0 || i == (index_t) pushed.size() - 1) {
+                for (auto l: queries) {
+                    REQUIRE(q.find_closest_non_empty_level(l) == closest(l));
+                }
+                REQUIRE(q.find_closest_non_empty_level(0) == closest(0));
+                REQUIRE(q.find_closest_non_empty_level(num_levels - 1) == closest(num_levels - 1));
+            }
+        }
+        for (index_t i = 0; i < (index_t) queue_levels.size(); i++) {
+            q.pop(queue_levels[i]);
+            if (!q.empty() && i % 100 == 0) {
+                for (auto l: queries) {
+                    REQUIRE(q.find_closest_non_empty_level(l) == closest(l));
+                }
+            }
+        }
+        REQUIRE(q.empty());
+        REQUIRE_THROWS(q.find_closest_non_empty_level(0));
+    }
+
     /*
     TEST_CASE("test interpolate_plain_map_khalimsky2d", "[tree_of_shapes]") {
 
@@ -394,6 +487,29 @@ TEST_CASE("test tree of shapes 2D no immersion padding zero no original space",
 }
 
 
+TEST_CASE("test tree of shapes 2D float all distinct values", "[tree_of_shapes]") {
+    // one level per pixel: the tree must be the same as with the integer level queue of small integers
+    const index_t h = 70, w = 90;
+    xt::random::seed(42);
+    array_2d<int16_t> gradient = xt::reshape_view(xt::arange<int16_t>(0, h * w), {h, w});
+    array_2d<int16_t> permutation = xt::reshape_view(xt::random::permutation<int16_t>(h * w), {h, w});
+    for (auto &image: {gradient, permutation}) {
+        array_2d<float> image_float = xt::cast<float>(image) * 0.5f - 100.25f;
+        auto res_int = component_tree_tree_of_shapes_image2d(image, tos_padding::none);
+        auto res_float = component_tree_tree_of_shapes_image2d(image_float, tos_padding::none);
+        REQUIRE(test_tree_isomorphism(res_float.tree, res_int.tree));
+        array_1d<float> altitudes_int = xt::cast<float>(res_int.altitudes) * 0.5f - 100.25f;
+        for (index_t i = 0; i < h * w; i++) {
+            REQUIRE(res_float.altitudes(parent(i, res_float.tree)) == altitudes_int(parent(i, res_int.tree)));
+        }
+        std::vector<float> sorted_float(res_float.altitudes.begin(), res_float.altitudes.end());
+        std::vector<float> sorted_int(altitudes_int.begin(), altitudes_int.end());
+        std::sort(sorted_float.begin(), sorted_float.end());
+        std::sort(sorted_int.begin(), sorted_int.end());
+        REQUIRE(sorted_float == sorted_int);
+    }
+}
+
 TEST_CASE("test tree of shapes 2D self duality", "[tree_of_shapes]") {
     xt::random::seed(42);
     array_2d<double> image = xt::random::rand<double>({25, 38});
@@ -910,5 +1026,72 @@ TEST_CASE("test tree of shapes no immersion padding zero no original space", "[t
     REQUIRE((altitudes == ref_altitudes));
 }
 
+TEST_CASE("test tree of shapes implicit plain map", "[tree_of_shapes]") {
+    xt::random::seed(42);
+    array_3d<int> image = xt::random::randint<int>({4, 5, 6}, 0, 10);
+    array_3d<int> padded_image = xt::zeros<int>({6, 7, 8});
+    xt::view(padded_image, xt::range(1, 5), xt::range(1, 6), xt::range(1, 7)) = image;
+
+    array_4d<int> plain_map({11, 13, 15, 2});
+    auto plain_map_interior = xt::view(plain_map, xt::range(2, 9), xt::range(2, 11), xt::range(2, 13), xt::all());
+    tree_of_shapes_internal::interpolate_plain_map_khalimsky_3d(image, embedding_grid_3d({4, 5, 6}),
+                                                                plain_map_interior);
+    tree_of_shapes_internal::fill_padding(plain_map, 0, true, true);
+    auto plain_map_2d = xt::reshape_view(plain_map, {(size_t) 11 * 13 * 15, (size_t) 2});
+
+    tree_of_shapes_internal::implicit_plain_map<int> implicit_plain_map(std::move(padded_image), true);
+    for (index_t i = 0; i < 11 * 13 * 15; i++) {
+        auto bounds = implicit_plain_map(i);
+        REQUIRE(bounds.first == plain_map_2d(i, 0));
+        REQUIRE(bounds.second == plain_map_2d(i, 1));
+    }
+}
 
-}
\ No newline at end of file
+TEST_CASE("test tree of shapes float and integer images", "[tree_of_shapes]") {
+    xt::random::seed(42);
+    array_2d<int> image = xt::random::randint<int>({25, 38}, 0, 6);
+    array_3d<int> image3d = xt::random::randint<int>({6, 7, 8}, 0, 6);
+    for (auto padding: {tos_padding::none, tos_padding::zero}) {
+        for (bool immersion: {true, false}) {
+            auto res1 = component_tree_tree_of_shapes_image(xt::eval(xt::cast<unsigned char>(image)), padding, false,
+                                                            immersion);
+            auto res2 = component_tree_tree_of_shapes_image(xt::eval(xt::cast<float>(image)), padding, false,
+                                                            immersion);
+            auto res3 = component_tree_tree_of_shapes_image(image, padding, false, immersion);
+            REQUIRE((res1.tree.parents() == res2.tree.parents()));
+            REQUIRE((res1.tree.parents() == res3.tree.parents()));
+            REQUIRE((xt::cast<float>(res1.altitudes) == res2.altitudes));
+
+            auto res4 = component_tree_tree_of_shapes_image(xt::eval(xt::cast<unsigned char>(image3d)), padding,
+                                                            false, immersion);
+            auto res5 = component_tree_tree_of_shapes_image(xt::eval(xt::cast<double>(image3d)), padding, false,
+                                                            immersion);
+            REQUIRE((res4.tree.parents() == res5.tree.parents()));
+            REQUIRE((xt::cast<double>(res4.altitudes) == res5.altitudes));
+        }
+    }
+}
+
+TEST_CASE("test tree of shapes parallel pre-tree", "[tree_of_shapes]") {
+    xt::random::seed(42);
+    auto graph = get_6_adjacency_implicit_graph({7, 8, 9});
+    array_2d<double> values = xt::random::rand<double>({(size_t) 7 * 8 * 9, (size_t) 2});
+    array_2d<double> plain_map = xt::stack(xt::xtuple(xt::amin(values, {1}), xt::amax(values, {1})), 1);
+
+    auto res_sort = tree_of_shapes_internal::sort_vertices_tree_of_shapes(graph, plain_map, 0);
+    auto &sorted_vertex_indices = res_sort.first;
+    array_1d<index_t> ranks = array_1d<index_t>::from_shape({sorted_vertex_indices.size()});
+    for (index_t i = 0; i < (index_t) ranks.size(); i++) {
+        ranks(sorted_vertex_indices(i)) = i;
+    }
+
+    auto parents = component_tree_internal::pre_tree_construction(graph, sorted_vertex_indices);
+    for (index_t num_slabs: {1, 2, 5, 7}) {
+        auto parallel_parents = component_tree_internal::parallel_pre_tree_construction(graph, ranks,
+                                                                                        std::less<index_t>(),
+                                                                                        num_slabs);
+        REQUIRE((parents == parallel_parents));
+    }
+}
+
+}
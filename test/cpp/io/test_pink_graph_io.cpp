@@ -9,10 +9,13 @@
 ****************************************************************************/
 
 #include "higra/io/pink_graph_io.hpp"
+#include "higra/image/graph_image.hpp"
+#include <limits>
 #include <sstream>
 #include <string>
 #include "../test_utils.hpp"
 #include "xtensor/xgenerator.hpp"
+#include "xtensor/xrandom.hpp"
 
 namespace pink_graph_io {
     
@@ -273,4 +276,140 @@ namespace pink_graph_io {
         ostringstream out;
         REQUIRE_THROWS(save_pink_graph(out, g, vertex_weights, edge_weights, shape));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("read graph from stream edge list", "[pink_graph_io]") {
+        istringstream in(s);
+
+        auto res = read_pink_graph_edge_list(in);
+
+        REQUIRE(res.num_vertices == 15);
+        REQUIRE(vectorEqual(res.shape, std::vector<size_t>{3, 5}));
+        REQUIRE((res.sources == xt::arange<index_t>(0, 14)));
+        REQUIRE((res.targets == xt::arange<index_t>(1, 15)));
+        REQUIRE(xt::allclose(res.vertex_weights, xt::arange<double>(1, 16)));
+        REQUIRE(xt::allclose(res.edge_weights, array_1d<double>{3, 0, 0, 1, 3, 0, 1, 0, 2, 0, 1, 0, 3, 0}));
+    }
+
+    TEST_CASE("read graph from stream small blocks", "[pink_graph_io]") {
+        // unordered vertices, blank lines, windows line ends, no final line end and various number formats
+        string s3(
+                "#rs 2 cs 2\n"
+                "\n"
+                "4 5\r\n"
+                "val sommets\n"
+                "3 -1.5e3\n"
+                "  1\t0.1\n"
+                "\n"
+                "0 1e-320\n"
+                "2 12345678901234567890123\n"
+                "arcs values\r\n"
+                "0 1 0.30000000000000004\n"
+                "1 2 -0\r\n"
+                "\n"
+                "2 3 inf\n"
+                "3 0 123.456e-7\n"
+                "0 2 +7");
+
+        array_1d<double> vertex_weights{1e-320, 0.1, 12345678901234567890123.0, -1.5e3};
+        array_1d<double> edge_weights{0.30000000000000004, -0.0, std::numeric_limits<double>::infinity(),
+                                      123.456e-7, 7};
+
+        for (size_t block_size: {1, 2, 3, 5, 7, 16, 1000}) {
+            istringstream in(s3);
+            pink_graph_io_internal::line_block_reader reader(in, block_size);
+            auto res = pink_graph_io_internal::read_pink_graph_edge_list(reader);
+            REQUIRE(res.num_vertices == 4);
+            REQUIRE(vectorEqual(res.shape, std::vector<size_t>{2, 2}));
+            REQUIRE((res.sources == array_1d<index_t>{0, 1, 2, 3, 0}));
+            REQUIRE((res.targets == array_1d<index_t>{1, 2, 3, 0, 2}));
+            REQUIRE((res.vertex_weights == vertex_weights));
+            REQUIRE((res.edge_weights == edge_weights));
+        }
+
+        istringstream in("4 5\nval sommets\n0 1\n1 1\n2 1\n3 1\narcs values\n0 1 1\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in));
+    }
+
+    TEST_CASE("read graph from stream missing weight", "[pink_graph_io]") {
+        // the parser must not read the weight of the next line
+        istringstream in1("2 1\nval sommets\n0\n1 5\narcs values\n0 1 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in1));
+
+        istringstream in2("2 1\nval sommets\n0 1\n1 5\narcs values\n0 1 \n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in2));
+    }
+
+    TEST_CASE("read graph from stream invalid vertex index", "[pink_graph_io]") {
+        // indices that overflow an index_t must not wrap to a valid or negative index
+        istringstream in1("2 1\nval sommets\n0 1\n18446744073709551616 5\narcs values\n0 1 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in1));
+
+        istringstream in2("2 1\nval sommets\n0 1\n1 5\narcs values\n0 9223372036854775808 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in2));
+
+        istringstream in3("2 1\nval sommets\n0 1\n1 5\narcs values\n100000000000000000000000 1 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in3));
+
+        istringstream in4("2 1\nval sommets\n0 1\n2 5\narcs values\n0 1 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in4));
+
+        istringstream in5("2 1\nval sommets\n0 1\n1 5\narcs values\n0 9223372036854775807 2\n");
+        REQUIRE_THROWS(read_pink_graph_edge_list(in5));
+    }
+
+    TEST_CASE("read and write large graph", "[pink_graph_io]") {
+        auto g = get_4_adjacency_graph({300, 500});
+        array_1d<double> vertex_weights = xt::random::randn<double>({num_vertices(g)});
+        array_1d<double> edge_weights = xt::random::rand<double>({num_edges(g)}) * 1000;
+        std::vector<size_t> shape = {300, 500};
+
+        ostringstream out;
+        out.precision(17);
+        save_pink_graph(out, g, vertex_weights, edge_weights, shape);
+        string str = out.str();
+
+        // reference parser
+        istringstream ref_in(str);
+        string discard;
+        size_t rs, cs;
+        index_t num_v, num_e;
+        ref_in >> discard >> rs >> discard >> cs >> num_v >> num_e >> discard >> discard;
+        REQUIRE(num_v == (index_t) num_vertices(g));
+        REQUIRE(num_e == (index_t) num_edges(g));
+        for (index_t i = 0; i < num_v; i++) {
+            index_t v;
+            double w;
+            ref_in >> v >> w;
+            REQUIRE(v == i);
+            REQUIRE(w == vertex_weights(i));
+        }
+
+        istringstream in(str);
+        auto res = read_pink_graph(in);
+        REQUIRE(vectorEqual(res.shape, shape));
+        REQUIRE((sources(res.graph) == sources(g)));
+        REQUIRE((targets(res.graph) == targets(g)));
+        REQUIRE((res.vertex_weights == vertex_weights));
+        REQUIRE((res.edge_weights == edge_weights));
+    }
+
+    TEST_CASE("write graph to stream integer weights", "[pink_graph_io]") {
+        ugraph g(3);
+        add_edge(0, 1, g);
+        add_edge(1, 2, g);
+        array_1d<int8_t> vertex_weights{-128, 0, 127};
+        array_1d<uint64_t> edge_weights{0, 18446744073709551615ull};
+        std::vector<size_t> shape{};
+
+        ostringstream out;
+        save_pink_graph(out, g, vertex_weights, edge_weights, shape);
+        REQUIRE(out.str() == "3 2\n"
+                             "val sommets\n"
+                             "0 -128\n"
+                             "1 0\n"
+                             "2 127\n"
+                             "arcs values\n"
+                             "0 1 0\n"
+                             "1 2 18446744073709551615\n");
+    }
+}
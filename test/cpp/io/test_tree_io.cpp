@@ -10,6 +10,10 @@
 
 #include "../test_utils.hpp"
 #include "higra/io/tree_io.hpp"
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <fstream>
 
 namespace tree_io {
 
@@ -40,4 +44,155 @@ namespace tree_io {
             REQUIRE(attributes.count("attr2") == 1);
             REQUIRE(xt::allclose(attributes["attr2"], attr2));
     }
-}
\ No newline at end of file
+
+    TEST_CASE("read and save tree binary", "[tree_io]") {
+        array_1d<index_t> parent{5, 5, 6, 6, 6, 7, 7, 7};
+
+        array_1d<double> attr1{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0};
+        array_1d<int> attr2{8, 7, 6, 5, 4, 3, 2, 1};
+        array_2d<float> attr3{{1, 2}, {3, 4}, {5, 6}, {7, 8}, {9, 10}, {11, 12}, {13, 14}, {15, 16}};
+        array_1d<uint8_t> mst_edge_map{3, 1, 0, 2};
+        tree t(parent);
+        ostringstream out;
+        save_tree_binary(out, t)
+                .add_attribute("attr1", attr1)
+                .add_attribute("attr2", attr2)
+                .add_attribute("attr3", xt::transpose(xt::transpose(attr3)))
+                .add_attribute("mst_edge_map", mst_edge_map)
+                .finalize();
+        string res = out.str();
+
+        istringstream in(res);
+        REQUIRE(is_binary_tree(in));
+        auto archive = read_tree_binary(in);
+        REQUIRE(archive.num_vertices() == 8);
+        REQUIRE((archive.parents() == parent));
+        REQUIRE((parents(archive.get_tree()) == parent));
+
+        REQUIRE(archive.attributes().size() == 4);
+        REQUIRE(archive.has_attribute("attr1"));
+        REQUIRE(!archive.has_attribute("parents"));
+        REQUIRE(!archive.has_attribute("attr4"));
+        REQUIRE((archive.attribute<double>("attr1") == attr1));
+        REQUIRE((archive.attribute<int>("attr2") == attr2));
+        REQUIRE((archive.attribute<float>("attr3") == attr3));
+        REQUIRE((archive.attribute<uint8_t>("mst_edge_map") == mst_edge_map));
+        REQUIRE_THROWS(archive.attribute<float>("attr1"));
+
+        // arrays are aligned in the storage
+        auto &info = archive.attribute_info("attr3");
+        REQUIRE(info.kind == 'f');
+        REQUIRE(info.item_size == 4);
+        REQUIRE(info.shape == vector<size_t>{8, 2});
+        REQUIRE((info.data - archive.storage().get()) % HG_TREE_IO_BINARY_ALIGNMENT == 0);
+
+        // compatibility with read_tree: scalar node attributes are converted to double
+        istringstream in2(res);
+        auto tree_attr = read_tree(in2);
+        REQUIRE((parents(tree_attr.first) == parent));
+        auto attributes = tree_attr.second;
+        REQUIRE(attributes.size() == 2);
+        REQUIRE(xt::allclose(attributes["attr1"], attr1));
+        REQUIRE(xt::allclose(attributes["attr2"], attr2));
+
+        ostringstream out2;
+        save_tree(out2, t).finalize();
+        istringstream in3(out2.str());
+        REQUIRE(!is_binary_tree(in3));
+    }
+
+    TEST_CASE("map tree binary", "[tree_io]") {
+        array_1d<index_t> parent{5, 5, 6, 6, 6, 7, 7, 7};
+        array_1d<double> altitudes{0, 0, 0, 0, 0, 1, 2, 3};
+        tree t(parent);
+
+        string filename = "test_map_tree_binary.tmp";
+        {
+            ofstream out(filename, ios::binary);
+            save_tree_binary(out, t).add_attribute("altitudes", altitudes);
+        }
+
+        {
+            auto archive = map_tree_binary(filename);
+            REQUIRE((parents(archive.get_tree()) == parent));
+            REQUIRE((archive.attribute<double>("altitudes") == altitudes));
+        }
+        std::remove(filename.c_str());
+    }
+
+    TEST_CASE("read tree binary corrupted", "[tree_io]") {
+        array_1d<index_t> parent{5, 5, 6, 6, 6, 7, 7, 7};
+        array_1d<double> altitudes{0, 0, 0, 0, 0, 1, 2, 3};
+        tree t(parent);
+        ostringstream out;
+        save_tree_binary(out, t).add_attribute("altitudes", altitudes).finalize();
+        const string res = out.str();
+
+        auto read = [](const string &content) {
+            istringstream in(content);
+            auto archive = read_tree_binary(in);
+            // access the data of all the arrays
+            double sum = xt::sum(archive.parents())();
+            for (auto &a: archive.attributes()) {
+                a.visit([&a, &sum](auto data) {
+                    for (size_t i = 0; i < a.size(); i++) {
+                        sum += (double) data[i];
+                    }
+                });
+            }
+            return sum;
+        };
+        REQUIRE_NOTHROW(read(res));
+
+        // truncated files
+        for (size_t size: {size_t(0), size_t(8), size_t(63), size_t(64), size_t(80), size_t(100),
+                           res.size() / 2, res.size() - 1}) {
+            REQUIRE_THROWS(read(res.substr(0, size)));
+        }
+
+        string filename = "test_map_tree_binary_truncated.tmp";
+        {
+            ofstream f(filename, ios::binary);
+            f << res.substr(0, res.size() - 8);
+        }
+        REQUIRE_THROWS(map_tree_binary(filename));
+        std::remove(filename.c_str());
+
+        // the first record (parents array, 1 dimension) starts at offset 64: name size, kind, item size,
+        // reserved, dimension, shape, data offset, data size
+        auto corrupt = [&res](size_t position, uint64_t value) {
+            string content = res;
+            std::memcpy(&content[position], &value, sizeof(value));
+            return content;
+        };
+        // the tree category follows the magic number, version, byte order mark, number of nodes and number of arrays
+        auto corrupt_category = [&res](uint32_t category) {
+            string content = res;
+            std::memcpy(&content[32], &category, sizeof(category));
+            return content;
+        };
+        REQUIRE_NOTHROW(read(corrupt_category((uint32_t) tree_category::component_tree)));
+        REQUIRE_THROWS(read(corrupt_category(2)));
+        REQUIRE_THROWS(read(corrupt_category(0xFFFFFFFFu)));
+
+        const uint64_t huge = std::numeric_limits<uint64_t>::max();
+        REQUIRE_THROWS(read(corrupt(64, huge)));
+        REQUIRE_THROWS(read(corrupt(64, huge - 16)));
+        REQUIRE_THROWS(read(corrupt(64, res.size())));
+        REQUIRE_THROWS(read(corrupt(80, huge)));
+        REQUIRE_THROWS(read(corrupt(80, (uint64_t) 1 << 61)));
+        REQUIRE_THROWS(read(corrupt(88, huge - 63)));
+        REQUIRE_THROWS(read(corrupt(88, (uint64_t) 1 << 62)));
+        REQUIRE_THROWS(read(corrupt(96, huge)));
+        REQUIRE_THROWS(read(corrupt(96, huge - 127)));
+
+        // the second record (altitudes, 1 dimension) follows the data of the parents array: a shape whose
+        // product with the element size overflows to the actual data size
+        uint64_t parents_offset, parents_size;
+        std::memcpy(&parents_offset, &res[88], sizeof(uint64_t));
+        std::memcpy(&parents_size, &res[96], sizeof(uint64_t));
+        size_t record = (size_t) tree_io_internal::binary_align(parents_offset + parents_size);
+        REQUIRE_NOTHROW(read(corrupt(record + 16, 8)));
+        REQUIRE_THROWS(read(corrupt(record + 16, ((uint64_t) 1 << 61) + 8)));
+    }
+}
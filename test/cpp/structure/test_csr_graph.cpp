@@ -0,0 +1,152 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/graph.hpp"
+#include "higra/image/graph_image.hpp"
+#include "higra/hierarchy/hierarchy_core.hpp"
+#include "higra/algo/watershed.hpp"
+#include "higra/algo/rag.hpp"
+#include "../test_utils.hpp"
+#include "xtensor/xrandom.hpp"
+
+
+namespace test_csr_graph {
+
+    using namespace std;
+    using namespace hg;
+
+    // 0 - 1
+    // | /
+    // 2   3
+    csr_graph get_graph() {
+        return csr_graph(array_1d<index_t>{0, 1, 0}, array_1d<index_t>{1, 2, 2}, 4);
+    }
+
+    TEST_CASE("csr graph size", "[csr_graph]") {
+        auto g = get_graph();
+
+        REQUIRE(num_vertices(g) == 4);
+        REQUIRE(num_edges(g) == 3);
+        REQUIRE(out_degree(0, g) == 2);
+        REQUIRE(in_degree(0, g) == 2);
+        REQUIRE(degree(0, g) == 2);
+        REQUIRE(out_degree(3, g) == 0);
+        REQUIRE(in_degree(3, g) == 0);
+        REQUIRE(degree(3, g) == 0);
+
+        array_2d<index_t> indices{{0, 3},
+                                  {1, 2}};
+        array_2d<size_t> ref{{2, 0},
+                             {2, 2}};
+        REQUIRE(xt::allclose(degree(indices, g), ref));
+
+        csr_graph g0;
+        REQUIRE(num_vertices(g0) == 0);
+        REQUIRE(num_edges(g0) == 0);
+    }
+
+    TEST_CASE("csr graph iterators", "[csr_graph]") {
+        auto g = get_graph();
+
+        vector<pair<index_t, index_t>> eref{{0, 1},
+                                            {1, 2},
+                                            {0, 2}};
+        vector<pair<index_t, index_t>> etest;
+        for (auto e: edge_iterator(g)) {
+            etest.push_back(e);
+            REQUIRE(e.source == source(edge_from_index(e.index, g), g));
+        }
+        REQUIRE(vectorEqual(eref, etest));
+
+        vector<vector<pair<index_t, index_t>>> out_list{{{0, 1}, {0, 2}},
+                                                        {{1, 0}, {1, 2}},
+                                                        {{2, 1}, {2, 0}},
+                                                        {}};
+        vector<vector<index_t>> out_index{{0, 2},
+                                          {0, 1},
+                                          {1, 2},
+                                          {}};
+        vector<vector<index_t>> adj_list{{1, 2},
+                                         {0, 2},
+                                         {1, 0},
+                                         {}};
+        for (auto v: vertex_iterator(g)) {
+            vector<pair<index_t, index_t>> out;
+            vector<pair<index_t, index_t>> in;
+            vector<index_t> indices;
+            vector<index_t> adj;
+            for (auto e: out_edge_iterator(v, g)) {
+                out.push_back(e);
+                indices.push_back(e.index);
+            }
+            for (auto e: in_edge_iterator(v, g)) {
+                in.emplace_back(e.second, e.first);
+            }
+            for (auto a: adjacent_vertex_iterator(v, g)) {
+                adj.push_back(a);
+            }
+            REQUIRE(vectorEqual(out_list[v], out));
+            REQUIRE(vectorEqual(out_list[v], in));
+            REQUIRE(vectorEqual(out_index[v], indices));
+            REQUIRE(vectorEqual(adj_list[v], adj));
+        }
+    }
+
+    TEST_CASE("csr graph self loops and parallel edges", "[csr_graph]") {
+        csr_graph g(array_1d<index_t>{1, 0, 1, 2}, array_1d<index_t>{1, 1, 0, 2}, 3);
+        REQUIRE(degree(0, g) == 2);
+        REQUIRE(degree(1, g) == 3);
+        REQUIRE(degree(2, g) == 1);
+
+        vector<index_t> adj;
+        for (auto a: adjacent_vertex_iterator(1, g)) {
+            adj.push_back(a);
+        }
+        REQUIRE(vectorEqual(adj, vector<index_t>{1, 0, 0}));
+    }
+
+    TEST_CASE("csr graph same as ugraph", "[csr_graph]") {
+        auto ug = get_8_adjacency_graph({100, 150});
+        csr_graph g(sources(ug), targets(ug), num_vertices(ug));
+        REQUIRE(num_vertices(g) == num_vertices(ug));
+        REQUIRE(num_edges(g) == num_edges(ug));
+        REQUIRE((sources(g) == sources(ug)));
+        REQUIRE((targets(g) == targets(ug)));
+
+        for (auto v: vertex_iterator(g)) {
+            REQUIRE(degree(v, g) == degree(v, ug));
+            auto it = out_edges(v, ug).first;
+            for (auto e: out_edge_iterator(v, g)) {
+                auto e2 = *it;
+                REQUIRE(e.source == e2.source);
+                REQUIRE(e.target == e2.target);
+                REQUIRE(e.index == e2.index);
+                it++;
+            }
+        }
+
+        array_1d<int> edge_weights = xt::random::randint<int>({num_edges(g)}, 0, 20);
+        auto bpt1 = bpt_canonical(g, edge_weights);
+        auto bpt2 = bpt_canonical(ug, edge_weights);
+        REQUIRE((bpt1.tree.parents() == bpt2.tree.parents()));
+        REQUIRE((bpt1.mst_edge_map == bpt2.mst_edge_map));
+
+        auto ws1 = labelisation_watershed(g, edge_weights);
+        auto ws2 = labelisation_watershed(ug, edge_weights);
+        REQUIRE((ws1 == ws2));
+
+        auto rag1 = make_region_adjacency_graph_from_labelisation(g, ws1);
+        auto rag2 = make_region_adjacency_graph_from_labelisation(ug, ws2);
+        REQUIRE((rag1.vertex_map == rag2.vertex_map));
+        REQUIRE((rag1.edge_map == rag2.edge_map));
+        REQUIRE((sources(rag1.rag) == sources(rag2.rag)));
+        REQUIRE((targets(rag1.rag) == targets(rag2.rag)));
+    }
+}
@@ -0,0 +1,157 @@
+/***************************************************************************
+* Copyright ESIEE Paris (2018)                                             *
+*                                                                          *
+* Contributor(s) : Benjamin Perret                                         *
+*                                                                          *
+* Distributed under the terms of the CECILL-B License.                     *
+*                                                                          *
+* The full license is in the file LICENSE, distributed with this software. *
+****************************************************************************/
+
+#include "higra/structure/indexed_heap.hpp"
+#include "../test_utils.hpp"
+#include <random>
+#include <set>
+
+namespace test_indexed_heap {
+
+    using namespace hg;
+    using namespace std;
+
+    template<typename heap_t>
+    void test_simple() {
+        heap_t heap(10);
+        REQUIRE(heap.empty());
+        heap.push(3, 5);
+        heap.push(7, 2);
+        heap.push(1, 8);
+        heap.push(5, 4);
+        REQUIRE(heap.size() == 4);
+        REQUIRE(heap.contains(5));
+        REQUIRE(!heap.contains(4));
+        REQUIRE(heap.top() == 7);
+        REQUIRE(heap.top_value() == 2);
+        REQUIRE(heap.value(3) == 5);
+
+        heap.pop();
+        REQUIRE(!heap.contains(7));
+        heap.update(1, 3);
+        REQUIRE(heap.top() == 1);
+        heap.update(1, 9);
+        REQUIRE(heap.top() == 5);
+        heap.erase(5);
+        REQUIRE(heap.top() == 3);
+        heap.pop();
+        REQUIRE(heap.top() == 1);
+        REQUIRE(heap.top_value() == 9);
+        heap.pop();
+        REQUIRE(heap.empty());
+    }
+
+    /*
+     * Random sequence of operations compared to a std::set. If monotone is true, values pushed or updated are not
+     * smaller than the last popped value (radix heap).
+     */
+    template<typename heap_t>
+    void test_random(bool monotone) {
+        const index_t capacity = 500;
+        std::mt19937 gen(42);
+        std::uniform_int_distribution<int> op_dist(0, 9);
+        std::uniform_int_distribution<int> value_dist(0, 100);
+        std::uniform_int_distribution<index_t> element_dist(0, capacity - 1);
+
+        heap_t heap(capacity);
+        std::set<std::pair<int, index_t>> reference;
+        std::vector<int> values(capacity, -1);
+        int last = 0;
+
+        for (index_t i = 0; i < 20000; i++) {
+            auto op = op_dist(gen);
+            auto element = element_dist(gen);
+            auto value = value_dist(gen) + (monotone ? last : 0);
+            if (op < 4) {
+                if (values[element] < 0) {
+                    heap.push(element, value);
+                    reference.insert({value, element});
+                    values[element] = value;
+                }
+            } else if (op < 7) {
+                if (values[element] >= 0) {
+                    heap.update(element, value);
+                    reference.erase({values[element], element});
+                    reference.insert({value, element});
+                    values[element] = value;
+                }
+            } else if (op < 8) {
+                if (values[element] >= 0) {
+                    heap.erase(element);
+                    reference.erase({values[element], element});
+                    values[element] = -1;
+                }
+            } else if (!reference.empty()) {
+                auto min_value = reference.begin()->first;
+                REQUIRE((int) heap.top_value() == min_value);
+                auto top = heap.top();
+                REQUIRE(values[top] == min_value);
+                heap.pop();
+                reference.erase({min_value, top});
+                values[top] = -1;
+                last = min_value;
+            }
+            REQUIRE(heap.size() == reference.size());
+            REQUIRE(heap.contains(element) == (values[element] >= 0));
+        }
+
+        while (!reference.empty()) {
+            REQUIRE((int) heap.top_value() == reference.begin()->first);
+            reference.erase({heap.top_value(), heap.top()});
+            heap.pop();
+        }
+        REQUIRE(heap.empty());
+    }
+
+    TEST_CASE("indexed fibonacci heap", "[indexed_heap]") {
+        test_simple<indexed_fibonacci_heap<int>>();
+        test_random<indexed_fibonacci_heap<int>>(false);
+    }
+
+    TEST_CASE("indexed dary heap", "[indexed_heap]") {
+        test_simple<indexed_dary_heap<int>>();
+        test_simple<indexed_dary_heap<double, 2>>();
+        test_random<indexed_dary_heap<int, 2>>(false);
+        test_random<indexed_dary_heap<int, 4>>(false);
+        test_random<indexed_dary_heap<int, 7>>(false);
+
+        // ties are broken by element index
+        indexed_dary_heap<int> heap(5);
+        heap.push(3, 1);
+        heap.push(4, 1);
+        heap.push(0, 1);
+        heap.push(2, 0);
+        heap.update(2, 1);
+        for (index_t e: {0, 2, 3, 4}) {
+            REQUIRE(heap.top() == e);
+            heap.pop();
+        }
+    }
+
+    TEST_CASE("indexed radix heap", "[indexed_heap]") {
+        test_simple<indexed_radix_heap<int>>();
+        test_simple<indexed_radix_heap<unsigned char>>();
+        test_random<indexed_radix_heap<int>>(true);
+        test_random<indexed_radix_heap<uint64_t>>(true);
+
+        indexed_radix_heap<long> heap(4);
+        heap.push(0, -5);
+        heap.push(1, 7);
+        heap.push(2, -100);
+        REQUIRE(heap.top_value() == -100);
+        heap.pop();
+        REQUIRE(heap.top_value() == -5);
+        heap.pop();
+        REQUIRE_THROWS(heap.push(3, -6));
+        REQUIRE_THROWS(heap.update(1, -6));
+        heap.update(1, -5);
+        REQUIRE(heap.top() == 1);
+    }
+}
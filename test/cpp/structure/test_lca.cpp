@@ -31,7 +31,8 @@ namespace lca {
     } data;
 
 
-    TEMPLATE_TEST_CASE("lca pairs of vertices", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block) {
+    TEMPLATE_TEST_CASE("lca pairs of vertices", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
         auto t = data.t;
         TestType lca(t);
         REQUIRE(lca.lca(0, 0) == 0);
@@ -49,7 +50,8 @@ namespace lca {
         REQUIRE(lca.lca(2, 6) == 6);
     }
 
-    TEMPLATE_TEST_CASE("lca iterators", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block) {
+    TEMPLATE_TEST_CASE("lca iterators", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
         auto g = get_4_adjacency_graph({2, 2});
         tree t(array_1d<index_t>{4, 4, 5, 5, 6, 6, 6});
         TestType lca(t);
@@ -58,7 +60,8 @@ namespace lca {
         REQUIRE((l == ref));
     }
 
-    TEMPLATE_TEST_CASE("lca tensors", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block) {
+    TEMPLATE_TEST_CASE("lca tensors", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
         tree t(array_1d<index_t>{4, 4, 5, 5, 6, 6, 6});
         TestType lca(t);
         array_1d<index_t> v1{0, 0, 1, 3};
@@ -68,7 +71,8 @@ namespace lca {
         REQUIRE((l == ref));
     }
 
-    TEMPLATE_TEST_CASE("lca sanity", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block) {
+    TEMPLATE_TEST_CASE("lca sanity", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
         xt::random::seed(42);
         auto g = hg::get_4_adjacency_graph({20, 20});
         auto w = xt::eval(xt::random::rand<double>({num_edges(g)}));
@@ -87,6 +91,72 @@ namespace lca {
         }
     }
 
+    TEMPLATE_TEST_CASE("lca batch", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
+        xt::random::seed(42);
+        auto g = hg::get_4_adjacency_graph({40, 40});
+        auto w = xt::eval(xt::random::rand<double>({num_edges(g)}));
+        auto h = hg::bpt_canonical(g, w);
+        auto &tree = h.tree;
+
+        TestType lca(tree);
+        index_t num_queries = 1000;
+        array_1d<index_t> v1 = xt::random::randint<index_t>({num_queries}, 0, num_vertices(tree));
+        array_1d<index_t> v2 = xt::random::randint<index_t>({num_queries}, 0, num_vertices(tree));
+        xt::view(v2, xt::range(0, num_queries, 7)) = xt::view(v1, xt::range(0, num_queries, 7));
+
+        auto res = lca.lca(v1, v2);
+        REQUIRE(res.size() == (size_t) num_queries);
+        for (index_t i = 0; i < num_queries; i++) {
+            REQUIRE(res(i) == lowest_common_ancestor(v1(i), v2(i), tree));
+        }
+
+        auto res_edges = lca.lca(edge_iterator(g));
+        REQUIRE(res_edges.size() == num_edges(g));
+        for (auto e: edge_iterator(g)) {
+            REQUIRE(res_edges(index(e, g)) == lowest_common_ancestor(source(e, g), target(e, g), tree));
+        }
+    }
+
+    TEMPLATE_TEST_CASE("lca schieber vishkin random trees", "[lca]", hg::lca_schieber_vishkin,
+                       hg::lca_schieber_vishkin_32) {
+        xt::random::seed(42);
+        for (index_t num_leaves: {1, 2, 10, 50}) {
+            // random tree with internal nodes of random degrees
+            index_t num_internal = 1 + num_leaves / 2;
+            index_t num_nodes = num_leaves + num_internal;
+            array_1d<index_t> parents = xt::empty<index_t>({num_nodes});
+            for (index_t i = 0; i < num_nodes - 1; i++) {
+                if (i < num_internal) {
+                    // each internal node has at least one leaf child
+                    parents(i) = num_leaves + i;
+                } else {
+                    index_t first = (std::max)(i + 1, num_leaves);
+                    parents(i) = xt::random::randint<index_t>({1}, first, num_nodes)(0);
+                }
+            }
+            parents(num_nodes - 1) = num_nodes - 1;
+            tree t(parents);
+
+            TestType lca(t);
+            for (index_t i = 0; i < num_nodes; ++i) {
+                for (index_t j = 0; j < num_nodes; j++) {
+                    REQUIRE(lca.lca(i, j) == lowest_common_ancestor(i, j, t));
+                }
+            }
+        }
+
+        // chain
+        array_1d<index_t> parents{1, 2, 3, 4, 5, 5};
+        tree t(parents);
+        TestType lca(t);
+        for (index_t i = 0; i < 6; ++i) {
+            for (index_t j = 0; j < 6; j++) {
+                REQUIRE(lca.lca(i, j) == (std::max)(i, j));
+            }
+        }
+    }
+
     TEST_CASE("lca sparse table block", "[lca]") {
         xt::random::seed(42);
         auto g = hg::get_4_adjacency_graph({10, 10});
@@ -106,7 +176,8 @@ namespace lca {
         }
     }
 
-    TEMPLATE_TEST_CASE("lca serialization", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block) {
+    TEMPLATE_TEST_CASE("lca serialization", "[lca]", hg::lca_sparse_table, hg::lca_sparse_table_block,
+                       hg::lca_schieber_vishkin, hg::lca_schieber_vishkin_32) {
         tree t(array_1d<index_t>{4, 4, 5, 5, 6, 6, 6});
         TestType lca(t);
         array_1d<index_t> v1{0, 0, 1, 3};
@@ -10,7 +10,9 @@
 
 #include "xtensor/xio.hpp"
 #include "higra/graph.hpp"
+#include "higra/structure/details/tree_schedule.hpp"
 #include "../test_utils.hpp"
+#include <atomic>
 #include <functional>
 
 namespace tree {
@@ -56,6 +58,25 @@ namespace tree {
         REQUIRE(t.children_computed() == false);
     }
 
+    TEST_CASE("tree children storage", "[tree]") {
+        hg::tree t(array_1d<index_t>{6, 5, 6, 5, 5, 7, 7, 7});
+        vector<vector<index_t>> ref{{}, {}, {}, {}, {}, {1, 3, 4}, {0, 2}, {5, 6}};
+        for (int k = 0; k < 2; k++) {
+            t.compute_children();
+            for (auto v: vertex_iterator(t)) {
+                auto c = t.children(v);
+                REQUIRE(c.size() == ref[v].size());
+                REQUIRE(num_children(v, t) == ref[v].size());
+                REQUIRE(vectorEqual(vector<index_t>(c.begin(), c.end()), ref[v]));
+                for (index_t i = 0; i < (index_t) c.size(); i++) {
+                    REQUIRE(c[i] == ref[v][i]);
+                    REQUIRE(child(i, v, t) == ref[v][i]);
+                }
+            }
+            t.clear_children();
+        }
+    }
+
     TEST_CASE("tree sizes", "[tree]") {
         auto t = data.t;
         REQUIRE(hg::category(t) == tree_category::partition_tree);
@@ -479,4 +500,95 @@ namespace tree {
         REQUIRE(num_vertices(t) == 8);
         REQUIRE(num_edges(t) == 7);
     }
-}
\ No newline at end of file
+
+
+    TEST_CASE("tree schedule", "[tree]") {
+        // 0 .. 9 leaves
+        hg::tree t(array_1d<index_t>{10, 10, 11, 11, 12, 13, 13, 14, 14, 15,
+                                     12, 16, 16, 17, 15, 17, 18, 18, 18});
+        index_t max_subtree_size = 3;
+        tree_internal::tree_schedule schedule(t, max_subtree_size);
+        REQUIRE(schedule.num_subtrees() == 6);
+
+        array_1d<index_t> part = xt::zeros<index_t>({num_vertices(t)}) - 1;
+        for (index_t i = 0; i <= schedule.num_subtrees(); i++) {
+            auto nodes = schedule.nodes(i);
+            if (i < schedule.num_subtrees()) {
+                REQUIRE((index_t) nodes.size() <= max_subtree_size);
+            }
+            for (index_t j = 0; j < (index_t) nodes.size(); j++) {
+                REQUIRE(part(nodes[j]) == -1);
+                part(nodes[j]) = i;
+                if (j > 0) {
+                    REQUIRE(nodes[j - 1] < nodes[j]);
+                }
+            }
+        }
+        REQUIRE(xt::amin(part)() == 0);
+        // each subtree has a single root, whose parent is in the top of the tree
+        vector<index_t> num_roots(schedule.num_subtrees(), 0);
+        for (index_t i = 0; i < (index_t) num_vertices(t) - 1; i++) {
+            if (part(i) != part(parent(i, t))) {
+                REQUIRE(part(parent(i, t)) == schedule.num_subtrees());
+                num_roots[part(i)]++;
+            }
+        }
+        REQUIRE(vectorEqual(num_roots, vector<index_t>(schedule.num_subtrees(), 1)));
+
+        // the callbacks may run concurrently: each node is only written by the task that processes it, and
+        // errors are counted atomically
+        array_1d<index_t> num_visits = xt::zeros<index_t>({num_vertices(t)});
+        std::atomic<index_t> num_errors(0);
+        schedule.leaves_to_root([&](auto first, auto last) {
+            for (; first != last; ++first) {
+                auto n = *first;
+                // the parent of a node is processed after the node
+                if (n != t.root() && num_visits(parent(n, t)) != 0) {
+                    num_errors++;
+                }
+                num_visits(n)++;
+            }
+        });
+        REQUIRE(num_errors.load() == 0);
+        REQUIRE(xt::all(xt::equal(num_visits, 1)));
+
+        num_visits.fill(0);
+        schedule.root_to_leaves([&](auto first, auto last) {
+            for (; first != last; ++first) {
+                auto n = *first;
+                // the parent of a node is processed before the node
+                if (n != t.root() && num_visits(parent(n, t)) == 0) {
+                    num_errors++;
+                }
+                num_visits(n)++;
+            }
+        });
+        REQUIRE(num_errors.load() == 0);
+        REQUIRE(xt::all(xt::equal(num_visits, 1)));
+    }
+
+    TEST_CASE("tree schedule is cached", "[tree]") {
+        hg::tree t(array_1d<index_t>{10, 10, 11, 11, 12, 13, 13, 14, 14, 15,
+                                     12, 16, 16, 17, 15, 17, 18, 18, 18});
+        auto &schedule = t.schedule();
+        REQUIRE(&t.schedule() == &schedule);
+        auto t2 = t;
+        REQUIRE(&t2.schedule() == &schedule);
+
+        index_t num_nodes = 0;
+        for (index_t i = 0; i <= schedule.num_subtrees(); i++) {
+            num_nodes += (index_t) schedule.nodes(i).size();
+        }
+        REQUIRE(num_nodes == (index_t) num_vertices(t));
+
+        hg::tree t3(array_1d<index_t>{10, 10, 11, 11, 12, 13, 13, 14, 14, 15,
+                                      12, 16, 16, 17, 15, 17, 18, 18, 18});
+        std::vector<const tree_internal::tree_schedule *> schedules(8);
+        parfor(0, (index_t) schedules.size(), [&t3, &schedules](index_t i) {
+            schedules[i] = &t3.schedule();
+        });
+        for (auto s: schedules) {
+            REQUIRE(s == &t3.schedule());
+        }
+    }
+}
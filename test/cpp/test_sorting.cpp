@@ -10,6 +10,7 @@
 
 #include "higra/sorting.hpp"
 #include "test_utils.hpp"
+#include "xtensor/xrandom.hpp"
 
 namespace test_sorting {
 
@@ -72,4 +73,42 @@ namespace test_sorting {
         array_1d<int> ref2 = {4, 0, 1, 2, 3};
         REQUIRE((i2 == ref2));
     }
-}
\ No newline at end of file
+
+    template<typename value_t>
+    void test_radix_arg_sort(const array_1d<value_t> &a) {
+        auto less = [](value_t x, value_t y) { return x < y; };
+        auto greater = [](value_t x, value_t y) { return x > y; };
+
+        auto i1 = sorting_internal::radix_stable_arg_sort(a);
+        auto ref1 = stable_arg_sort(a, less);
+        REQUIRE((i1 == ref1));
+
+        auto i2 = sorting_internal::radix_stable_arg_sort(a, true);
+        auto ref2 = stable_arg_sort(a, greater);
+        REQUIRE((i2 == ref2));
+
+        REQUIRE((stable_arg_sort(a) == ref1));
+        REQUIRE((stable_arg_sort(a, std::greater<value_t>()) == ref2));
+    }
+
+    TEST_CASE("radix stable arg sort", "[sorting]") {
+        size_t size = 5000;
+        test_radix_arg_sort<uint8_t>(xt::random::randint<int>({size}, 0, 256));
+        test_radix_arg_sort<int8_t>(xt::random::randint<int>({size}, -128, 128));
+        test_radix_arg_sort<uint16_t>(xt::random::randint<int>({size}, 0, 1000));
+        test_radix_arg_sort<int>(xt::random::randint<int>({size}, -100000, 100000));
+        test_radix_arg_sort<unsigned long>(xt::random::randint<unsigned long>({size}, 0, 1ul << 40));
+        test_radix_arg_sort<long>(xt::random::randint<long>({size}, -(1l << 40), 1l << 40));
+
+        array_1d<float> af = xt::random::randint<int>({size}, -100, 100) / 8.0;
+        af(0) = -0.0f;
+        af(1) = 0.0f;
+        af(2) = std::numeric_limits<float>::infinity();
+        af(3) = -std::numeric_limits<float>::infinity();
+        test_radix_arg_sort<float>(af);
+        array_1d<double> ad = xt::random::randn<double>({size});
+        ad(0) = -0.0;
+        ad(1) = 0.0;
+        test_radix_arg_sort<double>(ad);
+    }
+}
@@ -88,5 +88,28 @@ class TestAlignement(unittest.TestCase):
             res_k = hg.graph_4_adjacency_2_khalimsky(g, res, (3, 3))
             self.assertTrue(np.all(res_k == sm_k_ref))
 
+    def test_hierarchy_aligner_align_hierarchies(self):
+        np.random.seed(42)
+        g = hg.get_4_adjacency_graph((10, 8))
+        aligner = hg.HierarchyAligner.from_graph_cut(g, np.random.randint(0, 2, g.num_edges()))
+
+        trees, altitudes, saliency_maps = [], [], []
+        for _ in range(3):
+            t, a = hg.bpt_canonical(g, np.random.randint(0, 5, g.num_edges()).astype(np.float64))
+            trees.append(t)
+            altitudes.append(a)
+            saliency_maps.append(hg.saliency(t, a))
+
+        res_trees = aligner.align_hierarchies(trees, altitudes)
+        res_sms = aligner.align_hierarchies(g, saliency_maps)
+
+        self.assertTrue(len(res_trees) == 3)
+        self.assertTrue(len(res_sms) == 3)
+        for t, a, sm, r1, r2 in zip(trees, altitudes, saliency_maps, res_trees, res_sms):
+            self.assertTrue(np.all(r1 == aligner.align_hierarchy(t, a)))
+            self.assertTrue(np.all(r2 == aligner.align_hierarchy(g, sm)))
+            self.assertTrue(np.all(r1 == r2))
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -55,6 +55,42 @@ class TestRag(unittest.TestCase):
                                         iv, 4, iv))
         self.assertTrue(np.allclose(edge_map, expected_edge_map))
 
+    def test_make_rag_parallel(self):
+        g = hg.get_4_adjacency_graph((4, 4))
+        vertex_labels = np.asarray((1, 1, 5, 5,
+                                    1, 1, 5, 5,
+                                    1, 1, 3, 3,
+                                    1, 1, 10, 10))
+
+        rag = hg.make_region_adjacency_graph_from_labelisation(g, vertex_labels, parallel=True)
+
+        detail = hg.CptRegionAdjacencyGraph.construct(rag)
+        vertex_map = detail["vertex_map"]
+        edge_map = detail["edge_map"]
+
+        self.assertTrue(rag.num_vertices() == 4)
+        self.assertTrue(rag.num_edges() == 5)
+
+        expected_edges = ((0, 1), (0, 2), (0, 3), (1, 2), (2, 3))
+
+        i = 0
+        for e in rag.edges():
+            self.assertTrue((e[0], e[1]) == expected_edges[i])
+            i += 1
+
+        expected_vertex_map = np.asarray((0, 0, 1, 1,
+                                          0, 0, 1, 1,
+                                          0, 0, 2, 2,
+                                          0, 0, 3, 3))
+        self.assertTrue(np.all(vertex_map == expected_vertex_map))
+
+        iv = -1
+        expected_edge_map = np.asarray((iv, iv, 0, iv, iv, iv, iv,
+                                        iv, iv, 0, iv, iv, 3, 3,
+                                        iv, iv, 1, iv, iv, 4, 4,
+                                        iv, 2, iv))
+        self.assertTrue(np.all(edge_map == expected_edge_map))
+
     def test_make_rag_from_graph_cut(self):
         g = hg.get_4_adjacency_graph((4, 4))
         edge_weights = np.asarray((0, 0, 1, 0, 0, 0, 0,
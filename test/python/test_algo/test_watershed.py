@@ -26,6 +26,20 @@ class TestWatershed(unittest.TestCase):
                     (1, 1, 3, 3))
         self.assertTrue(np.allclose(labels, expected))
 
+    def test_watershed_implicit_graph(self):
+        np.random.seed(1)
+        for shape, explicit, implicit in (((13, 17), hg.get_4_adjacency_graph, hg.get_4_adjacency_implicit_graph),
+                                          ((13, 17), hg.get_8_adjacency_graph, hg.get_8_adjacency_implicit_graph),
+                                          ((5, 7, 9), hg.get_6_adjacency_graph, hg.get_6_adjacency_implicit_graph)):
+            g = explicit(shape)
+            gi = implicit(shape)
+            edge_weights = np.random.randint(0, 5, g.num_edges())
+
+            labels = hg.labelisation_watershed(gi, edge_weights)
+            expected = hg.labelisation_watershed(g, edge_weights)
+            self.assertTrue(labels.shape == shape)
+            self.assertTrue(np.all(labels == expected))
+
     def test_seeded_watershed(self):
         g = hg.get_4_adjacency_graph((4, 4))
         edge_weights = np.asarray((1, 2, 5, 5, 4, 8, 1, 4, 3, 4, 4, 1, 5, 2, 6, 2, 5, 2, 0, 7, 0, 3, 4, 0))
@@ -127,6 +141,41 @@ class TestWatershed(unittest.TestCase):
                                (2, 2, 2, 2)))
         self.assertTrue(np.all(labels == expected))
 
+    def test_seeded_watershed_msf(self):
+        g = hg.get_4_adjacency_graph((4, 4))
+        edge_weights = np.asarray((1, 2, 5, 5, 4, 8, 1, 4, 3, 4, 4, 1, 5, 2, 6, 2, 5, 2, 0, 7, 0, 3, 4, 0))
+
+        msf = hg.make_seeded_watershed_msf(g, edge_weights)
+        self.assertTrue(msf.num_vertices == 16)
+        self.assertTrue(msf.sources.size == 15)
+        self.assertTrue(msf.targets.size == 15)
+
+        seeds = np.asarray(((1, 1, 0, 0),
+                            (1, 0, 0, 0),
+                            (0, 0, 0, 0),
+                            (1, 1, 2, 2)))
+
+        labels = hg.labelisation_seeded_watershed(g, msf, seeds)
+
+        expected = np.asarray(((1, 1, 2, 2),
+                               (1, 1, 2, 2),
+                               (1, 1, 2, 2),
+                               (1, 1, 2, 2)))
+        self.assertTrue(np.all(labels == expected))
+
+        seeds = np.asarray(((1, 1, 9, 9),
+                            (1, 9, 9, 9),
+                            (9, 9, 9, 9),
+                            (2, 2, 3, 3)))
+
+        labels = hg.labelisation_seeded_watershed(g, msf, seeds, background_label=9)
+
+        expected = np.asarray(((1, 1, 3, 3),
+                               (1, 1, 3, 3),
+                               (2, 2, 3, 3),
+                               (2, 2, 3, 3)))
+        self.assertTrue(np.all(labels == expected))
+
 
 if __name__ == '__main__':
     unittest.main()
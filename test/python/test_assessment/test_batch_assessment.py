@@ -0,0 +1,116 @@
+############################################################################
+# Copyright ESIEE Paris (2018)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+
+import unittest
+import numpy as np
+import higra as hg
+
+
+class TestBatchAssessment(unittest.TestCase):
+
+    @staticmethod
+    def get_data(num_ground_truths):
+        np.random.seed(42)
+        g = hg.get_4_adjacency_graph((6, 5))
+        trees, altitudes, ground_truths = [], [], []
+        for n in num_ground_truths:
+            t, a = hg.bpt_canonical(g, np.random.randint(0, 5, g.num_edges()).astype(np.float64))
+            trees.append(t)
+            altitudes.append(a)
+            gt = np.random.randint(0, 4, (n, g.num_vertices()))
+            ground_truths.append(gt[0] if n == 1 else gt)
+        return trees, altitudes, ground_truths
+
+    def test_assess_partition_batch(self):
+        trees, altitudes, ground_truths = self.get_data((3, 1, 2))
+        candidates = [hg.labelisation_horizontal_cut_from_num_regions(t, a, 4) for t, a in zip(trees, altitudes)]
+
+        scores = hg.assess_partition_batch(candidates, ground_truths, hg.PartitionMeasure.BCE)
+
+        self.assertTrue(len(scores) == 3)
+        for candidate, gts, s in zip(candidates, ground_truths, scores):
+            gts = np.atleast_2d(gts)
+            self.assertTrue(s.shape == (gts.shape[0],))
+            for gt, sj in zip(gts, s):
+                self.assertTrue(np.isclose(sj, hg.assess_partition(candidate.ravel(), gt, hg.PartitionMeasure.BCE)))
+
+    def test_dendrogram_purity_batch(self):
+        trees, _, leaf_labels = self.get_data((2, 3, 1))
+
+        scores = hg.dendrogram_purity_batch(trees, leaf_labels)
+
+        self.assertTrue(len(scores) == 3)
+        for t, labels, s in zip(trees, leaf_labels, scores):
+            labels = np.atleast_2d(labels)
+            self.assertTrue(s.shape == (labels.shape[0],))
+            for l, sj in zip(labels, s):
+                self.assertTrue(np.isclose(sj, hg.dendrogram_purity(t, l)))
+
+    def test_dendrogram_purity_batch_negative_label(self):
+        trees, _, leaf_labels = self.get_data((2, 3, 1))
+        leaf_labels[1][1, 0] = -1
+
+        with self.assertRaises(RuntimeError):
+            hg.dendrogram_purity_batch(trees, leaf_labels)
+
+    def test_dendrogram_purity_batch_repeated_tree(self):
+        trees, _, leaf_labels = self.get_data((2, 3, 1))
+        trees = [trees[0]] * 3
+
+        scores = hg.dendrogram_purity_batch(trees, leaf_labels)
+
+        self.assertTrue(len(scores) == 3)
+        for labels, s in zip(leaf_labels, scores):
+            for l, sj in zip(np.atleast_2d(labels), s):
+                self.assertTrue(np.isclose(sj, hg.dendrogram_purity(trees[0], l)))
+
+    def test_assess_fragmentation_batch(self):
+        trees, altitudes, ground_truths = self.get_data((2, 1, 3))
+
+        curves_oc = hg.assess_fragmentation_optimal_cut_batch(trees, ground_truths, hg.OptimalCutMeasure.DHamming,
+                                                              max_regions=10)
+        curves_hc = hg.assess_fragmentation_horizontal_cut_batch(trees, altitudes, ground_truths,
+                                                                 hg.PartitionMeasure.DHamming, max_regions=10)
+
+        self.assertTrue(len(curves_oc) == 3)
+        self.assertTrue(len(curves_hc) == 3)
+        for t, a, gts, c_oc, c_hc in zip(trees, altitudes, ground_truths, curves_oc, curves_hc):
+            gts = np.atleast_2d(gts)
+            self.assertTrue(len(c_oc) == gts.shape[0])
+            self.assertTrue(len(c_hc) == gts.shape[0])
+            for gt, c1, c2 in zip(gts, c_oc, c_hc):
+                ref1 = hg.assess_fragmentation_optimal_cut(t, gt, hg.OptimalCutMeasure.DHamming, max_regions=10)
+                self.assertTrue(np.allclose(c1.scores(), ref1.scores()))
+                self.assertTrue(np.all(c1.num_regions() == ref1.num_regions()))
+                ref2 = hg.assess_fragmentation_horizontal_cut(t, a, gt, hg.PartitionMeasure.DHamming, max_regions=10)
+                self.assertTrue(np.allclose(c2.scores(), ref2.scores()))
+                self.assertTrue(np.all(c2.num_regions() == ref2.num_regions()))
+
+    def test_assess_fragmentation_optimal_cut_batch_on_rag(self):
+        vertex_map = np.asarray((0, 0, 1, 1, 2, 2, 3, 4), dtype=np.int64)
+        g = hg.get_4_adjacency_graph((1, 8))
+        hg.CptRegionAdjacencyGraph.link(g, None, vertex_map, np.ones((7,)))
+        t = hg.Tree((6, 6, 5, 5, 7, 7, 8, 8, 8))
+        hg.CptHierarchy.link(t, g)
+        t2 = hg.Tree((8, 8, 9, 9, 10, 10, 11, 13, 12, 12, 11, 13, 14, 14, 14))
+        ground_truth = np.asarray((0, 0, 1, 1, 1, 2, 2, 2), dtype=np.int32)
+
+        curves = hg.assess_fragmentation_optimal_cut_batch((t, t2), (ground_truth, ground_truth),
+                                                           hg.OptimalCutMeasure.BCE)
+
+        ref_scores = np.asarray((2.75, 4.5, 2 + 4.0 / 3 + 2.5, 2 + 4.0 / 3 + 2, 2 + 4.0 / 3 + 4.0 / 3))
+        self.assertTrue(np.allclose(curves[0][0].scores(), ref_scores / t.num_leaves()))
+        ref2 = hg.assess_fragmentation_optimal_cut(t2, ground_truth, hg.OptimalCutMeasure.BCE)
+        self.assertTrue(np.allclose(curves[1][0].scores(), ref2.scores()))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -56,6 +56,12 @@ class TestHierarchicalCost(unittest.TestCase):
         p = hg.dendrogram_purity(tree, labels)
         self.assertTrue(np.allclose(p, 0.5666666666666667))
 
+    def test_dendrogram_purity_negative_label(self):
+        tree = hg.Tree((5, 5, 6, 7, 7, 6, 8, 8, 8))
+        labels = np.asarray((1, 1, -1, 1, 0), dtype=np.int32)
+        with self.assertRaises(RuntimeError):
+            hg.dendrogram_purity(tree, labels)
+
     def test_dendrogram_purity_random(self):
         g = hg.get_4_adjacency_graph((10, 10))
         np.random.seed(42)
@@ -668,5 +668,33 @@ class TestAttributes(unittest.TestCase):
                0.1481, 0.2222, 0.16, 0.2222, 0.2756)
         self.assertTrue(np.allclose(res,ref,atol=0.0001))
 
+    def test_compute_tree_attributes(self):
+        np.random.seed(1)
+        g = hg.get_4_adjacency_graph((20, 15))
+        vertex_weights = np.random.randint(0, 10, g.num_vertices()).astype(np.float64)
+        names = ["area", "volume", "depth", "height", "extrema", "dynamics", "topological_height"]
+
+        for tree, altitudes in (hg.component_tree_max_tree(g, vertex_weights),
+                                hg.component_tree_min_tree(g, vertex_weights)):
+            res = hg.compute_tree_attributes(tree, names, altitudes)
+            self.assertTrue(set(res.keys()) == set(names))
+            area = hg.attribute_area(tree)
+            self.assertTrue(np.array_equal(res["area"], area))
+            self.assertTrue(np.allclose(res["volume"], hg.attribute_volume(tree, altitudes)))
+            self.assertTrue(np.array_equal(res["depth"], hg.attribute_depth(tree)))
+            self.assertTrue(np.array_equal(res["height"], hg.attribute_height(tree, altitudes)))
+            self.assertTrue(np.array_equal(res["extrema"], hg.attribute_extrema(tree, altitudes)))
+            self.assertTrue(np.array_equal(res["dynamics"], hg.attribute_dynamics(tree, altitudes)))
+            self.assertTrue(np.array_equal(res["topological_height"], hg.attribute_topological_height(tree)))
+
+        tree = hg.Tree((5, 5, 6, 6, 6, 7, 7, 7))
+        res = hg.compute_tree_attributes(tree, [hg.TreeAttribute.area, "depth"], vertex_area=np.asarray((2, 1, 1, 3, 2)))
+        self.assertTrue(set(res.keys()) == {"area", "depth"})
+        self.assertTrue(np.array_equal(res["area"], (2, 1, 1, 3, 2, 3, 6, 9)))
+        self.assertTrue(np.array_equal(res["depth"], (2, 2, 2, 2, 2, 1, 1, 0)))
+
+        with self.assertRaises(ValueError):
+            hg.compute_tree_attributes(tree, ["unknown"])
+
 if __name__ == '__main__':
     unittest.main()
@@ -9,6 +9,9 @@
 ############################################################################
 
 import unittest
+import tempfile
+import os
+import numpy as np
 import higra as hg
 
 
@@ -84,6 +87,28 @@ def default_attr(o, v=1):
     return 4
 
 
+crash_disk_attr = False
+
+
+@hg.auto_cache
+def disk_attr(tree, altitudes, factor=1):
+    global crash_disk_attr
+    if crash_disk_attr:
+        raise Exception("Should not have been called")
+    return altitudes[tree.parents()] * factor
+
+
+crash_disk_tree = False
+
+
+@hg.auto_cache
+def disk_tree(tree):
+    global crash_disk_tree
+    if crash_disk_tree:
+        raise Exception("Should not have been called")
+    return hg.Tree(tree.parents())
+
+
 class TestDataCache(unittest.TestCase):
 
     def test_auto_cache_and_force_recompute(self):
@@ -245,6 +270,129 @@ class TestDataCache(unittest.TestCase):
         self.assertTrue(default_attr(obj1, 1) == 4)
         self.assertRaises(Exception, default_attr, obj1, 1, force_recompute=True)
 
+    def test_auto_cache_disk_tier(self):
+        global crash_disk_attr
+        with tempfile.TemporaryDirectory() as directory:
+            disk_tier = hg.set_auto_cache_disk_tier(directory)
+            try:
+                self.assertTrue(hg.get_auto_cache_disk_tier() is disk_tier)
+                altitudes = np.asarray((0, 0, 0, 2, 3), dtype=np.float32)
+                crash_disk_attr = False
+                res1 = disk_attr(hg.Tree((3, 3, 4, 4, 4)), altitudes, 2)
+                self.assertTrue(len(os.listdir(directory)) == 1)
+
+                # same content, different objects: result is loaded from disk
+                crash_disk_attr = True
+                res2 = disk_attr(hg.Tree((3, 3, 4, 4, 4)), altitudes.copy(), 2)
+                self.assertTrue(res2.dtype == res1.dtype)
+                self.assertTrue(np.all(res2 == res1))
+                res2[0] = 42
+                res3 = disk_attr(hg.Tree((3, 3, 4, 4, 4)), altitudes, factor=2)
+                self.assertTrue(np.all(res3 == res1))
+
+                # different content
+                self.assertRaises(Exception, disk_attr, hg.Tree((3, 3, 4, 4, 4)), altitudes, 3)
+                self.assertRaises(Exception, disk_attr, hg.Tree((4, 3, 4, 4, 4)), altitudes, 2)
+                self.assertRaises(Exception, disk_attr, hg.Tree((3, 3, 4, 4, 4)), altitudes.astype(np.float64), 2)
+                self.assertRaises(Exception, disk_attr, hg.Tree((3, 3, 4, 4, 4)), altitudes, 2, force_recompute=True)
+                self.assertRaises(Exception, disk_attr, hg.Tree((3, 3, 4, 4, 4)), altitudes, 2, no_cache=True)
+
+                # Higra attributes of the arguments are part of their content
+                tree = hg.Tree((3, 3, 4, 4, 4))
+                hg.set_attribute(tree, "foo", np.ones(3))
+                self.assertRaises(Exception, disk_attr, tree, altitudes, 2)
+
+                # arguments which cannot be hashed are not stored on disk
+                crash_disk_attr = False
+                tree = hg.Tree((3, 3, 4, 4, 4))
+                hg.set_attribute(tree, "foo", Dummy(1))
+                disk_attr(tree, altitudes, 2)
+                self.assertTrue(len(os.listdir(directory)) == 1)
+            finally:
+                hg.set_auto_cache_disk_tier(None)
+                hg.clear_all_attributes()
+
+        self.assertTrue(hg.get_auto_cache_disk_tier() is None)
+
+    def test_auto_cache_disk_tier_tree(self):
+        global crash_disk_tree
+        with tempfile.TemporaryDirectory() as directory:
+            hg.set_auto_cache_disk_tier(directory)
+            try:
+                crash_disk_tree = False
+                res1 = disk_tree(hg.Tree((5, 5, 6, 6, 6, 7, 7, 7)))
+                crash_disk_tree = True
+                res2 = disk_tree(hg.Tree((5, 5, 6, 6, 6, 7, 7, 7)))
+                self.assertTrue(type(res2) is hg.Tree)
+                self.assertTrue(np.all(res2.parents() == res1.parents()))
+            finally:
+                hg.set_auto_cache_disk_tier(None)
+                hg.clear_all_attributes()
+
+    def test_auto_cache_disk_tier_linked_graph(self):
+        with tempfile.TemporaryDirectory() as directory:
+            hg.set_auto_cache_disk_tier(directory)
+            try:
+                def make_tree():
+                    g = hg.get_4_adjacency_graph((4, 5))
+                    return hg.bpt_canonical(g, np.arange(g.num_edges(), dtype=np.float64))[0]
+
+                tree1 = make_tree()
+                tree1.lowest_common_ancestor_preprocess()
+                area1 = hg.attribute_area(tree1)
+                # entries of attribute_area and of attribute_vertex_area on the leaf graph
+                entries = [os.path.join(directory, f) for f in os.listdir(directory)]
+                self.assertTrue(len(entries) == 2)
+
+                # replace the stored area: a disk hit returns the new value
+                entry = [e for e in entries if np.load(e).size == tree1.num_vertices()][0]
+                np.save(entry, area1 * 2)
+
+                tree2 = make_tree()
+                area2 = hg.attribute_area(tree2)
+                self.assertTrue(np.all(area2 == area1 * 2))
+                self.assertTrue(len(os.listdir(directory)) == 2)
+            finally:
+                hg.set_auto_cache_disk_tier(None)
+                hg.clear_all_attributes()
+
+    def test_auto_cache_disk_tier_eviction(self):
+        global crash_disk_attr
+        with tempfile.TemporaryDirectory() as directory:
+            # room for 2 entries of 1024 float64 values
+            disk_tier = hg.set_auto_cache_disk_tier(directory, max_size=2 * 8192 + 512)
+            try:
+                crash_disk_attr = False
+                tree = hg.Tree(np.full((1024,), 1023))
+                altitudes = np.zeros((1024,), dtype=np.float64)
+                disk_attr(tree, altitudes, 1)
+                os.utime(os.path.join(directory, os.listdir(directory)[0]), (0, 0))
+                disk_attr(tree, altitudes, 2, attribute_name="other")
+                self.assertTrue(len(os.listdir(directory)) == 2)
+
+                # refresh entry 1
+                hg.clear_all_attributes()
+                crash_disk_attr = True
+                disk_attr(tree, altitudes, 1)
+
+                # entry 2 is the least recently used
+                crash_disk_attr = False
+                disk_attr(tree, altitudes, 3)
+                self.assertTrue(len(os.listdir(directory)) == 2)
+                self.assertTrue(disk_tier.size() <= disk_tier.max_size)
+
+                hg.clear_all_attributes()
+                crash_disk_attr = True
+                disk_attr(tree, altitudes, 1)
+                disk_attr(tree, altitudes, 3)
+                self.assertRaises(Exception, disk_attr, tree, altitudes, 2, attribute_name="other")
+
+                disk_tier.clear()
+                self.assertTrue(len(os.listdir(directory)) == 0)
+            finally:
+                hg.set_auto_cache_disk_tier(None)
+                hg.clear_all_attributes()
+
 
 if __name__ == '__main__':
     unittest.main()
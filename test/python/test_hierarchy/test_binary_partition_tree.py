@@ -169,5 +169,40 @@ class TestBinaryPartitionTree(unittest.TestCase):
         self.assertTrue(np.allclose(altitudes, alt_ref))
 
 
+    def test_binary_partition_tree_rnn_engine(self):
+        np.random.seed(1)
+        g = hg.get_4_adjacency_graph((10, 10))
+        edge_weights = np.random.rand(g.num_edges())
+        edge_weight_weights = np.random.randint(1, 10, g.num_edges())
+
+        tree, altitudes = hg.binary_partition_tree_complete_linkage(g, edge_weights, engine="rnn")
+        t_ref, alt_ref = hg.binary_partition_tree_complete_linkage(g, edge_weights)
+        self.assertTrue(np.all(tree.parents() == t_ref.parents()))
+        self.assertTrue(np.allclose(altitudes, alt_ref))
+
+        tree, altitudes = hg.binary_partition_tree_average_linkage(g, edge_weights, edge_weight_weights, engine="rnn")
+        t_ref, alt_ref = hg.binary_partition_tree_average_linkage(g, edge_weights, edge_weight_weights)
+        self.assertTrue(np.all(tree.parents() == t_ref.parents()))
+        self.assertTrue(np.allclose(altitudes, alt_ref))
+
+        tree, altitudes = hg.binary_partition_tree_exponential_linkage(g, edge_weights, 3, edge_weight_weights,
+                                                                       engine="rnn")
+        t_ref, alt_ref = hg.binary_partition_tree_exponential_linkage(g, edge_weights, 3, edge_weight_weights)
+        self.assertTrue(np.all(tree.parents() == t_ref.parents()))
+        self.assertTrue(np.allclose(altitudes, alt_ref))
+
+        tree, altitudes = hg.binary_partition_tree_ward_linkage(g, np.random.rand(g.num_vertices(), 2), engine="rnn")
+        self.assertTrue(tree.num_vertices() == g.num_vertices() * 2 - 1)
+        self.assertTrue(np.all(altitudes[tree.parents()] >= altitudes))
+
+        with self.assertRaises(Exception):
+            hg.binary_partition_tree_complete_linkage(g, edge_weights, engine="unknown")
+
+        multigraph = hg.UndirectedGraph(3)
+        multigraph.add_edges((0, 1, 1), (1, 2, 2))
+        with self.assertRaises(RuntimeError):
+            hg.binary_partition_tree_average_linkage(multigraph, np.asarray((1., 2., 3.)), engine="rnn")
+
+
 if __name__ == '__main__':
     unittest.main()
@@ -64,6 +64,18 @@ class TestHierarchyCore(unittest.TestCase):
 
         self.assertTrue(np.all(mst_edge_map == (1, 0, 3, 4, 2)))
 
+    def test_BPT_edge_weights_vs_sorted_edge_indices(self):
+        graph = hg.get_8_adjacency_graph((150, 150))
+        edge_weights = np.random.randint(0, 50, graph.num_edges())
+
+        tree1, altitudes1 = hg.bpt_canonical(graph, edge_weights)
+        tree2, altitudes2 = hg.bpt_canonical(graph, edge_weights,
+                                             sorted_edge_indices=hg.arg_sort(edge_weights, stable=True))
+
+        self.assertTrue(np.all(tree1.parents() == tree2.parents()))
+        self.assertTrue(np.all(altitudes1 == altitudes2))
+        self.assertTrue(np.all(tree1.mst_edge_map == tree2.mst_edge_map))
+
     def test_BPT_from_edge_list(self):
         graph = hg.get_4_adjacency_graph((2, 3))
         sources, targets = graph.edge_list()
@@ -241,6 +253,12 @@ class TestHierarchyCore(unittest.TestCase):
         sm = hg.saliency(*hg.bpt_canonical(rag, rag_edge_weights))
         self.assertTrue(np.all(sm == edge_weights))
 
+        # with a precomputed lowest common ancestor structure
+        tree, altitudes = hg.bpt_canonical(graph, edge_weights)
+        tree.lowest_common_ancestor_preprocess()
+        sm = hg.saliency(tree, altitudes)
+        self.assertTrue(np.all(sm == edge_weights))
+
     def test_canonize_tree(self):
         t = TestHierarchyCore.getTree()
         altitudes = np.asarray((0, 0, 0, 0, 0, 1, 2, 2))
@@ -25,6 +25,21 @@ class TestGraphImage(unittest.TestCase):
         r = hg.graph_4_adjacency_2_khalimsky(g, data)
         self.assertTrue(np.allclose(ref, r))
 
+    def test_saliency_khalimsky(self):
+        g = hg.get_4_adjacency_graph((2, 3))
+        data = np.asarray((1, 0, 2, 1, 1, 1, 2))
+        tree, altitudes = hg.bpt_canonical(g, data)
+
+        ref = np.asarray(((0, 1, 0, 2, 0),
+                          (0, 1, 1, 2, 1),
+                          (0, 1, 0, 2, 0)))
+        r = hg.saliency_khalimsky(tree, altitudes)
+        self.assertTrue(np.allclose(ref, r))
+
+        r2 = hg.saliency_khalimsky(tree, altitudes, add_extra_border=True)
+        ref2 = hg.graph_4_adjacency_2_khalimsky(g, data, add_extra_border=True)
+        self.assertTrue(np.allclose(ref2, r2))
+
     def test_khalimsky_2_graph_4_adjacency(self):
         data = np.asarray((1, 0, 2, 1, 1, 1, 2))
 
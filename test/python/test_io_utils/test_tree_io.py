@@ -56,6 +56,50 @@ class TestTreeIO(unittest.TestCase):
 
         self.assertTrue(np.allclose(tree.parents(), parents))
 
+    def test_treeReadWriteBinary(self):
+        filename = "testTreeIOBinary.graph"
+        silent_remove(filename)
+
+        parents = np.asarray((5, 5, 6, 6, 6, 7, 7, 7), dtype=np.int64)
+        tree = hg.Tree(parents)
+
+        altitudes = np.asarray((0, 0, 0, 0, 0, 1.5, 2, 3))
+        attr2 = np.asarray((8, 7, 6, 5, 4, 3, 2, 1), dtype=np.int32)
+        attr3 = np.arange(16, dtype=np.float32).reshape((8, 2))[:, ::-1]
+        mst_edge_map = np.asarray((3, 1, 0, 2), dtype=np.uint8)
+
+        hg.save_tree(filename, tree,
+                     {"altitudes": altitudes, "attr2": attr2, "attr3": attr3, "mst_edge_map": mst_edge_map},
+                     binary=True)
+
+        for mmap in (True, False):
+            tree2, attributes = hg.read_tree(filename, mmap=mmap)
+
+            self.assertTrue(np.all(tree2.parents() == parents))
+            self.assertTrue(len(attributes) == 4)
+            for k, v in (("altitudes", altitudes), ("attr2", attr2), ("attr3", attr3), ("mst_edge_map", mst_edge_map)):
+                self.assertTrue(attributes[k].dtype == v.dtype)
+                self.assertTrue(np.all(attributes[k] == v))
+            self.assertTrue(np.all(hg.get_attribute(tree2, "altitudes") == altitudes))
+
+            # attributes are writable and modifications are not written to the file
+            attributes["attr2"][0] = 100
+            del tree2, attributes
+
+        tree2, attributes = hg.read_tree(filename)
+        self.assertTrue(attributes["attr2"][0] == 8)
+        del tree2, attributes
+        silent_remove(filename)
+
+        # Test without attributes
+        hg.save_tree(filename, tree, binary=True)
+
+        tree2, attributes = hg.read_tree(filename)
+        silent_remove(filename)
+
+        self.assertTrue(np.all(tree2.parents() == parents))
+        self.assertTrue(len(attributes) == 0)
+
     def test_print_partition_tree(self):
         tree = hg.Tree((5, 5, 6, 6, 6, 7, 7, 7))
         s = hg.print_partition_tree(tree, altitudes=np.asarray([0, 0, 0, 0, 0, 100, 1100, 20000]),
@@ -0,0 +1,109 @@
+############################################################################
+# Copyright ESIEE Paris (2018)                                             #
+#                                                                          #
+# Contributor(s) : Benjamin Perret                                         #
+#                                                                          #
+# Distributed under the terms of the CECILL-B License.                     #
+#                                                                          #
+# The full license is in the file LICENSE, distributed with this software. #
+############################################################################
+
+import unittest
+import pickle
+import higra as hg
+import numpy as np
+
+
+class TestCSRGraph(unittest.TestCase):
+
+    @staticmethod
+    def test_graph():
+        # 0 - 1
+        # | /
+        # 2   3
+        return hg.CSRGraph(np.asarray((0, 1, 0), dtype=np.int64), np.asarray((1, 2, 2), dtype=np.int64), 4)
+
+    def test_size(self):
+        g = TestCSRGraph.test_graph()
+        self.assertTrue(g.num_vertices() == 4)
+        self.assertTrue(g.num_edges() == 3)
+        self.assertTrue(g.degree(0) == 2)
+        self.assertTrue(g.degree(3) == 0)
+        self.assertTrue(np.all(g.degree(np.asarray((0, 1, 2, 3))) == (2, 2, 2, 0)))
+
+    def test_iterators(self):
+        g = TestCSRGraph.test_graph()
+
+        self.assertTrue(list(g.edges()) == [(0, 1, 0), (1, 2, 1), (0, 2, 2)])
+        self.assertTrue(list(g.out_edges(0)) == [(0, 1, 0), (0, 2, 2)])
+        self.assertTrue(list(g.in_edges(2)) == [(1, 2, 1), (0, 2, 2)])
+        self.assertTrue(list(g.adjacent_vertices(1)) == [0, 2])
+        self.assertTrue(list(g.adjacent_vertices(3)) == [])
+        self.assertTrue(g.edge_from_index(1) == (1, 2, 1))
+
+        offsets, adjacent_vertices, edge_indices = g._csr_arrays()
+        self.assertTrue(np.all(offsets == (0, 2, 4, 6, 6)))
+        self.assertTrue(np.all(adjacent_vertices == (1, 2, 0, 2, 1, 0)))
+        self.assertTrue(np.all(edge_indices == (0, 2, 0, 1, 1, 2)))
+
+    def test_zero_copy(self):
+        sources = np.asarray((0, 1, 0), dtype=np.int64)
+        targets = np.asarray((1, 2, 2), dtype=np.int64)
+        g = hg.CSRGraph(sources, targets, 4)
+        s, t = g.edge_list()
+        self.assertTrue(s is sources)
+        self.assertTrue(t is targets)
+
+        # other types are converted
+        g = hg.CSRGraph(np.asarray((0, 1, 0), dtype=np.int32), np.asarray((1, 2, 2), dtype=np.uint8), 4)
+        s, t = g.edge_list()
+        self.assertTrue(np.all(s == (0, 1, 0)))
+        self.assertTrue(np.all(t == (1, 2, 2)))
+
+    def test_to_csr_graph(self):
+        g = hg.get_4_adjacency_graph((4, 5))
+        g2 = g.to_csr_graph()
+        self.assertTrue(g2.num_vertices() == g.num_vertices())
+        self.assertTrue(np.all(g2.sources() == g.sources()))
+        self.assertTrue(np.all(g2.targets() == g.targets()))
+        for v in g.vertices():
+            self.assertTrue(list(g2.out_edges(v)) == list(g.out_edges(v)))
+
+    def test_pickle(self):
+        g = TestCSRGraph.test_graph()
+        hg.set_attribute(g, "test", (1, 2, 3))
+        hg.add_tag(g, "foo")
+
+        data = pickle.dumps(g)
+        g2 = pickle.loads(data)
+
+        self.assertTrue(g.num_vertices() == g2.num_vertices())
+        self.assertTrue(np.all(g.sources() == g2.sources()))
+        self.assertTrue(np.all(g.targets() == g2.targets()))
+        self.assertTrue(g2.test == (1, 2, 3))
+        self.assertTrue(hg.has_tag(g2, "foo"))
+
+    def test_algorithms(self):
+        g = hg.get_4_adjacency_graph((10, 12))
+        g2 = g.to_csr_graph()
+        edge_weights = np.random.randint(0, 10, g.num_edges())
+
+        tree1, altitudes1 = hg.bpt_canonical(g, edge_weights)
+        tree2, altitudes2 = hg.bpt_canonical(g2, edge_weights)
+        self.assertTrue(np.all(tree1.parents() == tree2.parents()))
+        self.assertTrue(np.all(altitudes1 == altitudes2))
+
+        labels1 = hg.labelisation_watershed(g, edge_weights)
+        labels2 = hg.labelisation_watershed(g2, edge_weights)
+        self.assertTrue(np.all(labels1.ravel() == labels2))
+
+        rag1 = hg.make_region_adjacency_graph_from_labelisation(g, labels1)
+        rag2 = hg.make_region_adjacency_graph_from_labelisation(g2, labels2)
+        self.assertTrue(np.all(rag1.sources() == rag2.sources()))
+        self.assertTrue(np.all(rag1.targets() == rag2.targets()))
+        self.assertTrue(np.all(hg.CptRegionAdjacencyGraph.get_vertex_map(rag1) ==
+                               hg.CptRegionAdjacencyGraph.get_vertex_map(rag2)))
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -22,7 +22,8 @@ class TestLCAFast(unittest.TestCase):
 
     def test_LCAFast(self):
         t = TestLCAFast.getTree()
-        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block]:
+        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block, hg.LCA_schieber_vishkin,
+                      hg.LCA_schieber_vishkin_32]:
             with self.subTest(lca_type=lca_t):
                 lca = lca_t(t)
 
@@ -62,7 +63,8 @@ class TestLCAFast(unittest.TestCase):
     def test_LCAFastV(self):
         g = hg.get_4_adjacency_graph((2, 2))
         t = hg.Tree((4, 4, 5, 5, 6, 6, 6))
-        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block]:
+        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block, hg.LCA_schieber_vishkin,
+                      hg.LCA_schieber_vishkin_32]:
             with self.subTest(lca_type=lca_t):
                 lca = lca_t(t)
 
@@ -72,7 +74,8 @@ class TestLCAFast(unittest.TestCase):
 
     def test_LCAFastVertices(self):
         t = hg.Tree((4, 4, 5, 5, 6, 6, 6))
-        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block]:
+        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block, hg.LCA_schieber_vishkin,
+                      hg.LCA_schieber_vishkin_32]:
             with self.subTest(lca_type=lca_t):
                 lca = lca_t(t)
                 res = lca.lca((0, 0, 1, 3), (0, 3, 0, 0))
@@ -80,7 +83,8 @@ class TestLCAFast(unittest.TestCase):
 
     def test_dynamic_attributes(self):
         t = hg.Tree((4, 4, 5, 5, 6, 6, 6))
-        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block]:
+        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block, hg.LCA_schieber_vishkin,
+                      hg.LCA_schieber_vishkin_32]:
             with self.subTest(lca_type=lca_t):
                 lca = lca_t(t)
                 lca.new_attribute = 42
@@ -89,7 +93,8 @@ class TestLCAFast(unittest.TestCase):
     def test_pickle(self):
         import pickle
         tree = hg.Tree((4, 4, 5, 5, 6, 6, 6))
-        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block]:
+        for lca_t in [hg.LCA_rmq_sparse_table, hg.LCA_rmq_sparse_table_block, hg.LCA_schieber_vishkin,
+                      hg.LCA_schieber_vishkin_32]:
             with self.subTest(lca_type=lca_t):
                 lca = lca_t(tree)
                 hg.set_attribute(lca, "test", (1, 2, 3))
@@ -105,6 +110,13 @@ class TestLCAFast(unittest.TestCase):
                 self.assertTrue(lca.test == lca2.test)
                 self.assertTrue(hg.has_tag(lca2, "foo"))
 
+    def test_preprocess_schieber_vishkin(self):
+        t = hg.Tree((4, 4, 5, 5, 6, 6, 6))
+        lca = t.lowest_common_ancestor_preprocess(algorithm="schieber_vishkin")
+        self.assertTrue(isinstance(lca, hg.LCA_schieber_vishkin_32))
+        res = t.lowest_common_ancestor((0, 0, 1, 3), (0, 3, 0, 0))
+        self.assertTrue(np.all(res == (0, 6, 4, 6)))
+
 
 if __name__ == '__main__':
     unittest.main()